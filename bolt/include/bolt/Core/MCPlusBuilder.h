@@ -502,10 +502,12 @@ public:
     return 0;
   }
 
-  /// Create increment contents of target by 1 for Instrumentation
+  /// Create increment contents of target by 1 for Instrumentation. Unless
+  /// \p IsAtomic is set, the increment is a plain read-modify-write that may
+  /// lose updates racing with other threads.
   virtual InstructionListType
   createInstrIncMemory(const MCSymbol *Target, MCContext *Ctx, bool IsLeaf,
-                       unsigned CodePointerSize) const {
+                       unsigned CodePointerSize, bool IsAtomic) const {
     llvm_unreachable("not implemented");
     return InstructionListType();
   }
@@ -35,6 +35,11 @@ private:
   sortedByFunc(BinaryContext &BC, const BinarySection &Section,
                std::map<uint64_t, BinaryFunction> &BFs) const;
 
+  /// Group symbols accessed by the same functions, visiting functions in
+  /// order of their memory profile counts.
+  std::pair<DataOrder, unsigned>
+  sortedByAffinity(BinaryContext &BC, const BinarySection &Section) const;
+
   void printOrder(const BinarySection &Section, DataOrder::const_iterator Begin,
                   DataOrder::const_iterator End) const;
 
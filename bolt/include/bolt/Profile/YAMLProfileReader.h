@@ -80,6 +80,11 @@ private:
   /// Initialize maps for profile matching.
   void buildNameMaps(BinaryContext &BC);
 
+  /// Match profiles that found no function by name to functions without a
+  /// profile that have the same hash, e.g. functions renamed or moved since
+  /// the profile was collected.
+  void matchProfilesByHash(BinaryContext &BC);
+
   /// Update matched YAML -> BinaryFunction pair.
   void matchProfileToFunction(yaml::bolt::BinaryFunctionProfile &YamlBF,
                               BinaryFunction &BF) {
@@ -76,6 +76,13 @@ cl::opt<bool>
                       cl::init(false), cl::Optional,
                       cl::cat(BoltInstrCategory));
 
+cl::opt<bool> InstrumentationNonAtomicCounters(
+    "instrumentation-nonatomic-counters",
+    cl::desc("increment counters without atomic instructions. This is much "
+             "cheaper in multi-threaded programs, but concurrent updates of "
+             "the same counter may be lost (default: false)"),
+    cl::init(false), cl::Optional, cl::cat(BoltInstrCategory));
+
 cl::opt<bool> InstrumentCalls("instrument-calls",
                               cl::desc("record profile for inter-function "
                                        "control flow activity (default: true)"),
@@ -196,7 +203,8 @@ Instrumentation::createInstrumentationSnippet(BinaryContext &BC, bool IsLeaf) {
   MCSymbol *Label = BC.Ctx->createNamedTempSymbol("InstrEntry");
   Summary->Counters.emplace_back(Label);
   return BC.MIB->createInstrIncMemory(Label, BC.Ctx.get(), IsLeaf,
-                                      BC.AsmInfo->getCodePointerSize());
+                                      BC.AsmInfo->getCodePointerSize(),
+                                      !opts::InstrumentationNonAtomicCounters);
 }
 
 // Helper instruction sequence insertion function
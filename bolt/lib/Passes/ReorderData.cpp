@@ -44,7 +44,8 @@ ReorderData("reorder-data",
 
 enum ReorderAlgo : char {
   REORDER_COUNT         = 0,
-  REORDER_FUNCS         = 1
+  REORDER_FUNCS         = 1,
+  REORDER_AFFINITY      = 2
 };
 
 static cl::opt<ReorderAlgo>
@@ -57,7 +58,10 @@ ReorderAlgorithm("reorder-data-algo",
       "sort hot data by read counts"),
     clEnumValN(REORDER_FUNCS,
       "funcs",
-      "sort hot data by hot function usage and count")),
+      "sort hot data by hot function usage and count"),
+    clEnumValN(REORDER_AFFINITY,
+      "affinity",
+      "group hot data accessed by the same functions, hottest first")),
   cl::ZeroOrMore,
   cl::cat(BoltOptCategory));
 
@@ -326,6 +330,87 @@ ReorderData::sortedByCount(BinaryContext &BC,
   return std::make_pair(Order, SplitPoint);
 }
 
+/// Place data objects that are sampled together next to each other. Functions
+/// are visited in order of the number of memory events they generate, and each
+/// one pulls in the not yet placed objects it accesses, most accessed first.
+/// Objects shared by several functions land next to their hottest user, so the
+/// working set of each hot function occupies as few cache lines and pages as
+/// possible.
+std::pair<DataOrder, unsigned>
+ReorderData::sortedByAffinity(BinaryContext &BC,
+                              const BinarySection &Section) const {
+  using AccessCounts = std::vector<std::pair<BinaryData *, uint64_t>>;
+  std::vector<std::pair<uint64_t, AccessCounts>> FuncAccesses;
+
+  for (auto &BFI : BC.getBinaryFunctions()) {
+    const BinaryFunction &BF = BFI.second;
+    if (!BF.hasMemoryProfile())
+      continue;
+
+    std::unordered_map<BinaryData *, uint64_t> Counts;
+    uint64_t FuncCount = 0;
+    for (const BinaryBasicBlock &BB : BF) {
+      for (const MCInst &Inst : BB) {
+        auto ErrorOrMemAccessProfile =
+            BC.MIB->tryGetAnnotationAs<MemoryAccessProfile>(
+                Inst, "MemoryAccessProfile");
+        if (!ErrorOrMemAccessProfile)
+          continue;
+
+        for (const AddressAccess &AccessInfo :
+             ErrorOrMemAccessProfile.get().AddressAccessInfo) {
+          BinaryData *BD = AccessInfo.MemoryObject;
+          if (!BD || &BD->getSection() != &Section)
+            continue;
+          Counts[BD->getAtomicRoot()] += AccessInfo.Count;
+          FuncCount += AccessInfo.Count;
+        }
+      }
+    }
+    if (!FuncCount)
+      continue;
+
+    AccessCounts Accesses(Counts.begin(), Counts.end());
+    llvm::sort(Accesses, [](const AccessCounts::value_type &A,
+                            const AccessCounts::value_type &B) {
+      return A.second > B.second ||
+             (A.second == B.second &&
+              A.first->getAddress() < B.first->getAddress());
+    });
+    FuncAccesses.emplace_back(FuncCount, std::move(Accesses));
+  }
+
+  llvm::stable_sort(FuncAccesses, [](const auto &A, const auto &B) {
+    return A.first > B.first;
+  });
+
+  // Rank every object by the position its hottest user assigns to it.
+  std::unordered_map<const BinaryData *, unsigned> Rank;
+  for (const auto &Entry : FuncAccesses)
+    for (const AccessCounts::value_type &Access : Entry.second)
+      Rank.emplace(Access.first, Rank.size());
+
+  DataOrder Order = baseOrder(BC, Section);
+  llvm::stable_sort(Order, [&](const DataOrder::value_type &A,
+                               const DataOrder::value_type &B) {
+    auto AI = Rank.find(A.first);
+    auto BI = Rank.find(B.first);
+    if (AI == Rank.end() || BI == Rank.end())
+      return AI != Rank.end() && BI == Rank.end();
+    return AI->second < BI->second;
+  });
+
+  unsigned SplitPoint = Order.size();
+  for (unsigned Idx = 0; Idx < Order.size(); ++Idx) {
+    if (!Rank.count(Order[Idx].first)) {
+      SplitPoint = Idx;
+      break;
+    }
+  }
+
+  return std::make_pair(Order, SplitPoint);
+}
+
 // TODO
 // add option for cache-line alignment (or just use cache-line when section
 // is writeable)?
@@ -485,6 +570,9 @@ void ReorderData::runOnFunctions(BinaryContext &BC) {
     if (opts::ReorderAlgorithm == opts::ReorderAlgo::REORDER_COUNT) {
       outs() << "BOLT-INFO: reorder-sections: ordering data by count\n";
       std::tie(Order, SplitPointIdx) = sortedByCount(BC, *Section);
+    } else if (opts::ReorderAlgorithm == opts::ReorderAlgo::REORDER_AFFINITY) {
+      outs() << "BOLT-INFO: reorder-sections: ordering data by affinity\n";
+      std::tie(Order, SplitPointIdx) = sortedByAffinity(BC, *Section);
     } else {
       outs() << "BOLT-INFO: reorder-sections: ordering data by funcs\n";
       std::tie(Order, SplitPointIdx) =
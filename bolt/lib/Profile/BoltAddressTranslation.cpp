@@ -163,20 +163,21 @@ std::error_code BoltAddressTranslation::parse(StringRef Buf) {
 
     const uint64_t Address = DE.getU64(&Offset);
     const uint32_t NumEntries = DE.getU32(&Offset);
-    MapTy Map;
 
     LLVM_DEBUG(dbgs() << "Parsing " << NumEntries << " entries for 0x"
                       << Twine::utohexstr(Address) << "\n");
     if (Buf.size() - Offset < 8 * NumEntries)
       return make_error_code(llvm::errc::io_error);
+    MapTy &Map = Maps[Address];
     for (uint32_t J = 0; J < NumEntries; ++J) {
       const uint32_t OutputAddr = DE.getU32(&Offset);
       const uint32_t InputAddr = DE.getU32(&Offset);
-      Map.insert(std::pair<uint32_t, uint32_t>(OutputAddr, InputAddr));
+      // Entries are written in increasing output address order, so appending
+      // at the end keeps the insertion constant time.
+      Map.emplace_hint(Map.end(), OutputAddr, InputAddr);
       LLVM_DEBUG(dbgs() << Twine::utohexstr(OutputAddr) << " -> "
                         << Twine::utohexstr(InputAddr) << "\n");
     }
-    Maps.insert(std::pair<uint64_t, MapTy>(Address, Map));
   }
 
   if (Buf.size() - Offset < 4)
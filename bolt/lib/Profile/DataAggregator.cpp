@@ -1379,12 +1379,15 @@ uint64_t DataAggregator::parseLBRSample(const PerfBranchSample &Sample,
     // chronological order)
     if (NeedsSkylakeFix && NumEntry <= 2)
       continue;
+    // Function lookups are the bulk of the aggregation time, so do them only
+    // once per branch end. The fall-through trace starts at the branch target.
+    const BinaryFunction *FromBF = getBinaryFunctionContainingAddress(LBR.From);
+    const BinaryFunction *ToBF = getBinaryFunctionContainingAddress(LBR.To);
     if (NextPC) {
       // Record fall-through trace.
       const uint64_t TraceFrom = LBR.To;
       const uint64_t TraceTo = NextPC;
-      const BinaryFunction *TraceBF =
-          getBinaryFunctionContainingAddress(TraceFrom);
+      const BinaryFunction *TraceBF = ToBF;
       if (TraceBF && TraceBF->containsAddress(TraceTo)) {
         FTInfo &Info = FallthroughLBRs[Trace(TraceFrom, TraceTo)];
         if (TraceBF->containsAddress(LBR.From))
@@ -1419,8 +1422,8 @@ uint64_t DataAggregator::parseLBRSample(const PerfBranchSample &Sample,
     }
     NextPC = LBR.From;
 
-    uint64_t From = getBinaryFunctionContainingAddress(LBR.From) ? LBR.From : 0;
-    uint64_t To = getBinaryFunctionContainingAddress(LBR.To) ? LBR.To : 0;
+    uint64_t From = FromBF ? LBR.From : 0;
+    uint64_t To = ToBF ? LBR.To : 0;
     if (!From && !To)
       continue;
     BranchInfo &Info = BranchLBRs[Trace(From, To)];
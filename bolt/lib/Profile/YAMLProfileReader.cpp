@@ -9,6 +9,7 @@
 #include "bolt/Profile/YAMLProfileReader.h"
 #include "bolt/Core/BinaryBasicBlock.h"
 #include "bolt/Core/BinaryFunction.h"
+#include "bolt/Core/ParallelUtilities.h"
 #include "bolt/Passes/MCF.h"
 #include "bolt/Profile/ProfileYAMLMapping.h"
 #include "bolt/Utils/Utils.h"
@@ -31,6 +32,11 @@ static llvm::cl::opt<bool>
 llvm::cl::opt<bool> ProfileUseDFS("profile-use-dfs",
                                   cl::desc("use DFS order for YAML profile"),
                                   cl::Hidden, cl::cat(BoltOptCategory));
+
+static llvm::cl::opt<bool> MatchProfileWithFunctionHash(
+    "match-profile-with-function-hash",
+    cl::desc("match profiles of renamed or moved functions by function hash"),
+    cl::Hidden, cl::cat(BoltOptCategory));
 }
 
 namespace llvm {
@@ -386,6 +392,9 @@ Error YAMLProfileReader::readProfile(BinaryContext &BC) {
     if (!YamlBF.Used && BF && !ProfiledFunctions.count(BF))
       matchProfileToFunction(YamlBF, *BF);
 
+  if (opts::MatchProfileWithFunctionHash && !opts::IgnoreHash)
+    matchProfilesByHash(BC);
+
   for (yaml::bolt::BinaryFunctionProfile &YamlBF : YamlBP.Functions)
     if (!YamlBF.Used && opts::Verbosity >= 1)
       errs() << "BOLT-WARNING: profile ignored for function " << YamlBF.Name
@@ -413,6 +422,53 @@ Error YAMLProfileReader::readProfile(BinaryContext &BC) {
   return Error::success();
 }
 
+void YAMLProfileReader::matchProfilesByHash(BinaryContext &BC) {
+  if (llvm::all_of(YamlBP.Functions,
+                   [](const yaml::bolt::BinaryFunctionProfile &YamlBF) {
+                     return YamlBF.Used;
+                   }))
+    return;
+
+  // Hashing is linear in the function size and has to be done for every
+  // function without a profile, so spread it over the thread pool.
+  ParallelUtilities::WorkFuncTy WorkFun = [&](BinaryFunction &BF) {
+    BF.computeHash(YamlBP.Header.IsDFSOrder);
+  };
+  ParallelUtilities::PredicateTy SkipFunc = [&](const BinaryFunction &BF) {
+    return !BF.hasCFG() || BF.empty() || ProfiledFunctions.count(&BF);
+  };
+  ParallelUtilities::runOnEachFunction(
+      BC, ParallelUtilities::SchedulingPolicy::SP_INST_LINEAR, WorkFun,
+      SkipFunc, "matchProfilesByHash");
+
+  // Index the remaining functions by hash. Functions with identical contents
+  // are interchangeable for profile purposes, so the first one wins and the
+  // next profile with the same hash goes to the next function.
+  std::unordered_map<size_t, std::vector<BinaryFunction *>> HashToFunctions;
+  for (auto &[Address, BF] : BC.getBinaryFunctions())
+    if (!SkipFunc(BF))
+      HashToFunctions[BF.getHash()].push_back(&BF);
+  for (auto &[Hash, Functions] : HashToFunctions)
+    std::reverse(Functions.begin(), Functions.end());
+
+  uint64_t NumMatched = 0;
+  for (yaml::bolt::BinaryFunctionProfile &YamlBF : YamlBP.Functions) {
+    if (YamlBF.Used)
+      continue;
+    auto It = HashToFunctions.find(YamlBF.Hash);
+    if (It == HashToFunctions.end() || It->second.empty())
+      continue;
+    BinaryFunction *BF = It->second.back();
+    It->second.pop_back();
+    matchProfileToFunction(YamlBF, *BF);
+    ++NumMatched;
+  }
+
+  if (NumMatched)
+    outs() << "BOLT-INFO: matched " << NumMatched
+           << " profiles to functions by hash\n";
+}
+
 bool YAMLProfileReader::usesEvent(StringRef Name) const {
   return YamlBP.Header.EventNames.find(std::string(Name)) != StringRef::npos;
 }
@@ -79,6 +79,7 @@ namespace opts {
 extern cl::opt<MacroFusionType> AlignMacroOpFusion;
 extern cl::list<std::string> HotTextMoveSections;
 extern cl::opt<bool> Hugify;
+extern cl::opt<bool> HugifyAlignedLoad;
 extern cl::opt<bool> Instrument;
 extern cl::opt<JumpTableSupportLevel> JumpTables;
 extern cl::list<std::string> ReorderData;
@@ -387,6 +388,14 @@ Error RewriteInstance::setProfile(StringRef Filename) {
   return Error::success();
 }
 
+/// Return true if hot text has to be padded with an extra huge page on each
+/// side for -hugify. A PIE binary may be loaded at an address that is only
+/// 4KB aligned, and the runtime must then round the hot text out to huge page
+/// boundaries without touching neighbouring mappings.
+static bool needsHugifyPadding(const BinaryContext &BC) {
+  return opts::Hugify && !BC.HasFixedLoadAddress && !opts::HugifyAlignedLoad;
+}
+
 /// Return true if the function \p BF should be disassembled.
 static bool shouldDisassemble(const BinaryFunction &BF) {
   if (BF.isPseudo())
@@ -555,7 +564,7 @@ Error RewriteInstance::discoverStorage() {
 
   // Hugify: Additional huge page from left side due to
   // weird ASLR mapping addresses (4KB aligned)
-  if (opts::Hugify && !BC->HasFixedLoadAddress)
+  if (needsHugifyPadding(*BC))
     NextAvailableAddress += BC->PageAlign;
 
   if (!opts::UseGnuStack) {
@@ -3240,6 +3249,13 @@ void RewriteInstance::emitAndLink() {
   Linker->loadObject(ObjectMemBuffer->getMemBufferRef(),
                      [this](auto MapSection) { mapFileSections(MapSection); });
 
+  // The object is linked into sections allocated by the memory manager, and
+  // the symbol table keeps its own copy of the names. The in-memory object is
+  // as large as all the emitted code, so free it before the runtime library is
+  // linked on top of it.
+  ObjectMemBuffer.reset();
+  ObjectBuffer = SmallString<0>();
+
   // Update output addresses based on the new section map and
   // layout. Only do this for the object created by ourselves.
   updateOutputValues(*Linker);
@@ -3404,7 +3420,7 @@ void RewriteInstance::mapCodeSections(BOLTLinker::SectionMapper MapSection) {
 
         // Hugify: Additional huge page from right side due to
         // weird ASLR mapping addresses (4KB aligned)
-        if (opts::Hugify && !BC->HasFixedLoadAddress &&
+        if (needsHugifyPadding(*BC) &&
             Section->getName() == BC->getMainCodeSectionName())
           Address = alignTo(Address, Section->getAlignment());
       }
@@ -33,6 +33,13 @@ cl::opt<bool>
                     "(which is what --hot-text relies on)."),
            cl::cat(BoltOptCategory));
 
+cl::opt<bool> HugifyAlignedLoad(
+    "hugify-aligned-load",
+    cl::desc("assume the loader honors the 2MB alignment of the hot text "
+             "segment of a PIE binary (e.g. Linux 5.10 and later) and do not "
+             "pad hot text with extra huge pages for -hugify"),
+    cl::Hidden, cl::cat(BoltOptCategory));
+
 static cl::opt<std::string> RuntimeHugifyLib(
     "runtime-hugify-lib",
     cl::desc("specify file name of the runtime hugify library"),
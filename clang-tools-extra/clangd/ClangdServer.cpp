@@ -432,6 +432,12 @@ void ClangdServer::codeComplete(PathRef File, Position Pos,
       {
         std::lock_guard<std::mutex> Lock(CachedCompletionFuzzyFindRequestMutex);
         SpecFuzzyFind->CachedReq = CachedCompletionFuzzyFindRequestByFile[File];
+        // Index contents change over time, so complete results are only
+        // reused over a short burst of typing.
+        auto &CachedResult = CachedCompletionIndexResultByFile[File];
+        if (std::chrono::steady_clock::now() - CachedResult.second <
+            std::chrono::seconds(5))
+          SpecFuzzyFind->CachedResult = CachedResult.first;
       }
     }
     ParseInputs ParseInput{IP->Command, &getHeaderFS(), IP->Contents.str()};
@@ -455,6 +461,11 @@ void ClangdServer::codeComplete(PathRef File, Position Pos,
     if (SpecFuzzyFind && SpecFuzzyFind->NewReq) {
       std::lock_guard<std::mutex> Lock(CachedCompletionFuzzyFindRequestMutex);
       CachedCompletionFuzzyFindRequestByFile[File] = *SpecFuzzyFind->NewReq;
+      auto &CachedResult = CachedCompletionIndexResultByFile[File];
+      // Reused results keep the time they were fetched at.
+      if (SpecFuzzyFind->NewResult != CachedResult.first)
+        CachedResult = {SpecFuzzyFind->NewResult,
+                        std::chrono::steady_clock::now()};
     }
     // SpecFuzzyFind is only destroyed after speculative fuzzy find finishes.
     // We don't want `codeComplete` to wait for the async call if it doesn't use
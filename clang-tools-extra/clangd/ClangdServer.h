@@ -33,6 +33,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/FunctionExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -489,6 +490,12 @@ private:
   // GUARDED_BY(CachedCompletionFuzzyFindRequestMutex)
   llvm::StringMap<std::optional<FuzzyFindRequest>>
       CachedCompletionFuzzyFindRequestByFile;
+  // Complete index results for the cached request above, and when the index
+  // produced them. See SpeculativeFuzzyFind::CachedResult.
+  // GUARDED_BY(CachedCompletionFuzzyFindRequestMutex)
+  llvm::StringMap<std::pair<std::shared_ptr<const SymbolSlab>,
+                            std::chrono::steady_clock::time_point>>
+      CachedCompletionIndexResultByFile;
   mutable std::mutex CachedCompletionFuzzyFindRequestMutex;
 
   std::optional<std::string> WorkspaceRoot;
@@ -1491,6 +1491,25 @@ FuzzyFindRequest speculativeFuzzyFindRequestForCompletion(
   return CachedReq;
 }
 
+// Returns true if every index result for \p Req is also a result for
+// \p CachedReq, so that the complete results of \p CachedReq can be filtered
+// instead of running \p Req. This is the case while the user keeps typing
+// the same identifier: a symbol matching the longer query also fuzzy-matches
+// its prefix.
+// Queries shorter than a trigram are the exception. Dex only matches them
+// against the first segments of an identifier, so their results may lack
+// symbols that a longer query matches in a later segment.
+bool canRefineCachedResult(const FuzzyFindRequest &CachedReq,
+                           const FuzzyFindRequest &Req) {
+  if (CachedReq.Query.size() < 3)
+    return false;
+  if (!llvm::StringRef(Req.Query).starts_with_insensitive(CachedReq.Query))
+    return false;
+  FuzzyFindRequest SameQuery = CachedReq;
+  SameQuery.Query = Req.Query;
+  return SameQuery == Req;
+}
+
 // Runs Sema-based (AST) and Index-based completion, returns merged results.
 //
 // There are a few tricky considerations:
@@ -1575,7 +1594,10 @@ public:
       assert(!SpecFuzzyFind->Result.valid());
       SpecReq = speculativeFuzzyFindRequestForCompletion(
           *SpecFuzzyFind->CachedReq, HeuristicPrefix);
-      SpecFuzzyFind->Result = startAsyncFuzzyFind(*Opts.Index, *SpecReq);
+      // No need to speculate if the cached results will likely answer it.
+      if (!SpecFuzzyFind->CachedResult ||
+          !canRefineCachedResult(*SpecFuzzyFind->CachedReq, *SpecReq))
+        SpecFuzzyFind->Result = startAsyncFuzzyFind(*Opts.Index, *SpecReq);
     }
 
     // We run Sema code completion first. It builds an AST and calculates:
@@ -1830,6 +1852,21 @@ private:
 
     if (SpecFuzzyFind)
       SpecFuzzyFind->NewReq = Req;
+    if (SpecFuzzyFind && SpecFuzzyFind->CachedResult &&
+        canRefineCachedResult(*SpecFuzzyFind->CachedReq, Req)) {
+      vlog("Code complete: filtering {0} complete index results of a previous "
+           "request.",
+           SpecFuzzyFind->CachedResult->size());
+      SPAN_ATTACH(Tracer, "Cached results", true);
+      SymbolSlab::Builder ResultsBuilder;
+      for (const Symbol &Sym : *SpecFuzzyFind->CachedResult)
+        if (Filter->match(Sym.Name))
+          ResultsBuilder.insert(Sym);
+      // The cached results remain a superset of the results for Req.
+      SpecFuzzyFind->NewResult = SpecFuzzyFind->CachedResult;
+      return std::move(ResultsBuilder).build();
+    }
+    SPAN_ATTACH(Tracer, "Cached results", false);
     if (SpecFuzzyFind && SpecFuzzyFind->Result.valid() && (*SpecReq == Req)) {
       vlog("Code complete: speculative fuzzy request matches the actual index "
            "request. Waiting for the speculative index results.");
@@ -1838,6 +1875,8 @@ private:
       trace::Span WaitSpec("Wait speculative results");
       auto SpecRes = SpecFuzzyFind->Result.get();
       Incomplete |= SpecRes.first;
+      if (!SpecRes.first)
+        rememberCompleteResult(SpecRes.second);
       return std::move(SpecRes.second);
     }
 
@@ -1845,9 +1884,26 @@ private:
 
     // Run the query against the index.
     SymbolSlab::Builder ResultsBuilder;
-    Incomplete |= Opts.Index->fuzzyFind(
+    bool IndexIncomplete = Opts.Index->fuzzyFind(
         Req, [&](const Symbol &Sym) { ResultsBuilder.insert(Sym); });
-    return std::move(ResultsBuilder).build();
+    Incomplete |= IndexIncomplete;
+    SymbolSlab Results = std::move(ResultsBuilder).build();
+    if (!IndexIncomplete)
+      rememberCompleteResult(Results);
+    return Results;
+  }
+
+  // Keeps a copy of complete index results for later completion requests
+  // that refine the same query. With a limit set there are at most Limit
+  // symbols, so copying them is cheap.
+  void rememberCompleteResult(const SymbolSlab &Results) {
+    if (!SpecFuzzyFind || !Opts.Limit)
+      return;
+    SymbolSlab::Builder Copy;
+    for (const Symbol &Sym : Results)
+      Copy.insert(Sym);
+    SpecFuzzyFind->NewResult =
+        std::make_shared<SymbolSlab>(std::move(Copy).build());
   }
 
   // Merges Sema and Index results where possible, to form CompletionCandidates.
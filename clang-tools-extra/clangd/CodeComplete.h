@@ -30,6 +30,7 @@
 #include "llvm/ADT/StringRef.h"
 #include <functional>
 #include <future>
+#include <memory>
 #include <optional>
 #include <utility>
 
@@ -270,6 +271,16 @@ struct SpeculativeFuzzyFind {
   /// The result is consumed by `codeComplete()` if speculation succeeded.
   /// NOTE: the destructor will wait for the async call to finish.
   std::future<std::pair<bool /*Incomplete*/, SymbolSlab>> Result;
+  /// Every symbol the index returns for CachedReq (and possibly more), if the
+  /// index reported the results as complete. Completion requests that only
+  /// extend the query of CachedReq are then answered by filtering these, as
+  /// the user types, without querying the index again.
+  /// Set by caller of `codeComplete()`.
+  std::shared_ptr<const SymbolSlab> CachedResult;
+  /// A superset of the index results for NewReq, if they are known to be
+  /// complete. Set by `codeComplete()`. This can be used by callers to update
+  /// cache.
+  std::shared_ptr<const SymbolSlab> NewResult;
 };
 
 /// Gets code completions at a specified \p Pos in \p FileName.
@@ -79,6 +79,10 @@ struct Config {
     /// Absolute path to source root this index is associated with, uses
     /// forward-slashes.
     std::string MountPoint;
+    /// Addresses of further clangd-index-servers serving the other parts of a
+    /// sharded remote index. Only used for Server, whose Location is the first
+    /// shard.
+    std::vector<std::string> Shards;
   };
   /// Controls index behavior.
   struct {
@@ -170,12 +174,14 @@ template <> struct DenseMapInfo<clang::clangd::Config::ExternalIndexSpec> {
     return {ExternalIndexSpec::File, "TOMB", "STONE"};
   }
   static unsigned getHashValue(const ExternalIndexSpec &Val) {
-    return llvm::hash_combine(Val.Kind, Val.Location, Val.MountPoint);
+    return llvm::hash_combine(
+        Val.Kind, Val.Location, Val.MountPoint,
+        llvm::hash_combine_range(Val.Shards.begin(), Val.Shards.end()));
   }
   static bool isEqual(const ExternalIndexSpec &LHS,
                       const ExternalIndexSpec &RHS) {
-    return std::tie(LHS.Kind, LHS.Location, LHS.MountPoint) ==
-           std::tie(RHS.Kind, RHS.Location, RHS.MountPoint);
+    return std::tie(LHS.Kind, LHS.Location, LHS.MountPoint, LHS.Shards) ==
+           std::tie(RHS.Kind, RHS.Location, RHS.MountPoint, RHS.Shards);
   }
 };
 } // namespace llvm
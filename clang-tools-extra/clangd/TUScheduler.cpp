@@ -65,8 +65,11 @@
 #include "support/Trace.h"
 #include "clang/Basic/Stack.h"
 #include "clang/Frontend/CompilerInvocation.h"
+#include "clang/Lex/Lexer.h"
 #include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/FunctionExtras.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SmallVector.h"
@@ -115,6 +118,12 @@ constexpr trace::Metric PreambleBuildSize("preamble_build_size",
                                           trace::Metric::Distribution);
 constexpr trace::Metric PreambleSerializedSize("preamble_serialized_size",
                                                trace::Metric::Distribution);
+// Classifies preamble rebuilds: "includes_appended" when the new preamble
+// only adds includes after the ones of the previous preamble (and the compile
+// command is unchanged), and "other" otherwise. The former could reuse the old
+// PCH as a prefix if preambles were ever built incrementally.
+constexpr trace::Metric PreambleRebuildKind("preamble_rebuild_kind",
+                                            trace::Metric::Counter, "kind");
 
 void reportPreambleBuild(const PreambleBuildStats &Stats,
                          bool IsFirstPreamble) {
@@ -133,6 +142,59 @@ void reportPreambleBuild(const PreambleBuildStats &Stats,
   PreambleSerializedSize.record(Stats.SerializedSize);
 }
 
+void reportPreambleRebuildKind(const PreambleData &Old,
+                               const PreambleData &New) {
+  const auto &OldIncludes = Old.Includes.MainFileIncludes;
+  const auto &NewIncludes = New.Includes.MainFileIncludes;
+  bool Appended =
+      OldIncludes.size() < NewIncludes.size() &&
+      Old.CompileCommand.CommandLine == New.CompileCommand.CommandLine &&
+      std::equal(OldIncludes.begin(), OldIncludes.end(), NewIncludes.begin(),
+                 [](const Inclusion &L, const Inclusion &R) {
+                   return L.Written == R.Written && L.HashLine == R.HashLine;
+                 });
+  PreambleRebuildKind.record(1, Appended ? "includes_appended" : "other");
+}
+
+// Tracks which fraction of the top-level declarations of a stale AST lie
+// entirely outside the region changed by an edit, i.e. how much of the AST an
+// incremental reparse of the main file could keep.
+constexpr trace::Metric ASTReusableDecls("ast_reusable_decls",
+                                         trace::Metric::Distribution);
+
+void reportReusableDecls(ParsedAST &Old, llvm::StringRef NewContents) {
+  const SourceManager &SM = Old.getSourceManager();
+  llvm::StringRef OldContents = SM.getBufferData(SM.getMainFileID());
+  // The edited region is everything between the common prefix and the common
+  // suffix of the two versions.
+  size_t Prefix = 0;
+  size_t MaxPrefix = std::min(OldContents.size(), NewContents.size());
+  while (Prefix < MaxPrefix && OldContents[Prefix] == NewContents[Prefix])
+    ++Prefix;
+  size_t Suffix = 0;
+  size_t MaxSuffix = MaxPrefix - Prefix;
+  while (Suffix < MaxSuffix &&
+         OldContents.end()[-1 - Suffix] == NewContents.end()[-1 - Suffix])
+    ++Suffix;
+  size_t ChangedEnd = OldContents.size() - Suffix;
+
+  llvm::ArrayRef<Decl *> Decls = Old.getLocalTopLevelDecls();
+  if (Decls.empty())
+    return;
+  unsigned Reusable = 0;
+  for (const Decl *D : Decls) {
+    SourceLocation Begin = SM.getFileLoc(D->getBeginLoc());
+    SourceLocation End = Lexer::getLocForEndOfToken(
+        SM.getFileLoc(D->getEndLoc()), 0, SM, Old.getLangOpts());
+    if (!SM.isWrittenInMainFile(Begin) || !SM.isWrittenInMainFile(End))
+      continue;
+    if (SM.getFileOffset(End) <= Prefix ||
+        SM.getFileOffset(Begin) >= ChangedEnd)
+      ++Reusable;
+  }
+  ASTReusableDecls.record(double(Reusable) / Decls.size());
+}
+
 class ASTWorker;
 } // namespace
 
@@ -343,6 +405,50 @@ public:
   }
 };
 
+/// Records, through the "preamble_shareable" metric, whether another file was
+/// recently built with the same compile flags, directory and preamble region,
+/// i.e. whether the two could have shared one built preamble. This measures how
+/// much a cross-file preamble cache would save before committing to one.
+///
+/// All methods are threadsafe, record() is called from preamble threads.
+class TUScheduler::PreambleShareability {
+  // Quoted includes are resolved relative to the file, so its directory is
+  // part of the key, but its name is not. Neither are the flags that only name
+  // this TU's outputs.
+  ArgStripper OutputFlags;
+  std::mutex Mu;
+  llvm::DenseMap<uint64_t, std::string> FirstFileForKey; // GUARDED_BY(Mu)
+  // Keep the table bounded, it only needs to cover recently built preambles.
+  static constexpr unsigned MaxKeys = 4096;
+
+public:
+  PreambleShareability() {
+    for (llvm::StringRef Flag : {"-o", "-MF", "-MT", "-MQ"})
+      OutputFlags.strip(Flag);
+  }
+
+  void record(PathRef FileName, const tooling::CompileCommand &Cmd,
+              llvm::StringRef PreambleRegion) {
+    static constexpr trace::Metric PreambleShareable(
+        "preamble_shareable", trace::Metric::Counter, "result");
+    std::vector<std::string> Args = Cmd.CommandLine;
+    OutputFlags.process(Args);
+    llvm::hash_code Key = llvm::hash_combine(
+        Cmd.Directory, llvm::sys::path::parent_path(FileName), PreambleRegion);
+    for (const std::string &Arg : Args)
+      if (Arg != Cmd.Filename && Arg != FileName)
+        Key = llvm::hash_combine(Key, Arg);
+
+    std::lock_guard<std::mutex> Lock(Mu);
+    if (FirstFileForKey.size() >= MaxKeys)
+      FirstFileForKey.clear();
+    auto It = FirstFileForKey.try_emplace(static_cast<size_t>(Key),
+                                          FileName.str())
+                  .first;
+    PreambleShareable.record(1, It->second == FileName ? "unique" : "shared");
+  }
+};
+
 namespace {
 
 bool isReliable(const tooling::CompileCommand &Cmd) {
@@ -428,11 +534,12 @@ public:
                  bool StorePreambleInMemory, bool RunSync,
                  PreambleThrottler *Throttler, SynchronizedTUStatus &Status,
                  TUScheduler::HeaderIncluderCache &HeaderIncluders,
+                 TUScheduler::PreambleShareability &Shareability,
                  ASTWorker &AW)
       : FileName(FileName), Callbacks(Callbacks),
         StoreInMemory(StorePreambleInMemory), RunSync(RunSync),
         Throttler(Throttler), Status(Status), ASTPeer(AW),
-        HeaderIncluders(HeaderIncluders) {}
+        HeaderIncluders(HeaderIncluders), Shareability(Shareability) {}
 
   /// It isn't guaranteed that each requested version will be built. If there
   /// are multiple update requests while building a preamble, only the last one
@@ -586,6 +693,7 @@ private:
   SynchronizedTUStatus &Status;
   ASTWorker &ASTPeer;
   TUScheduler::HeaderIncluderCache &HeaderIncluders;
+  TUScheduler::PreambleShareability &Shareability;
 };
 
 class ASTWorkerHandle;
@@ -605,6 +713,7 @@ class ASTWorker {
   ASTWorker(PathRef FileName, const GlobalCompilationDatabase &CDB,
             TUScheduler::ASTCache &LRUCache,
             TUScheduler::HeaderIncluderCache &HeaderIncluders,
+            TUScheduler::PreambleShareability &Shareability,
             Semaphore &Barrier, bool RunSync, const TUScheduler::Options &Opts,
             ParsingCallbacks &Callbacks);
 
@@ -618,6 +727,7 @@ public:
   create(PathRef FileName, const GlobalCompilationDatabase &CDB,
          TUScheduler::ASTCache &IdleASTs,
          TUScheduler::HeaderIncluderCache &HeaderIncluders,
+         TUScheduler::PreambleShareability &Shareability,
          AsyncTaskRunner *Tasks, Semaphore &Barrier,
          const TUScheduler::Options &Opts, ParsingCallbacks &Callbacks);
   ~ASTWorker();
@@ -811,12 +921,13 @@ ASTWorkerHandle
 ASTWorker::create(PathRef FileName, const GlobalCompilationDatabase &CDB,
                   TUScheduler::ASTCache &IdleASTs,
                   TUScheduler::HeaderIncluderCache &HeaderIncluders,
+                  TUScheduler::PreambleShareability &Shareability,
                   AsyncTaskRunner *Tasks, Semaphore &Barrier,
                   const TUScheduler::Options &Opts,
                   ParsingCallbacks &Callbacks) {
-  std::shared_ptr<ASTWorker> Worker(
-      new ASTWorker(FileName, CDB, IdleASTs, HeaderIncluders, Barrier,
-                    /*RunSync=*/!Tasks, Opts, Callbacks));
+  std::shared_ptr<ASTWorker> Worker(new ASTWorker(
+      FileName, CDB, IdleASTs, HeaderIncluders, Shareability, Barrier,
+      /*RunSync=*/!Tasks, Opts, Callbacks));
   if (Tasks) {
     Tasks->runAsync("ASTWorker:" + llvm::sys::path::filename(FileName),
                     [Worker]() { Worker->run(); });
@@ -830,6 +941,7 @@ ASTWorker::create(PathRef FileName, const GlobalCompilationDatabase &CDB,
 ASTWorker::ASTWorker(PathRef FileName, const GlobalCompilationDatabase &CDB,
                      TUScheduler::ASTCache &LRUCache,
                      TUScheduler::HeaderIncluderCache &HeaderIncluders,
+                     TUScheduler::PreambleShareability &Shareability,
                      Semaphore &Barrier, bool RunSync,
                      const TUScheduler::Options &Opts,
                      ParsingCallbacks &Callbacks)
@@ -838,7 +950,8 @@ ASTWorker::ASTWorker(PathRef FileName, const GlobalCompilationDatabase &CDB,
       ContextProvider(Opts.ContextProvider), CDB(CDB), Callbacks(Callbacks),
       Barrier(Barrier), Done(false), Status(FileName, Callbacks),
       PreamblePeer(FileName, Callbacks, Opts.StorePreamblesInMemory, RunSync,
-                   Opts.PreambleThrottler, Status, HeaderIncluders, *this) {
+                   Opts.PreambleThrottler, Status, HeaderIncluders,
+                   Shareability, *this) {
   // Set a fallback command because compile command can be accessed before
   // `Inputs` is initialized. Other fields are only used after initialization
   // from client inputs.
@@ -1082,6 +1195,7 @@ void PreambleThread::build(Request Req) {
 
   PreambleBuildStats Stats;
   bool IsFirstPreamble = !LatestBuild;
+  std::shared_ptr<const PreambleData> PreviousBuild = LatestBuild;
   LatestBuild = clang::clangd::buildPreamble(
       FileName, *Req.CI, Inputs, StoreInMemory,
       [&](CapturedASTCtx ASTCtx,
@@ -1093,6 +1207,11 @@ void PreambleThread::build(Request Req) {
   if (!LatestBuild)
     return;
   reportPreambleBuild(Stats, IsFirstPreamble);
+  Shareability.record(
+      FileName, LatestBuild->CompileCommand,
+      Inputs.Contents.substr(0, LatestBuild->Preamble.getBounds().Size));
+  if (PreviousBuild)
+    reportPreambleRebuildKind(*PreviousBuild, *LatestBuild);
   if (isReliable(LatestBuild->CompileCommand))
     HeaderIncluders.update(FileName, LatestBuild->Includes.allHeaders());
 }
@@ -1206,6 +1325,11 @@ void ASTWorker::generateDiagnostics(
   std::optional<std::unique_ptr<ParsedAST>> AST =
       IdleASTs.take(this, &ASTAccessForDiag);
   if (!AST || !InputsAreLatest) {
+    // Only an AST built on the same preamble could have been updated in place.
+    if (AST && *AST && *LatestPreamble &&
+        (*AST)->preambleVersion() ==
+            llvm::StringRef((*LatestPreamble)->Version))
+      reportReusableDecls(**AST, Inputs.Contents);
     auto RebuildStartTime = DebouncePolicy::clock::now();
     std::optional<ParsedAST> NewAST = ParsedAST::build(
         FileName, Inputs, std::move(Invocation), CIDiags, *LatestPreamble);
@@ -1633,7 +1757,8 @@ TUScheduler::TUScheduler(const GlobalCompilationDatabase &CDB,
       Barrier(Opts.AsyncThreadsCount), QuickRunBarrier(Opts.AsyncThreadsCount),
       IdleASTs(
           std::make_unique<ASTCache>(Opts.RetentionPolicy.MaxRetainedASTs)),
-      HeaderIncluders(std::make_unique<HeaderIncluderCache>()) {
+      HeaderIncluders(std::make_unique<HeaderIncluderCache>()),
+      Shareability(std::make_unique<PreambleShareability>()) {
   // Avoid null checks everywhere.
   if (!Opts.ContextProvider) {
     this->Opts.ContextProvider = [](llvm::StringRef) {
@@ -1675,7 +1800,7 @@ bool TUScheduler::update(PathRef File, ParseInputs Inputs,
   if (!FD) {
     // Create a new worker to process the AST-related tasks.
     ASTWorkerHandle Worker = ASTWorker::create(
-        File, CDB, *IdleASTs, *HeaderIncluders,
+        File, CDB, *IdleASTs, *HeaderIncluders, *Shareability,
         WorkerThreads ? &*WorkerThreads : nullptr, Barrier, Opts, *Callbacks);
     FD = std::unique_ptr<FileData>(
         new FileData{Inputs.Contents, std::move(Worker)});
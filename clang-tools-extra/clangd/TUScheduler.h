@@ -345,6 +345,9 @@ public:
   class ASTCache;
   /// Tracks headers included by open files, to get known-good compile commands.
   class HeaderIncluderCache;
+  /// Tracks recently built preambles, to measure how often they could be
+  /// shared between files.
+  class PreambleShareability;
 
   // The file being built/processed in the current thread. This is a hack in
   // order to get the file name into the index implementations. Do not depend on
@@ -368,6 +371,7 @@ private:
   llvm::StringMap<std::unique_ptr<FileData>> Files;
   std::unique_ptr<ASTCache> IdleASTs;
   std::unique_ptr<HeaderIncluderCache> HeaderIncluders;
+  std::unique_ptr<PreambleShareability> Shareability;
   // std::nullopt when running tasks synchronously and non-std::nullopt when
   // running tasks asynchronously.
   std::optional<AsyncTaskRunner> PreambleTasks;
@@ -76,6 +76,7 @@ public:
     llvm::ThreadPriority ThreadPri = llvm::ThreadPriority::Low;
     unsigned QueuePri = 0; // Higher-priority tasks will run first.
     std::string Tag;       // Allows priority to be boosted later.
+    std::string GroupTag;  // Like Tag, but shared by a group of related tasks.
     uint64_t Key = 0;      // If the key matches a previous task, drop this one.
                            // (in practice this means we never reindex a file).
 
@@ -96,8 +97,8 @@ public:
   // Add tasks to the queue.
   void push(Task);
   void append(std::vector<Task>);
-  // Boost priority of current and new tasks with matching Tag, if they are
-  // lower priority.
+  // Boost priority of current and new tasks with matching Tag or GroupTag, if
+  // they are lower priority.
   // Reducing the boost of a tag affects future tasks but not current ones.
   void boost(llvm::StringRef Tag, unsigned NewPriority);
 
@@ -162,7 +163,9 @@ public:
   }
 
   /// Boosts priority of indexing related to Path.
-  /// Typically used to index TUs when headers are opened.
+  /// Typically used to index TUs when headers are opened. Files in the same
+  /// directory as Path get a smaller boost, as they are likely to be opened or
+  /// navigated to next.
   void boostRelated(llvm::StringRef Path);
 
   // Cause background threads to stop after ther current task, any remaining
@@ -218,6 +221,7 @@ private:
   // from lowest to highest priority
   enum QueuePriority {
     IndexFile,
+    IndexNearbyFile,
     IndexBoostedFile,
     LoadShards,
   };
@@ -83,6 +83,8 @@ bool BackgroundQueue::adjust(Task &T) {
   if (T.Key && !SeenKeys.insert(T.Key).second)
     return false;
   T.QueuePri = std::max(T.QueuePri, Boosts.lookup(T.Tag));
+  if (!T.GroupTag.empty())
+    T.QueuePri = std::max(T.QueuePri, Boosts.lookup(T.GroupTag));
   return true;
 }
 
@@ -124,7 +126,8 @@ void BackgroundQueue::boost(llvm::StringRef Tag, unsigned NewPriority) {
 
   unsigned Changes = 0;
   for (Task &T : Queue)
-    if (Tag == T.Tag && NewPriority > T.QueuePri) {
+    if ((Tag == T.Tag || (!T.GroupTag.empty() && Tag == T.GroupTag)) &&
+        NewPriority > T.QueuePri) {
       T.QueuePri = NewPriority;
       ++Changes;
     }
@@ -46,7 +46,8 @@ void BackgroundIndexRebuilder::indexedTU() {
 void BackgroundIndexRebuilder::idle() {
   maybeRebuild("when background indexer is idle", [this] {
     // rebuild if there's anything new in the index.
-    // (even if currently rebuilding! this ensures eventual completeness)
+    // (even if currently rebuilding! the request is deferred until that build
+    // is done, which ensures eventual completeness)
     return IndexedTUs > IndexedTUsAtLastRebuild;
   });
 }
@@ -84,14 +85,24 @@ void BackgroundIndexRebuilder::maybeRebuild(const char *Reason,
   {
     std::lock_guard<std::mutex> Lock(Mu);
     if (!ShouldStop && Check()) {
+      // Every build holds a complete copy of the index until it is swapped
+      // in, so overlapping builds multiply the peak memory. Instead, leave the
+      // request to the build in progress, which starts another one when done.
+      if (Building) {
+        PendingReason = Reason;
+        return;
+      }
+      Building = true;
       BuildVersion = ++StartedVersion;
       IndexedTUsAtLastRebuild = IndexedTUs;
     }
   }
-  if (BuildVersion) {
+  while (BuildVersion) {
     std::unique_ptr<SymbolIndex> NewIndex;
     {
       vlog("BackgroundIndex: building version {0} {1}", BuildVersion, Reason);
+      if (BeforeBuild)
+        BeforeBuild();
       trace::Span Tracer("RebuildBackgroundIndex");
       SPAN_ATTACH(Tracer, "reason", Reason);
       NewIndex = Source->buildIndex(IndexType::Heavy, DuplicateHandling::Merge);
@@ -105,6 +116,15 @@ void BackgroundIndexRebuilder::maybeRebuild(const char *Reason,
              NewIndex->estimateMemoryUsage());
         Target->reset(std::move(NewIndex));
       }
+      BuildVersion = 0;
+      if (PendingReason && !ShouldStop) {
+        Reason = PendingReason;
+        BuildVersion = ++StartedVersion;
+        IndexedTUsAtLastRebuild = IndexedTUs;
+      } else {
+        Building = false;
+      }
+      PendingReason = nullptr;
     }
   }
 }
@@ -39,6 +39,10 @@ namespace clangd {
 //
 // The index is rebuilt every time the queue goes idle, if it's stale.
 //
+// Only one rebuild runs at a time. A rebuild requested while another one is
+// in progress is deferred until that one finishes, and several such requests
+// are coalesced into a single rebuild.
+//
 // All methods are threadsafe. They're called after FileSymbols is updated
 // etc. Without external locking, the rebuilt index may include more updates
 // than intended, which is fine.
@@ -72,6 +76,8 @@ public:
   // Thresholds for rebuilding as TUs get indexed. Exposed for testing.
   const unsigned TUsBeforeFirstBuild; // Typically one per worker thread.
   const unsigned TUsBeforeRebuild = 100;
+  // Called on the building thread before each rebuild. Exposed for testing.
+  std::function<void()> BeforeBuild;
 
 private:
   // Run Check under the lock, and rebuild if it returns true.
@@ -84,6 +90,9 @@ private:
   // Index builds are versioned. ActiveVersion chases StartedVersion.
   unsigned StartedVersion = 0;
   unsigned ActiveVersion = 0;
+  // Is a rebuild running? If so, further requests set PendingReason instead.
+  bool Building = false;
+  const char *PendingReason = nullptr;
   // How many TUs have we indexed so far since startup?
   unsigned IndexedTUs = 0;
   unsigned IndexedTUsAtLastRebuild = 0;
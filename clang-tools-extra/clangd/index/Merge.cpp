@@ -10,10 +10,16 @@
 #include "index/Symbol.h"
 #include "index/SymbolLocation.h"
 #include "index/SymbolOrigin.h"
+#include "support/Context.h"
 #include "support/Trace.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/StringSaver.h"
 #include <algorithm>
 #include <iterator>
+#include <limits>
 
 namespace clang {
 namespace clangd {
@@ -187,6 +193,156 @@ void MergedIndex::relations(
   });
 }
 
+ShardedIndex::ShardedIndex(std::vector<std::unique_ptr<SymbolIndex>> Shards)
+    : Shards(std::move(Shards)),
+      Pool(llvm::hardware_concurrency(this->Shards.size())) {
+  assert(!this->Shards.empty());
+}
+
+void ShardedIndex::forEachShard(
+    llvm::function_ref<void(const SymbolIndex &, size_t)> Query) const {
+  // Tasks run on pool threads but belong to this request, e.g. for tracing.
+  Context Ctx = Context::current().clone();
+  llvm::ThreadPoolTaskGroup Group(Pool);
+  for (size_t I = 1; I < Shards.size(); ++I)
+    Group.async([&, I] {
+      WithContext C(Ctx.clone());
+      Query(*Shards[I], I);
+    });
+  Query(*Shards.front(), 0);
+  Group.wait();
+}
+
+// Merges the symbols collected from every shard, reporting each symbol ID once.
+static void reportShardSymbols(
+    std::vector<SymbolSlab::Builder> &Results,
+    llvm::function_ref<void(const Symbol &)> Callback) {
+  SymbolSlab::Builder Merged;
+  for (auto &Result : Results) {
+    SymbolSlab Slab = std::move(Result).build();
+    for (const Symbol &S : Slab) {
+      if (const Symbol *Existing = Merged.find(S.ID))
+        Merged.insert(mergeSymbol(*Existing, S));
+      else
+        Merged.insert(S);
+    }
+  }
+  for (const Symbol &S : std::move(Merged).build())
+    Callback(S);
+}
+
+bool ShardedIndex::fuzzyFind(
+    const FuzzyFindRequest &Req,
+    llvm::function_ref<void(const Symbol &)> Callback) const {
+  trace::Span Tracer("ShardedIndex fuzzyFind");
+  std::vector<SymbolSlab::Builder> Results(Shards.size());
+  // Not std::vector<bool>: shards set their flags concurrently.
+  std::vector<char> HasMore(Shards.size());
+  forEachShard([&](const SymbolIndex &Shard, size_t I) {
+    HasMore[I] =
+        Shard.fuzzyFind(Req, [&](const Symbol &S) { Results[I].insert(S); });
+  });
+  // Like MergedIndex, we may return more than Req.Limit symbols and leave the
+  // final ranking and truncation to the caller.
+  reportShardSymbols(Results, Callback);
+  return llvm::is_contained(HasMore, true);
+}
+
+void ShardedIndex::lookup(
+    const LookupRequest &Req,
+    llvm::function_ref<void(const Symbol &)> Callback) const {
+  trace::Span Tracer("ShardedIndex lookup");
+  std::vector<SymbolSlab::Builder> Results(Shards.size());
+  forEachShard([&](const SymbolIndex &Shard, size_t I) {
+    Shard.lookup(Req, [&](const Symbol &S) { Results[I].insert(S); });
+  });
+  reportShardSymbols(Results, Callback);
+}
+
+bool ShardedIndex::refs(const RefsRequest &Req,
+                        llvm::function_ref<void(const Ref &)> Callback) const {
+  trace::Span Tracer("ShardedIndex refs");
+  struct ShardRefs {
+    std::vector<Ref> Refs;
+    // Owns the file URIs of Refs.
+    llvm::BumpPtrAllocator Arena;
+    llvm::UniqueStringSaver Strings{Arena};
+    bool HasMore = false;
+  };
+  std::vector<ShardRefs> Results(Shards.size());
+  forEachShard([&](const SymbolIndex &Shard, size_t I) {
+    ShardRefs &Result = Results[I];
+    Result.HasMore = Shard.refs(Req, [&](const Ref &R) {
+      Result.Refs.push_back(R);
+      Result.Refs.back().Location.FileURI =
+          Result.Strings.save(R.Location.FileURI).data();
+    });
+  });
+  bool More = llvm::any_of(
+      Results, [](const ShardRefs &Result) { return Result.HasMore; });
+  uint32_t Remaining = Req.Limit.value_or(std::numeric_limits<uint32_t>::max());
+  for (const ShardRefs &Result : Results) {
+    for (const Ref &R : Result.Refs) {
+      if (Remaining == 0)
+        return true;
+      --Remaining;
+      Callback(R);
+    }
+  }
+  return More;
+}
+
+void ShardedIndex::relations(
+    const RelationsRequest &Req,
+    llvm::function_ref<void(const SymbolID &, const Symbol &)> Callback) const {
+  trace::Span Tracer("ShardedIndex relations");
+  struct ShardRelations {
+    std::vector<std::pair<SymbolID, SymbolID>> Relations;
+    SymbolSlab::Builder Objects;
+  };
+  std::vector<ShardRelations> Results(Shards.size());
+  forEachShard([&](const SymbolIndex &Shard, size_t I) {
+    Shard.relations(Req, [&](const SymbolID &Subject, const Symbol &Object) {
+      Results[I].Relations.emplace_back(Subject, Object.ID);
+      Results[I].Objects.insert(Object);
+    });
+  });
+  uint32_t Remaining = Req.Limit.value_or(std::numeric_limits<uint32_t>::max());
+  llvm::DenseSet<std::pair<SymbolID, SymbolID>> SeenRelations;
+  for (auto &Result : Results) {
+    SymbolSlab Objects = std::move(Result.Objects).build();
+    for (const auto &Relation : Result.Relations) {
+      if (Remaining == 0)
+        return;
+      if (!SeenRelations.insert(Relation).second)
+        continue;
+      --Remaining;
+      Callback(Relation.first, *Objects.find(Relation.second));
+    }
+  }
+}
+
+llvm::unique_function<IndexContents(llvm::StringRef) const>
+ShardedIndex::indexedFiles() const {
+  std::vector<llvm::unique_function<IndexContents(llvm::StringRef) const>>
+      ShardFiles;
+  for (const auto &Shard : Shards)
+    ShardFiles.push_back(Shard->indexedFiles());
+  return [ShardFiles = std::move(ShardFiles)](llvm::StringRef FileURI) {
+    IndexContents Contents = IndexContents::None;
+    for (const auto &Files : ShardFiles)
+      Contents = Contents | Files(FileURI);
+    return Contents;
+  };
+}
+
+size_t ShardedIndex::estimateMemoryUsage() const {
+  size_t Total = 0;
+  for (const auto &Shard : Shards)
+    Total += Shard->estimateMemoryUsage();
+  return Total;
+}
+
 // Returns true if \p L is (strictly) preferred to \p R (e.g. by file paths). If
 // neither is preferred, this returns false.
 static bool prefer(const SymbolLocation &L, const SymbolLocation &R) {
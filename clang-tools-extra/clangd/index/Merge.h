@@ -10,6 +10,9 @@
 #define LLVM_CLANG_TOOLS_EXTRA_CLANGD_INDEX_MERGE_H
 
 #include "index/Index.h"
+#include "llvm/Support/ThreadPool.h"
+#include <memory>
+#include <vector>
 
 namespace clang {
 namespace clangd {
@@ -48,6 +51,38 @@ public:
   }
 };
 
+// ShardedIndex combines several indexes built from disjoint sets of files, e.g.
+// remote index servers each serving a part of a large project. Requests are
+// sent to all shards in parallel and their results are merged: symbols seen by
+// more than one shard are combined with mergeSymbol(), refs are concatenated.
+class ShardedIndex : public SymbolIndex {
+public:
+  explicit ShardedIndex(std::vector<std::unique_ptr<SymbolIndex>> Shards);
+
+  bool fuzzyFind(const FuzzyFindRequest &,
+                 llvm::function_ref<void(const Symbol &)>) const override;
+  void lookup(const LookupRequest &,
+              llvm::function_ref<void(const Symbol &)>) const override;
+  bool refs(const RefsRequest &,
+            llvm::function_ref<void(const Ref &)>) const override;
+  void relations(const RelationsRequest &,
+                 llvm::function_ref<void(const SymbolID &, const Symbol &)>)
+      const override;
+  llvm::unique_function<IndexContents(llvm::StringRef) const>
+  indexedFiles() const override;
+  size_t estimateMemoryUsage() const override;
+
+private:
+  // Runs \p Query on every shard and waits for all of them to finish. The first
+  // shard is queried on the calling thread, the others on Pool.
+  void forEachShard(
+      llvm::function_ref<void(const SymbolIndex &, size_t)> Query) const;
+
+  std::vector<std::unique_ptr<SymbolIndex>> Shards;
+  // Shared by all requests, so that queries don't spawn threads.
+  mutable llvm::ThreadPool Pool;
+};
+
 } // namespace clangd
 } // namespace clang
 
@@ -209,6 +209,9 @@ public:
   }
 };
 
+// Strings point either into the data the table was read from or, for a
+// compressed table, into Arena. They are only valid while both are alive, which
+// is fine as every consumer copies the strings it keeps.
 struct StringTableIn {
   llvm::BumpPtrAllocator Arena;
   std::vector<llvm::StringRef> Strings;
@@ -220,8 +223,8 @@ llvm::Expected<StringTableIn> readStringTable(llvm::StringRef Data) {
   if (R.err())
     return error("Truncated string table");
 
+  StringTableIn Table;
   llvm::StringRef Uncompressed;
-  llvm::SmallVector<uint8_t, 0> UncompressedStorage;
   if (UncompressedSize == 0) // No compression
     Uncompressed = R.rest();
   else if (llvm::compression::zlib::isAvailable()) {
@@ -234,22 +237,25 @@ llvm::Expected<StringTableIn> readStringTable(llvm::StringRef Data) {
       return error("Bad stri table: uncompress {0} -> {1} bytes is implausible",
                    R.rest().size(), UncompressedSize);
 
+    // Decompress straight into the arena, so the strings can refer to the
+    // decompressed data in place instead of being copied one by one.
+    uint8_t *UncompressedStorage =
+        Table.Arena.Allocate<uint8_t>(UncompressedSize);
     if (llvm::Error E = llvm::compression::zlib::decompress(
             llvm::arrayRefFromStringRef(R.rest()), UncompressedStorage,
             UncompressedSize))
       return std::move(E);
-    Uncompressed = toStringRef(UncompressedStorage);
+    Uncompressed = llvm::StringRef(
+        reinterpret_cast<const char *>(UncompressedStorage), UncompressedSize);
   } else
     return error("Compressed string table, but zlib is unavailable");
 
-  StringTableIn Table;
-  llvm::StringSaver Saver(Table.Arena);
   R = Reader(Uncompressed);
   for (Reader R(Uncompressed); !R.eof();) {
     auto Len = R.rest().find(0);
     if (Len == llvm::StringRef::npos)
       return error("Bad string table: not null terminated");
-    Table.Strings.push_back(Saver.save(R.consume(Len)));
+    Table.Strings.push_back(R.consume(Len));
     R.consume8();
   }
   if (R.err())
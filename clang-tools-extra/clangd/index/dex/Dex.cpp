@@ -259,6 +259,9 @@ bool Dex::fuzzyFind(const FuzzyFindRequest &Req,
 
   using IDAndScore = std::pair<DocID, float>;
   std::vector<IDAndScore> IDAndScores = consume(*Root);
+  // Candidates beyond the retrieval limit were never looked at.
+  if (Req.Limit && IDAndScores.size() == *Req.Limit * 100)
+    More = true;
 
   auto Compare = [](const IDAndScore &LHS, const IDAndScore &RHS) {
     return LHS.second > RHS.second;
@@ -10,7 +10,6 @@
 #include "index/dex/Iterator.h"
 #include "index/dex/Token.h"
 #include "llvm/Support/MathExtras.h"
-#include <optional>
 
 namespace clang {
 namespace clangd {
@@ -181,38 +180,32 @@ std::vector<Chunk> encodeStream(llvm::ArrayRef<DocID> Documents) {
   return std::vector<Chunk>(Result); // no move, shrink-to-fit
 }
 
-/// Reads variable length DocID from the buffer and updates the buffer size. If
-/// the stream is terminated, return std::nullopt.
-std::optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
-  if (Bytes.front() == 0 || Bytes.empty())
-    return std::nullopt;
-  DocID Result = 0;
-  bool HasNextByte = true;
-  for (size_t Length = 0; HasNextByte && !Bytes.empty(); ++Length) {
-    assert(Length <= 5 && "Malformed VByte encoding sequence.");
-    // Write meaningful bits to the correct place in the document decoding.
-    Result |= (Bytes.front() & 0x7f) << (BitsPerEncodingByte * Length);
-    if ((Bytes.front() & 0x80) == 0)
-      HasNextByte = false;
-    Bytes = Bytes.drop_front();
-  }
-  return Result;
-}
-
 } // namespace
 
 llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
   llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
-  llvm::ArrayRef<uint8_t> Bytes(Payload);
-  DocID Delta;
-  for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
-    auto MaybeDelta = readVByte(Bytes);
-    if (!MaybeDelta)
-      break;
-    Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+  DocID Current = Head;
+  // A zero byte terminates the stream, as 0 is never a valid delta.
+  for (size_t I = 0; I < PayloadSize && Payload[I] != 0;) {
+    // Most gaps are small, so handle single byte encodings without entering
+    // the continuation loop.
+    DocID Delta = Payload[I++];
+    if (Delta & 0x80) {
+      Delta &= 0x7f;
+      for (unsigned Shift = BitsPerEncodingByte; I < PayloadSize;
+           Shift += BitsPerEncodingByte) {
+        assert(Shift < 5 * BitsPerEncodingByte &&
+               "Malformed VByte encoding sequence.");
+        uint8_t Byte = Payload[I++];
+        Delta |= DocID(Byte & 0x7f) << Shift;
+        if ((Byte & 0x80) == 0)
+          break;
+      }
+    }
+    Current += Delta;
+    Result.push_back(Current);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+  return Result;
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
@@ -12,6 +12,7 @@
 #include "Feature.h"
 #include "Service.grpc.pb.h"
 #include "index/Index.h"
+#include "index/Merge.h"
 #include "marshalling/Marshalling.h"
 #include "support/Logger.h"
 #include "support/Trace.h"
@@ -190,6 +191,23 @@ std::unique_ptr<clangd::SymbolIndex> getClient(llvm::StringRef Address,
       new IndexClient(Channel, Address, ProjectRoot));
 }
 
+std::unique_ptr<clangd::SymbolIndex>
+getShardedClient(llvm::ArrayRef<std::string> Addresses,
+                 llvm::StringRef ProjectRoot) {
+  if (Addresses.size() == 1)
+    return getClient(Addresses.front(), ProjectRoot);
+  std::vector<std::unique_ptr<clangd::SymbolIndex>> Shards;
+  for (const std::string &Address : Addresses) {
+    auto Shard = getClient(Address, ProjectRoot);
+    if (!Shard)
+      return nullptr;
+    Shards.push_back(std::move(Shard));
+  }
+  if (Shards.empty())
+    return nullptr;
+  return std::make_unique<ShardedIndex>(std::move(Shards));
+}
+
 } // namespace remote
 } // namespace clangd
 } // namespace clang
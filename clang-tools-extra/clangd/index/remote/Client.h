@@ -10,7 +10,9 @@
 #define LLVM_CLANG_TOOLS_EXTRA_CLANGD_INDEX_REMOTE_CLIENT_H
 
 #include "index/Index.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
+#include <string>
 
 namespace clang {
 namespace clangd {
@@ -29,6 +31,16 @@ namespace remote {
 std::unique_ptr<clangd::SymbolIndex> getClient(llvm::StringRef Address,
                                                llvm::StringRef IndexRoot);
 
+/// Returns a SymbolIndex client for an index split across several servers, one
+/// per element of \p Addresses, each serving a disjoint part of the project
+/// (e.g. indexes built from disjoint sets of files). Requests are sent to all
+/// servers in parallel and their results are merged, see ShardedIndex.
+///
+/// \returns nullptr if any of the clients can't be created.
+std::unique_ptr<clangd::SymbolIndex>
+getShardedClient(llvm::ArrayRef<std::string> Addresses,
+                 llvm::StringRef IndexRoot);
+
 } // namespace remote
 } // namespace clangd
 } // namespace clang
@@ -20,6 +20,13 @@ std::unique_ptr<clangd::SymbolIndex> getClient(llvm::StringRef Address,
   return nullptr;
 }
 
+std::unique_ptr<clangd::SymbolIndex>
+getShardedClient(llvm::ArrayRef<std::string> Addresses,
+                 llvm::StringRef IndexRoot) {
+  elog("Can't create SymbolIndex client without Remote Index support.");
+  return nullptr;
+}
+
 } // namespace remote
 } // namespace clangd
 } // namespace clang
@@ -542,6 +542,14 @@ opt<std::string> RemoteIndexAddress{
     desc("Address of the remote index server"),
 };
 
+list<std::string> RemoteIndexShards{
+    "remote-index-shard",
+    cat(Features),
+    desc("Address of a further remote index server serving another part of "
+         "the project. May be repeated. Requests are sent to all servers and "
+         "their results are merged. Requires remote-index-address to be set."),
+};
+
 // FIXME(kirillbobyrev): Should this be the location of compile_commands.json?
 opt<std::string> ProjectRoot{
     "project-root",
@@ -606,7 +614,11 @@ loadExternalIndex(const Config::ExternalIndexSpec &External,
     RemoteIndexUsed.record(1, External.Location);
     log("Associating {0} with remote index at {1}.", External.MountPoint,
         External.Location);
-    return remote::getClient(External.Location, External.MountPoint);
+    if (External.Shards.empty())
+      return remote::getClient(External.Location, External.MountPoint);
+    std::vector<std::string> Addresses = {External.Location};
+    llvm::append_range(Addresses, External.Shards);
+    return remote::getShardedClient(Addresses, External.MountPoint);
   case Config::ExternalIndexSpec::File:
     log("Associating {0} with monolithic index at {1}.", External.MountPoint,
         External.Location);
@@ -678,6 +690,7 @@ public:
       Spec.Kind = Spec.Server;
       Spec.Location = RemoteIndexAddress;
       Spec.MountPoint = ProjectRoot;
+      Spec.Shards.assign(RemoteIndexShards.begin(), RemoteIndexShards.end());
       IndexSpec = std::move(Spec);
       BGPolicy = Config::BackgroundPolicy::Skip;
     }
@@ -880,6 +893,11 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
                     "specified at the same time.";
     return 1;
   }
+  if (!RemoteIndexShards.empty() && RemoteIndexAddress.empty()) {
+    llvm::errs() << "remote-index-shard requires remote-index-address to be "
+                    "specified.";
+    return 1;
+  }
   if (!RemoteIndexAddress.empty()) {
     if (IndexFile.empty()) {
       log("Connecting to remote index at {0}", RemoteIndexAddress);
@@ -7,6 +7,7 @@
 #include "index/Background.h"
 #include "index/BackgroundRebuild.h"
 #include "index/MemIndex.h"
+#include "support/Threading.h"
 #include "clang/Tooling/ArgumentsAdjusters.h"
 #include "clang/Tooling/CompilationDatabase.h"
 #include "llvm/ADT/STLExtras.h"
@@ -757,6 +758,34 @@ TEST_F(BackgroundIndexRebuilderTest, LoadingShards) {
   EXPECT_TRUE(checkRebuild([&] { Rebuilder.doneLoading(); }));
 }
 
+TEST_F(BackgroundIndexRebuilderTest, NoOverlappingBuilds) {
+  std::atomic<unsigned> Builds(0);
+  Notification FirstBuildStarted, FinishFirstBuild;
+  Rebuilder.BeforeBuild = [&] {
+    if (++Builds == 1) {
+      FirstBuildStarted.notify();
+      FinishFirstBuild.wait();
+    }
+  };
+
+  Rebuilder.indexedTU();
+  EXPECT_TRUE(checkRebuild([&] {
+    std::thread Builder([&] { Rebuilder.idle(); });
+    FirstBuildStarted.wait();
+    // Rebuilds requested while the first one runs don't start builds of
+    // their own...
+    for (unsigned I = 0; I < 3; ++I) {
+      Rebuilder.indexedTU();
+      Rebuilder.idle();
+    }
+    EXPECT_EQ(Builds, 1u);
+    FinishFirstBuild.notify();
+    Builder.join();
+  }));
+  // ...but are coalesced into one more build once it is done.
+  EXPECT_EQ(Builds, 2u);
+}
+
 TEST(BackgroundQueueTest, Priority) {
   // Create high and low priority tasks.
   // Once a bunch of high priority tasks have run, the queue is stopped.
@@ -822,6 +851,16 @@ TEST(BackgroundQueueTest, Boost) {
     Q.work([&] { Q.stop(); });
     EXPECT_EQ("AB", Sequence) << "A was boosted after enqueueing";
   }
+  Sequence.clear();
+  {
+    BackgroundQueue::Task GroupedA = A;
+    GroupedA.GroupTag = "G";
+    BackgroundQueue Q;
+    Q.append({GroupedA, B});
+    Q.boost("G", 3);
+    Q.work([&] { Q.stop(); });
+    EXPECT_EQ("AB", Sequence) << "A's group was boosted after enqueueing";
+  }
 }
 
 TEST(BackgroundQueueTest, Duplicates) {
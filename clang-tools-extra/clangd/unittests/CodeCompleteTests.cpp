@@ -23,6 +23,7 @@
 #include "index/Index.h"
 #include "index/MemIndex.h"
 #include "index/SymbolOrigin.h"
+#include "index/dex/Dex.h"
 #include "support/Threading.h"
 #include "clang/Sema/CodeCompleteConsumer.h"
 #include "clang/Tooling/CompilationDatabase.h"
@@ -1623,7 +1624,8 @@ TEST(SignatureHelpTest, StalePreamble) {
 
 class IndexRequestCollector : public SymbolIndex {
 public:
-  IndexRequestCollector(std::vector<Symbol> Syms = {}) : Symbols(Syms) {}
+  IndexRequestCollector(std::vector<Symbol> Syms = {}, bool HasMore = true)
+      : Symbols(Syms), HasMore(HasMore) {}
 
   bool
   fuzzyFind(const FuzzyFindRequest &Req,
@@ -1633,7 +1635,7 @@ public:
     ReceivedRequestCV.notify_one();
     for (const auto &Sym : Symbols)
       Callback(Sym);
-    return true;
+    return HasMore;
   }
 
   void lookup(const LookupRequest &,
@@ -1668,6 +1670,7 @@ public:
 
 private:
   std::vector<Symbol> Symbols;
+  bool HasMore;
   // We need a mutex to handle async fuzzy find requests.
   mutable std::condition_variable ReceivedRequestCV;
   mutable std::mutex Mut;
@@ -2749,6 +2752,72 @@ TEST(CompletionTest, EnableSpeculativeIndexRequest) {
   ASSERT_EQ(Reqs3.size(), 2u);
 }
 
+TEST(CompletionTest, RefineCompleteIndexResults) {
+  MockFS FS;
+  MockCompilationDatabase CDB;
+  ClangdServer Server(CDB, FS, ClangdServer::optsForTest());
+
+  auto File = testPath("foo.cpp");
+  Annotations Test(R"cpp(
+      void f() { abc$1^; abcd$2^; }
+  )cpp");
+  runAddDocument(Server, File, Test.code());
+  clangd::CodeCompleteOptions Opts = {};
+  Opts.Limit = 10;
+
+  IndexRequestCollector Requests({var("abcde"), var("abcxy")},
+                                 /*HasMore=*/false);
+  Opts.Index = &Requests;
+
+  auto CompleteAtPoint = [&](StringRef P) {
+    return cantFail(runCodeComplete(Server, File, Test.point(P), Opts))
+        .Completions;
+  };
+
+  EXPECT_THAT(CompleteAtPoint("1"),
+              AllOf(Contains(named("abcde")), Contains(named("abcxy"))));
+  ASSERT_EQ(Requests.consumeRequests(1).size(), 1u);
+
+  // The query only got longer, so the complete results of the previous
+  // request were filtered instead of querying the index again.
+  EXPECT_THAT(CompleteAtPoint("2"),
+              AllOf(Contains(named("abcde")), Not(Contains(named("abcxy")))));
+  EXPECT_THAT(Requests.consumeRequests(0), IsEmpty());
+}
+
+TEST(CompletionTest, RefineShortQueryIndexResults) {
+  MockFS FS;
+  MockCompilationDatabase CDB;
+  ClangdServer Server(CDB, FS, ClangdServer::optsForTest());
+
+  auto File = testPath("foo.cpp");
+  Annotations Test(R"cpp(
+      void f() { a$1^; ab$2^; abc$3^; }
+  )cpp");
+  runAddDocument(Server, File, Test.code());
+
+  // Dex matches queries shorter than a trigram against the first segments of
+  // an identifier only, so it finds fooBarAbc for "abc" but not for "a" or
+  // "ab". Results cached for the short queries must not be refined.
+  SymbolSlab::Builder Slab;
+  Slab.insert(var("fooBarAbc"));
+  Slab.insert(var("abacus"));
+  auto Index =
+      dex::Dex::build(std::move(Slab).build(), RefSlab(), RelationSlab());
+  clangd::CodeCompleteOptions Opts = {};
+  Opts.Limit = 10;
+  Opts.Index = Index.get();
+
+  auto CompleteAtPoint = [&](StringRef P) {
+    return cantFail(runCodeComplete(Server, File, Test.point(P), Opts))
+        .Completions;
+  };
+
+  EXPECT_THAT(CompleteAtPoint("1"), Not(Contains(named("fooBarAbc"))));
+  EXPECT_THAT(CompleteAtPoint("2"), Not(Contains(named("fooBarAbc"))));
+  EXPECT_THAT(CompleteAtPoint("3"), Contains(named("fooBarAbc")));
+}
+
 TEST(CompletionTest, InsertTheMostPopularHeader) {
   std::string DeclFile = URI::create(testPath("foo")).toString();
   Symbol Sym = func("Func");
@@ -636,6 +636,51 @@ TEST(MergeIndexTest, IncludeHeadersMerged) {
   });
   EXPECT_EQ(IncludeHeader, "<header>");
 }
+
+TEST(ShardedIndexTest, TwoShards) {
+  auto RefIn = [](const char *FileURI) {
+    Ref R;
+    R.Location.FileURI = FileURI;
+    R.Kind = RefKind::Reference;
+    return R;
+  };
+  RefSlab::Builder RefsA, RefsB;
+  RefsA.insert(SymbolID("ns::B"), RefIn("unittest:///a.cc"));
+  RefsB.insert(SymbolID("ns::B"), RefIn("unittest:///b.cc"));
+  std::vector<std::unique_ptr<SymbolIndex>> Shards;
+  Shards.push_back(MemIndex::build(generateSymbols({"ns::A", "ns::B"}),
+                                   std::move(RefsA).build(), RelationSlab()));
+  Shards.push_back(MemIndex::build(generateSymbols({"ns::B", "ns::C"}),
+                                   std::move(RefsB).build(), RelationSlab()));
+  ShardedIndex Sharded(std::move(Shards));
+
+  EXPECT_THAT(lookup(Sharded, SymbolID("ns::A")),
+              UnorderedElementsAre("ns::A"));
+  EXPECT_THAT(lookup(Sharded, SymbolID("ns::C")),
+              UnorderedElementsAre("ns::C"));
+  // Symbols found in both shards are only reported once.
+  EXPECT_THAT(lookup(Sharded, {SymbolID("ns::A"), SymbolID("ns::B"),
+                               SymbolID("ns::C")}),
+              UnorderedElementsAre("ns::A", "ns::B", "ns::C"));
+  EXPECT_THAT(lookup(Sharded, SymbolID("ns::D")), UnorderedElementsAre());
+
+  FuzzyFindRequest Req;
+  Req.Scopes = {"ns::"};
+  EXPECT_THAT(match(Sharded, Req),
+              UnorderedElementsAre("ns::A", "ns::B", "ns::C"));
+
+  EXPECT_THAT(getRefs(Sharded, SymbolID("ns::B")),
+              ElementsAre(Pair(_, UnorderedElementsAre(
+                                      fileURI("unittest:///a.cc"),
+                                      fileURI("unittest:///b.cc")))));
+
+  RefsRequest Request;
+  Request.IDs = {SymbolID("ns::B")};
+  Request.Limit = 1;
+  size_t NumRefs = 0;
+  EXPECT_TRUE(Sharded.refs(Request, [&](const Ref &) { ++NumRefs; }));
+  EXPECT_EQ(NumRefs, 1u);
+}
 } // namespace
 } // namespace clangd
 } // namespace clang
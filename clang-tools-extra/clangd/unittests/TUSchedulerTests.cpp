@@ -644,6 +644,35 @@ TEST_F(TUSchedulerTests, EvictedAST) {
               UnorderedElementsAre(Foo, AnyOf(Bar, Baz)));
 }
 
+TEST_F(TUSchedulerTests, PreambleShareability) {
+  trace::TestTracer Tracer;
+  TUScheduler S(CDB, optsForTest());
+
+  FS.Files[testPath("foo.h")] = "void foo();";
+  llvm::StringLiteral Contents = R"cpp(
+    #include "foo.h"
+    int main() {}
+  )cpp";
+  auto Build = [&](PathRef File, std::vector<std::string> ExtraArgs) {
+    auto Inputs = getInputs(File, Contents.str());
+    auto &Args = Inputs.CompileCommand.CommandLine;
+    Args.insert(Args.end() - 1, ExtraArgs.begin(), ExtraArgs.end());
+    S.update(File, std::move(Inputs), WantDiagnostics::Yes);
+    ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  };
+
+  Build(testPath("foo.cpp"), {"-o", "foo.o", "-MF", "foo.d"});
+  EXPECT_THAT(Tracer.takeMetric("preamble_shareable", "unique"), SizeIs(1));
+  // Only the output flags differ, so the preamble could have been shared.
+  Build(testPath("bar.cpp"), {"-o", "bar.o", "-MFbar.d"});
+  EXPECT_THAT(Tracer.takeMetric("preamble_shareable", "shared"), SizeIs(1));
+  EXPECT_THAT(Tracer.takeMetric("preamble_shareable", "unique"), SizeIs(0));
+  // A macro definition changes what the preamble means.
+  Build(testPath("baz.cpp"), {"-o", "baz.o", "-DBAZ"});
+  EXPECT_THAT(Tracer.takeMetric("preamble_shareable", "unique"), SizeIs(1));
+  EXPECT_THAT(Tracer.takeMetric("preamble_shareable", "shared"), SizeIs(0));
+}
+
 // We send "empty" changes to TUScheduler when we think some external event
 // *might* have invalidated current state (e.g. a header was edited).
 // Verify that this doesn't evict our cache entries.
@@ -213,9 +213,12 @@ private:
                                                      StringRef CrossTUDir,
                                                      StringRef IndexName,
                                                      bool DisplayCTUProgress);
-  template <typename T>
-  const T *findDefInDeclContext(const DeclContext *DC,
-                                StringRef LookupName);
+  /// Definitions with a body or an initializer in an external unit, keyed by
+  /// their lookup name.
+  using DefinitionMapTy = llvm::StringMap<const Decl *>;
+  /// Returns the definitions in \p Unit. The unit is walked, and a lookup name
+  /// generated for each of its definitions, only on the first call.
+  const DefinitionMapTy &getDefinitionsInUnit(ASTUnit *Unit);
   template <typename T>
   llvm::Expected<const T *> importDefinitionImpl(const T *D, ASTUnit *Unit);
 
@@ -224,6 +227,8 @@ private:
 
   ImporterMapTy ASTUnitImporterMap;
 
+  llvm::DenseMap<TranslationUnitDecl *, DefinitionMapTy> UnitDefinitionsMap;
+
   ASTContext &Context;
   std::shared_ptr<ASTImporterSharedState> ImporterSharedSt;
 
@@ -513,6 +513,15 @@ public:
   /// Minimum time granularity (in microseconds) traced by time profiler.
   unsigned TimeTraceGranularity;
 
+  /// Maximum number of time profiler events kept per thread, or 0.
+  unsigned TimeTraceMaxEvents;
+
+  /// Only record per-name totals in the time profiler output.
+  bool TimeTraceSummary;
+
+  /// Maximum number of time profiler totals written, or 0.
+  unsigned TimeTraceMaxTotals;
+
   /// Path which stores the output files for -ftime-trace
   std::string TimeTracePath;
 
@@ -528,7 +537,8 @@ public:
         BuildingImplicitModuleUsesLock(true), ModulesEmbedAllFiles(false),
         IncludeTimestamps(true), UseTemporary(true),
         AllowPCMWithCompilerErrors(false), ModulesShareFileManager(true),
-        TimeTraceGranularity(500) {}
+        TimeTraceGranularity(500), TimeTraceMaxEvents(0),
+        TimeTraceSummary(false), TimeTraceMaxTotals(0) {}
 
   /// getInputKindForExtension - Return the appropriate input kind for a file
   /// extension. For example, "c" would return Language::C.
@@ -1500,6 +1500,15 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// Overload resolution statistics, collected when CollectStats is set.
+  /// A resolution counts as repeated when the same source location already
+  /// resolved a candidate set found through the same lookup results, e.g. the
+  /// same call in another instantiation of a template.
+  unsigned NumOverloadResolutions = 0;
+  unsigned NumOverloadCandidates = 0;
+  unsigned NumRepeatedOverloadResolutions = 0;
+  llvm::DenseSet<std::pair<unsigned, unsigned>> SeenOverloadResolutions;
+
   typedef llvm::DenseMap<ParmVarDecl *, llvm::TinyPtrVector<ParmVarDecl *>>
     UnparsedDefaultArgInstantiationsMap;
 
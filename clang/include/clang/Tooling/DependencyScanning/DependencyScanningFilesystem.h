@@ -196,12 +196,24 @@ public:
                                 const CachedFileSystemEntry &Entry);
   };
 
+  /// Summary of the cache contents, used to judge how much work the workers
+  /// of one scanning process managed to share.
+  struct CacheStats {
+    /// Number of distinct filenames that were looked up.
+    size_t NumFilenames = 0;
+    /// Number of distinct files (by unique ID) that were stat'ed or read.
+    size_t NumUniqueFiles = 0;
+  };
+
   DependencyScanningFilesystemSharedCache();
 
   /// Returns shard for the given key.
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Returns the current cache statistics, locking each shard in turn.
+  CacheStats getStats() const;
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
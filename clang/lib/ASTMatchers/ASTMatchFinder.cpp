@@ -1036,18 +1036,29 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
+    // Whether the node is skipped only depends on the traversal kind, which
+    // is usually shared by many matchers in a row; only recompute it when the
+    // kind changes.
+    const TraversalKind DefaultTK =
+        getASTContext().getParentMapContext().getTraversalKind();
+    std::optional<TraversalKind> LastTK;
+    bool IsIgnored = false;
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
       BoundNodesTreeBuilder Builder;
 
-      {
-        TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
-        if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
-            DynNode)
-          continue;
+      TraversalKind TK = MP.first.getTraversalKind().value_or(DefaultTK);
+      if (TK != LastTK) {
+        TraversalKindScope RAII(getASTContext(), TK);
+        IsIgnored =
+            getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
+            DynNode;
+        LastTK = TK;
       }
+      if (IsIgnored)
+        continue;
 
       CurMatchRAII RAII(*this, MP.second, DynNode);
       if (MP.first.matches(DynNode, this, &Builder)) {
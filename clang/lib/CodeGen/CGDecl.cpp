@@ -1523,6 +1523,7 @@ CodeGenFunction::EmitAutoVarAlloca(const VarDecl &D) {
       // variable (C++0x [class.copy]p34).
       address = ReturnValue;
       AllocaAddr = ReturnValue;
+      ReturnValueHoldsNRVOVariable = true;
 
       if (const RecordType *RecordTy = Ty->getAs<RecordType>()) {
         const auto *RD = RecordTy->getDecl();
@@ -37,6 +37,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/Frontend/OpenMP/OMPIRBuilder.h"
 #include "llvm/IR/DataLayout.h"
+#include "llvm/IR/DebugInfo.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/FPEnv.h"
 #include "llvm/IR/IntrinsicInst.h"
@@ -44,6 +45,7 @@
 #include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Operator.h"
 #include "llvm/Support/CRC.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/xxhash.h"
 #include "llvm/Transforms/Scalar/LowerExpectIntrinsic.h"
 #include "llvm/Transforms/Utils/PromoteMemToReg.h"
@@ -52,6 +54,11 @@
 using namespace clang;
 using namespace CodeGen;
 
+static llvm::cl::opt<bool> PromoteInternalSlots(
+    "codegen-promote-internal-slots", llvm::cl::Hidden,
+    llvm::cl::desc("Rewrite the compiler-generated return value and cleanup "
+                   "destination slots into SSA values in every function"));
+
 /// shouldEmitLifetimeMarkers - Decide whether we need emit the life-time
 /// markers.
 static bool shouldEmitLifetimeMarkers(const CodeGenOptions &CGOpts,
@@ -526,6 +533,33 @@ void CodeGenFunction::FinishFunction(SourceLocation EndLoc) {
       ReturnValue = Address::invalid();
     }
   }
+
+  // With -codegen-promote-internal-slots, rewrite the return value slot and
+  // the cleanup destination slot into SSA values in every function, not just
+  // coroutines. This removes loads and stores that -O0 instruction selection
+  // and register allocation would otherwise have to process. The return value
+  // slot is also the storage of an NRVO variable, which the debugger must
+  // still be able to find in memory, so leave it alone in that case and
+  // whenever a slot has debug info attached.
+  if (PromoteInternalSlots) {
+    SmallVector<llvm::AllocaInst *, 2> Slots;
+    for (Address *Slot : {&ReturnValue, &NormalCleanupDest}) {
+      if (!Slot->isValid())
+        continue;
+      if (Slot == &ReturnValue && ReturnValueHoldsNRVOVariable)
+        continue;
+      auto *AI = dyn_cast<llvm::AllocaInst>(Slot->getPointer());
+      if (AI && llvm::isAllocaPromotable(AI) &&
+          llvm::FindDbgDeclareUses(AI).empty()) {
+        Slots.push_back(AI);
+        *Slot = Address::invalid();
+      }
+    }
+    if (!Slots.empty()) {
+      llvm::DominatorTree DT(*CurFn);
+      llvm::PromoteMemToReg(Slots, DT);
+    }
+  }
 }
 
 /// ShouldInstrumentFunction - Return true if the current function should be
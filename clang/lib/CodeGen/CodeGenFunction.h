@@ -361,6 +361,10 @@ public:
   /// value. This is invalid iff the function has no return value.
   Address ReturnValue = Address::invalid();
 
+  /// Whether an NRVO variable was allocated in ReturnValue, which makes it a
+  /// user-visible variable rather than a compiler-generated slot.
+  bool ReturnValueHoldsNRVOVariable = false;
+
   /// ReturnValuePointer - The temporary alloca to hold a pointer to sret.
   /// This is invalid if sret is not in use.
   Address ReturnValuePointer = Address::invalid();
@@ -764,7 +764,11 @@ void CodeGenModule::Release() {
   Module *Primary = getContext().getCurrentNamedModule();
   if (CXX20ModuleInits && Primary && !Primary->isHeaderLikeModule())
     EmitModuleInitializers(Primary);
-  EmitDeferred();
+  {
+    // EmitDeferred recurses, so time the outermost call only.
+    llvm::TimeTraceScope TimeScope("EmitDeferred");
+    EmitDeferred();
+  }
   DeferredDecls.insert(EmittedDeferredDecls.begin(),
                        EmittedDeferredDecls.end());
   EmittedDeferredDecls.clear();
@@ -250,29 +250,41 @@ CrossTranslationUnitContext::getLookupName(const NamedDecl *ND) {
   return std::string(DeclUSR.str());
 }
 
-/// Recursively visits the decls of a DeclContext, and returns one with the
-/// given USR.
-template <typename T>
-const T *
-CrossTranslationUnitContext::findDefInDeclContext(const DeclContext *DC,
-                                                  StringRef LookupName) {
+/// Recursively visits the decls of a DeclContext and records the definitions
+/// by lookup name. If several definitions share a name, the first one visited
+/// is kept.
+static void collectDefinitions(const DeclContext *DC,
+                               llvm::StringMap<const Decl *> &Defs) {
   assert(DC && "Declaration Context must not be null");
   for (const Decl *D : DC->decls()) {
-    const auto *SubDC = dyn_cast<DeclContext>(D);
-    if (SubDC)
-      if (const auto *ND = findDefInDeclContext<T>(SubDC, LookupName))
-        return ND;
-
-    const auto *ND = dyn_cast<T>(D);
-    const T *ResultDecl;
-    if (!ND || !hasBodyOrInit(ND, ResultDecl))
-      continue;
-    std::optional<std::string> ResultLookupName = getLookupName(ResultDecl);
-    if (!ResultLookupName || *ResultLookupName != LookupName)
+    if (const auto *SubDC = dyn_cast<DeclContext>(D))
+      collectDefinitions(SubDC, Defs);
+
+    const NamedDecl *Def = nullptr;
+    if (const auto *FD = dyn_cast<FunctionDecl>(D)) {
+      const FunctionDecl *FDDef;
+      if (hasBodyOrInit(FD, FDDef))
+        Def = FDDef;
+    } else if (const auto *VD = dyn_cast<VarDecl>(D)) {
+      const VarDecl *VDDef;
+      if (hasBodyOrInit(VD, VDDef))
+        Def = VDDef;
+    }
+    if (!Def)
       continue;
-    return ResultDecl;
+    if (std::optional<std::string> LookupName =
+            CrossTranslationUnitContext::getLookupName(Def))
+      Defs.try_emplace(*LookupName, Def);
   }
-  return nullptr;
+}
+
+const CrossTranslationUnitContext::DefinitionMapTy &
+CrossTranslationUnitContext::getDefinitionsInUnit(ASTUnit *Unit) {
+  TranslationUnitDecl *TU = Unit->getASTContext().getTranslationUnitDecl();
+  auto Result = UnitDefinitionsMap.try_emplace(TU);
+  if (Result.second)
+    collectDefinitions(TU, Result.first->second);
+  return Result.first->second;
 }
 
 template <typename T>
@@ -343,9 +355,11 @@ llvm::Expected<const T *> CrossTranslationUnitContext::getCrossTUDefinitionImpl(
         index_error_code::lang_dialect_mismatch);
   }
 
-  TranslationUnitDecl *TU = Unit->getASTContext().getTranslationUnitDecl();
-  if (const T *ResultDecl = findDefInDeclContext<T>(TU, *LookupName))
-    return importDefinition(ResultDecl, Unit);
+  const DefinitionMapTy &Defs = getDefinitionsInUnit(Unit);
+  auto DefIt = Defs.find(*LookupName);
+  if (DefIt != Defs.end())
+    if (const auto *ResultDecl = dyn_cast<T>(DefIt->second))
+      return importDefinition(ResultDecl, Unit);
   return llvm::make_error<IndexError>(index_error_code::failed_import);
 }
 
@@ -499,7 +513,7 @@ llvm::Error CrossTranslationUnitContext::ASTUnitStorage::ensureCTUIndexLoaded(
 
   if (auto IndexMapping = parseCrossTUIndex(IndexFile)) {
     // Initialize member map.
-    NameFileMap = *IndexMapping;
+    NameFileMap = std::move(*IndexMapping);
     return llvm::Error::success();
   } else {
     // Error while parsing CrossTU index file.
@@ -6474,6 +6474,9 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   if (const char *Name = C.getTimeTraceFile(&JA)) {
     CmdArgs.push_back(Args.MakeArgString("-ftime-trace=" + Twine(Name)));
     Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_granularity_EQ);
+    Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_max_events_EQ);
+    Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_summary);
+    Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_max_totals_EQ);
   }
 
   if (Arg *A = Args.getLastArg(options::OPT_ftrapv_handler_EQ)) {
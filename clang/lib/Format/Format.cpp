@@ -3697,6 +3697,12 @@ reformat(const FormatStyle &Style, StringRef Code,
   unsigned Penalty = 0;
   for (size_t I = 0, E = Passes.size(); I < E; ++I) {
     std::pair<tooling::Replacements, unsigned> PassFixes = Passes[I](*Env);
+    // A pass without fixes leaves the code and the affected ranges unchanged,
+    // so the environment built after an earlier pass can be reused as is.
+    if (PassFixes.first.empty() && CurrentCode) {
+      Penalty += PassFixes.second;
+      continue;
+    }
     auto NewCode = applyAllReplacements(
         CurrentCode ? StringRef(*CurrentCode) : Code, PassFixes.first);
     if (NewCode) {
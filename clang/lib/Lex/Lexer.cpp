@@ -2455,6 +2455,13 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   return false;
 }
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 /// We have just read the // characters from input.  Skip until we find the
 /// newline character that terminates the comment.  Then update BufferPtr and
 /// return.
@@ -2489,6 +2496,27 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
+#ifdef __SSE2__
+    // Skip 16 bytes at a time while none of them is a non-ASCII character, a
+    // newline or a nul the scalar loop below would stop at.
+    const char *VectorStart = CurPtr;
+    while (CurPtr + 16 < BufferEnd) {
+      __m128i Chunk = _mm_loadu_si128((const __m128i *)CurPtr);
+      int Mask =
+          _mm_movemask_epi8(Chunk) |
+          _mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\n'))) |
+          _mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\r'))) |
+          _mm_movemask_epi8(_mm_cmpeq_epi8(Chunk, _mm_setzero_si128()));
+      if (Mask) {
+        CurPtr += llvm::countr_zero<unsigned>(Mask);
+        break;
+      }
+      CurPtr += 16;
+    }
+    if (CurPtr != VectorStart)
+      UnicodeDecodingAlreadyDiagnosed = false;
+#endif
+
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (isASCII(C) && C != 0 &&   // Potentially EOF.
@@ -2727,13 +2755,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
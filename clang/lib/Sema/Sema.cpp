@@ -564,6 +564,11 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumOverloadResolutions << " overload resolutions, "
+               << NumOverloadCandidates << " candidates considered.\n";
+  llvm::errs() << NumRepeatedOverloadResolutions
+               << " overload resolutions repeated at the same location with "
+                  "the same lookup results.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -35,6 +35,7 @@
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateDeduction.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallString.h"
@@ -10365,6 +10366,20 @@ bool OverloadCandidate::NotValidBecauseConstraintExprHasError() const {
 OverloadingResult
 OverloadCandidateSet::BestViableFunction(Sema &S, SourceLocation Loc,
                                          iterator &Best) {
+  if (S.CollectStats) {
+    ++S.NumOverloadResolutions;
+    S.NumOverloadCandidates += size();
+    // Key on the declarations name lookup found rather than on the candidate
+    // functions, since the latter differ between template instantiations.
+    llvm::hash_code Hash = llvm::hash_value(size());
+    for (const OverloadCandidate &Cand : *this)
+      Hash = llvm::hash_combine(Hash, Cand.FoundDecl.getDecl());
+    if (!S.SeenOverloadResolutions
+             .insert({Loc.getRawEncoding(), static_cast<unsigned>(Hash)})
+             .second)
+      ++S.NumRepeatedOverloadResolutions;
+  }
+
   llvm::SmallVector<OverloadCandidate *, 16> Candidates;
   std::transform(begin(), end(), std::back_inserter(Candidates),
                  [](OverloadCandidate &Cand) { return &Cand; });
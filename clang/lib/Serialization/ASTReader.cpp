@@ -8017,6 +8017,37 @@ void ASTReader::PrintStats() {
                  NumIdentifierLookupHits, NumIdentifierLookups,
                  (double)NumIdentifierLookupHits*100.0/NumIdentifierLookups);
 
+  // Break the totals down per AST file, so that modules which are loaded but
+  // barely used stand out.
+  if (ModuleMgr.size() > 1) {
+    auto CountLoaded = [](const auto &Loaded, unsigned Base, unsigned Num) {
+      unsigned Count = 0;
+      for (unsigned I = Base, E = Base + Num; I != E; ++I)
+        Count += !(Loaded[I] == std::decay_t<decltype(Loaded[I])>());
+      return Count;
+    };
+    auto Percent = [](unsigned Part, unsigned Whole) {
+      return Whole ? (float)Part / Whole * 100 : 0.0f;
+    };
+    std::fprintf(stderr, "\n*** Per-File AST Statistics:\n");
+    for (ModuleFile &MF : ModuleMgr) {
+      unsigned Decls =
+          CountLoaded(DeclsLoaded, MF.BaseDeclID, MF.LocalNumDecls);
+      unsigned Types =
+          CountLoaded(TypesLoaded, MF.BaseTypeIndex, MF.LocalNumTypes);
+      unsigned Idents = CountLoaded(IdentifiersLoaded, MF.BaseIdentifierID,
+                                    MF.LocalNumIdentifiers);
+      std::fprintf(stderr,
+                   "  %s: %u/%u decls (%.1f%%), %u/%u types (%.1f%%), "
+                   "%u/%u identifiers (%.1f%%)\n",
+                   MF.FileName.c_str(), Decls, MF.LocalNumDecls,
+                   Percent(Decls, MF.LocalNumDecls), Types, MF.LocalNumTypes,
+                   Percent(Types, MF.LocalNumTypes), Idents,
+                   MF.LocalNumIdentifiers,
+                   Percent(Idents, MF.LocalNumIdentifiers));
+    }
+  }
+
   if (GlobalIndex) {
     std::fprintf(stderr, "\n");
     GlobalIndex->printStats();
@@ -107,6 +107,18 @@ DependencyScanningFilesystemSharedCache::getShardForUID(
   return CacheShards[Hash % NumShards];
 }
 
+DependencyScanningFilesystemSharedCache::CacheStats
+DependencyScanningFilesystemSharedCache::getStats() const {
+  CacheStats Stats;
+  for (unsigned I = 0; I != NumShards; ++I) {
+    const CacheShard &Shard = CacheShards[I];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    Stats.NumFilenames += Shard.EntriesByFilename.size();
+    Stats.NumUniqueFiles += Shard.EntriesByUID.size();
+  }
+  return Stats;
+}
+
 const CachedFileSystemEntry *
 DependencyScanningFilesystemSharedCache::CacheShard::findEntryByFilename(
     StringRef Filename) const {
@@ -0,0 +1,33 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -debug-info-kind=limited \
+// RUN:   -mllvm -codegen-promote-internal-slots -emit-llvm -o - %s | FileCheck %s
+
+// The compiler-generated return value slot is rewritten into an SSA value.
+
+// CHECK-LABEL: define{{.*}} i32 @_Z4pickb(
+// CHECK-NOT:     %retval = alloca
+// CHECK:       return:
+// CHECK-NEXT:    [[RET:%.*]] = phi i32 [ {{[12]}}, %{{.*}} ], [ {{[12]}}, %{{.*}} ]
+// CHECK-NEXT:    ret i32 [[RET]]
+int pick(bool b) {
+  if (b)
+    return 1;
+  return 2;
+}
+
+struct __attribute__((trivial_abi)) Trivial {
+  ~Trivial() {}
+  int ivar = 10;
+};
+
+// An NRVO variable lives in the return value slot, which must stay in memory
+// for the debugger.
+
+// CHECK-LABEL: define{{.*}} i32 @_Z11makeTrivialv(
+// CHECK:         [[RETVAL:%.*]] = alloca %struct.Trivial, align 4
+// CHECK:         call void @llvm.dbg.declare(metadata ptr [[RETVAL]], metadata [[VAR:![0-9]+]], metadata !DIExpression())
+// CHECK:         load i32, ptr {{.*}}
+// CHECK:       [[VAR]] = !DILocalVariable(name: "t"
+Trivial makeTrivial() {
+  Trivial t;
+  return t;
+}
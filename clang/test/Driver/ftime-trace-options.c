@@ -0,0 +1,18 @@
+// RUN: %clang -### -c -ftime-trace -ftime-trace-granularity=0 \
+// RUN:   -ftime-trace-max-events=100 -ftime-trace-summary \
+// RUN:   -ftime-trace-max-totals=5 -o %t.o %s 2>&1 | FileCheck %s
+
+// CHECK:      "-cc1"
+// CHECK-SAME: "-ftime-trace={{[^"]+}}.json"
+// CHECK-SAME: "-ftime-trace-granularity=0"
+// CHECK-SAME: "-ftime-trace-max-events=100"
+// CHECK-SAME: "-ftime-trace-summary"
+// CHECK-SAME: "-ftime-trace-max-totals=5"
+
+// The profiler options are only forwarded when a trace is requested.
+// RUN: %clang -### -c -ftime-trace-max-events=100 -ftime-trace-summary \
+// RUN:   -ftime-trace-max-totals=5 -o %t.o %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=NOTRACE
+
+// NOTRACE:     "-cc1"
+// NOTRACE-NOT: "-ftime-trace
@@ -0,0 +1,38 @@
+// RUN: rm -rf %t && mkdir %t
+
+// With -ftime-trace-summary only the totals are written.
+// RUN: %clang_cc1 -ftime-trace=%t/summary.json -ftime-trace-granularity=0 \
+// RUN:   -ftime-trace-summary -emit-llvm -o /dev/null %s
+// RUN: cat %t/summary.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s --check-prefix=SUMMARY
+
+// SUMMARY-NOT: "name": "ExecuteCompiler"
+// SUMMARY:     "name": "Total ExecuteCompiler"
+
+// -ftime-trace-max-totals limits how many totals are written.
+// RUN: %clang_cc1 -ftime-trace=%t/totals.json -ftime-trace-granularity=0 \
+// RUN:   -ftime-trace-max-totals=1 -emit-llvm -o /dev/null %s
+// RUN: cat %t/totals.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s --check-prefix=TOTALS
+
+// TOTALS-COUNT-1: "name": "Total
+// TOTALS-NOT:     "name": "Total
+
+// -ftime-trace-max-events drops the oldest events and says so.
+// RUN: %clang_cc1 -ftime-trace=%t/events.json -ftime-trace-granularity=0 \
+// RUN:   -ftime-trace-max-events=1 -emit-llvm -o /dev/null %s
+// RUN: cat %t/events.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s --check-prefix=EVENTS
+
+// EVENTS:     "droppedEvents": {{[1-9][0-9]*}},
+// EVENTS:     "traceEvents": [
+// EVENTS-NOT: "name":
+// EVENTS:     "name": "ExecuteCompiler"
+// EVENTS-NOT: "name":
+// EVENTS:     "name": "Total ExecuteCompiler"
+
+template <typename T> T twice(T x) { return x + x; }
+int f() { return twice(1) + twice(2L); }
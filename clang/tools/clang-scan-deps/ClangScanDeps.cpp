@@ -86,6 +86,7 @@ static bool DeprecatedDriverCommand;
 static ResourceDirRecipeKind ResourceDirRecipe;
 static bool Verbose;
 static bool PrintTiming;
+static bool PrintCacheStats;
 static std::vector<const char *> CommandLine;
 
 #ifndef NDEBUG
@@ -198,6 +199,8 @@ static void ParseArgs(int argc, char **argv) {
 
   PrintTiming = Args.hasArg(OPT_print_timing);
 
+  PrintCacheStats = Args.hasArg(OPT_print_cache_stats);
+
   Verbose = Args.hasArg(OPT_verbose);
 
   RoundTripArgs = Args.hasArg(OPT_round_trip_args);
@@ -974,6 +977,13 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
         "clang-scan-deps timing: %0.2fs wall, %0.2fs process\n",
         T.getTotalTime().getWallTime(), T.getTotalTime().getProcessTime());
 
+  if (PrintCacheStats) {
+    auto Stats = Service.getSharedCache().getStats();
+    llvm::errs() << "clang-scan-deps cache: " << Stats.NumFilenames
+                 << " filenames, " << Stats.NumUniqueFiles
+                 << " unique files\n";
+  }
+
   if (RoundTripArgs)
     if (FD && FD->roundTripCommands(llvm::errs()))
       HadErrors = true;
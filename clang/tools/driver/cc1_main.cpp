@@ -255,8 +255,14 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
                                                     Argv, Diags, Argv0);
 
   if (!Clang->getFrontendOpts().TimeTracePath.empty()) {
+    llvm::TimeTraceProfilerOptions TimeTraceOptions;
+    TimeTraceOptions.MaxEventsPerThread =
+        Clang->getFrontendOpts().TimeTraceMaxEvents;
+    TimeTraceOptions.SummaryOnly = Clang->getFrontendOpts().TimeTraceSummary;
+    TimeTraceOptions.MaxTotals = Clang->getFrontendOpts().TimeTraceMaxTotals;
     llvm::timeTraceProfilerInitialize(
-        Clang->getFrontendOpts().TimeTraceGranularity, Argv0);
+        Clang->getFrontendOpts().TimeTraceGranularity, Argv0,
+        TimeTraceOptions);
   }
   // --print-supported-cpus takes priority over the actual compilation.
   if (Clang->getFrontendOpts().PrintSupportedCPUs)
@@ -96,6 +96,8 @@ class ChunkHeader {
   // align < 8 -> 0
   // else      -> log2(min(align, 512)) - 2
   u8 user_requested_alignment_log : 3;
+  // Whether the chunk is fully protected, see heap_sample_rate.
+  u8 sampled : 1;
 
  private:
   u16 user_requested_size_hi;
@@ -335,6 +337,7 @@ void AllocatorOptions::SetFrom(const Flags *f, const CommonFlags *cf) {
   may_return_null = cf->allocator_may_return_null;
   alloc_dealloc_mismatch = f->alloc_dealloc_mismatch;
   release_to_os_interval_ms = cf->allocator_release_to_os_interval_ms;
+  heap_sample_rate = f->heap_sample_rate;
 }
 
 void AllocatorOptions::CopyTo(Flags *f, CommonFlags *cf) {
@@ -345,6 +348,7 @@ void AllocatorOptions::CopyTo(Flags *f, CommonFlags *cf) {
   cf->allocator_may_return_null = may_return_null;
   f->alloc_dealloc_mismatch = alloc_dealloc_mismatch;
   cf->allocator_release_to_os_interval_ms = release_to_os_interval_ms;
+  f->heap_sample_rate = heap_sample_rate;
 }
 
 struct Allocator {
@@ -363,6 +367,7 @@ struct Allocator {
   atomic_uint16_t min_redzone;
   atomic_uint16_t max_redzone;
   atomic_uint8_t alloc_dealloc_mismatch;
+  atomic_uint32_t heap_sample_rate;
 
   // ------------------- Initialization ------------------------
   explicit Allocator(LinkerInitialized)
@@ -385,6 +390,8 @@ struct Allocator {
                  memory_order_release);
     atomic_store(&min_redzone, options.min_redzone, memory_order_release);
     atomic_store(&max_redzone, options.max_redzone, memory_order_release);
+    atomic_store(&heap_sample_rate, options.heap_sample_rate,
+                 memory_order_release);
   }
 
   void InitLinkerInitialized(const AllocatorOptions &options) {
@@ -450,6 +457,8 @@ struct Allocator {
     options->alloc_dealloc_mismatch =
         atomic_load(&alloc_dealloc_mismatch, memory_order_acquire);
     options->release_to_os_interval_ms = allocator.ReleaseToOSIntervalMs();
+    options->heap_sample_rate =
+        atomic_load(&heap_sample_rate, memory_order_acquire);
   }
 
   // -------------------- Helper methods. -------------------------
@@ -468,6 +477,29 @@ struct Allocator {
     return Min(Max(rz_log, Max(min_log, hdr_log)), Max(max_log, hdr_log));
   }
 
+  // Decides whether the next allocation of the thread owning `ms` is fully
+  // protected. The intervals between sampled allocations are drawn uniformly
+  // from [1, 2 * rate - 1] so that periodic allocation patterns don't keep
+  // missing the same objects.
+  bool ShouldSampleAllocation(AsanThreadLocalMallocStorage *ms) {
+    u32 rate = atomic_load(&heap_sample_rate, memory_order_relaxed);
+    if (LIKELY(rate <= 1))
+      return true;
+    if (ms->heap_sample_countdown > 1) {
+      ms->heap_sample_countdown--;
+      return false;
+    }
+    u32 &state = ms->heap_sample_rand_state;
+    if (UNLIKELY(state == 0))
+      state = static_cast<u32>(reinterpret_cast<uptr>(ms) >> 4) | 1;
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    ms->heap_sample_countdown = 1 + state % (2 * rate - 1);
+    return true;
+  }
+
   static uptr ComputeUserRequestedAlignmentLog(uptr user_requested_alignment) {
     if (user_requested_alignment < 8)
       return 0;
@@ -551,7 +583,13 @@ struct Allocator {
       size = 1;
     }
     CHECK(IsPowerOfTwo(alignment));
-    uptr rz_log = ComputeRZLog(size);
+    AsanThread *t = GetCurrentThread();
+    // Allocations made without a thread (e.g. early during startup) are
+    // always sampled.
+    bool sampled = !t || ShouldSampleAllocation(&t->malloc_storage());
+    // Unsampled chunks only get the redzone that holds the chunk header.
+    uptr rz_log = sampled ? ComputeRZLog(size)
+                          : RZSize2Log(RoundUpToPowerOfTwo(sizeof(ChunkHeader)));
     uptr rz_size = RZLog2Size(rz_log);
     uptr rounded_size = RoundUpTo(Max(size, kChunkHeader2Size), alignment);
     uptr needed_size = rounded_size + rz_size;
@@ -575,7 +613,6 @@ struct Allocator {
       ReportAllocationSizeTooBig(size, needed_size, malloc_limit, stack);
     }
 
-    AsanThread *t = GetCurrentThread();
     void *allocated;
     if (t) {
       AllocatorCache *cache = GetAllocatorCache(&t->malloc_storage());
@@ -605,8 +642,10 @@ struct Allocator {
     CHECK(size);
     m->SetUsedSize(size);
     m->user_requested_alignment_log = user_requested_alignment_log;
+    m->sampled = sampled;
 
-    m->SetAllocContext(t ? t->tid() : kMainTid, StackDepotPut(*stack));
+    m->SetAllocContext(t ? t->tid() : kMainTid,
+                       sampled ? StackDepotPut(*stack) : 0);
 
     if (!from_primary || *(u8 *)MEM_TO_SHADOW((uptr)allocated) == 0) {
       // The allocator provides an unpoisoned chunk. This is possible for the
@@ -684,6 +723,21 @@ struct Allocator {
     CHECK_EQ(atomic_load(&m->chunk_state, memory_order_relaxed),
              CHUNK_QUARANTINE);
     AsanThread *t = GetCurrentThread();
+
+    // Unsampled chunks bypass the quarantine and are reused right away.
+    if (!m->sampled) {
+      m->SetFreeContext(t ? t->tid() : 0, 0);
+      if (t) {
+        AllocatorCache *ac = GetAllocatorCache(&t->malloc_storage());
+        QuarantineCallback(ac, stack).RecyclePassThrough(m);
+      } else {
+        SpinMutexLock l(&fallback_mutex);
+        QuarantineCallback(&fallback_allocator_cache, stack)
+            .RecyclePassThrough(m);
+      }
+      return;
+    }
+
     m->SetFreeContext(t ? t->tid() : 0, StackDepotPut(*stack));
 
     // Push into quarantine.
@@ -39,6 +39,7 @@ struct AllocatorOptions {
   u8 may_return_null;
   u8 alloc_dealloc_mismatch;
   s32 release_to_os_interval_ms;
+  u32 heap_sample_rate;
 
   void SetFrom(const Flags *f, const CommonFlags *cf);
   void CopyTo(Flags *f, CommonFlags *cf);
@@ -196,6 +197,10 @@ using AllocatorCache = AsanAllocator::AllocatorCache;
 struct AsanThreadLocalMallocStorage {
   uptr quarantine_cache[16];
   AllocatorCache allocator_cache;
+  // Number of allocations left until the next sampled one, and the state of
+  // the generator for the sampling intervals (see heap_sample_rate).
+  u32 heap_sample_countdown;
+  u32 heap_sample_rand_state;
   void CommitBack();
  private:
   // These objects are allocated via mmap() and are zero-initialized.
@@ -177,6 +177,15 @@ static StackTrace GetStackTraceFromId(u32 id) {
   return res;
 }
 
+// Chunks that were not sampled (see heap_sample_rate) have no stacks recorded.
+static void PrintStackFromId(u32 id) {
+  if (!id) {
+    Printf("    <not recorded>\n");
+    return;
+  }
+  GetStackTraceFromId(id).Print();
+}
+
 bool DescribeAddressIfHeap(uptr addr, uptr access_size) {
   HeapAddressDescription descr;
   if (!GetHeapAddressInformation(addr, access_size, &descr)) {
@@ -414,7 +423,6 @@ void HeapAddressDescription::Print() const {
 
   asanThreadRegistry().CheckLocked();
   AsanThreadContext *alloc_thread = GetThreadContextByTidLocked(alloc_tid);
-  StackTrace alloc_stack = GetStackTraceFromId(alloc_stack_id);
 
   Decorator d;
   AsanThreadContext *free_thread = nullptr;
@@ -422,15 +430,14 @@ void HeapAddressDescription::Print() const {
     free_thread = GetThreadContextByTidLocked(free_tid);
     Printf("%sfreed by thread %s here:%s\n", d.Allocation(),
            AsanThreadIdAndName(free_thread).c_str(), d.Default());
-    StackTrace free_stack = GetStackTraceFromId(free_stack_id);
-    free_stack.Print();
+    PrintStackFromId(free_stack_id);
     Printf("%spreviously allocated by thread %s here:%s\n", d.Allocation(),
            AsanThreadIdAndName(alloc_thread).c_str(), d.Default());
   } else {
     Printf("%sallocated by thread %s here:%s\n", d.Allocation(),
            AsanThreadIdAndName(alloc_thread).c_str(), d.Default());
   }
-  alloc_stack.Print();
+  PrintStackFromId(alloc_stack_id);
   DescribeThread(GetCurrentThread());
   if (free_thread) DescribeThread(free_thread);
   DescribeThread(alloc_thread);
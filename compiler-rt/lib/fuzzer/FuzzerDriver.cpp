@@ -766,6 +766,7 @@ int FuzzerDriver(int *argc, char ***argv, UserCallback Callback) {
     Options.FeaturesDir = Flags.features_dir;
     ValidateDirectoryExists(Options.FeaturesDir, Flags.create_missing_dirs);
   }
+  Options.ForkInMemoryMerge = Flags.fork_in_memory_merge;
   if (Flags.mutation_graph_file)
     Options.MutationGraphFile = Flags.mutation_graph_file;
   if (Flags.collect_data_flow)
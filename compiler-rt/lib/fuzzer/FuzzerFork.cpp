@@ -100,6 +100,7 @@ struct GlobalEnv {
   std::chrono::system_clock::time_point ProcessStartTime;
   int Verbosity = 0;
   int Group = 0;
+  bool InMemoryMerge = false;
   int NumCorpuses = 8;
 
   size_t NumTimeouts = 0;
@@ -201,6 +202,7 @@ struct GlobalEnv {
     NumRuns += Stats.number_of_executed_units;
 
     std::vector<SizedFile> TempFiles, MergeCandidates;
+    std::vector<std::vector<uint32_t>> MergeCandidateFeatures;
     // Read all newly created inputs and their feature sets.
     // Choose only those inputs that have new features.
     GetSizedFilesFromDir(Job->CorpusDir, &TempFiles);
@@ -208,13 +210,11 @@ struct GlobalEnv {
     for (auto &F : TempFiles) {
       auto FeatureFile = F.File;
       FeatureFile.replace(0, Job->CorpusDir.size(), Job->FeaturesDir);
-      auto FeatureBytes = FileToVector(FeatureFile, 0, false);
-      assert((FeatureBytes.size() % sizeof(uint32_t)) == 0);
-      std::vector<uint32_t> NewFeatures(FeatureBytes.size() / sizeof(uint32_t));
-      memcpy(NewFeatures.data(), FeatureBytes.data(), FeatureBytes.size());
+      auto NewFeatures = ReadUint32s(FeatureFile);
       for (auto Ft : NewFeatures) {
         if (!Features.count(Ft)) {
           MergeCandidates.push_back(F);
+          MergeCandidateFeatures.push_back(std::move(NewFeatures));
           break;
         }
       }
@@ -230,11 +230,28 @@ struct GlobalEnv {
 
     std::vector<std::string> FilesToAdd;
     std::set<uint32_t> NewFeatures, NewCov;
-    bool IsSetCoverMerge =
-        !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
-    CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
-                        &NewFeatures, Cov, &NewCov, Job->CFPath, false,
-                        IsSetCoverMerge);
+    if (InMemoryMerge) {
+      // Trust the feature sets reported by the job: take the inputs, smallest
+      // first, that still add a feature.
+      for (size_t I = 0; I < MergeCandidates.size(); I++) {
+        bool AddsFeature = false;
+        for (auto Ft : MergeCandidateFeatures[I])
+          if (!Features.count(Ft) && NewFeatures.insert(Ft).second)
+            AddsFeature = true;
+        if (AddsFeature)
+          FilesToAdd.push_back(MergeCandidates[I].File);
+      }
+      for (auto Idx : ReadUint32s(
+               DirPlusFile(Job->FeaturesDir, ForkObservedPCsFileName())))
+        if (!Cov.count(Idx))
+          NewCov.insert(Idx);
+    } else {
+      bool IsSetCoverMerge =
+          !Job->Cmd.getFlagValue("set_cover_merge").compare("1");
+      CrashResistantMerge(Args, {}, MergeCandidates, &FilesToAdd, Features,
+                          &NewFeatures, Cov, &NewCov, Job->CFPath, false,
+                          IsSetCoverMerge);
+    }
     for (auto &Path : FilesToAdd) {
       auto U = FileToVector(Path);
       auto NewPath = DirPlusFile(MainCorpusDir, Hash(U));
@@ -259,6 +276,14 @@ struct GlobalEnv {
                   TPC.GetNextInstructionPc(TE->PC));
   }
 
+  static std::vector<uint32_t> ReadUint32s(const std::string &Path) {
+    auto Bytes = FileToVector(Path, 0, false);
+    assert((Bytes.size() % sizeof(uint32_t)) == 0);
+    std::vector<uint32_t> Res(Bytes.size() / sizeof(uint32_t));
+    memcpy(Res.data(), Bytes.data(), Res.size() * sizeof(uint32_t));
+    return Res;
+  }
+
   void CollectDFT(const std::string &InputPath) {
     if (DataFlowBinary.empty()) return;
     if (!FilesWithDFT.insert(InputPath).second) return;
@@ -322,6 +347,7 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
   Env.ProcessStartTime = std::chrono::system_clock::now();
   Env.DataFlowBinary = Options.CollectDataFlow;
   Env.Group = Options.ForkCorpusGroups;
+  Env.InMemoryMerge = Options.ForkInMemoryMerge;
 
   std::vector<SizedFile> SeedFiles;
   for (auto &Dir : CorpusDirs)
@@ -16,6 +16,10 @@
 #include <string>
 
 namespace fuzzer {
+// With -fork_in_memory_merge, every job writes the indices of the PCs it
+// covered into this file of its features directory.
+inline const char *ForkObservedPCsFileName() { return "observed_pcs"; }
+
 void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
                   const std::vector<std::string> &Args,
                   const std::vector<std::string> &CorpusDirs, int NumJobs);
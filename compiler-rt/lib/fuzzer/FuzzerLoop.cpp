@@ -9,6 +9,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "FuzzerCorpus.h"
+#include "FuzzerFork.h"
 #include "FuzzerIO.h"
 #include "FuzzerInternal.h"
 #include "FuzzerMutate.h"
@@ -362,6 +363,16 @@ void Fuzzer::PrintFinalStats() {
     TPC.PrintCoverage(/*PrintAllCounters=*/false);
   if (Options.PrintCorpusStats)
     Corpus.PrintStats();
+  if (Options.ForkInMemoryMerge && !Options.FeaturesDir.empty()) {
+    // Report the coverage of this job to the parent in fork mode.
+    std::vector<uint32_t> ObservedPCs;
+    TPC.ForEachObservedPC([&](const TracePC::PCTableEntry *TE) {
+      ObservedPCs.push_back(static_cast<uint32_t>(TPC.PCTableEntryIdx(TE)));
+    });
+    WriteToFile(reinterpret_cast<const uint8_t *>(ObservedPCs.data()),
+                ObservedPCs.size() * sizeof(ObservedPCs[0]),
+                DirPlusFile(Options.FeaturesDir, ForkObservedPCsFileName()));
+  }
   if (!Options.PrintFinalStats)
     return;
   size_t ExecPerSec = execPerSec();
@@ -48,6 +48,7 @@ struct FuzzingOptions {
   bool OnlyASCII = false;
   bool Entropic = true;
   bool ForkCorpusGroups = false;
+  bool ForkInMemoryMerge = false;
   size_t EntropicFeatureFrequencyThreshold = 0xFF;
   size_t EntropicNumberOfRarestFeatures = 100;
   bool EntropicScalePerExecTime = false;
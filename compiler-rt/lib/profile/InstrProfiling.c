@@ -22,6 +22,9 @@
 
 static uint32_t __llvm_profile_global_timestamp = 1;
 
+COMPILER_RT_VISIBILITY void (*lprofMergeCounterShardsHook)(void) = 0;
+COMPILER_RT_VISIBILITY void (*lprofResetCounterShardsHook)(void) = 0;
+
 COMPILER_RT_VISIBILITY
 void INSTR_PROF_PROFILE_SET_TIMESTAMP(uint64_t *Probe) {
   if (*Probe == 0 || *Probe == (uint64_t)-1)
@@ -59,6 +62,8 @@ COMPILER_RT_VISIBILITY void __llvm_profile_reset_counters(void) {
   char ResetValue =
       (__llvm_profile_get_version() & VARIANT_MASK_BYTE_COVERAGE) ? 0xFF : 0;
   memset(I, ResetValue, E - I);
+  if (lprofResetCounterShardsHook)
+    lprofResetCounterShardsHook();
 
   const __llvm_profile_data *DataBegin = __llvm_profile_begin_data();
   const __llvm_profile_data *DataEnd = __llvm_profile_end_data();
@@ -152,6 +152,8 @@ void initBufferWriter(ProfDataWriter *BufferWriter, char *Buffer) {
 }
 
 COMPILER_RT_VISIBILITY int __llvm_profile_write_buffer(char *Buffer) {
+  if (lprofMergeCounterShardsHook)
+    lprofMergeCounterShardsHook();
   ProfDataWriter BufferWriter;
   initBufferWriter(&BufferWriter, Buffer);
   return lprofWriteData(&BufferWriter, 0, 0);
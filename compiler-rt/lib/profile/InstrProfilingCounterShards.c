@@ -0,0 +1,114 @@
+/*===- InstrProfilingCounterShards.c - Per-thread profile counter shards --===*\
+|*
+|* Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+|* See https://llvm.org/LICENSE.txt for license information.
+|* SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+|*
+\*===----------------------------------------------------------------------===*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "InstrProfiling.h"
+#include "InstrProfilingInternal.h"
+#include "InstrProfilingUtil.h"
+
+/* Code lowered with -instrprof-counter-sharding adds the value of this variable
+ * to the address of every counter it increments. Each thread is assigned one
+ * of a fixed number of copies (shards) of the counter section the first time
+ * it increments a counter, which spreads the writes of different threads over
+ * different cache lines. The shards are summed into the counter section before
+ * the profile is written.
+ *
+ * Only instrumented code refers to this file, so programs built without
+ * counter sharding neither link it nor pay for its thread-local variable. The
+ * rest of the runtime reaches the shards through the hooks installed below. */
+COMPILER_RT_VISIBILITY COMPILER_RT_TLS int64_t
+    INSTR_PROF_PROFILE_COUNTER_SHARD_BIAS_VAR = 0;
+
+#define INSTR_PROF_DEFAULT_COUNTER_SHARDS 16
+#define INSTR_PROF_MAX_COUNTER_SHARDS 64
+
+static char *CounterShards[INSTR_PROF_MAX_COUNTER_SHARDS];
+static unsigned NumCounterShards = 0;
+static char *NextCounterShard = 0;
+
+static unsigned getNumCounterShards(void) {
+  if (NumCounterShards)
+    return NumCounterShards;
+  unsigned N = INSTR_PROF_DEFAULT_COUNTER_SHARDS;
+  const char *Str = getenv("LLVM_PROFILE_COUNTER_SHARDS");
+  if (Str && Str[0]) {
+    int Value = atoi(Str);
+    if (Value > 0)
+      N = Value;
+  }
+  if (N > INSTR_PROF_MAX_COUNTER_SHARDS)
+    N = INSTR_PROF_MAX_COUNTER_SHARDS;
+  /* Racing threads compute the same value. */
+  NumCounterShards = N;
+  return N;
+}
+
+static void mergeCounterShards(void);
+static void resetCounterShards(void);
+
+COMPILER_RT_VISIBILITY int64_t
+INSTR_PROF_PROFILE_GET_COUNTER_SHARD_BIAS_FUNC(void) {
+  char *CountersBegin = __llvm_profile_begin_counters();
+  char *CountersEnd = __llvm_profile_end_counters();
+  if (CountersBegin == CountersEnd)
+    return 0;
+
+  /* Hand out the shards round-robin. */
+  unsigned Shard =
+      (uintptr_t)COMPILER_RT_PTR_FETCH_ADD(char, NextCounterShard, 1) %
+      getNumCounterShards();
+  char *Counters = CounterShards[Shard];
+  if (!Counters) {
+    char *NewCounters = (char *)calloc(CountersEnd - CountersBegin, 1);
+    /* Without a shard, keep updating the counter section. A zero bias makes
+     * the next function entry retry. */
+    if (!NewCounters)
+      return 0;
+    if (COMPILER_RT_BOOL_CMPXCHG(&CounterShards[Shard], 0, NewCounters)) {
+      Counters = NewCounters;
+    } else {
+      free(NewCounters);
+      Counters = CounterShards[Shard];
+    }
+  }
+  /* Racing threads store the same values. */
+  lprofMergeCounterShardsHook = mergeCounterShards;
+  lprofResetCounterShardsHook = resetCounterShards;
+  INSTR_PROF_PROFILE_COUNTER_SHARD_BIAS_VAR =
+      (intptr_t)Counters - (intptr_t)CountersBegin;
+  return INSTR_PROF_PROFILE_COUNTER_SHARD_BIAS_VAR;
+}
+
+static void mergeCounterShards(void) {
+  uint64_t *CountersBegin = (uint64_t *)__llvm_profile_begin_counters();
+  uint64_t *CountersEnd = (uint64_t *)__llvm_profile_end_counters();
+  unsigned I;
+  for (I = 0; I < INSTR_PROF_MAX_COUNTER_SHARDS; ++I) {
+    uint64_t *Shard = (uint64_t *)CounterShards[I];
+    uint64_t *Counter;
+    if (!Shard)
+      continue;
+    /* Threads may keep incrementing the shard meanwhile; like plain counter
+     * updates, the merge may lose some of those increments. */
+    for (Counter = CountersBegin; Counter < CountersEnd; ++Counter, ++Shard) {
+      *Counter += *Shard;
+      *Shard = 0;
+    }
+  }
+}
+
+static void resetCounterShards(void) {
+  size_t Size =
+      __llvm_profile_end_counters() - __llvm_profile_begin_counters();
+  unsigned I;
+  for (I = 0; I < INSTR_PROF_MAX_COUNTER_SHARDS; ++I)
+    if (CounterShards[I])
+      memset(CounterShards[I], 0, Size);
+}
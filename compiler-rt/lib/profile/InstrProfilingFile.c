@@ -183,9 +183,15 @@ COMPILER_RT_VISIBILITY extern intptr_t INSTR_PROF_PROFILE_COUNTER_BIAS_VAR
 #endif
 static const int ContinuousModeSupported = 1;
 static const int UseBiasVar = 1;
+#if defined(__ELF__)
+/* Every instrumented DSO carries its own copy of the runtime and appends its
+ * own raw profile to the (once truncated) file, starting at a page boundary. */
+static const char *FileOpenMode = "a+b";
+#else
 /* TODO: If there are two DSOs, the second DSO initilization will truncate the
  * first profile file. */
 static const char *FileOpenMode = "w+b";
+#endif
 /* This symbol is defined by the compiler when runtime counter relocation is
  * used and runtime provides a weak alias so we can check if it's defined. */
 static void *BiasAddr = &INSTR_PROF_PROFILE_COUNTER_BIAS_VAR;
@@ -202,10 +208,42 @@ static int mmapForContinuousMode(uint64_t CurrentFileOffset, FILE *File) {
   uint64_t FileSize = 0;
   if (getProfileFileSizeForMerging(File, &FileSize))
     return 1;
+  if (FileSize <= CurrentFileOffset) {
+    PROF_ERR("Profile is truncated (size = %" PRIu64 ", offset = %" PRIu64
+             ").\n",
+             FileSize, CurrentFileOffset);
+    return 1;
+  }
+
+#if defined(__ELF__)
+  /* Pad the file to a page boundary, so that the profile of the next DSO
+   * appended to it can be mapped as well. The raw profile reader skips zero
+   * padding between profiles. */
+  uint64_t PageSize = getpagesize();
+  uint64_t Padding = (PageSize - FileSize % PageSize) % PageSize;
+  if (Padding) {
+    static const char Zeroes[64] = {0};
+    uint64_t Left = Padding;
+    while (Left) {
+      size_t N = Left < sizeof(Zeroes) ? Left : sizeof(Zeroes);
+      if (fwrite(Zeroes, 1, N, File) != N) {
+        PROF_ERR("Unable to pad profile: %s\n", strerror(errno));
+        return 1;
+      }
+      Left -= N;
+    }
+    if (fflush(File)) {
+      PROF_ERR("Unable to pad profile: %s\n", strerror(errno));
+      return 1;
+    }
+    FileSize += Padding;
+  }
+#endif
 
-  /* Map the profile. */
-  char *Profile = (char *)mmap(NULL, FileSize, PROT_READ | PROT_WRITE,
-                               MAP_SHARED, fileno(File), 0);
+  /* Map the part of the profile which belongs to this image. */
+  uint64_t ProfileSize = FileSize - CurrentFileOffset;
+  char *Profile = (char *)mmap(NULL, ProfileSize, PROT_READ | PROT_WRITE,
+                               MAP_SHARED, fileno(File), CurrentFileOffset);
   if (Profile == MAP_FAILED) {
     PROF_ERR("Unable to mmap profile: %s\n", strerror(errno));
     return 1;
@@ -477,6 +515,8 @@ static int writeFile(const char *OutputName) {
 
   FreeHook = &free;
   setupIOBuffer();
+  if (lprofMergeCounterShardsHook)
+    lprofMergeCounterShardsHook();
   ProfDataWriter fileWriter;
   initFileWriter(&fileWriter, OutputFile);
   RetVal = lprofWriteData(&fileWriter, lprofGetVPDataReader(), MergeDone);
@@ -628,7 +668,12 @@ static void initializeProfileForContinuousMode(void) {
     File = fopen(Filename, FileOpenMode);
     if (!File)
       return;
-    /* Check that the offset within the file is page-aligned. */
+    /* Check that the offset within the file is page-aligned. The profiles of
+     * previously initialized images are appended, so start at the end. */
+    if (fseek(File, 0, SEEK_END) != 0) {
+      fclose(File);
+      return;
+    }
     CurrentFileOffset = ftell(File);
     unsigned PageSize = getpagesize();
     if (CurrentFileOffset % PageSize != 0) {
@@ -183,6 +183,15 @@ uint64_t lprofGetLoadModuleSignature();
 unsigned lprofProfileDumped(void);
 void lprofSetProfileDumped(unsigned);
 
+/*
+ * Hooks for the per-thread counter shards used by code lowered with
+ * -instrprof-counter-sharding. Only that code links in the shard runtime,
+ * which installs the hooks once it hands out a shard. The merge hook adds the
+ * shards to the counter section and clears them, the reset hook clears them.
+ */
+COMPILER_RT_VISIBILITY extern void (*lprofMergeCounterShardsHook)(void);
+COMPILER_RT_VISIBILITY extern void (*lprofResetCounterShardsHook)(void);
+
 COMPILER_RT_VISIBILITY extern void (*FreeHook)(void *);
 COMPILER_RT_VISIBILITY extern uint8_t *DynamicBufferIOBuffer;
 COMPILER_RT_VISIBILITY extern uint32_t VPBufferSize;
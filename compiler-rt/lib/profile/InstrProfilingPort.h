@@ -24,6 +24,7 @@
 #define COMPILER_RT_ALWAYS_INLINE __forceinline
 #define COMPILER_RT_CLEANUP(x)
 #define COMPILER_RT_USED
+#define COMPILER_RT_TLS __declspec(thread)
 #elif __GNUC__
 #ifdef _WIN32
 #define COMPILER_RT_FTRUNCATE(f, l) _chsize(fileno(f), l)
@@ -39,6 +40,7 @@
 #define COMPILER_RT_ALWAYS_INLINE inline __attribute((always_inline))
 #define COMPILER_RT_CLEANUP(x) __attribute__((cleanup(x)))
 #define COMPILER_RT_USED __attribute__((used))
+#define COMPILER_RT_TLS __thread
 #endif
 
 #if defined(__APPLE__)
@@ -36,6 +36,16 @@ void AddressInfo::Clear() {
   uuid_size = 0;
 }
 
+void AddressInfo::CopyFrom(const AddressInfo &other) {
+  internal_memcpy(this, &other, sizeof(AddressInfo));
+  if (other.module)
+    module = internal_strdup(other.module);
+  if (other.function)
+    function = internal_strdup(other.function);
+  if (other.file)
+    file = internal_strdup(other.file);
+}
+
 void AddressInfo::FillModuleInfo(const char *mod_name, uptr mod_offset,
                                  ModuleArch mod_arch) {
   module = internal_strdup(mod_name);
@@ -69,6 +79,42 @@ void SymbolizedStack::ClearAll() {
   InternalFree(this);
 }
 
+SymbolizedStack *SymbolizedStack::Clone() const {
+  SymbolizedStack *first = nullptr;
+  SymbolizedStack **last = &first;
+  for (const SymbolizedStack *cur = this; cur; cur = cur->next) {
+    SymbolizedStack *copy = New(cur->info.address);
+    copy->info.CopyFrom(cur->info);
+    *last = copy;
+    last = &copy->next;
+  }
+  return first;
+}
+
+SymbolizedStack *SymbolizedPCCache::Get(uptr addr) const {
+  auto *cached = cache_.find(addr);
+  return cached ? cached->second->Clone() : nullptr;
+}
+
+void SymbolizedPCCache::Add(uptr addr, const SymbolizedStack *frames) {
+  if (auto *cached = cache_.find(addr)) {
+    cached->second->ClearAll();
+    cached->second = frames->Clone();
+    return;
+  }
+  if (cache_.size() >= max_size_)
+    Clear();
+  cache_[addr] = frames->Clone();
+}
+
+void SymbolizedPCCache::Clear() {
+  cache_.forEach([](auto &kv) {
+    kv.second->ClearAll();
+    return true;
+  });
+  cache_.clear();
+}
+
 DataInfo::DataInfo() {
   internal_memset(this, 0, sizeof(DataInfo));
 }
@@ -126,8 +172,8 @@ const char *Symbolizer::ModuleNameOwner::GetOwnedCopy(const char *str) {
 }
 
 Symbolizer::Symbolizer(IntrusiveList<SymbolizerTool> tools)
-    : module_names_(&mu_), modules_(), modules_fresh_(false), tools_(tools),
-      start_hook_(0), end_hook_(0) {}
+    : module_names_(&mu_), modules_(), modules_fresh_(false),
+      pc_cache_(kMaxCachedPCs), tools_(tools), start_hook_(0), end_hook_(0) {}
 
 Symbolizer::SymbolizerScope::SymbolizerScope(const Symbolizer *sym)
     : sym_(sym), errno_(errno) {
@@ -19,6 +19,7 @@
 #define SANITIZER_SYMBOLIZER_H
 
 #include "sanitizer_common.h"
+#include "sanitizer_dense_map.h"
 #include "sanitizer_mutex.h"
 #include "sanitizer_vector.h"
 
@@ -46,6 +47,8 @@ struct AddressInfo {
   AddressInfo();
   // Deletes all strings and resets all fields.
   void Clear();
+  // Makes this a deep copy of |other|. Must be called on a cleared object.
+  void CopyFrom(const AddressInfo &other);
   void FillModuleInfo(const char *mod_name, uptr mod_offset, ModuleArch arch);
   void FillModuleInfo(const LoadedModule &mod);
   uptr module_base() const { return address - module_offset; }
@@ -59,11 +62,33 @@ struct SymbolizedStack {
   // Deletes current, and all subsequent frames in the linked list.
   // The object cannot be accessed after the call to this function.
   void ClearAll();
+  // Returns a deep copy of this frame and all subsequent frames.
+  SymbolizedStack *Clone() const;
 
  private:
   SymbolizedStack();
 };
 
+// Results of SymbolizePC, keyed by address. The cache owns deep copies of the
+// frames and hands out deep copies, so callers own what they get as usual. It
+// is dropped as a whole when it grows beyond |max_size| entries. Not thread
+// safe.
+class SymbolizedPCCache {
+ public:
+  explicit SymbolizedPCCache(uptr max_size) : max_size_(max_size) {}
+  ~SymbolizedPCCache() { Clear(); }
+  // Returns a deep copy of the frames cached for |addr|, or nullptr.
+  SymbolizedStack *Get(uptr addr) const;
+  // Caches a deep copy of |frames| for |addr|.
+  void Add(uptr addr, const SymbolizedStack *frames);
+  void Clear();
+  uptr size() const { return cache_.size(); }
+
+ private:
+  const uptr max_size_;
+  DenseMap<uptr, SymbolizedStack *> cache_;
+};
+
 // For now, DataInfo is used to describe global variable.
 struct DataInfo {
   // Owns all the string members. Storage for them is
@@ -187,6 +212,14 @@ class Symbolizer final {
   // If stale, need to reload the modules before looking up addresses.
   bool modules_fresh_;
 
+  // Reports and leak summaries tend to symbolize the same frames over and
+  // over (e.g. the allocator entry points and the common callers of many
+  // leaked objects), and every lookup through an external symbolizer is a
+  // pipe round trip. The cache is dropped when the module list is refreshed
+  // or Flush() is called.
+  static const uptr kMaxCachedPCs = 1 << 16;
+  SymbolizedPCCache pc_cache_;
+
   // Platform-specific default demangler, returns nullptr on failure.
   const char *PlatformDemangle(const char *name);
 
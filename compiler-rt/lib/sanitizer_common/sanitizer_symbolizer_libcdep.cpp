@@ -84,6 +84,11 @@ const char *ExtractTokenUpToDelimiter(const char *str, const char *delimiter,
 
 SymbolizedStack *Symbolizer::SymbolizePC(uptr addr) {
   Lock l(&mu_);
+  // A stale module list may map |addr| to a different module now.
+  if (modules_fresh_) {
+    if (SymbolizedStack *cached = pc_cache_.Get(addr))
+      return cached;
+  }
   SymbolizedStack *res = SymbolizedStack::New(addr);
   auto *mod = FindModuleForAddress(addr);
   if (!mod)
@@ -93,6 +98,7 @@ SymbolizedStack *Symbolizer::SymbolizePC(uptr addr) {
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
     if (tool.SymbolizePC(addr, res)) {
+      pc_cache_.Add(addr, res);
       return res;
     }
   }
@@ -152,6 +158,7 @@ bool Symbolizer::GetModuleNameAndOffsetForPC(uptr pc, const char **module_name,
 
 void Symbolizer::Flush() {
   Lock l(&mu_);
+  pc_cache_.Clear();
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
     tool.Flush();
@@ -189,6 +196,7 @@ void Symbolizer::RefreshModules() {
   fallback_modules_.fallbackInit();
   RAW_CHECK(modules_.size() > 0);
   modules_fresh_ = true;
+  pc_cache_.Clear();
 }
 
 static const LoadedModule *SearchForModule(const ListOfModules &modules,
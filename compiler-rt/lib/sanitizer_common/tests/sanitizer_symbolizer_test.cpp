@@ -54,6 +54,80 @@ TEST(Symbolizer, ExtractTokenUpToDelimiter) {
   InternalFree(token);
 }
 
+TEST(Symbolizer, SymbolizedStackClone) {
+  SymbolizedStack *frames = SymbolizedStack::New(0x1000);
+  frames->info.FillModuleInfo("a.out", 0x100, kModuleArchUnknown);
+  frames->info.function = internal_strdup("inlined");
+  frames->info.file = internal_strdup("a.h");
+  frames->info.line = 3;
+  frames->next = SymbolizedStack::New(0x1000);
+  frames->next->info.function = internal_strdup("caller");
+
+  SymbolizedStack *copy = frames->Clone();
+  frames->ClearAll();
+
+  ASSERT_NE(nullptr, copy);
+  EXPECT_EQ(0x1000U, copy->info.address);
+  EXPECT_STREQ("a.out", copy->info.module);
+  EXPECT_EQ(0x100U, copy->info.module_offset);
+  EXPECT_STREQ("inlined", copy->info.function);
+  EXPECT_STREQ("a.h", copy->info.file);
+  EXPECT_EQ(3, copy->info.line);
+  ASSERT_NE(nullptr, copy->next);
+  EXPECT_STREQ("caller", copy->next->info.function);
+  EXPECT_EQ(nullptr, copy->next->info.module);
+  EXPECT_EQ(nullptr, copy->next->next);
+  copy->ClearAll();
+}
+
+TEST(Symbolizer, SymbolizedPCCache) {
+  SymbolizedPCCache cache(2);
+  EXPECT_EQ(nullptr, cache.Get(0x1000));
+
+  SymbolizedStack *frames = SymbolizedStack::New(0x1000);
+  frames->info.function = internal_strdup("foo");
+  cache.Add(0x1000, frames);
+  frames->ClearAll();
+
+  // Hits return a copy that the caller owns.
+  SymbolizedStack *hit = cache.Get(0x1000);
+  ASSERT_NE(nullptr, hit);
+  EXPECT_STREQ("foo", hit->info.function);
+  hit->ClearAll();
+  hit = cache.Get(0x1000);
+  ASSERT_NE(nullptr, hit);
+  EXPECT_STREQ("foo", hit->info.function);
+  hit->ClearAll();
+
+  // Adding an address again replaces its frames.
+  frames = SymbolizedStack::New(0x1000);
+  frames->info.function = internal_strdup("bar");
+  cache.Add(0x1000, frames);
+  cache.Add(0x2000, frames);
+  frames->ClearAll();
+  EXPECT_EQ(2U, cache.size());
+  hit = cache.Get(0x1000);
+  ASSERT_NE(nullptr, hit);
+  EXPECT_STREQ("bar", hit->info.function);
+  hit->ClearAll();
+
+  // A full cache is dropped before a new address is added.
+  frames = SymbolizedStack::New(0x3000);
+  cache.Add(0x3000, frames);
+  frames->ClearAll();
+  EXPECT_EQ(1U, cache.size());
+  EXPECT_EQ(nullptr, cache.Get(0x1000));
+  EXPECT_EQ(nullptr, cache.Get(0x2000));
+  hit = cache.Get(0x3000);
+  ASSERT_NE(nullptr, hit);
+  EXPECT_EQ(0x3000U, hit->info.address);
+  hit->ClearAll();
+
+  cache.Clear();
+  EXPECT_EQ(0U, cache.size());
+  EXPECT_EQ(nullptr, cache.Get(0x3000));
+}
+
 #if !SANITIZER_WINDOWS
 TEST(Symbolizer, DemangleSwiftAndCXX) {
   // Swift names are not demangled in default llvm build because Swift
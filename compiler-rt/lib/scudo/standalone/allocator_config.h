@@ -79,6 +79,12 @@ namespace scudo {
 //     // primary64.
 //     static const uptr MapSizeIncrement = 1UL << 18;
 //
+//     // Once a region has grown to a huge page worth of blocks, map the rest of
+//     // it in huge page aligned chunks backed by transparent huge pages, and
+//     // only release whole huge pages in the periodic release. Only used with
+//     // primary64.
+//     static const bool EnableHugePages = false;
+//
 //     // Defines the minimal & maximal release interval that can be set.
 //     static const s32 MinReleaseToOsIntervalMs = INT32_MIN;
 //     static const s32 MaxReleaseToOsIntervalMs = INT32_MAX;
@@ -121,6 +127,7 @@ struct DefaultConfig {
     static const uptr CompactPtrScale = 0;
     static const bool EnableRandomOffset = true;
     static const uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
 #else
     static const uptr RegionSizeLog = 19U;
     static const uptr GroupSizeLog = 19U;
@@ -166,6 +173,7 @@ struct AndroidConfig {
     static const uptr GroupSizeLog = 20U;
     static const bool EnableRandomOffset = true;
     static const uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
 #else
     static const uptr RegionSizeLog = 18U;
     static const uptr GroupSizeLog = 18U;
@@ -214,6 +222,7 @@ struct FuchsiaConfig {
     typedef u32 CompactPtrT;
     static const bool EnableRandomOffset = true;
     static const uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
     static const uptr CompactPtrScale = SCUDO_MIN_ALIGNMENT_LOG;
     static const s32 MinReleaseToOsIntervalMs = INT32_MIN;
     static const s32 MaxReleaseToOsIntervalMs = INT32_MAX;
@@ -238,6 +247,7 @@ struct TrustyConfig {
     typedef u32 CompactPtrT;
     static const bool EnableRandomOffset = false;
     static const uptr MapSizeIncrement = 1UL << 12;
+    static const bool EnableHugePages = false;
     static const uptr CompactPtrScale = SCUDO_MIN_ALIGNMENT_LOG;
     static const s32 MinReleaseToOsIntervalMs = INT32_MIN;
     static const s32 MaxReleaseToOsIntervalMs = INT32_MAX;
@@ -129,6 +129,11 @@ inline uptr getPageSizeCached() {
 // Returns 0 if the number of CPUs could not be determined.
 u32 getNumberOfCPUs();
 
+// Returns the index of the CPU the calling thread is currently running on, or
+// -1 if it could not be determined. The thread can migrate at any time, so the
+// result is only a hint.
+s32 getCurrentCPU();
+
 const char *getEnv(const char *Name);
 
 u64 getMonotonicTime();
@@ -150,6 +155,7 @@ bool getRandom(void *Buffer, uptr Length, bool Blocking = false);
 #define MAP_RESIZABLE (1U << 2)
 #define MAP_MEMTAG (1U << 3)
 #define MAP_PRECOMMIT (1U << 4)
+#define MAP_HUGEPAGE (1U << 5)
 
 // Our platform memory mapping use is restricted to 3 scenarios:
 // - reserve memory at a random address (MAP_NOACCESS);
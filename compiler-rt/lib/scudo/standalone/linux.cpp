@@ -69,6 +69,12 @@ void *map(void *Addr, uptr Size, UNUSED const char *Name, uptr Flags,
       dieOnMapUnmapError(errno == ENOMEM ? Size : 0);
     return nullptr;
   }
+#if defined(MADV_HUGEPAGE)
+  // Ask for transparent huge pages. This is only a hint, so don't fail the
+  // mapping if the kernel doesn't support them.
+  if (Flags & MAP_HUGEPAGE)
+    madvise(P, Size, MADV_HUGEPAGE);
+#endif
 #if SCUDO_ANDROID
   if (Name)
     prctl(ANDROID_PR_SET_VMA, ANDROID_PR_SET_VMA_ANON_NAME, P, Size, Name);
@@ -166,6 +172,12 @@ u32 getNumberOfCPUs() {
   return static_cast<u32>(CPU_COUNT(&CPUs));
 }
 
+s32 getCurrentCPU() {
+  // Recent versions of glibc read this from the per-thread rseq area, older
+  // ones and bionic use the vDSO; either way this doesn't enter the kernel.
+  return static_cast<s32>(sched_getcpu());
+}
+
 u32 getThreadID() {
 #if SCUDO_ANDROID
   return static_cast<u32>(gettid());
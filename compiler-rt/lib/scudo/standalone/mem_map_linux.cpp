@@ -67,6 +67,12 @@ static void *mmapWrapper(uptr Addr, uptr Size, const char *Name, uptr Flags) {
       dieOnMapUnmapError(errno == ENOMEM ? Size : 0);
     return nullptr;
   }
+#if defined(MADV_HUGEPAGE)
+  // Ask for transparent huge pages. This is only a hint, so don't fail the
+  // mapping if the kernel doesn't support them.
+  if (Flags & MAP_HUGEPAGE)
+    madvise(P, Size, MADV_HUGEPAGE);
+#endif
 #if SCUDO_ANDROID
   if (Name)
     prctl(ANDROID_PR_SET_VMA, ANDROID_PR_SET_VMA_ANON_NAME, P, Size, Name);
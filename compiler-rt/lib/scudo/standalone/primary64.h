@@ -340,6 +340,7 @@ public:
   void getStats(ScopedString *Str) {
     // TODO(kostyak): get the RSS per region.
     uptr TotalMapped = 0;
+    uptr TotalHugePageMapped = 0;
     uptr PoppedBlocks = 0;
     uptr PushedBlocks = 0;
     for (uptr I = 0; I < NumClasses; I++) {
@@ -347,6 +348,7 @@ public:
       {
         ScopedLock L(Region->MMLock);
         TotalMapped += Region->MemMapInfo.MappedUser;
+        TotalHugePageMapped += getHugePageMappedUser(Region);
       }
       {
         ScopedLock L(Region->FLLock);
@@ -358,6 +360,12 @@ public:
                 "allocations; remains %zu\n",
                 TotalMapped >> 20, 0U, PoppedBlocks,
                 PoppedBlocks - PushedBlocks);
+    if (EnableHugePages) {
+      Str->append("Stats: SizeClassAllocator64: %zuM mapped with huge pages "
+                  "(%zu%% of mapped)\n",
+                  TotalHugePageMapped >> 20,
+                  TotalMapped ? TotalHugePageMapped * 100 / TotalMapped : 0);
+    }
 
     for (uptr I = 0; I < NumClasses; I++) {
       RegionInfo *Region = getRegionInfo(I);
@@ -498,6 +506,9 @@ private:
   static const uptr PrimarySize = RegionSize * NumClasses;
 
   static const uptr MapSizeIncrement = Config::Primary::MapSizeIncrement;
+  static const bool EnableHugePages = Config::Primary::EnableHugePages;
+  // The size of a transparent huge page on the supported targets.
+  static const uptr HugePageSize = 1UL << 21;
   // Fill at most this number of batches from the newly map'd memory.
   static const u32 MaxNumBatches = SCUDO_ANDROID ? 4U : 8U;
 
@@ -520,6 +531,10 @@ private:
     uptr MappedUser = 0;
     // Bytes allocated for user memory.
     uptr AllocatedUser = 0;
+    // First huge page boundary of the user memory mapped with huge pages, or 0
+    // if there is none. Everything from there up to `MappedUser` is backed by
+    // huge pages.
+    uptr HugePageBeg = 0;
   };
 
   struct UnpaddedRegionInfo {
@@ -882,19 +897,37 @@ private:
     // Map more space for blocks, if necessary.
     if (TotalUserBytes > MappedUser) {
       // Do the mmap for the user memory.
-      const uptr MapSize =
-          roundUp(TotalUserBytes - MappedUser, MapSizeIncrement);
+      uptr MapSize = roundUp(TotalUserBytes - MappedUser, MapSizeIncrement);
       const uptr RegionBase = RegionBeg - getRegionBaseByClassId(ClassId);
       if (UNLIKELY(RegionBase + MappedUser + MapSize > RegionSize)) {
         Region->Exhausted = true;
         return nullptr;
       }
 
+      uptr MapFlags = MAP_ALLOWNOMEM | MAP_RESIZABLE |
+                      (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG
+                                                                : 0);
+      // Once a size class has used a huge page worth of memory it is hot
+      // enough to be worth backing by huge pages: from then on grow it up to
+      // the next huge page boundary, so that the kernel can back each aligned
+      // 2MB range as a whole.
+      if (EnableHugePages && MappedUser + MapSize >= HugePageSize) {
+        const uptr HugeMapSize =
+            roundUp(RegionBeg + MappedUser + MapSize, HugePageSize) -
+            (RegionBeg + MappedUser);
+        if (RegionBase + MappedUser + HugeMapSize <= RegionSize) {
+          MapSize = HugeMapSize;
+          MapFlags |= MAP_HUGEPAGE;
+          // The chunk ends on a huge page boundary but may start below the
+          // first one, and that part stays backed by small pages.
+          if (Region->MemMapInfo.HugePageBeg == 0)
+            Region->MemMapInfo.HugePageBeg =
+                roundUp(RegionBeg + MappedUser, HugePageSize);
+        }
+      }
+
       if (UNLIKELY(!Region->MemMapInfo.MemMap.remap(
-              RegionBeg + MappedUser, MapSize, "scudo:primary",
-              MAP_ALLOWNOMEM | MAP_RESIZABLE |
-                  (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG
-                                                            : 0)))) {
+              RegionBeg + MappedUser, MapSize, "scudo:primary", MapFlags))) {
         return nullptr;
       }
       Region->MemMapInfo.MappedUser += MapSize;
@@ -977,14 +1010,28 @@ private:
     Str->append(
         "%s %02zu (%6zu): mapped: %6zuK popped: %7zu pushed: %7zu "
         "inuse: %6zu total: %6zu releases: %6zu last "
-        "released: %6zuK latest pushed bytes: %6zuK region: 0x%zx (0x%zx)\n",
+        "released: %6zuK latest pushed bytes: %6zuK ",
         Region->Exhausted ? "F" : " ", ClassId, getSizeByClassId(ClassId),
         Region->MemMapInfo.MappedUser >> 10, Region->FreeListInfo.PoppedBlocks,
         Region->FreeListInfo.PushedBlocks, InUseBlocks, TotalChunks,
         Region->ReleaseInfo.RangesReleased,
         Region->ReleaseInfo.LastReleasedBytes >> 10,
-        RegionPushedBytesDelta >> 10, Region->RegionBeg,
-        getRegionBaseByClassId(ClassId));
+        RegionPushedBytesDelta >> 10);
+    if (EnableHugePages)
+      Str->append("huge: %6zuK ", getHugePageMappedUser(Region) >> 10);
+    Str->append("region: 0x%zx (0x%zx)\n", Region->RegionBeg,
+                getRegionBaseByClassId(ClassId));
+  }
+
+  // Returns the bytes of user memory of the region that are backed by huge
+  // pages. This is what was advised to the kernel, which may still fall back
+  // to small pages; the actual coverage is reported in /proc/self/smaps.
+  static uptr getHugePageMappedUser(RegionInfo *Region)
+      REQUIRES(Region->MMLock) {
+    if (Region->MemMapInfo.HugePageBeg == 0)
+      return 0;
+    return Region->RegionBeg + Region->MemMapInfo.MappedUser -
+           Region->MemMapInfo.HugePageBeg;
   }
 
   void getRegionFragmentationInfo(RegionInfo *Region, uptr ClassId,
@@ -1095,9 +1142,17 @@ private:
     // ==================================================================== //
     // 4. Release the unused physical pages back to the OS.
     // ==================================================================== //
-    RegionReleaseRecorder<MemMapT> Recorder(&Region->MemMapInfo.MemMap,
-                                            Region->RegionBeg,
-                                            Context.getReleaseOffset());
+    // The periodic release leaves partially used huge pages alone, as splitting
+    // them would cost more in TLB misses than the few pages it returns. An
+    // explicit release (ForceAll) still returns every free page.
+    const bool WholeHugePages = EnableHugePages &&
+                                ReleaseType != ReleaseToOS::ForceAll &&
+                                Region->MemMapInfo.HugePageBeg != 0;
+    RegionReleaseRecorder<MemMapT> Recorder(
+        &Region->MemMapInfo.MemMap, Region->RegionBeg,
+        Context.getReleaseOffset(),
+        WholeHugePages ? Region->MemMapInfo.HugePageBeg : 0,
+        WholeHugePages ? HugePageSize : 0);
     auto SkipRegion = [](UNUSED uptr RegionIndex) { return false; };
     releaseFreeMemoryToOS(Context, Recorder, SkipRegion);
     if (Recorder.getReleasedRangesCount() > 0) {
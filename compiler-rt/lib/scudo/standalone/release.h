@@ -19,8 +19,15 @@ namespace scudo {
 
 template <typename MemMapT> class RegionReleaseRecorder {
 public:
-  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0)
-      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset) {}
+  // If `HugePageSize` is not 0, the memory at and above `HugePageBeg`, which is
+  // aligned to `HugePageSize`, is backed by huge pages and is only released in
+  // whole huge pages so that the remaining huge pages aren't split.
+  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0,
+                        uptr HugePageBeg = 0, uptr HugePageSize = 0)
+      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset),
+        HugePageBeg(HugePageBeg), HugePageSize(HugePageSize) {
+    DCHECK(HugePageSize == 0 || isAligned(HugePageBeg, HugePageSize));
+  }
 
   uptr getReleasedRangesCount() const { return ReleasedRangesCount; }
 
@@ -31,13 +38,29 @@ public:
   // Releases [From, To) range of pages back to OS. Note that `From` and `To`
   // are offseted from `Base` + Offset.
   void releasePageRangeToOS(uptr From, uptr To) {
-    const uptr Size = To - From;
-    RegionMemMap->releasePagesToOS(getBase() + Offset + From, Size);
+    const uptr Beg = getBase() + Offset + From;
+    const uptr End = getBase() + Offset + To;
+    if (HugePageSize == 0 || End <= HugePageBeg) {
+      releaseRange(Beg, End);
+      return;
+    }
+    const uptr HugeBeg = Max(Beg, HugePageBeg);
+    if (Beg < HugeBeg)
+      releaseRange(Beg, HugeBeg);
+    const uptr AlignedBeg = roundUp(HugeBeg, HugePageSize);
+    const uptr AlignedEnd = roundDown(End, HugePageSize);
+    if (AlignedBeg < AlignedEnd)
+      releaseRange(AlignedBeg, AlignedEnd);
+  }
+
+private:
+  void releaseRange(uptr Beg, uptr End) {
+    const uptr Size = End - Beg;
+    RegionMemMap->releasePagesToOS(Beg, Size);
     ReleasedRangesCount++;
     ReleasedBytes += Size;
   }
 
-private:
   uptr ReleasedRangesCount = 0;
   uptr ReleasedBytes = 0;
   MemMapT *RegionMemMap = nullptr;
@@ -45,6 +68,9 @@ private:
   // The release offset from Base. This is used when we know a given range after
   // Base will not be released.
   uptr Offset = 0;
+  // The start of the huge page backed memory, and the size of a huge page.
+  uptr HugePageBeg = 0;
+  uptr HugePageSize = 0;
 };
 
 class ReleaseRecorder {
@@ -621,6 +621,7 @@ struct DeathConfig {
     static const scudo::uptr CompactPtrScale = 0;
     static const bool EnableRandomOffset = true;
     static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
     static const scudo::uptr GroupSizeLog = 18;
   };
   template <typename Config>
@@ -39,6 +39,7 @@ template <typename SizeClassMapT> struct TestConfig1 {
     static const scudo::uptr CompactPtrScale = 0;
     static const bool EnableRandomOffset = true;
     static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
   };
 };
 
@@ -60,6 +61,7 @@ template <typename SizeClassMapT> struct TestConfig2 {
     static const scudo::uptr CompactPtrScale = 0;
     static const bool EnableRandomOffset = true;
     static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
   };
 };
 
@@ -81,6 +83,7 @@ template <typename SizeClassMapT> struct TestConfig3 {
     static const scudo::uptr CompactPtrScale = 0;
     static const bool EnableRandomOffset = true;
     static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
   };
 };
 
@@ -102,6 +105,7 @@ template <typename SizeClassMapT> struct TestConfig4 {
     typedef scudo::u32 CompactPtrT;
     static const bool EnableRandomOffset = true;
     static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
   };
 };
 
@@ -199,6 +203,7 @@ struct SmallRegionsConfig {
     static const scudo::uptr CompactPtrScale = 0;
     static const bool EnableRandomOffset = true;
     static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = false;
     static const scudo::uptr GroupSizeLog = 20U;
   };
 };
@@ -242,10 +247,79 @@ TEST(ScudoPrimaryTest, Primary64OOM) {
   scudo::ScopedString Str;
   Allocator.getStats(&Str);
   Str.output();
+  // Huge page stats are only reported when the config enables them.
+  EXPECT_EQ(strstr(Str.data(), "huge"), nullptr);
   EXPECT_EQ(AllocationFailed, true);
   Allocator.unmapTestOnly();
 }
 
+struct HugePagesConfig {
+  static const bool MaySupportMemoryTagging = false;
+
+  struct Primary {
+    using SizeClassMap = scudo::DefaultSizeClassMap;
+    static const scudo::uptr RegionSizeLog = 24U;
+    static const scudo::s32 MinReleaseToOsIntervalMs = INT32_MIN;
+    static const scudo::s32 MaxReleaseToOsIntervalMs = INT32_MAX;
+    typedef scudo::uptr CompactPtrT;
+    static const scudo::uptr CompactPtrScale = 0;
+    static const bool EnableRandomOffset = true;
+    static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    static const bool EnableHugePages = true;
+    static const scudo::uptr GroupSizeLog = 20U;
+  };
+};
+
+TEST(ScudoPrimaryTest, Primary64HugePages) {
+  using Primary = scudo::SizeClassAllocator64<HugePagesConfig>;
+  std::unique_ptr<Primary> Allocator(new Primary);
+  Allocator->init(/*ReleaseToOsInterval=*/-1);
+  typename Primary::CacheT Cache;
+  Cache.init(nullptr, Allocator.get());
+  // Allocate enough blocks of a single size class for the region to be backed
+  // by huge pages.
+  const scudo::uptr Size = 4096U;
+  const scudo::uptr ClassId = Primary::SizeClassMap::getClassIdBySize(Size);
+  std::vector<void *> Pointers;
+  for (scudo::uptr I = 0; I < (6UL << 20) / Size; I++) {
+    void *P = Cache.allocate(ClassId);
+    ASSERT_NE(P, nullptr);
+    memset(P, 'B', Size);
+    Pointers.push_back(P);
+  }
+  scudo::ScopedString Str;
+  Allocator->getStats(&Str);
+  // Huge pages are counted from the first huge page boundary, so every region
+  // reports a whole number of them, and the hot one at least one.
+  const scudo::uptr HugePageKB = 2048U;
+  scudo::uptr TotalHugeKB = 0;
+  for (const char *S = strstr(Str.data(), "huge: "); S;
+       S = strstr(S + 1, "huge: ")) {
+    const scudo::uptr HugeKB = strtoul(S + strlen("huge: "), nullptr, 10);
+    EXPECT_EQ(HugeKB % HugePageKB, 0U);
+    TotalHugeKB += HugeKB;
+  }
+  EXPECT_GE(TotalHugeKB, HugePageKB);
+  const char *TotalHuge = strstr(Str.data(), "M mapped with huge pages");
+  ASSERT_NE(TotalHuge, nullptr);
+  while (TotalHuge > Str.data() && TotalHuge[-1] >= '0' && TotalHuge[-1] <= '9')
+    TotalHuge--;
+  EXPECT_EQ(strtoul(TotalHuge, nullptr, 10), TotalHugeKB >> 10);
+
+  // Freed blocks are reused, whichever way the pages were released.
+  for (void *P : Pointers)
+    Cache.deallocate(ClassId, P);
+  Cache.drain();
+  Allocator->releaseToOS(scudo::ReleaseToOS::Force);
+  Allocator->releaseToOS(scudo::ReleaseToOS::ForceAll);
+  void *P = Cache.allocate(ClassId);
+  ASSERT_NE(P, nullptr);
+  memset(P, 'C', Size);
+  Cache.deallocate(ClassId, P);
+  Cache.destroy(nullptr);
+  Allocator->unmapTestOnly();
+}
+
 SCUDO_TYPED_TEST(ScudoPrimaryTest, PrimaryIterate) {
   using Primary = TestAllocator<TypeParam, scudo::DefaultSizeClassMap>;
   std::unique_ptr<Primary> Allocator(new Primary);
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <random>
 #include <set>
+#include <vector>
 
 TEST(ScudoReleaseTest, RegionPageMap) {
   for (scudo::uptr I = 0; I < SCUDO_WORDSIZE; I++) {
@@ -626,6 +627,52 @@ TEST(ScudoReleaseTest, RangeReleaseRegionWithSingleBlock) {
   testReleaseRangeWithSingleBlock<scudo::FuchsiaSizeClassMap>();
 }
 
+// Records the ranges released through a RegionReleaseRecorder.
+struct FakeRegionMemMap {
+  std::vector<std::pair<scudo::uptr, scudo::uptr>> Released;
+  void releasePagesToOS(scudo::uptr From, scudo::uptr Size) {
+    Released.emplace_back(From, Size);
+  }
+};
+
+TEST(ScudoReleaseTest, RegionReleaseRecorderHugePages) {
+  constexpr scudo::uptr HugePageSize = 1UL << 21;
+  constexpr scudo::uptr Base = 8 * HugePageSize + 0x3000;
+  constexpr scudo::uptr HugePageBeg = 10 * HugePageSize;
+  const scudo::uptr HugeOffset = HugePageBeg - Base;
+
+  // Without huge pages, ranges are released as they are.
+  {
+    FakeRegionMemMap MemMap;
+    scudo::RegionReleaseRecorder<FakeRegionMemMap> Recorder(&MemMap, Base);
+    Recorder.releasePageRangeToOS(0x1000, HugeOffset + 3 * HugePageSize);
+    ASSERT_EQ(MemMap.Released.size(), 1U);
+    EXPECT_EQ(MemMap.Released[0].first, Base + 0x1000);
+    EXPECT_EQ(MemMap.Released[0].second,
+              HugeOffset + 3 * HugePageSize - 0x1000);
+  }
+
+  // Below the first huge page boundary, memory is released page by page,
+  // while above it only whole huge pages are released.
+  FakeRegionMemMap MemMap;
+  scudo::RegionReleaseRecorder<FakeRegionMemMap> Recorder(
+      &MemMap, Base, /*Offset=*/0, HugePageBeg, HugePageSize);
+  Recorder.releasePageRangeToOS(0x1000, 0x5000);
+  Recorder.releasePageRangeToOS(HugeOffset - 0x2000,
+                                HugeOffset + 2 * HugePageSize + 0x1000);
+  Recorder.releasePageRangeToOS(HugeOffset + 3 * HugePageSize + 0x1000,
+                                HugeOffset + 4 * HugePageSize);
+  ASSERT_EQ(MemMap.Released.size(), 3U);
+  EXPECT_EQ(MemMap.Released[0].first, Base + 0x1000);
+  EXPECT_EQ(MemMap.Released[0].second, 0x4000U);
+  EXPECT_EQ(MemMap.Released[1].first, HugePageBeg - 0x2000);
+  EXPECT_EQ(MemMap.Released[1].second, 0x2000U);
+  EXPECT_EQ(MemMap.Released[2].first, HugePageBeg);
+  EXPECT_EQ(MemMap.Released[2].second, 2 * HugePageSize);
+  EXPECT_EQ(Recorder.getReleasedRangesCount(), 3U);
+  EXPECT_EQ(Recorder.getReleasedBytes(), 0x6000U + 2 * HugePageSize);
+}
+
 TEST(ScudoReleaseTest, BufferPool) {
   constexpr scudo::uptr StaticBufferCount = SCUDO_WORDSIZE - 1;
   constexpr scudo::uptr StaticBufferSize = 512U;
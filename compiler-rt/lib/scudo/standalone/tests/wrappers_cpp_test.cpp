@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "common.h"
 #include "memtag.h"
 #include "tests/scudo_unit_test.h"
 
@@ -14,6 +15,7 @@
 #include <fstream>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <thread>
 #include <vector>
 
@@ -27,6 +29,19 @@
 void operator delete(void *, size_t) noexcept;
 void operator delete[](void *, size_t) noexcept;
 
+// The MemProf hot/cold operator new extension, implemented by the wrappers.
+enum class __hot_cold_t : uint8_t {};
+void *operator new(size_t, __hot_cold_t);
+void *operator new[](size_t, __hot_cold_t);
+void *operator new(size_t, const std::nothrow_t &, __hot_cold_t) noexcept;
+void *operator new[](size_t, const std::nothrow_t &, __hot_cold_t) noexcept;
+void *operator new(size_t, std::align_val_t, __hot_cold_t);
+void *operator new[](size_t, std::align_val_t, __hot_cold_t);
+void *operator new(size_t, std::align_val_t, const std::nothrow_t &,
+                   __hot_cold_t) noexcept;
+void *operator new[](size_t, std::align_val_t, const std::nothrow_t &,
+                     __hot_cold_t) noexcept;
+
 extern "C" {
 #ifndef SCUDO_ENABLE_HOOKS_TESTS
 #define SCUDO_ENABLE_HOOKS_TESTS 0
@@ -158,6 +173,65 @@ TEST_F(ScudoWrappersCppDeathTest, New) {
   testCxxNew<Pixel>();
 }
 
+TEST_F(ScudoWrappersCppTest, HotColdNew) {
+  const __hot_cold_t Hints[] = {__hot_cold_t(0), __hot_cold_t(255)};
+  const size_t Sizes[] = {1U, 1U << 16};
+  const size_t Alignment = 64U;
+
+  auto Verify = [this](void *P, size_t Size, size_t Align) {
+    EXPECT_NE(P, nullptr);
+    EXPECT_TRUE(scudo::isAligned(reinterpret_cast<scudo::uptr>(P), Align));
+    verifyAllocHookPtr(P);
+    verifyAllocHookSize(Size);
+    memset(P, 0x42, Size);
+  };
+
+  for (__hot_cold_t Hint : Hints) {
+    for (size_t Size : Sizes) {
+      void *P = operator new(Size, Hint);
+      Verify(P, Size, sizeof(void *));
+      operator delete(P);
+      verifyDeallocHookPtr(P);
+
+      P = operator new[](Size, Hint);
+      Verify(P, Size, sizeof(void *));
+      operator delete[](P);
+      verifyDeallocHookPtr(P);
+
+      P = operator new(Size, std::nothrow, Hint);
+      Verify(P, Size, sizeof(void *));
+      operator delete(P);
+      verifyDeallocHookPtr(P);
+
+      P = operator new[](Size, std::nothrow, Hint);
+      Verify(P, Size, sizeof(void *));
+      operator delete[](P);
+      verifyDeallocHookPtr(P);
+
+      P = operator new(Size, std::align_val_t(Alignment), Hint);
+      Verify(P, Size, Alignment);
+      operator delete(P, std::align_val_t(Alignment));
+      verifyDeallocHookPtr(P);
+
+      P = operator new[](Size, std::align_val_t(Alignment), Hint);
+      Verify(P, Size, Alignment);
+      operator delete[](P, std::align_val_t(Alignment));
+      verifyDeallocHookPtr(P);
+
+      P = operator new(Size, std::align_val_t(Alignment), std::nothrow, Hint);
+      Verify(P, Size, Alignment);
+      operator delete(P, std::align_val_t(Alignment));
+      verifyDeallocHookPtr(P);
+
+      P = operator new[](Size, std::align_val_t(Alignment), std::nothrow,
+                         Hint);
+      Verify(P, Size, Alignment);
+      operator delete[](P, std::align_val_t(Alignment));
+      verifyDeallocHookPtr(P);
+    }
+  }
+}
+
 static std::mutex Mutex;
 static std::condition_variable Cv;
 static bool Ready;
@@ -31,7 +31,7 @@ struct TSDRegistrySharedT {
     Instance->init();
     for (u32 I = 0; I < TSDsArraySize; I++)
       TSDs[I].init(Instance);
-    const u32 NumberOfCPUs = getNumberOfCPUs();
+    NumberOfCPUs = getNumberOfCPUs();
     setNumberOfTSDs((NumberOfCPUs == 0) ? DefaultTSDCount
                                         : Min(NumberOfCPUs, DefaultTSDCount));
     Initialized = true;
@@ -178,11 +178,32 @@ private:
     *getTlsPtr() |= B;
   }
 
+  // Returns the TSD associated with the CPU the thread is running on, or null
+  // if the platform can't tell. Threads running on the same CPU at different
+  // times share a TSD, so its lock is rarely contended and the cache memory is
+  // bounded by the number of CPUs rather than the number of threads. If more
+  // TSDs than CPUs were requested, they are spread over the threads instead.
+  ALWAYS_INLINE TSD<Allocator> *getCPUTSD(u32 N) {
+    if (N > NumberOfCPUs)
+      return nullptr;
+    const s32 CPU = getCurrentCPU();
+    if (CPU < 0)
+      return nullptr;
+    return &TSDs[static_cast<u32>(CPU) % N];
+  }
+
   NOINLINE void initThread(Allocator *Instance) NO_THREAD_SAFETY_ANALYSIS {
     initOnceMaybe(Instance);
-    // Initial context assignment is done in a plain round-robin fashion.
-    const u32 Index = atomic_fetch_add(&CurrentIndex, 1U, memory_order_relaxed);
-    setCurrentTSD(&TSDs[Index % NumberOfTSDs]);
+    // Initial context assignment follows the current CPU when it is known, and
+    // is otherwise done in a plain round-robin fashion.
+    TSD<Allocator> *CPUTSD = getCPUTSD(NumberOfTSDs);
+    if (CPUTSD) {
+      setCurrentTSD(CPUTSD);
+    } else {
+      const u32 Index =
+          atomic_fetch_add(&CurrentIndex, 1U, memory_order_relaxed);
+      setCurrentTSD(&TSDs[Index % NumberOfTSDs]);
+    }
     Instance->callPostInitCallback();
   }
 
@@ -202,6 +223,13 @@ private:
       Inc = CoPrimes[R % NumberOfCoPrimes];
     }
     if (N > 1U) {
+      // The thread has likely migrated since it picked its TSD: first try the
+      // one of the CPU it is running on now.
+      TSD<Allocator> *CPUTSD = getCPUTSD(N);
+      if (CPUTSD && CPUTSD != CurrentTSD && CPUTSD->tryLock()) {
+        setCurrentTSD(CPUTSD);
+        return CPUTSD;
+      }
       u32 Index = R % N;
       uptr LowestPrecedence = UINTPTR_MAX;
       TSD<Allocator> *CandidateTSD = nullptr;
@@ -233,6 +261,7 @@ private:
   }
 
   atomic_u32 CurrentIndex = {};
+  u32 NumberOfCPUs = 0;
   u32 NumberOfTSDs GUARDED_BY(MutexTSDs) = 0;
   u32 NumberOfCoPrimes GUARDED_BY(MutexTSDs) = 0;
   u32 CoPrimes[TSDsArraySize] GUARDED_BY(MutexTSDs) = {};
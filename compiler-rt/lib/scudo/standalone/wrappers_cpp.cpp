@@ -24,6 +24,12 @@ struct nothrow_t {};
 enum class align_val_t : size_t {};
 } // namespace std
 
+// Hotness hint of the operator new extension used by MemProf, where 0 is the
+// coldest and 255 the hottest value. The hint is accepted so that programs
+// rewritten to use it link against Scudo, but it does not change where the
+// chunk is allocated.
+enum class __hot_cold_t : uint8_t {};
+
 static void reportAllocation(void *ptr, size_t size) {
   if (SCUDO_ENABLE_HOOKS)
     if (__scudo_allocate_hook && ptr)
@@ -84,6 +90,59 @@ INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
   return Ptr;
 }
 
+INTERFACE WEAK void *operator new(size_t size, __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::nothrow_t const &,
+                                  __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::nothrow_t const &,
+                                    __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  std::nothrow_t const &,
+                                  __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    std::nothrow_t const &,
+                                    __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+
 INTERFACE WEAK void operator delete(void *ptr) NOEXCEPT {
   reportDeallocation(ptr);
   Allocator.deallocate(ptr, scudo::Chunk::Origin::New);
@@ -76,6 +76,14 @@ void OnInitialize() {
 }
 #endif
 
+// Returns true if the trace parts allocated so far reached the limit set by
+// history_memory_limit_mb.
+static bool TracePartLimitReached() SANITIZER_REQUIRES(ctx->slot_mtx) {
+  uptr limit_mb = flags()->history_memory_limit_mb;
+  return limit_mb &&
+         ctx->trace_part_total_allocated * sizeof(TracePart) >= limit_mb << 20;
+}
+
 static TracePart* TracePartAlloc(ThreadState* thr) {
   TracePart* part = nullptr;
   {
@@ -83,7 +91,7 @@ static TracePart* TracePartAlloc(ThreadState* thr) {
     uptr max_parts = Trace::kMinParts + flags()->history_size;
     Trace* trace = &thr->tctx->trace;
     if (trace->parts_allocated == max_parts ||
-        ctx->trace_part_finished_excess) {
+        ctx->trace_part_finished_excess || TracePartLimitReached()) {
       part = ctx->trace_part_recycle.PopFront();
       DPrintf("#%d: TracePartAlloc: part=%p\n", thr->tid, part);
       if (part && part->trace) {
@@ -962,8 +970,12 @@ void TraceSwitchPartImpl(ThreadState* thr) {
   thr->trace_prev_pc = 0;
   TracePart* recycle = nullptr;
   // Keep roughly half of parts local to the thread
-  // (not queued into the recycle queue).
-  uptr local_parts = (Trace::kMinParts + flags()->history_size + 1) / 2;
+  // (not queued into the recycle queue). With a history memory limit only
+  // the current part is kept, so that the parts of idle threads can be
+  // reused by the busy ones.
+  uptr local_parts = flags()->history_memory_limit_mb
+                         ? 1
+                         : (Trace::kMinParts + flags()->history_size + 1) / 2;
   {
     Lock lock(&trace->mtx);
     if (trace->parts.Empty())
@@ -973,6 +985,10 @@ void TraceSwitchPartImpl(ThreadState* thr) {
       trace->local_head = trace->parts.Next(recycle);
     }
     trace->parts.PushBack(part);
+    // With a single local part the recycled part was the last one, and the
+    // new part is the only local one left.
+    if (!trace->local_head)
+      trace->local_head = part;
     atomic_store_relaxed(&thr->trace_pos,
                          reinterpret_cast<uptr>(&part->events[0]));
   }
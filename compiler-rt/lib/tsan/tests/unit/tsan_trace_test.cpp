@@ -338,4 +338,32 @@ TRACE_TEST(TraceAlloc, FinishedThreadReuse2) {
   }
 }
 
+TRACE_TEST(TraceAlloc, MemoryLimit) {
+  TraceResetForTesting();
+  // Allow 4 parts.
+  constexpr uptr kLimitParts = 4;
+  static_assert(((kLimitParts * sizeof(TracePart)) & ((1 << 20) - 1)) == 0,
+                "limit must be a whole number of MB");
+  uptr old_limit = flags()->history_memory_limit_mb;
+  flags()->history_memory_limit_mb = kLimitParts * sizeof(TracePart) >> 20;
+  constexpr uptr Min = Trace::kMinParts;
+  constexpr uptr kThreads = 8;
+  ThreadArray<kThreads> threads;
+  for (uptr i = 0; i < kThreads; i++) {
+    for (uptr j = 0; j < Min; j++) TraceSwitchPartImpl(threads[i]);
+    {
+      // Only the current part is local to the thread.
+      Trace* trace = &threads[i]->tctx->trace;
+      Lock l(&trace->mtx);
+      CHECK_EQ(trace->local_head, trace->parts.Back());
+    }
+    // Without the limit every thread would allocate Min parts. With it, parts
+    // are mostly taken over from the other threads.
+    Lock l(&ctx->slot_mtx);
+    CHECK_LE(ctx->trace_part_total_allocated, kLimitParts + i);
+  }
+  for (uptr i = 0; i < kThreads; i++) threads.Finish(i);
+  flags()->history_memory_limit_mb = old_limit;
+}
+
 }  // namespace __tsan
@@ -106,6 +106,49 @@ TEST(BufferQueueTest, MultiThreaded) {
   F();
 }
 
+TEST(BufferQueueTest, NoBufferHandedOutTwice) {
+  // Contend on few buffers, and check that no two threads ever hold the same
+  // one.
+  constexpr size_t kBuffers = 4;
+  bool Success = false;
+  BufferQueue Buffers(kSize, kBuffers, Success);
+  ASSERT_TRUE(Success);
+  std::atomic<int> Fails{0};
+  std::atomic<uint64_t> Acquired{0};
+  auto F = [&] {
+    BufferQueue::Buffer B;
+    for (int I = 0; I < 20000; ++I) {
+      if (Buffers.getBuffer(B) != BufferQueue::ErrorCode::Ok)
+        continue;
+      Acquired.fetch_add(1, std::memory_order_relaxed);
+      auto *Owner = reinterpret_cast<std::atomic<int> *>(B.Data);
+      if (Owner->exchange(1, std::memory_order_acq_rel) != 0)
+        Fails.fetch_add(1, std::memory_order_relaxed);
+      Owner->store(0, std::memory_order_release);
+      if (Buffers.releaseBuffer(B) != BufferQueue::ErrorCode::Ok)
+        Fails.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+  std::thread T0(F), T1(F), T2(F), T3(F), T4(F), T5(F);
+  T0.join();
+  T1.join();
+  T2.join();
+  T3.join();
+  T4.join();
+  T5.join();
+  EXPECT_EQ(Fails.load(), 0);
+  EXPECT_GT(Acquired.load(), 0u);
+
+  // Every buffer is available again.
+  BufferQueue::Buffer Held[kBuffers];
+  for (auto &B : Held)
+    ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+  BufferQueue::Buffer Extra;
+  EXPECT_EQ(Buffers.getBuffer(Extra), BufferQueue::ErrorCode::NotEnoughMemory);
+  for (auto &B : Held)
+    ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+}
+
 TEST(BufferQueueTest, Apply) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
@@ -120,6 +163,36 @@ TEST(BufferQueueTest, Apply) {
   ASSERT_EQ(Count, 10);
 }
 
+TEST(BufferQueueTest, ApplyWhileReleasing) {
+  // apply() reads the slots that getBuffer() and releaseBuffer() write without
+  // the lock; it must wait for those calls instead of racing with them.
+  bool Success = false;
+  BufferQueue Buffers(kSize, 4, Success);
+  ASSERT_TRUE(Success);
+  std::atomic<bool> Done{false};
+  std::atomic<int> Fails{0};
+  auto F = [&] {
+    BufferQueue::Buffer B;
+    while (!Done.load(std::memory_order_relaxed)) {
+      if (Buffers.getBuffer(B) != BufferQueue::ErrorCode::Ok)
+        continue;
+      if (Buffers.releaseBuffer(B) != BufferQueue::ErrorCode::Ok)
+        Fails.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+  std::thread T0(F), T1(F), T2(F);
+  for (int I = 0; I < 1000; ++I) {
+    size_t Count = 0;
+    Buffers.apply([&](const BufferQueue::Buffer &B) { Count += B.Size != 0; });
+    EXPECT_LE(Count, 4u);
+  }
+  Done.store(true, std::memory_order_relaxed);
+  T0.join();
+  T1.join();
+  T2.join();
+  EXPECT_EQ(Fails.load(), 0);
+}
+
 TEST(BufferQueueTest, GenerationalSupport) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
@@ -65,14 +65,58 @@ struct ExtentsPadded {
 
 constexpr size_t kExtentsSize = sizeof(ExtentsPadded);
 
+// Flags in the top bits of BufferQueue::Users. init() replaces the slots, so
+// calls that start while it runs leave them alone. apply() only reads the
+// slots, so calls that start while it runs wait for it to finish.
+constexpr uint64_t kUsersInitializing = 1ULL << 63;
+constexpr uint64_t kUsersApplying = 1ULL << 62;
+
 } // namespace
 
+bool BufferQueue::enterUser() {
+  for (;;) {
+    uint64_t U = atomic_fetch_add(&Users, 1, memory_order_acq_rel);
+    if (!(U & (kUsersInitializing | kUsersApplying)))
+      return true;
+    exitUser();
+    if (U & kUsersInitializing)
+      return false;
+    while (atomic_load(&Users, memory_order_acquire) & kUsersApplying)
+      internal_sched_yield();
+  }
+}
+
+void BufferQueue::exitUser() {
+  atomic_fetch_sub(&Users, 1, memory_order_acq_rel);
+}
+
+void BufferQueue::drainUsers(uint64_t Flag) {
+  atomic_fetch_add(&Users, Flag, memory_order_acq_rel);
+  while (atomic_load(&Users, memory_order_acquire) != Flag)
+    internal_sched_yield();
+}
+
+void BufferQueue::undrainUsers(uint64_t Flag) {
+  atomic_fetch_sub(&Users, Flag, memory_order_acq_rel);
+}
+
+void BufferQueue::beginApply() { drainUsers(kUsersApplying); }
+
+void BufferQueue::endApply() { undrainUsers(kUsersApplying); }
+
 BufferQueue::ErrorCode BufferQueue::init(size_t BS, size_t BC) {
   SpinMutexLock Guard(&Mutex);
 
   if (!finalizing())
     return BufferQueue::ErrorCode::AlreadyInitialized;
 
+  // Wait for the threads still releasing buffers into the current slots. Any
+  // call starting from now on sees the initializing bit and leaves the slots
+  // alone.
+  drainUsers(kUsersInitializing);
+  auto ClearInitializing =
+      at_scope_exit([this] { undrainUsers(kUsersInitializing); });
+
   cleanupBuffers();
 
   bool Success = false;
@@ -132,11 +176,12 @@ BufferQueue::ErrorCode BufferQueue::init(size_t BS, size_t BC) {
     Buf.ExtentsBackingStore = ExtentsBackingStore;
     Buf.Count = BufferCount;
     T.Used = false;
+    // All buffers start out available, as if released at position i.
+    atomic_store(&T.Sequence, i + 1, memory_order_relaxed);
   }
 
-  Next = Buffers;
-  First = Buffers;
-  LiveBuffers = 0;
+  atomic_store(&DequeuePos, 0, memory_order_relaxed);
+  atomic_store(&EnqueuePos, BufferCount, memory_order_relaxed);
   atomic_store(&Finalizing, 0, memory_order_release);
   Success = true;
   return BufferQueue::ErrorCode::Ok;
@@ -148,12 +193,12 @@ BufferQueue::BufferQueue(size_t B, size_t N,
       BufferCount(N),
       Mutex(),
       Finalizing{1},
+      Users{0},
       BackingStore(nullptr),
       ExtentsBackingStore(nullptr),
       Buffers(nullptr),
-      Next(Buffers),
-      First(Buffers),
-      LiveBuffers(0),
+      DequeuePos{0},
+      EnqueuePos{0},
       Generation{0} {
   Success = init(B, N) == BufferQueue::ErrorCode::Ok;
 }
@@ -161,16 +206,31 @@ BufferQueue::BufferQueue(size_t B, size_t N,
 BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
   if (atomic_load(&Finalizing, memory_order_acquire))
     return ErrorCode::QueueFinalizing;
+  if (!enterUser())
+    return ErrorCode::QueueFinalizing;
+  auto Exit = at_scope_exit([this] { exitUser(); });
 
+  // The slots form a bounded multi-producer/multi-consumer queue of the
+  // available buffers. A thread claims the slot at DequeuePos once the buffer
+  // released into it has been published.
   BufferRep *B = nullptr;
-  {
-    SpinMutexLock Guard(&Mutex);
-    if (LiveBuffers == BufferCount)
-      return ErrorCode::NotEnoughMemory;
-    B = Next++;
-    if (Next == (Buffers + BufferCount))
-      Next = Buffers;
-    ++LiveBuffers;
+  atomic_uint64_t::Type Pos = atomic_load(&DequeuePos, memory_order_relaxed);
+  for (;;) {
+    B = &Buffers[Pos % BufferCount];
+    uint64_t Seq = atomic_load(&B->Sequence, memory_order_acquire);
+    if (Seq == Pos + 1) {
+      if (atomic_compare_exchange_weak(&DequeuePos, &Pos, Pos + 1,
+                                       memory_order_relaxed))
+        break;
+    } else if (Seq < Pos + 1) {
+      // All buffers are handed out, unless a release of this slot is still in
+      // progress.
+      if (atomic_load(&EnqueuePos, memory_order_acquire) <= Pos)
+        return ErrorCode::NotEnoughMemory;
+      Pos = atomic_load(&DequeuePos, memory_order_relaxed);
+    } else {
+      Pos = atomic_load(&DequeuePos, memory_order_relaxed);
+    }
   }
 
   incRefCount(BackingStore);
@@ -178,30 +238,53 @@ BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
   Buf = B->Buff;
   Buf.Generation = generation();
   B->Used = true;
+  // Hand the slot to the release at position Pos + BufferCount.
+  atomic_store(&B->Sequence, Pos + BufferCount, memory_order_release);
   return ErrorCode::Ok;
 }
 
 BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
+  auto ReleaseStale = [&Buf] {
+    decRefCount(Buf.BackingStore, Buf.Size, Buf.Count);
+    decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
+    Buf = {};
+    return BufferQueue::ErrorCode::Ok;
+  };
+  // Buffers of a previous generation only drop their references; the slots
+  // they came from are gone.
+  if (!enterUser())
+    return ReleaseStale();
+  auto Exit = at_scope_exit([this] { exitUser(); });
+  if (Buf.Generation != generation())
+    return ReleaseStale();
+
   // Check whether the buffer being referred to is within the bounds of the
   // backing store's range.
+  if (Buf.Data < &BackingStore->Data ||
+      Buf.Data > &BackingStore->Data + (BufferCount * BufferSize))
+    return BufferQueue::ErrorCode::UnrecognizedBuffer;
+
   BufferRep *B = nullptr;
-  {
-    SpinMutexLock Guard(&Mutex);
-    if (Buf.Generation != generation() || LiveBuffers == 0) {
-      Buf = {};
-      decRefCount(Buf.BackingStore, Buf.Size, Buf.Count);
-      decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
-      return BufferQueue::ErrorCode::Ok;
+  atomic_uint64_t::Type Pos = atomic_load(&EnqueuePos, memory_order_relaxed);
+  for (;;) {
+    B = &Buffers[Pos % BufferCount];
+    uint64_t Seq = atomic_load(&B->Sequence, memory_order_acquire);
+    if (Seq == Pos) {
+      if (atomic_compare_exchange_weak(&EnqueuePos, &Pos, Pos + 1,
+                                       memory_order_relaxed))
+        break;
+    } else if (Seq < Pos) {
+      // If every buffer is already available this one can't be ours.
+      // Otherwise the buffer of this slot is still being handed out. Load the
+      // enqueue position first: while we hold a buffer of this queue, the
+      // difference can then never reach BufferCount.
+      Pos = atomic_load(&EnqueuePos, memory_order_acquire);
+      s64 Available = Pos - atomic_load(&DequeuePos, memory_order_acquire);
+      if (Available >= static_cast<s64>(BufferCount))
+        return ReleaseStale();
+    } else {
+      Pos = atomic_load(&EnqueuePos, memory_order_relaxed);
     }
-
-    if (Buf.Data < &BackingStore->Data ||
-        Buf.Data > &BackingStore->Data + (BufferCount * BufferSize))
-      return BufferQueue::ErrorCode::UnrecognizedBuffer;
-
-    --LiveBuffers;
-    B = First++;
-    if (First == (Buffers + BufferCount))
-      First = Buffers;
   }
 
   // Now that the buffer has been released, we mark it as "used".
@@ -211,6 +294,8 @@ BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
   decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
   atomic_store(B->Buff.Extents, atomic_load(Buf.Extents, memory_order_acquire),
                memory_order_release);
+  // Publish the buffer to the getBuffer at position Pos.
+  atomic_store(&B->Sequence, Pos + 1, memory_order_release);
   Buf = {};
   return ErrorCode::Ok;
 }
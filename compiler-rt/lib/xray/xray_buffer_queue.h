@@ -71,6 +71,12 @@ public:
     // This is true if the buffer has been returned to the available queue, and
     // is considered "used" by another thread.
     bool Used = false;
+
+    // Position-based ticket which tells getBuffer and releaseBuffer whether
+    // this slot currently holds an available buffer (Sequence == Pos + 1 for
+    // the dequeue position Pos) or is free to receive a released buffer
+    // (Sequence == Pos for the enqueue position Pos).
+    atomic_uint64_t Sequence;
   };
 
 private:
@@ -137,9 +143,16 @@ private:
   // Amount of pre-allocated buffers.
   size_t BufferCount;
 
+  // Serializes init() and apply(). getBuffer() and releaseBuffer() do not take
+  // the lock.
   SpinMutex Mutex;
   atomic_uint8_t Finalizing;
 
+  // Number of getBuffer/releaseBuffer calls currently accessing the slots. The
+  // top bits are set by init() while it replaces the slots and by apply()
+  // while it reads them.
+  atomic_uint64_t Users;
+
   // The collocated ControlBlock and buffer storage.
   ControlBlock *BackingStore;
 
@@ -149,15 +162,13 @@ private:
   // A dynamically allocated array of BufferRep instances.
   BufferRep *Buffers;
 
-  // Pointer to the next buffer to be handed out.
-  BufferRep *Next;
+  // Monotonic position of the next buffer to be handed out. The slot is at
+  // index (DequeuePos % BufferCount).
+  atomic_uint64_t DequeuePos;
 
-  // Pointer to the entry in the array where the next released buffer will be
+  // Monotonic position of the slot where the next released buffer will be
   // placed.
-  BufferRep *First;
-
-  // Count of buffers that have been handed out through 'getBuffer'.
-  size_t LiveBuffers;
+  atomic_uint64_t EnqueuePos;
 
   // We use a generation number to identify buffers and which generation they're
   // associated with.
@@ -166,6 +177,20 @@ private:
   /// Releases references to the buffers backed by the current buffer queue.
   void cleanupBuffers();
 
+  /// Registers a getBuffer/releaseBuffer call. Returns false, without
+  /// registering, if init() is replacing the buffers. Waits while apply() is
+  /// reading them.
+  bool enterUser();
+  void exitUser();
+
+  /// Sets |Flag| in Users and waits for all registered calls to finish.
+  void drainUsers(uint64_t Flag);
+  void undrainUsers(uint64_t Flag);
+
+  /// Gives apply() exclusive access to the slots.
+  void beginApply();
+  void endApply();
+
 public:
   enum class ErrorCode : unsigned {
     Ok,
@@ -254,8 +279,12 @@ public:
   /// releaseBuffer(...) operation).
   template <class F> void apply(F Fn) XRAY_NEVER_INSTRUMENT {
     SpinMutexLock G(&Mutex);
+    // Wait for in-flight getBuffer/releaseBuffer calls, which write the slots
+    // without taking the lock, and hold off new ones until we're done.
+    beginApply();
     for (auto I = begin(), E = end(); I != E; ++I)
       Fn(*I);
+    endApply();
   }
 
   using const_iterator = Iterator<const Buffer>;
@@ -0,0 +1,24 @@
+// Check that with heap sampling, unsampled chunks bypass the quarantine and are
+// reused right after free.
+// RUN: %clangxx_asan -O0 %s -o %t
+// RUN: %run %t 2>&1 | FileCheck %s --check-prefix=CHECK-FULL
+// RUN: %env_asan_opts=heap_sample_rate=1 %run %t 2>&1 | FileCheck %s --check-prefix=CHECK-FULL
+// RUN: %env_asan_opts=heap_sample_rate=1000000 %run %t 2>&1 | FileCheck %s --check-prefix=CHECK-SAMPLED
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int main() {
+  // The first allocation of a thread is always sampled, make sure it is not
+  // one of the allocations below.
+  free(malloc(32));
+
+  char *volatile p = (char *)malloc(32);
+  free(p);
+  char *volatile q = (char *)malloc(32);
+  fprintf(stderr, q == p ? "reused\n" : "not reused\n");
+  // CHECK-FULL: not reused
+  // CHECK-SAMPLED: reused
+  free(q);
+  return 0;
+}
@@ -0,0 +1,20 @@
+// Check that errors on unsampled chunks are reported, even though their stacks
+// are not recorded.
+// RUN: %clangxx_asan -O0 %s -o %t
+// RUN: %env_asan_opts=heap_sample_rate=1000000 not %run %t 2>&1 | FileCheck %s
+
+#include <stdlib.h>
+
+int main() {
+  // The first allocation of a thread is always sampled, make sure it is not
+  // the one below.
+  free(malloc(32));
+
+  // Unsampled chunks keep their partial right redzone.
+  char *volatile p = (char *)malloc(10);
+  return p[10];
+  // CHECK: ERROR: AddressSanitizer: heap-buffer-overflow
+  // CHECK: is located 0 bytes after 10-byte region
+  // CHECK: allocated by thread T0 here:
+  // CHECK-NEXT: <not recorded>
+}
@@ -0,0 +1,27 @@
+// REQUIRES: linux
+
+// Each DSO appends its own raw profile to the shared file and keeps its
+// counters mapped onto it, so the file can be read while the process runs.
+
+// RUN: echo "void dso1(void) {}" > %t.dso1.c
+// RUN: echo "void dso2(void) {}" > %t.dso2.c
+// RUN: %clang_pgogen -fPIC -shared -mllvm -runtime-counter-relocation=true -o %t.dso1.so %t.dso1.c
+// RUN: %clang_pgogen -fPIC -shared -mllvm -runtime-counter-relocation=true -o %t.dso2.so %t.dso2.c
+// RUN: %clang_pgogen -mllvm -runtime-counter-relocation=true -o %t.exe %s %t.dso1.so %t.dso2.so
+// RUN: env LLVM_PROFILE_FILE="%c%t.profraw" %run %t.exe 2>&1 | count 0
+// RUN: llvm-profdata show --counts --all-functions %t.profraw | FileCheck %s
+
+// CHECK-LABEL: Counters:
+// CHECK-DAG:   dso1:
+// CHECK-DAG:   dso2:
+// CHECK-DAG:   main:
+// CHECK: Functions shown: 3
+
+void dso1(void);
+void dso2(void);
+
+int main() {
+  dso1();
+  dso2();
+  return 0;
+}
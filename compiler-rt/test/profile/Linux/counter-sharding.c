@@ -0,0 +1,31 @@
+// Counters incremented by several threads are kept in per-thread shards which
+// are summed into the profile when it is written.
+
+// RUN: %clang_profgen -pthread -mllvm -instrprof-counter-sharding -o %t %s
+// RUN: env LLVM_PROFILE_FILE=%t.profraw LLVM_PROFILE_COUNTER_SHARDS=4 %run %t
+// RUN: llvm-profdata show --counts --function=work %t.profraw | FileCheck %s
+
+// CHECK:      work:
+// CHECK-NEXT:   Hash: 0x{{.*}}
+// CHECK-NEXT:   Counters: 2
+// CHECK-NEXT:   Function count: 8
+// CHECK-NEXT:   Block counts: [8000]
+
+#include <pthread.h>
+
+static volatile int Sink;
+
+void *work(void *Arg) {
+  for (int I = 0; I < 1000; ++I)
+    Sink += I;
+  return Arg;
+}
+
+int main() {
+  pthread_t Threads[8];
+  for (int I = 0; I < 8; ++I)
+    pthread_create(&Threads[I], 0, work, 0);
+  for (int I = 0; I < 8; ++I)
+    pthread_join(Threads[I], 0);
+  return 0;
+}
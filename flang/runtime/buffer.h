@@ -144,7 +144,12 @@ private:
     if (bytes > size_) {
       char *old{buffer_};
       auto oldSize{size_};
-      size_ = std::max<std::int64_t>(bytes, size_ + minBuffer);
+      // Grow geometrically.  A sequential unformatted record must stay in the
+      // buffer until its header is written, so a large record built up by
+      // many small transfers would otherwise be copied again after every
+      // minBuffer bytes.
+      size_ = std::max<std::int64_t>(
+          bytes, size_ + std::max<std::int64_t>(size_, minBuffer));
       buffer_ =
           reinterpret_cast<char *>(AllocateMemoryOrCrash(terminator, size_));
       auto chunk{std::min<std::int64_t>(length_, oldSize - start_)};
@@ -25,6 +25,8 @@
 #include "tools.h"
 #include "flang/Runtime/cpp-type.h"
 #include "flang/Runtime/descriptor.h"
+#include <type_traits>
+#include <utility>
 
 namespace Fortran::runtime {
 
@@ -36,6 +38,17 @@ namespace Fortran::runtime {
 // array and does something with a scalar element, and a GetResult()
 // member function that copies a final result into its destination.
 
+// Accumulators whose result does not depend on the positions of the elements
+// may also support an Accumulate() member function that takes an element by
+// value.  DoTotalReduction() uses it to traverse a contiguous array with a
+// plain pointer, without computing subscripts and offsets for each element.
+template <typename ACCUMULATOR, typename TYPE, typename = void>
+struct HasElementAccumulate : std::false_type {};
+template <typename ACCUMULATOR, typename TYPE>
+struct HasElementAccumulate<ACCUMULATOR, TYPE,
+    std::void_t<decltype(std::declval<ACCUMULATOR &>().Accumulate(
+        std::declval<const TYPE &>()))>> : std::true_type {};
+
 // Total reduction of the array argument to a scalar (or to a vector in the
 // cases of FINDLOC, MAXLOC, & MINLOC).  These are the cases without DIM= or
 // cases where the argument has rank 1 and DIM=, if present, must be 1.
@@ -68,6 +81,17 @@ inline void DoTotalReduction(const Descriptor &x, int dim,
     }
   }
   // No MASK=, or scalar MASK=.TRUE.
+  if constexpr (HasElementAccumulate<ACCUMULATOR, TYPE>::value) {
+    if (x.ElementBytes() == sizeof(TYPE) && x.IsContiguous()) {
+      const TYPE *p{x.OffsetElement<TYPE>()};
+      for (auto elements{x.Elements()}; elements--; ++p) {
+        if (!accumulator.Accumulate(*p)) {
+          break; // cut short, result is known
+        }
+      }
+      return;
+    }
+  }
   for (auto elements{x.Elements()}; elements--; x.IncrementSubscripts(xAt)) {
     if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
       break; // cut short, result is known
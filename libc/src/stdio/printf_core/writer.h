@@ -42,13 +42,26 @@ struct WriteBuffer {
 
   // The overflow_write method is intended to be called to write the contents of
   // the buffer and new_str to the stream_writer if it exists, else it will
-  // write as much of new_str to the buffer as it can. The current position in
-  // the buffer will be reset iff stream_writer is called. Calling this with an
+  // write as much of new_str to the buffer as it can. Calling this with an
   // empty string will flush the buffer if relevant.
   int overflow_write(cpp::string_view new_str) {
     // If there is a stream_writer, write the contents of the buffer, then
     // new_str, then clear the buffer.
     if (stream_writer != nullptr) {
+      // A string shorter than the buffer is split instead of being written on
+      // its own: the head tops off the buffer, which is flushed, and the tail
+      // starts the next buffer. This way the stream is handed one full buffer
+      // per call rather than a partial buffer followed by a short string.
+      cpp::string_view tail;
+      if (new_str.size() < buff_len) {
+        size_t head_len = buff_len - buff_cur;
+        if (head_len > new_str.size())
+          head_len = new_str.size();
+        inline_memcpy(buff + buff_cur, new_str.data(), head_len);
+        buff_cur += head_len;
+        tail = new_str.substr(head_len);
+        new_str = cpp::string_view();
+      }
       if (buff_cur > 0) {
         int retval = stream_writer({buff, buff_cur}, output_target);
         if (retval < 0) {
@@ -61,7 +74,8 @@ struct WriteBuffer {
           return retval;
         }
       }
-      buff_cur = 0;
+      inline_memcpy(buff, tail.data(), tail.size());
+      buff_cur = tail.size();
       return WRITE_OK;
     } else {
       // We can't flush to the stream, so fill the rest of the buffer, then drop
@@ -308,3 +308,45 @@ TEST(LlvmLibcPrintfWriterTest, NullStringWithZeroMaxLengthWithCallback) {
   ASSERT_EQ(writer.get_chars_written(), 12);
   ASSERT_STREQ("aaaDEF111456", str);
 }
+
+struct CountingOutBuff {
+  char *out_str;
+  size_t cur_pos = 0;
+  size_t num_writes = 0;
+};
+
+int count_and_copy_to_out(string_view new_str, void *raw_out_buff) {
+  CountingOutBuff *out_buff = reinterpret_cast<CountingOutBuff *>(raw_out_buff);
+  __llvm_libc::inline_memcpy(out_buff->out_str + out_buff->cur_pos,
+                             new_str.data(), new_str.size());
+  out_buff->cur_pos += new_str.size();
+  ++out_buff->num_writes;
+  return 0;
+}
+
+TEST(LlvmLibcPrintfWriterTest, ShortWritesFlushFullBuffers) {
+  char str[32];
+
+  CountingOutBuff out_buff = {str};
+
+  char wb_buff[8];
+  WriteBuffer wb(wb_buff, sizeof(wb_buff), &count_and_copy_to_out,
+                 reinterpret_cast<void *>(&out_buff));
+  Writer writer(&wb);
+  writer.write({"abcde", 5});
+  writer.write({"fghij", 5});
+  writer.write({"klmno", 5});
+  writer.write({"pqrst", 5});
+
+  // Only the two full buffers have been handed to the stream so far.
+  ASSERT_EQ(out_buff.num_writes, size_t(2));
+  ASSERT_EQ(out_buff.cur_pos, size_t(16));
+
+  // Flush the buffer
+  wb.overflow_write("");
+  str[out_buff.cur_pos] = '\0';
+
+  ASSERT_STREQ("abcdefghijklmnopqrst", str);
+  ASSERT_EQ(out_buff.num_writes, size_t(3));
+  ASSERT_EQ(writer.get_chars_written(), 20);
+}
@@ -0,0 +1,31 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Every element has to be inspected, so there is no early exit to hide the
+// cost of the comparison loop.
+template <class T>
+static void bm_count(benchmark::State& state) {
+  std::vector<T> vec(state.range(), '1');
+  for (size_t i = 0; i < vec.size(); i += 3)
+    vec[i] = '2';
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec);
+    benchmark::DoNotOptimize(std::count(vec.begin(), vec.end(), T('2')));
+  }
+}
+BENCHMARK(bm_count<char>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_count<short>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_count<int>)->DenseRange(1, 8)->Range(16, 1 << 20);
+BENCHMARK(bm_count<long long>)->DenseRange(1, 8)->Range(16, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <latch>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+// Two threads hand a token back and forth through atomic wait/notify. Every
+// iteration is a full round trip, so the result is dominated by the cost of
+// blocking and waking.
+//
+// On Linux 4-byte atomics are waited on directly, while other sizes go
+// through the contention table; the two instantiations cover both paths.
+template <class T>
+static void BM_atomic_wait_ping_pong(benchmark::State& state) {
+  std::atomic<T> a(0);
+  std::atomic<bool> done(false);
+  std::thread partner([&] {
+    T expected = 1;
+    while (true) {
+      a.wait(expected - 1);
+      if (done.load(std::memory_order_relaxed))
+        return;
+      a.store(expected + 1);
+      a.notify_one();
+      expected += 2;
+    }
+  });
+
+  T next = 1;
+  for (auto _ : state) {
+    a.store(next);
+    a.notify_one();
+    a.wait(next);
+    next += 2;
+  }
+
+  done.store(true, std::memory_order_relaxed);
+  a.store(next);
+  a.notify_one();
+  partner.join();
+}
+BENCHMARK(BM_atomic_wait_ping_pong<std::uint32_t>)->UseRealTime();
+BENCHMARK(BM_atomic_wait_ping_pong<std::uint64_t>)->UseRealTime();
+
+// Notifying an atomic nobody waits on. This should never need a system call.
+template <class T>
+static void BM_atomic_notify_no_waiters(benchmark::State& state) {
+  std::atomic<T> a(0);
+  for (auto _ : state) {
+    a.fetch_add(1, std::memory_order_relaxed);
+    a.notify_all();
+  }
+}
+BENCHMARK(BM_atomic_notify_no_waiters<std::uint32_t>);
+BENCHMARK(BM_atomic_notify_no_waiters<std::uint64_t>);
+
+static void BM_binary_semaphore_ping_pong(benchmark::State& state) {
+  std::binary_semaphore ping(0);
+  std::binary_semaphore pong(0);
+  std::atomic<bool> done(false);
+  std::thread partner([&] {
+    while (true) {
+      ping.acquire();
+      if (done.load(std::memory_order_relaxed))
+        return;
+      pong.release();
+    }
+  });
+
+  for (auto _ : state) {
+    ping.release();
+    pong.acquire();
+  }
+
+  done.store(true, std::memory_order_relaxed);
+  ping.release();
+  partner.join();
+}
+BENCHMARK(BM_binary_semaphore_ping_pong)->UseRealTime();
+
+// Each latch is counted down once by every thread; the main thread waits for
+// all of them.
+static void BM_latch(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  for (auto _ : state) {
+    std::latch latch(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i != num_threads; ++i)
+      threads.emplace_back([&] { latch.count_down(); });
+    latch.wait();
+    for (auto& t : threads)
+      t.join();
+  }
+}
+BENCHMARK(BM_latch)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+// Every iteration is one phase of a barrier shared by all threads.
+static void BM_barrier_arrive_and_wait(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  std::barrier<> barrier(num_threads);
+  std::atomic<bool> done(false);
+  std::vector<std::thread> threads;
+  for (int i = 1; i != num_threads; ++i)
+    threads.emplace_back([&] {
+      while (true) {
+        barrier.arrive_and_wait();
+        if (done.load(std::memory_order_relaxed)) {
+          // Some threads may only see done one phase after the others, so
+          // leave with arrive_and_drop and never wait for the ones already
+          // gone.
+          barrier.arrive_and_drop();
+          return;
+        }
+      }
+    });
+
+  for (auto _ : state)
+    barrier.arrive_and_wait();
+
+  done.store(true, std::memory_order_relaxed);
+  barrier.arrive_and_drop();
+  for (auto& t : threads)
+    t.join();
+}
+BENCHMARK(BM_barrier_arrive_and_wait)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+BENCHMARK_MAIN();
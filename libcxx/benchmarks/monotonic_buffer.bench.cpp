@@ -25,4 +25,26 @@ static void bm_list(benchmark::State& state) {
 }
 BENCHMARK(bm_list)->Range(1, 2048);
 
+// Without an initial buffer every growth step is an upstream allocation.
+// Mixed request sizes exercise requests that don't fit the current chunk.
+static void bm_growth(benchmark::State& state) {
+  for (auto _ : state) {
+    std::pmr::monotonic_buffer_resource resource(64);
+    for (int64_t i = 0; i != state.range(); ++i)
+      benchmark::DoNotOptimize(resource.allocate(16 + (i % 7) * 48, 8));
+  }
+}
+BENCHMARK(bm_growth)->Range(1, 1 << 14);
+
+// All threads share one synchronized_pool_resource.
+static void bm_synchronized_pool(benchmark::State& state) {
+  static std::pmr::synchronized_pool_resource resource;
+  for (auto _ : state) {
+    void* p = resource.allocate(32, 8);
+    benchmark::DoNotOptimize(p);
+    resource.deallocate(p, 32, 8);
+  }
+}
+BENCHMARK(bm_synchronized_pool)->ThreadRange(1, 8)->UseRealTime();
+
 BENCHMARK_MAIN();
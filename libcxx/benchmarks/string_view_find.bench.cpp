@@ -0,0 +1,40 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <string_view>
+
+// The needle only occurs at the very end of the haystack, so the search has
+// to scan the whole string. The haystack is made of near misses of the
+// needle's first character to defeat a plain memchr scan.
+static void bm_string_view_find(benchmark::State& state) {
+  std::string haystack(state.range(0), 'a');
+  haystack.replace(haystack.size() - 3, 3, "abc");
+  std::string_view sv = haystack;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sv);
+    benchmark::DoNotOptimize(sv.find("abc"));
+  }
+}
+BENCHMARK(bm_string_view_find)->Range(16, 1 << 20);
+
+static void bm_string_view_find_char(benchmark::State& state) {
+  std::string haystack(state.range(0), 'a');
+  haystack.back() = 'b';
+  std::string_view sv = haystack;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sv);
+    benchmark::DoNotOptimize(sv.find('b'));
+  }
+}
+BENCHMARK(bm_string_view_find_char)->Range(16, 1 << 20);
+
+BENCHMARK_MAIN();
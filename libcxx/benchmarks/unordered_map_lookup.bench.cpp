@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "GenerateInput.h"
+
+constexpr std::size_t TestNumInputs = 1024;
+
+// Looks up every key of the map, in an order unrelated to the insertion order,
+// so that successive lookups touch unrelated buckets and nodes.
+template <class GenInputs>
+void BM_FindHit(benchmark::State& st, GenInputs gen) {
+  auto keys = gen(st.range(0));
+  using Key = typename decltype(keys)::value_type;
+  std::unordered_map<Key, std::uint64_t> m;
+  for (std::size_t i = 0; i != keys.size(); ++i)
+    m.emplace(keys[i], i);
+  auto lookups = keys;
+  std::reverse(lookups.begin(), lookups.end());
+
+  for (auto _ : st) {
+    for (const auto& k : lookups)
+      benchmark::DoNotOptimize(m.find(k));
+    benchmark::ClobberMemory();
+  }
+}
+
+// Looks up keys that are not in the map. Every lookup walks a whole bucket
+// chain before failing.
+template <class GenInputs>
+void BM_FindMiss(benchmark::State& st, GenInputs gen) {
+  auto keys = gen(2 * st.range(0));
+  using Key = typename decltype(keys)::value_type;
+  std::unordered_map<Key, std::uint64_t> m;
+  for (std::size_t i = 0; i != keys.size() / 2; ++i)
+    m.emplace(keys[i], i);
+  std::vector<Key> lookups(keys.begin() + keys.size() / 2, keys.end());
+  for (const auto& k : lookups)
+    m.erase(k);
+
+  for (auto _ : st) {
+    for (const auto& k : lookups)
+      benchmark::DoNotOptimize(m.find(k));
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK_CAPTURE(BM_FindHit, random_uint64, getRandomIntegerInputs<std::uint64_t>)
+    ->Arg(TestNumInputs)
+    ->Arg(TestNumInputs * 1024);
+BENCHMARK_CAPTURE(BM_FindMiss, random_uint64, getRandomIntegerInputs<std::uint64_t>)
+    ->Arg(TestNumInputs)
+    ->Arg(TestNumInputs * 1024);
+BENCHMARK_CAPTURE(BM_FindHit, random_string, getRandomStringInputs)->Arg(TestNumInputs);
+BENCHMARK_CAPTURE(BM_FindMiss, random_string, getRandomStringInputs)->Arg(TestNumInputs);
+
+BENCHMARK_MAIN();
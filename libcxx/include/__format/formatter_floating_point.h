@@ -114,12 +114,26 @@ _LIBCPP_HIDE_FROM_ABI constexpr size_t __float_buffer_size(int __precision) {
   return 4 + _Traits::__max_integral + __precision + _Traits::__max_fractional_value;
 }
 
+/// The buffer size required when no precision is used.
+///
+/// Without a precision to_chars writes the shortest round-trip
+/// representation (or the exact hexadecimal representation), which is far
+/// shorter than what __float_buffer_size(__max_fractional) reserves. The
+/// extra code unit is used for the radix point of the alternate form.
+template <floating_point _Fp>
+_LIBCPP_HIDE_FROM_ABI constexpr size_t __float_buffer_size_shortest() {
+  return 1 + __traits<_Fp>::__max_shortest;
+}
+
 template <>
 struct __traits<float> {
   static constexpr int __max_integral = 38;
   static constexpr int __max_fractional = 149;
   static constexpr int __max_fractional_value = 3;
   static constexpr size_t __stack_buffer_size = 256;
+  // -1.23456789e-38 is the longest output of to_chars without a precision,
+  // the hexadecimal form is shorter.
+  static constexpr int __max_shortest = 15;
 
   static constexpr int __hex_precision_digits = 3;
 };
@@ -130,6 +144,9 @@ struct __traits<double> {
   static constexpr int __max_fractional = 1074;
   static constexpr int __max_fractional_value = 4;
   static constexpr size_t __stack_buffer_size = 1024;
+  // -2.2250738585072014e-308 is the longest output of to_chars without a
+  // precision, the hexadecimal form is shorter.
+  static constexpr int __max_shortest = 24;
 
   static constexpr int __hex_precision_digits = 4;
 };
@@ -168,7 +185,14 @@ public:
       __precision_ = _Traits::__max_fractional;
     }
 
-    __size_ = __formatter::__float_buffer_size<_Fp>(__precision_);
+    // Without a precision the size is bounded by the shortest representation.
+    // This matters for the most common format string "{}": for double,
+    // __float_buffer_size(__max_fractional) exceeds the stack buffer and
+    // would require a heap allocation for every formatted value.
+    if (__precision == -1)
+      __size_ = __formatter::__float_buffer_size_shortest<_Fp>();
+    else
+      __size_ = __formatter::__float_buffer_size<_Fp>(__precision_);
     if (__size_ > _Traits::__stack_buffer_size)
       // The allocated buffer's contents don't need initialization.
       __begin_ = allocator<char>{}.allocate(__size_);
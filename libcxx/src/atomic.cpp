@@ -47,8 +47,7 @@ _LIBCPP_BEGIN_NAMESPACE_STD
 static void __libcpp_platform_wait_on_address(__cxx_atomic_contention_t const volatile* __ptr,
                                               __cxx_contention_t __val)
 {
-    static constexpr timespec __timeout = { 2, 0 };
-    syscall(SYS_futex, __ptr, FUTEX_WAIT_PRIVATE, __val, &__timeout, 0, 0);
+    syscall(SYS_futex, __ptr, FUTEX_WAIT_PRIVATE, __val, 0, 0, 0);
 }
 
 static void __libcpp_platform_wake_by_address(__cxx_atomic_contention_t const volatile* __ptr,
@@ -143,6 +142,12 @@ static void __libcpp_contention_notify(__cxx_atomic_contention_t volatile* __con
                                        __cxx_atomic_contention_t const volatile* __platform_state,
                                        bool __notify_one)
 {
+    // The store that changed the watched value may be a release (or weaker)
+    // store, which on its own can be reordered after the load of the waiter
+    // count below. A waiter could then increment the count and go to sleep on
+    // the old value after we have seen no waiters, and nobody would wake it.
+    // The fence pairs with the seq_cst increment in __libcpp_contention_wait.
+    __cxx_atomic_thread_fence(memory_order_seq_cst);
     if(0 != __cxx_atomic_load(__contention_state, memory_order_seq_cst))
         // We only call 'wake' if we consumed a contention bit here.
         __libcpp_platform_wake_by_address(__platform_state, __notify_one);
@@ -457,7 +457,7 @@ void* monotonic_buffer_resource::do_allocate(size_t bytes, size_t align) {
 
     size_t newsize = (__initial_.__start_ != nullptr) ? (__initial_.__end_ - __initial_.__start_) : __initial_.__size_;
 
-    return roundup(newsize, footer_align) + footer_size;
+    return roundup(newsize, footer_align);
   };
 
   if (void* result = __initial_.__try_allocate_from_chunk(bytes, align))
@@ -475,10 +475,14 @@ void* monotonic_buffer_resource::do_allocate(size_t bytes, size_t align) {
   size_t aligned_capacity  = roundup(bytes, footer_align) + footer_size;
   size_t previous_capacity = previous_allocation_size();
 
-  if (aligned_capacity <= previous_capacity) {
-    size_t newsize   = 2 * (previous_capacity - footer_size);
-    aligned_capacity = roundup(newsize, footer_align) + footer_size;
-  }
+  // Grow geometrically, based on the size of the whole upstream allocation
+  // (footer included). This keeps the chunk sizes powers of two when the
+  // initial size is one, which is what malloc-like upstream resources handle
+  // best, and a request that does not fit the current chunk but fits the
+  // doubled size gets the doubled size, not a chunk of exactly its own size.
+  // Only requests larger than that are allocated with their own size.
+  if (aligned_capacity <= 2 * previous_capacity)
+    aligned_capacity = 2 * previous_capacity;
 
   char* start            = (char*)__res_->allocate(aligned_capacity, align);
   auto end               = start + aligned_capacity - footer_size;
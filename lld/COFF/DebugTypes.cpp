@@ -1214,8 +1214,10 @@ void TypeMerger::clearGHashes() {
     if (src->ownedGHashes)
       delete[] src->ghashes.data();
     src->ghashes = {};
-    src->isItemIndex.clear();
-    src->uniqueTypes.clear();
+    // Assign empty containers rather than calling clear() so that the memory
+    // is actually returned; these scale with the number of input types.
+    src->isItemIndex = {};
+    src->uniqueTypes = {};
   }
 }
 
@@ -308,6 +308,13 @@ static void addGHashTypeInfo(COFFLinkerContext &ctx,
     builder.getIpiBuilder().addTypeRecords(source->mergedIpi.recs,
                                            source->mergedIpi.recSizes,
                                            source->mergedIpi.recHashes);
+    // The builders keep referring to the record bytes, but they have consumed
+    // the sizes and copied the hashes, so release those now.
+    for (TpiSource::MergedInfo *merged :
+         {&source->mergedTpi, &source->mergedIpi}) {
+      merged->recSizes = {};
+      merged->recHashes = {};
+    }
   }
 }
 
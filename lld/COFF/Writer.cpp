@@ -1991,17 +1991,23 @@ void Writer::writeBuildId() {
   // "timestamp" in the COFF file header, and the ones in the coff debug
   // directory.  Now we can hash the file and write that hash to the various
   // timestamp fields in the file.
-  StringRef outputFileData(
-      reinterpret_cast<const char *>(buffer->getBufferStart()),
-      buffer->getBufferSize());
+  ArrayRef<uint8_t> outputFileData(buffer->getBufferStart(),
+                                   buffer->getBufferSize());
 
   uint32_t timestamp = config->timestamp;
   uint64_t hash = 0;
   bool generateSyntheticBuildId =
       config->mingw && config->debug && config->pdbPath.empty();
 
-  if (config->repro || generateSyntheticBuildId)
-    hash = xxh3_64bits(outputFileData);
+  // Hash 1 MiB chunks of the output in parallel, then the chunk hashes.
+  if (config->repro || generateSyntheticBuildId) {
+    uint8_t digest[8];
+    parallelTreeHash(digest, outputFileData,
+                     [](uint8_t *dest, ArrayRef<uint8_t> arr) {
+                       write64le(dest, xxh3_64bits(arr));
+                     });
+    hash = read64le(digest);
+  }
 
   if (config->repro)
     timestamp = static_cast<uint32_t>(hash);
@@ -27,6 +27,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GlobPattern.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/TimeProfiler.h"
 #include <atomic>
 #include <memory>
 #include <optional>
@@ -159,6 +160,7 @@ struct Config {
   llvm::StringRef entry;
   llvm::StringRef emulation;
   llvm::StringRef fini;
+  llvm::StringRef incrementalState;
   llvm::StringRef init;
   llvm::StringRef ltoAAPipeline;
   llvm::StringRef ltoCSProfileFile;
@@ -219,6 +221,7 @@ struct Config {
   bool checkSections;
   bool checkDynamicRelocs;
   llvm::DebugCompressionType compressDebugSections;
+  std::optional<int> compressDebugSectionsLevel;
   bool cref;
   llvm::SmallVector<std::pair<llvm::GlobPattern, uint64_t>, 0>
       deadRelocInNonAlloc;
@@ -346,6 +349,7 @@ struct Config {
   unsigned optimize;
   StringRef thinLTOJobs;
   unsigned timeTraceGranularity;
+  llvm::TimeTraceProfilerOptions timeTraceOptions;
   int32_t splitStackAdjustSize;
   StringRef packageMetadata;
 
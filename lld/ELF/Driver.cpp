@@ -61,10 +61,12 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <tuple>
 #include <utility>
@@ -663,7 +665,8 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
 
   // Initialize time trace profiler.
   if (config->timeTraceEnabled)
-    timeTraceProfilerInitialize(config->timeTraceGranularity, config->progName);
+    timeTraceProfilerInitialize(config->timeTraceGranularity, config->progName,
+                                config->timeTraceOptions);
 
   {
     llvm::TimeTraceScope timeScope("ExecuteLinker");
@@ -952,10 +955,37 @@ static void readCallGraph(MemoryBufferRef mb) {
   };
 
   for (StringRef line : args::getLines(mb)) {
-    SmallVector<StringRef, 3> fields;
+    SmallVector<StringRef, 8> fields;
     line.split(fields, ' ');
     uint64_t count;
 
+    // A BOLT .fdata branch profile can be used in place of a call graph.
+    // Records have the form
+    //   <1> <from> <from-offset> <1> <to> <to-offset> <mispreds> <count>
+    // where 1 marks a symbol-relative location. A branch landing at offset 0
+    // of another function is a call or a tail call; everything else is an
+    // intra-function branch or a return and does not contribute an edge.
+    // BOLT appends "/<file>/<n>" to local symbol names, which is dropped.
+    if (line == "boltedcollection")
+      continue;
+    if (fields.size() == 8) {
+      uint64_t toOffset;
+      if (!to_integer(fields[5], toOffset, 16) ||
+          !to_integer(fields[7], count)) {
+        error(mb.getBufferIdentifier() + ": parse error");
+        return;
+      }
+      StringRef fromName = fields[1].split('/').first;
+      StringRef toName = fields[4].split('/').first;
+      if (fields[0] != "1" || fields[3] != "1" || toOffset != 0 ||
+          fromName == toName)
+        continue;
+      if (InputSectionBase *from = findSection(fromName))
+        if (InputSectionBase *to = findSection(toName))
+          config->callGraphProfile[std::make_pair(from, to)] += count;
+      continue;
+    }
+
     if (fields.size() != 3 || !to_integer(fields[2], count)) {
       error(mb.getBufferIdentifier() + ": parse error");
       return;
@@ -1232,9 +1262,30 @@ static void readConfigs(opt::InputArgList &args) {
   config->checkSections =
       args.hasFlag(OPT_check_sections, OPT_no_check_sections, true);
   config->chroot = args.getLastArgValue(OPT_chroot);
-  config->compressDebugSections = getCompressionType(
-      args.getLastArgValue(OPT_compress_debug_sections, "none"),
-      "--compress-debug-sections");
+  {
+    auto [type, level] =
+        args.getLastArgValue(OPT_compress_debug_sections, "none").split(':');
+    config->compressDebugSections =
+        getCompressionType(type, "--compress-debug-sections");
+    if (!level.empty()) {
+      // zlib takes levels 0 to 9, and zstd 1 to 22.
+      bool isZstd =
+          config->compressDebugSections == DebugCompressionType::Zstd;
+      int minLevel = isZstd ? 1 : compression::zlib::NoCompression;
+      int maxLevel = isZstd ? 22 : compression::zlib::BestSizeCompression;
+      int v;
+      if (config->compressDebugSections == DebugCompressionType::None ||
+          !to_integer(level, v))
+        error("--compress-debug-sections: invalid compression level: " +
+              level);
+      else if (v < minLevel || v > maxLevel)
+        error("--compress-debug-sections: compression level " + level +
+              " is out of range [" + Twine(minLevel) + ", " + Twine(maxLevel) +
+              "]");
+      else
+        config->compressDebugSectionsLevel = v;
+    }
+  }
   config->cref = args.hasArg(OPT_cref);
   config->optimizeBBJumps =
       args.hasFlag(OPT_optimize_bb_jumps, OPT_no_optimize_bb_jumps, false);
@@ -1282,6 +1333,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  config->incrementalState = args.getLastArgValue(OPT_incremental_state);
   config->init = args.getLastArgValue(OPT_init, "_init");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -1418,6 +1470,11 @@ static void readConfigs(opt::InputArgList &args) {
   config->timeTraceEnabled = args.hasArg(OPT_time_trace_eq);
   config->timeTraceGranularity =
       args::getInteger(args, OPT_time_trace_granularity, 500);
+  config->timeTraceOptions.MaxEventsPerThread =
+      args::getInteger(args, OPT_time_trace_max_events, 0);
+  config->timeTraceOptions.SummaryOnly = args.hasArg(OPT_time_trace_summary);
+  config->timeTraceOptions.MaxTotals =
+      args::getInteger(args, OPT_time_trace_max_totals, 0);
   config->trace = args.hasArg(OPT_trace);
   config->undefined = args::getStrings(args, OPT_undefined);
   config->undefinedVersion =
@@ -2685,6 +2742,124 @@ static void postParseObjectFile(ELFFileBase *file) {
   }
 }
 
+// --incremental-state=<file> records a digest of the command line and of all
+// input file contents together with the size and modification time of the
+// output. If a later link computes the same digest and finds the output
+// untouched, the previous output is reused and the link is skipped.
+static constexpr StringLiteral incrementalStateMagic =
+    "lld-incremental-state-v1";
+
+static uint64_t computeIncrementalDigest(opt::InputArgList &args) {
+  llvm::TimeTraceScope timeScope("Compute incremental digest");
+  SmallVector<uint64_t, 0> hashes;
+  hashes.push_back(xxh3_64bits(getLLDVersion()));
+  SmallString<128> cwd;
+  if (!fs::current_path(cwd))
+    hashes.push_back(xxh3_64bits(cwd));
+  for (const opt::Arg *arg : args)
+    hashes.push_back(xxh3_64bits(arg->getAsString(args)));
+
+  // Files named by these options are read after this point and are not in
+  // ctx.memoryBuffers yet, so hash their contents separately.
+  SmallVector<StringRef, 0> lateInputs = {config->ltoSampleProfile};
+  if (!config->ltoCSProfileGenerate)
+    lateInputs.push_back(config->ltoCSProfileFile);
+  if (auto *arg = args.getLastArg(OPT_call_graph_ordering_file))
+    lateInputs.push_back(arg->getValue());
+  std::vector<std::unique_ptr<MemoryBuffer>> lateBuffers;
+  for (StringRef path : lateInputs) {
+    if (path.empty())
+      continue;
+    auto mbOrErr = MemoryBuffer::getFile(path, /*IsText=*/false,
+                                         /*RequiresNullTerminator=*/false);
+    if (mbOrErr)
+      lateBuffers.push_back(std::move(*mbOrErr));
+    else
+      hashes.push_back(xxh3_64bits(path));
+  }
+
+  SmallVector<MemoryBufferRef, 0> buffers;
+  for (const std::unique_ptr<MemoryBuffer> &mb : ctx.memoryBuffers)
+    buffers.push_back(mb->getMemBufferRef());
+  for (const std::unique_ptr<MemoryBuffer> &mb : lateBuffers)
+    buffers.push_back(mb->getMemBufferRef());
+
+  // Input files can be large, so hash them in parallel.
+  size_t base = hashes.size();
+  hashes.resize(base + buffers.size() * 2);
+  parallelFor(0, buffers.size(), [&](size_t i) {
+    hashes[base + i * 2] = xxh3_64bits(buffers[i].getBufferIdentifier());
+    hashes[base + i * 2 + 1] = xxh3_64bits(buffers[i].getBuffer());
+  });
+  return xxh3_64bits(ArrayRef(reinterpret_cast<const uint8_t *>(hashes.data()),
+                              hashes.size() * sizeof(uint64_t)));
+}
+
+static std::string getOutputFileStamp() {
+  fs::file_status st;
+  if (fs::status(config->outputFile, st) || !fs::is_regular_file(st))
+    return "";
+  return (Twine(st.getSize()) + " " +
+          Twine(st.getLastModificationTime().time_since_epoch().count()))
+      .str();
+}
+
+// Returns true if the state file says the output was produced from the same
+// inputs and nobody has modified it since.
+static bool isOutputUpToDate(uint64_t digest) {
+  // These options are expected to print something on every link.
+  if (tar || config->printGcSections || config->printIcfSections ||
+      config->printMemoryUsage || config->trace)
+    return false;
+  // Reusing the output does not rewrite the files these options ask for, which
+  // would then be left stale.
+  if (!config->mapFile.empty() || !config->whyExtract.empty() ||
+      !config->dependencyFile.empty() || !config->printArchiveStats.empty() ||
+      !config->dwoDir.empty() || !config->ltoObjPath.empty() ||
+      !config->optRemarksFilename.empty() || !config->saveTempsArgs.empty() ||
+      config->thinLTOIndexOnly || config->thinLTOEmitImportsFiles)
+    return false;
+
+  auto mbOrErr = MemoryBuffer::getFile(config->incrementalState);
+  if (!mbOrErr)
+    return false;
+  SmallVector<StringRef, 3> lines;
+  (*mbOrErr)->getBuffer().trim().split(lines, '\n');
+  if (lines.size() != 3 || lines[0] != incrementalStateMagic ||
+      lines[1] != utohexstr(digest))
+    return false;
+  std::string stamp = getOutputFileStamp();
+  return !stamp.empty() && lines[2] == stamp;
+}
+
+// Bumps the modification time of the reused output, so that build systems
+// comparing it against its inputs see it as up to date.
+static bool touchOutputFile() {
+  int fd;
+  if (fs::openFileForReadWrite(config->outputFile, fd, fs::CD_OpenExisting,
+                               fs::OF_None))
+    return false;
+  std::error_code ec = fs::setLastAccessAndModificationTime(
+      fd, std::chrono::system_clock::now());
+  sys::Process::SafelyCloseFileDescriptor(fd);
+  return !ec;
+}
+
+static void writeIncrementalState(uint64_t digest) {
+  std::string stamp = getOutputFileStamp();
+  if (stamp.empty())
+    return;
+  std::error_code ec;
+  raw_fd_ostream os(config->incrementalState, ec, fs::OF_None);
+  if (ec) {
+    warn("cannot open --incremental-state= file " + config->incrementalState +
+         ": " + ec.message());
+    return;
+  }
+  os << incrementalStateMagic << '\n' << utohexstr(digest) << '\n' << stamp
+     << '\n';
+}
+
 // Do actual linking. Note that when this function is called,
 // all linker scripts have already been parsed.
 void LinkerDriver::link(opt::InputArgList &args) {
@@ -2702,6 +2877,20 @@ void LinkerDriver::link(opt::InputArgList &args) {
   if (config->outputFile.empty())
     config->outputFile = "a.out";
 
+  // Skip the link if the previous output is still up to date. The state file
+  // is removed first so that a failed link does not leave a stale record.
+  uint64_t incrementalDigest = 0;
+  if (!config->incrementalState.empty()) {
+    incrementalDigest = computeIncrementalDigest(args);
+    if (isOutputUpToDate(incrementalDigest) && touchOutputFile()) {
+      log("--incremental-state: " + config->outputFile + " is up to date");
+      // Touching the output changed its modification time.
+      writeIncrementalState(incrementalDigest);
+      return;
+    }
+    fs::remove(config->incrementalState);
+  }
+
   // Fail early if the output file or map file is not writable. If a user has a
   // long link, e.g. due to a large LTO link, they do not wish to run it and
   // find that it failed because there was a mistake in their command-line.
@@ -2742,12 +2931,29 @@ void LinkerDriver::link(opt::InputArgList &args) {
   // appended to the Files vector.
   {
     llvm::TimeTraceScope timeScope("Parse input files");
+    // Input sections are read in no particular order, but small files are read
+    // in full. Let the kernel fault them in on worker threads rather than page
+    // by page during the serial parse.
+    parallelForEach(ctx.memoryBuffers, [](std::unique_ptr<MemoryBuffer> &mb) {
+      mb->adviseIfMmap(MemoryBuffer::AccessPattern::Normal);
+    });
+    // Symbol resolution below is serial, but hashing the names of global
+    // symbols is independent of resolution order. Do that up front.
+    parallelForEach(files, [](InputFile *file) {
+      if (file->kind() == InputFile::ObjKind)
+        cast<ELFFileBase>(file)->hashGlobalSymbolNames();
+    });
     for (size_t i = 0; i < files.size(); ++i) {
       llvm::TimeTraceScope timeScope("Parse input files", files[i]->getName());
       parseFile(files[i]);
     }
     if (armCmseImpLib)
       parseArmCMSEImportLib(*armCmseImpLib);
+
+    // Release the hashes of archive members that were not extracted.
+    for (InputFile *file : files)
+      if (file->kind() == InputFile::ObjKind)
+        cast<ELFFileBase>(file)->globalNameHashes.reset();
   }
 
   // Now that we have every file, we can decide if we will need a
@@ -3081,4 +3287,7 @@ void LinkerDriver::link(opt::InputArgList &args) {
 
   // Write the result to the file.
   invokeELFT(writeResult,);
+
+  if (!config->incrementalState.empty() && !errorCount())
+    writeIncrementalState(incrementalDigest);
 }
@@ -524,6 +524,30 @@ template <class ELFT> void ICF<ELFT>::run() {
     segregate(begin, end, eqClassBase, true);
   });
 
+  // Sections that are alone in their class at this point can never be folded,
+  // and they are usually the vast majority. Drop them so that the iterations
+  // below only visit sections that may still be folded. Their class IDs are
+  // still read through relocations of other sections, so store the final ID
+  // in both slots. Do the same for the remaining sections, which makes either
+  // slot valid regardless of whether the iterations below run in parallel.
+  {
+    size_t oldSize = sections.size();
+    SmallVector<InputSection *, 0> candidates;
+    for (size_t i = 0; i != oldSize; ++i) {
+      uint32_t eqClass = sections[i]->eqClass[next];
+      bool single =
+          (i == 0 || sections[i - 1]->eqClass[next] != eqClass) &&
+          (i + 1 == oldSize || sections[i + 1]->eqClass[next] != eqClass);
+      sections[i]->eqClass[0] = sections[i]->eqClass[1] = eqClass;
+      if (!single)
+        candidates.push_back(sections[i]);
+    }
+    sections = std::move(candidates);
+    current = next = 0;
+    // New class IDs must not collide with the ones assigned so far.
+    eqClassBase += oldSize;
+  }
+
   // Split groups by comparing relocations until convergence is obtained.
   do {
     repeat = false;
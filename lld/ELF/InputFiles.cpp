@@ -540,6 +540,43 @@ template <class ELFT> void ELFFileBase::init(InputFile::Kind k) {
   stringTable = CHECK(obj.getStringTableForSymtab(*symtabSec, sections), this);
 }
 
+void ELFFileBase::hashGlobalSymbolNames() {
+  switch (ekind) {
+  case ELF32LEKind:
+    hashGlobalSymbolNames<ELF32LE>();
+    break;
+  case ELF32BEKind:
+    hashGlobalSymbolNames<ELF32BE>();
+    break;
+  case ELF64LEKind:
+    hashGlobalSymbolNames<ELF64LE>();
+    break;
+  case ELF64BEKind:
+    hashGlobalSymbolNames<ELF64BE>();
+    break;
+  default:
+    llvm_unreachable("getELFKind");
+  }
+}
+
+// Hashing symbol names is a large part of the cost of SymbolTable::insert,
+// which has to run serially. This may be called in parallel before symbol
+// resolution to take that work off the serial path. Errors are left for
+// initializeSymbols() and parseLazy() to report.
+template <typename ELFT> void ELFFileBase::hashGlobalSymbolNames() {
+  ArrayRef<typename ELFT::Sym> eSyms = getGlobalELFSyms<ELFT>();
+  auto hashes = std::make_unique<uint32_t[]>(eSyms.size());
+  for (size_t i = 0, e = eSyms.size(); i != e; ++i) {
+    Expected<StringRef> name = eSyms[i].getName(stringTable);
+    if (!name) {
+      consumeError(name.takeError());
+      return;
+    }
+    hashes[i] = SymbolTable::hashName(*name);
+  }
+  globalNameHashes = std::move(hashes);
+}
+
 template <class ELFT>
 uint32_t ObjFile<ELFT>::getSectionIndex(const Elf_Sym &sym) const {
   return CHECK(
@@ -1042,15 +1079,16 @@ InputSectionBase *ObjFile<ELFT>::createInputSection(uint32_t idx,
 template <class ELFT>
 void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
-  if (numSymbols == 0) {
-    numSymbols = eSyms.size();
-    symbols = std::make_unique<Symbol *[]>(numSymbols);
-  }
+  numSymbols = eSyms.size();
+  symbols = std::make_unique<Symbol *[]>(numSymbols);
 
-  // Some entries have been filled by LazyObjFile.
-  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
-    if (!symbols[i])
-      symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    StringRef name = CHECK(eSyms[i].getName(stringTable), this);
+    symbols[i] = globalNameHashes
+                     ? symtab.insert(name, globalNameHashes[i - firstGlobal])
+                     : symtab.insert(name);
+  }
+  globalNameHashes.reset();
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1782,17 +1820,23 @@ ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
 
 template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   const ArrayRef<typename ELFT::Sym> eSyms = this->getELFSyms<ELFT>();
-  numSymbols = eSyms.size();
-  symbols = std::make_unique<Symbol *[]>(numSymbols);
 
+  // Names point into the mapped member and the symbol table only records the
+  // defining file, so a lazy member costs no per-symbol allocation. The
+  // symbols array is created by initializeSymbols() if the member is
+  // extracted; most members of a large archive never are.
+  //
   // resolve() may trigger this->extract() if an existing symbol is an undefined
   // symbol. If that happens, this function has served its purpose, and we can
   // exit from the loop early.
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
-    symbols[i]->resolve(LazyObject{*this});
+    StringRef name = CHECK(eSyms[i].getName(stringTable), this);
+    Symbol *sym = globalNameHashes
+                      ? symtab.insert(name, globalNameHashes[i - firstGlobal])
+                      : symtab.insert(name);
+    sym->resolve(LazyObject{*this});
     if (!lazy)
       break;
   }
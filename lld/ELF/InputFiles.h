@@ -172,6 +172,7 @@ public:
   static bool classof(const InputFile *f) { return f->isElf(); }
 
   void init();
+  void hashGlobalSymbolNames();
   template <typename ELFT> llvm::object::ELFFile<ELFT> getObj() const {
     return check(llvm::object::ELFFile<ELFT>::create(mb.getBuffer()));
   }
@@ -207,6 +208,7 @@ public:
 protected:
   // Initializes this class's member variables.
   template <typename ELFT> void init(InputFile::Kind k);
+  template <typename ELFT> void hashGlobalSymbolNames();
 
   StringRef stringTable;
   const void *elfShdrs = nullptr;
@@ -216,6 +218,9 @@ protected:
   uint32_t firstGlobal = 0;
 
 public:
+  // SymbolTable::hashName() of each global symbol, if precomputed by
+  // hashGlobalSymbolNames(). Released once the symbols are inserted.
+  std::unique_ptr<uint32_t[]> globalNameHashes;
   uint32_t andFeatures = 0;
   bool hasCommonSyms = false;
 };
@@ -344,46 +344,47 @@ template <class ELFT> void OutputSection::maybeCompress() {
   }
 
 #if LLVM_ENABLE_ZSTD
-  // Use ZSTD's streaming compression API which permits parallel workers working
-  // on the stream. See http://facebook.github.io/zstd/zstd_manual.html
-  // "Streaming compression - HowTo".
+  // Split input into 8-MiB shards and compress each into an independent zstd
+  // frame. A zstd decoder decompresses concatenated frames as one stream, so
+  // the shards can be compressed in parallel and written back to back. The
+  // shard size is fixed so that the output does not depend on the number of
+  // threads. 0 selects zstd's default level.
   if (config->compressDebugSections == DebugCompressionType::Zstd) {
-    // Allocate a buffer of half of the input size, and grow it by 1.5x if
-    // insufficient.
-    compressed.shards = std::make_unique<SmallVector<uint8_t, 0>[]>(1);
-    SmallVector<uint8_t, 0> &out = compressed.shards[0];
-    out.resize_for_overwrite(std::max<size_t>(size / 2, 32));
-    size_t pos = 0;
-
-    ZSTD_CCtx *cctx = ZSTD_createCCtx();
-    // Ignore error if zstd was not built with ZSTD_MULTITHREAD.
-    (void)ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers,
-                                 parallel::strategy.compute_thread_count());
-    ZSTD_outBuffer zob = {out.data(), out.size(), 0};
-    ZSTD_EndDirective directive = ZSTD_e_continue;
-    const size_t blockSize = ZSTD_CStreamInSize();
-    do {
-      const size_t n = std::min(static_cast<size_t>(size - pos), blockSize);
-      if (n == size - pos)
-        directive = ZSTD_e_end;
-      ZSTD_inBuffer zib = {buf.get() + pos, n, 0};
-      size_t bytesRemaining = 0;
-      while (zib.pos != zib.size ||
-             (directive == ZSTD_e_end && bytesRemaining != 0)) {
+    const int level = config->compressDebugSectionsLevel.value_or(0);
+    constexpr size_t shardSize = 8 << 20;
+    auto shardsIn = split(ArrayRef<uint8_t>(buf.get(), size), shardSize);
+    const size_t numShards = shardsIn.size();
+    auto shardsOut = std::make_unique<SmallVector<uint8_t, 0>[]>(numShards);
+    parallelFor(0, numShards, [&](size_t i) {
+      // Allocate a buffer of half of the shard size, and grow it by 1.5x if
+      // insufficient, instead of reserving the worst case for every shard.
+      SmallVector<uint8_t, 0> &out = shardsOut[i];
+      out.resize_for_overwrite(std::max<size_t>(shardsIn[i].size() / 2, 32));
+
+      ZSTD_CCtx *cctx = ZSTD_createCCtx();
+      (void)ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+      (void)ZSTD_CCtx_setPledgedSrcSize(cctx, shardsIn[i].size());
+      ZSTD_inBuffer zib = {shardsIn[i].data(), shardsIn[i].size(), 0};
+      ZSTD_outBuffer zob = {out.data(), out.size(), 0};
+      size_t bytesRemaining;
+      do {
         if (zob.pos == zob.size) {
           out.resize_for_overwrite(out.size() * 3 / 2);
           zob.dst = out.data();
           zob.size = out.size();
         }
-        bytesRemaining = ZSTD_compressStream2(cctx, &zob, &zib, directive);
+        bytesRemaining = ZSTD_compressStream2(cctx, &zob, &zib, ZSTD_e_end);
         assert(!ZSTD_isError(bytesRemaining));
-      }
-      pos += n;
-    } while (directive != ZSTD_e_end);
-    out.resize(zob.pos);
-    ZSTD_freeCCtx(cctx);
+      } while (bytesRemaining != 0);
+      out.truncate(zob.pos);
+      ZSTD_freeCCtx(cctx);
+    });
 
-    size = sizeof(Elf_Chdr) + out.size();
+    size = sizeof(Elf_Chdr);
+    for (size_t i = 0; i != numShards; ++i)
+      size += shardsOut[i].size();
+    compressed.shards = std::move(shardsOut);
+    compressed.numShards = numShards;
     flags |= SHF_COMPRESSED;
     return;
   }
@@ -395,7 +396,8 @@ template <class ELFT> void OutputSection::maybeCompress() {
   // ~15%. We found that level 7 to 9 doesn't make much difference (~1% more
   // compression) while they take significant amount of time (~2x), so level 6
   // seems enough.
-  const int level = config->optimize >= 2 ? 6 : Z_BEST_SPEED;
+  const int level = config->compressDebugSectionsLevel.value_or(
+      config->optimize >= 2 ? 6 : Z_BEST_SPEED);
 
   // Split input into 1-MiB shards.
   constexpr size_t shardSize = 1 << 20;
@@ -456,19 +458,23 @@ void OutputSection::writeTo(uint8_t *buf, parallel::TaskGroup &tg) {
     chdr->ch_size = compressed.uncompressedSize;
     chdr->ch_addralign = addralign;
     buf += sizeof(*chdr);
-    if (config->compressDebugSections == DebugCompressionType::Zstd) {
-      chdr->ch_type = ELFCOMPRESS_ZSTD;
-      memcpy(buf, compressed.shards[0].data(), compressed.shards[0].size());
-      return;
-    }
-    chdr->ch_type = ELFCOMPRESS_ZLIB;
+    bool isZstd = config->compressDebugSections == DebugCompressionType::Zstd;
+    chdr->ch_type = isZstd ? ELFCOMPRESS_ZSTD : ELFCOMPRESS_ZLIB;
 
     // Compute shard offsets.
     auto offsets = std::make_unique<size_t[]>(compressed.numShards);
-    offsets[0] = 2; // zlib header
+    offsets[0] = isZstd ? 0 : 2; // zlib header
     for (size_t i = 1; i != compressed.numShards; ++i)
       offsets[i] = offsets[i - 1] + compressed.shards[i - 1].size();
 
+    if (isZstd) {
+      parallelFor(0, compressed.numShards, [&](size_t i) {
+        memcpy(buf + offsets[i], compressed.shards[i].data(),
+               compressed.shards[i].size());
+      });
+      return;
+    }
+
     buf[0] = 0x78; // CMF
     buf[1] = 0x01; // FLG: best speed
     parallelFor(0, compressed.numShards, [&](size_t i) {
@@ -449,6 +449,11 @@ class RelocationScanner {
 public:
   template <class ELFT> void scanSection(InputSectionBase &s);
 
+  // PPC64 TOC entries that must not be relaxed. Collected per scanner and
+  // merged into ppc64noTocRelax after scanning so that scanning can run in
+  // parallel.
+  SmallVector<std::pair<const Symbol *, uint64_t>, 0> noTocRelax;
+
 private:
   InputSectionBase *sec;
   OffsetGetter getter;
@@ -1413,14 +1418,13 @@ template <class ELFT, class RelTy> void RelocationScanner::scanOne(RelTy *&i) {
     // have got-based small code model relocs. The .toc sections get placed
     // after the end of the linker allocated .got section and we do sort those
     // so sections addressed with small code model relocations come first.
-    if (type == R_PPC64_TOC16 || type == R_PPC64_TOC16_DS)
-      sec->file->ppc64SmallCodeModelTocRelocs = true;
+    // The objects using them are found by checkPPC64Relocs() before scanning.
 
     // Record the TOC entry (.toc + addend) as not relaxable. See the comment in
     // InputSectionBase::relocateAlloc().
     if (type == R_PPC64_TOC16_LO && sym.isSection() && isa<Defined>(sym) &&
         cast<Defined>(sym).section->name == ".toc")
-      ppc64noTocRelax.insert({&sym, addend});
+      noTocRelax.emplace_back(&sym, addend);
 
     if ((type == R_PPC64_TLSGD && expr == R_TLSDESC_CALL) ||
         (type == R_PPC64_TLSLD && expr == R_TLSLD_HINT)) {
@@ -1500,14 +1504,34 @@ static void checkPPC64TLSRelax(InputSectionBase &sec, ArrayRef<RelTy> rels) {
   }
 }
 
+// Record the per-file properties of the PPC64 relocations of \p sec. This runs
+// serially, in input order, before the relocations are scanned in parallel so
+// that the scanners only read these flags and diagnostics are deterministic.
+template <class ELFT> static void checkPPC64Relocs(InputSectionBase &sec) {
+  if (!sec.file)
+    return;
+  const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
+  auto check = [&](auto rs) {
+    for (const auto &rel : rs) {
+      RelType type = rel.getType(false);
+      if (type == R_PPC64_TOC16 || type == R_PPC64_TOC16_DS) {
+        sec.file->ppc64SmallCodeModelTocRelocs = true;
+        break;
+      }
+    }
+    checkPPC64TLSRelax(sec, rs);
+  };
+  if (rels.areRelocsRel())
+    check(rels.rels);
+  else
+    check(rels.relas);
+}
+
 template <class ELFT, class RelTy>
 void RelocationScanner::scan(ArrayRef<RelTy> rels) {
   // Not all relocations end up in Sec->Relocations, but a lot do.
   sec->relocations.reserve(rels.size());
 
-  if (config->emachine == EM_PPC64)
-    checkPPC64TLSRelax<RelTy>(*sec, rels);
-
   // For EhInputSection, OffsetGetter expects the relocations to be sorted by
   // r_offset. In rare cases (.eh_frame pieces are reordered by a linker
   // script), the relocations may be unordered.
@@ -1546,34 +1570,52 @@ template <class ELFT> void elf::scanRelocations() {
   // directly processed by InputSection::relocateNonAlloc.
 
   // Deterministic parallellism needs sorting relocations which is unsuitable
-  // for -z nocombreloc. MIPS and PPC64 use global states which are not suitable
-  // for parallelism.
-  bool serial = !config->zCombreloc || config->emachine == EM_MIPS ||
-                config->emachine == EM_PPC64;
-  parallel::TaskGroup tg;
-  for (ELFFileBase *f : ctx.objectFiles) {
-    auto fn = [f]() {
-      RelocationScanner scanner;
-      for (InputSectionBase *s : f->getSections()) {
+  // for -z nocombreloc. MIPS uses global states (the multi-GOT) which are not
+  // suitable for parallelism. PPC64's per-file flags are computed by the serial
+  // pre-pass below, and its non-relaxable TOC entries are buffered in each
+  // scanner and merged at the end.
+  bool serial = !config->zCombreloc || config->emachine == EM_MIPS;
+  if (config->emachine == EM_PPC64) {
+    for (ELFFileBase *f : ctx.objectFiles)
+      for (InputSectionBase *s : f->getSections())
         if (s && s->kind() == SectionBase::Regular && s->isLive() &&
-            (s->flags & SHF_ALLOC) &&
-            !(s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
-          scanner.template scanSection<ELFT>(*s);
-      }
-    };
-    tg.spawn(fn, serial);
+            (s->flags & SHF_ALLOC))
+          checkPPC64Relocs<ELFT>(*s);
+    for (Partition &part : partitions)
+      for (EhInputSection *sec : part.ehFrame->sections)
+        checkPPC64Relocs<ELFT>(*sec);
   }
+  const size_t numFiles = ctx.objectFiles.size();
+  std::vector<RelocationScanner> scanners(numFiles + 1);
+  {
+    parallel::TaskGroup tg;
+    for (size_t i = 0; i != numFiles; ++i) {
+      auto fn = [f = ctx.objectFiles[i], &scanner = scanners[i]]() {
+        for (InputSectionBase *s : f->getSections()) {
+          if (s && s->kind() == SectionBase::Regular && s->isLive() &&
+              (s->flags & SHF_ALLOC) &&
+              !(s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
+            scanner.template scanSection<ELFT>(*s);
+        }
+      };
+      tg.spawn(fn, serial);
+    }
 
-  tg.spawn([] {
-    RelocationScanner scanner;
-    for (Partition &part : partitions) {
-      for (EhInputSection *sec : part.ehFrame->sections)
-        scanner.template scanSection<ELFT>(*sec);
-      if (part.armExidx && part.armExidx->isLive())
-        for (InputSection *sec : part.armExidx->exidxSections)
+    tg.spawn([&scanner = scanners[numFiles]] {
+      for (Partition &part : partitions) {
+        for (EhInputSection *sec : part.ehFrame->sections)
           scanner.template scanSection<ELFT>(*sec);
-    }
-  });
+        if (part.armExidx && part.armExidx->isLive())
+          for (InputSection *sec : part.armExidx->exidxSections)
+            scanner.template scanSection<ELFT>(*sec);
+      }
+    });
+  }
+
+  if (config->emachine == EM_PPC64)
+    for (const RelocationScanner &scanner : scanners)
+      ppc64noTocRelax.insert(scanner.noTocRelax.begin(),
+                             scanner.noTocRelax.end());
 }
 
 static bool handleNonPreemptibleIfunc(Symbol &sym, uint16_t flags) {
@@ -62,20 +62,37 @@ void SymbolTable::wrap(Symbol *sym, Symbol *real, Symbol *wrap) {
   real->isUsedInRegularObj = false;
 }
 
+// <name>@@<version> means the symbol is the default version. In that
+// case <name>@@<version> will be used to resolve references to <name>.
+//
+// Since this is a hot path, the following string search code is
+// optimized for speed. StringRef::find(char) is much faster than
+// StringRef::find(StringRef).
+static StringRef getStem(StringRef name, size_t &pos) {
+  pos = name.find('@');
+  if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
+    return name.take_front(pos);
+  return name;
+}
+
+// Returns the hash value insert() uses for a symbol name. This does not touch
+// the symbol table, so it can be computed in parallel ahead of time.
+uint32_t SymbolTable::hashName(StringRef name) {
+  size_t pos;
+  return CachedHashStringRef(getStem(name, pos)).hash();
+}
+
 // Find an existing symbol or create a new one.
 Symbol *SymbolTable::insert(StringRef name) {
-  // <name>@@<version> means the symbol is the default version. In that
-  // case <name>@@<version> will be used to resolve references to <name>.
-  //
-  // Since this is a hot path, the following string search code is
-  // optimized for speed. StringRef::find(char) is much faster than
-  // StringRef::find(StringRef).
-  StringRef stem = name;
-  size_t pos = name.find('@');
-  if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
-    stem = name.take_front(pos);
+  return insert(name, hashName(name));
+}
 
-  auto p = symMap.insert({CachedHashStringRef(stem), (int)symVector.size()});
+// Same as above, but with a precomputed hashName(name).
+Symbol *SymbolTable::insert(StringRef name, uint32_t hash) {
+  size_t pos;
+  StringRef stem = getStem(name, pos);
+  auto p =
+      symMap.insert({CachedHashStringRef(stem, hash), (int)symVector.size()});
   if (!p.second) {
     Symbol *sym = symVector[p.first->second];
     if (stem.size() != name.size()) {
@@ -43,6 +43,8 @@ public:
   void wrap(Symbol *sym, Symbol *real, Symbol *wrap);
 
   Symbol *insert(StringRef name);
+  Symbol *insert(StringRef name, uint32_t hash);
+  static uint32_t hashName(StringRef name);
 
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
@@ -2783,9 +2783,13 @@ readPubNamesAndTypes(const LLDDwarfObj<ELFT> &obj,
 
 // Create a list of symbols from a given list of symbol names and types
 // by uniquifying them by name.
+//
+// nameAttrs is consumed. It is released as soon as it is no longer needed
+// because it is usually the largest data structure here: it has an entry for
+// each occurrence of a name in each compilation unit.
 static std::pair<SmallVector<GdbIndexSection::GdbSymbol, 0>, size_t>
 createSymbols(
-    ArrayRef<SmallVector<GdbIndexSection::NameAttrEntry, 0>> nameAttrs,
+    SmallVector<SmallVector<GdbIndexSection::NameAttrEntry, 0>, 0> nameAttrs,
     const SmallVector<GdbIndexSection::GdbChunk, 0> &chunks) {
   using GdbSymbol = GdbIndexSection::GdbSymbol;
   using NameAttrEntry = GdbIndexSection::NameAttrEntry;
@@ -2835,18 +2839,24 @@ createSymbols(
     }
   });
 
+  nameAttrs.clear();
+  map.reset();
+
   size_t numSymbols = 0;
   for (ArrayRef<GdbSymbol> v : ArrayRef(symbols.get(), numShards))
     numSymbols += v.size();
 
   // The return type is a flattened vector, so we'll copy each vector
-  // contents to Ret.
+  // contents to Ret. Free each shard right after copying it so that we
+  // don't have two copies of all symbols at the same time.
   SmallVector<GdbSymbol, 0> ret;
   ret.reserve(numSymbols);
   for (SmallVector<GdbSymbol, 0> &vec :
-       MutableArrayRef(symbols.get(), numShards))
+       MutableArrayRef(symbols.get(), numShards)) {
     for (GdbSymbol &sym : vec)
       ret.push_back(std::move(sym));
+    vec = {};
+  }
 
   // CU vectors and symbol names are adjacent in the output file.
   // We can compute their offsets in the output file now.
@@ -2864,7 +2874,7 @@ createSymbols(
     errorOrWarn("--gdb-index: constant pool size (" + Twine(off) +
                 ") exceeds UINT32_MAX");
 
-  return {ret, off};
+  return {std::move(ret), off};
 }
 
 // Returns a newly-created .gdb_index section.
@@ -2916,7 +2926,8 @@ template <class ELFT> GdbIndexSection *GdbIndexSection::create() {
 
   auto *ret = make<GdbIndexSection>();
   ret->chunks = std::move(chunks);
-  std::tie(ret->symbols, ret->size) = createSymbols(nameAttrs, ret->chunks);
+  std::tie(ret->symbols, ret->size) =
+      createSymbols(std::move(nameAttrs), ret->chunks);
 
   // Count the areas other than the constant pool.
   ret->size += sizeof(GdbIndexHeader) + ret->computeSymtabSize() * 8;
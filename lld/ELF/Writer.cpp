@@ -20,7 +20,6 @@
 #include "Symbols.h"
 #include "SyntheticSections.h"
 #include "Target.h"
-#include "lld/Common/Arrays.h"
 #include "lld/Common/CommonLinkerContext.h"
 #include "lld/Common/Filesystem.h"
 #include "lld/Common/Strings.h"
@@ -2952,10 +2951,27 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
       if (sec->type == SHT_REL || sec->type == SHT_RELA)
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
+  // Write SHF_ALLOC sections before the others. Non-SHF_ALLOC sections, in
+  // particular large debug sections that need relocations applied, follow
+  // all SHF_ALLOC sections in the file, so the latter can be handed to the
+  // OS for writeback while the rest of the output is being computed.
+  uint64_t allocEnd = 0;
   {
     parallel::TaskGroup tg;
     for (OutputSection *sec : outputSections)
-      if (sec->type != SHT_REL && sec->type != SHT_RELA)
+      if (sec->type != SHT_REL && sec->type != SHT_RELA &&
+          (sec->flags & SHF_ALLOC)) {
+        sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
+        if (sec->type != SHT_NOBITS)
+          allocEnd = std::max(allocEnd, sec->offset + sec->size);
+      }
+  }
+  buffer->startWriteback(0, allocEnd);
+  {
+    parallel::TaskGroup tg;
+    for (OutputSection *sec : outputSections)
+      if (sec->type != SHT_REL && sec->type != SHT_RELA &&
+          !(sec->flags & SHF_ALLOC))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
 
@@ -2967,27 +2983,6 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
   }
 }
 
-// Computes a hash value of Data using a given hash function.
-// In order to utilize multiple cores, we first split data into 1MB
-// chunks, compute a hash for each chunk, and then compute a hash value
-// of the hash values.
-static void
-computeHash(llvm::MutableArrayRef<uint8_t> hashBuf,
-            llvm::ArrayRef<uint8_t> data,
-            std::function<void(uint8_t *dest, ArrayRef<uint8_t> arr)> hashFn) {
-  std::vector<ArrayRef<uint8_t>> chunks = split(data, 1024 * 1024);
-  const size_t hashesSize = chunks.size() * hashBuf.size();
-  std::unique_ptr<uint8_t[]> hashes(new uint8_t[hashesSize]);
-
-  // Compute hash values.
-  parallelFor(0, chunks.size(), [&](size_t i) {
-    hashFn(hashes.get() + i * hashBuf.size(), chunks[i]);
-  });
-
-  // Write to the final output buffer.
-  hashFn(hashBuf.data(), ArrayRef(hashes.get(), hashesSize));
-}
-
 template <class ELFT> void Writer<ELFT>::writeBuildId() {
   if (!mainPart->buildId || !mainPart->buildId->getParent())
     return;
@@ -2998,7 +2993,9 @@ template <class ELFT> void Writer<ELFT>::writeBuildId() {
     return;
   }
 
-  // Compute a hash of all sections of the output file.
+  // Compute a hash of all sections of the output file. In order to utilize
+  // multiple cores, parallelTreeHash hashes 1 MiB chunks in parallel and then
+  // hashes the chunk hashes.
   size_t hashSize = mainPart->buildId->hashSize;
   std::unique_ptr<uint8_t[]> buildId(new uint8_t[hashSize]);
   MutableArrayRef<uint8_t> output(buildId.get(), hashSize);
@@ -3012,17 +3009,17 @@ template <class ELFT> void Writer<ELFT>::writeBuildId() {
   // efficient BLAKE3.
   switch (config->buildId) {
   case BuildIdKind::Fast:
-    computeHash(output, input, [](uint8_t *dest, ArrayRef<uint8_t> arr) {
+    parallelTreeHash(output, input, [](uint8_t *dest, ArrayRef<uint8_t> arr) {
       write64le(dest, xxh3_64bits(arr));
     });
     break;
   case BuildIdKind::Md5:
-    computeHash(output, input, [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
+    parallelTreeHash(output, input, [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
       memcpy(dest, BLAKE3::hash<16>(arr).data(), hashSize);
     });
     break;
   case BuildIdKind::Sha1:
-    computeHash(output, input, [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
+    parallelTreeHash(output, input, [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
       memcpy(dest, BLAKE3::hash<20>(arr).data(), hashSize);
     });
     break;
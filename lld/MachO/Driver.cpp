@@ -45,6 +45,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -1129,6 +1130,26 @@ static void handleSymbolPatterns(InputArgList &args,
     parseSymbolPatternsFile(arg, symbolPatterns);
 }
 
+// Input files are parsed one at a time because symbol resolution depends on
+// the command line order, so they can't be faulted in ahead of parsing without
+// opening them out of order. Later passes (e.g. loading archive members,
+// splitting sections and writing the output) touch much more of each input
+// than parsing does, though. Fault in the pages of every buffer readFile() has
+// opened on worker threads so that these passes find them resident.
+static void pageInInputFiles() {
+  TimeTraceScope timeScope("Page in input files");
+  SmallVector<MemoryBufferRef, 0> buffers;
+  for (const auto &entry : cachedReads)
+    buffers.push_back(entry.second);
+
+  const size_t pageSize = sys::Process::getPageSizeEstimate();
+  parallelForEach(buffers, [&](MemoryBufferRef mb) {
+    const volatile char *data = mb.getBufferStart();
+    for (size_t i = 0, e = mb.getBufferSize(); i < e; i += pageSize)
+      (void)data[i];
+  });
+}
+
 static void createFiles(const InputArgList &args) {
   TimeTraceScope timeScope("Load input files");
   // This loop should be reserved for options whose exact ordering matters.
@@ -1204,6 +1225,8 @@ static void createFiles(const InputArgList &args) {
       break;
     }
   }
+  if (parallel::strategy.compute_thread_count() > 1)
+    pageInInputFiles();
 }
 
 static void gatherInputSections() {
@@ -1866,10 +1889,16 @@ bool link(ArrayRef<const char *> argsArr, llvm::raw_ostream &stdoutOS,
   config->timeTraceEnabled = args.hasArg(OPT_time_trace_eq);
   config->timeTraceGranularity =
       args::getInteger(args, OPT_time_trace_granularity_eq, 500);
+  config->timeTraceOptions.MaxEventsPerThread =
+      args::getInteger(args, OPT_time_trace_max_events_eq, 0);
+  config->timeTraceOptions.SummaryOnly = args.hasArg(OPT_time_trace_summary);
+  config->timeTraceOptions.MaxTotals =
+      args::getInteger(args, OPT_time_trace_max_totals_eq, 0);
 
   // Initialize time trace profiler.
   if (config->timeTraceEnabled)
-    timeTraceProfilerInitialize(config->timeTraceGranularity, config->progName);
+    timeTraceProfilerInitialize(config->timeTraceGranularity, config->progName,
+                                config->timeTraceOptions);
 
   {
     TimeTraceScope timeScope("ExecuteLinker");
@@ -1313,7 +1313,8 @@ template <class LP> void Writer::run() {
   finalizeAddresses();
   threadPool.async([&] {
     if (LLVM_ENABLE_THREADS && config->timeTraceEnabled)
-      timeTraceProfilerInitialize(config->timeTraceGranularity, "writeMapFile");
+      timeTraceProfilerInitialize(config->timeTraceGranularity, "writeMapFile",
+                                  config->timeTraceOptions);
     writeMapFile();
     if (LLVM_ENABLE_THREADS && config->timeTraceEnabled)
       timeTraceProfilerFinishThread();
@@ -0,0 +1,49 @@
+# RUN: llvm-mc -filetype=obj -triple=wasm32-unknown-unknown %s -o %t.o
+
+# Test implicit trace file name
+# RUN: wasm-ld --time-trace --time-trace-granularity=0 -o %t1.wasm %t.o
+# RUN: cat %t1.wasm.time-trace \
+# RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+# RUN:   | FileCheck %s
+# RUN: FileCheck %s --check-prefix=SCOPES < %t1.wasm.time-trace
+
+# Test specified trace file name
+# RUN: wasm-ld --time-trace=%t2.json --time-trace-granularity=0 -o %t2.wasm %t.o
+# RUN: cat %t2.json \
+# RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+# RUN:   | FileCheck %s
+
+# Test trace requested to stdout
+# RUN: env LLD_IN_TEST=1 wasm-ld --time-trace=- --time-trace-granularity=0 -o %t3.wasm %t.o \
+# RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+# RUN:   | FileCheck %s
+
+# CHECK:      "beginningOfTime": {{[0-9]{16},}}
+# CHECK-NEXT: "traceEvents": [
+
+# Check one event has correct fields
+# CHECK:      "dur":
+# CHECK-NEXT: "name":
+# CHECK-NEXT: "ph":
+# CHECK-NEXT: "pid":
+# CHECK-NEXT: "tid":
+# CHECK-NEXT: "ts":
+
+# Check there is an ExecuteLinker event
+# CHECK: "name": "ExecuteLinker"
+
+# Check process_name entry field
+# CHECK: "name": "wasm-ld{{(.exe)?}}"
+# CHECK: "name": "process_name"
+# CHECK: "name": "thread_name"
+
+# Check the scopes of the main link phases
+# SCOPES-DAG: "name":"Add files to the symbol table"
+# SCOPES-DAG: "name":"Garbage collection"
+# SCOPES-DAG: "name":"Scan relocations"
+# SCOPES-DAG: "name":"Write output sections"
+
+.globl _start
+_start:
+  .functype _start () -> ()
+  end_function
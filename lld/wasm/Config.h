@@ -65,6 +65,7 @@ struct Configuration {
   bool stripDebug;
   bool stackFirst;
   bool isStatic = false;
+  bool timeTraceEnabled;
   bool trace;
   uint64_t globalBase;
   uint64_t initialMemory;
@@ -75,6 +76,7 @@ struct Configuration {
   llvm::CodeGenOptLevel ltoCgo;
   unsigned optimize;
   llvm::StringRef thinLTOJobs;
+  unsigned timeTraceGranularity;
   bool ltoDebugPassManager;
   UnresolvedPolicy unresolvedSymbols;
   BuildIdKind buildId = BuildIdKind::None;
@@ -32,6 +32,7 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/TargetParser/Host.h"
 #include <optional>
 
@@ -72,6 +73,7 @@ public:
   void linkerMain(ArrayRef<const char *> argsArr);
 
 private:
+  void link(opt::InputArgList &args);
   void createFiles(opt::InputArgList &args);
   void addFile(StringRef path);
   void addLibrary(StringRef name);
@@ -490,6 +492,9 @@ static void readConfigs(opt::InputArgList &args) {
   config->stripAll = args.hasArg(OPT_strip_all);
   config->stripDebug = args.hasArg(OPT_strip_debug);
   config->stackFirst = args.hasArg(OPT_stack_first);
+  config->timeTraceEnabled = args.hasArg(OPT_time_trace_eq);
+  config->timeTraceGranularity =
+      args::getInteger(args, OPT_time_trace_granularity, 500);
   config->trace = args.hasArg(OPT_trace);
   config->thinLTOCacheDir = args.getLastArgValue(OPT_thinlto_cache_dir);
   config->thinLTOCachePolicy = CHECK(
@@ -1161,6 +1166,23 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   readConfigs(args);
   setConfigs();
 
+  // Initialize time trace profiler.
+  if (config->timeTraceEnabled)
+    timeTraceProfilerInitialize(config->timeTraceGranularity, argsArr[0]);
+
+  {
+    llvm::TimeTraceScope timeScope("ExecuteLinker");
+    link(args);
+  }
+
+  if (config->timeTraceEnabled) {
+    checkError(timeTraceProfilerWrite(
+        args.getLastArgValue(OPT_time_trace_eq).str(), config->outputFile));
+    timeTraceProfilerCleanup();
+  }
+}
+
+void LinkerDriver::link(opt::InputArgList &args) {
   createFiles(args);
   if (errorCount())
     return;
@@ -1198,8 +1220,11 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
 
   // Add all files to the symbol table. This will add almost all
   // symbols that we need to the symbol table.
-  for (InputFile *f : files)
-    symtab->addFile(f);
+  {
+    llvm::TimeTraceScope timeScope("Add files to the symbol table");
+    for (InputFile *f : files)
+      symtab->addFile(f);
+  }
   if (errorCount())
     return;
 
@@ -1273,7 +1298,10 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
 
   // Do link-time optimization if given files are LLVM bitcode files.
   // This compiles bitcode files into real object files.
-  symtab->compileBitcodeFiles();
+  {
+    llvm::TimeTraceScope timeScope("LTO");
+    symtab->compileBitcodeFiles();
+  }
   if (errorCount())
     return;
 
@@ -1323,7 +1351,10 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   demoteLazySymbols();
 
   // Do size optimizations: garbage collection
-  markLive();
+  {
+    llvm::TimeTraceScope timeScope("Garbage collection");
+    markLive();
+  }
 
   // Provide the indirect function table if needed.
   WasmSym::indirectFunctionTable =
@@ -65,7 +65,27 @@ void CodeSection::finalizeContents() {
   createHeader(bodySize);
 }
 
-void CodeSection::writeTo(uint8_t *buf) {
+// Writes chunks asynchronously, in tasks of up to about 4 MiB, to overlap the
+// write time with other output sections. Each chunk writes only to its own
+// range of the section, so the tasks never touch the same bytes.
+template <class ChunkT>
+static void writeChunks(ArrayRef<ChunkT *> chunks, uint8_t *buf,
+                        parallel::TaskGroup &tg) {
+  const size_t taskSizeLimit = 4 << 20;
+  for (size_t begin = 0, i = 0, taskSize = 0; i != chunks.size();) {
+    taskSize += chunks[i]->getSize();
+    if (++i == chunks.size() || taskSize >= taskSizeLimit) {
+      tg.spawn([=] {
+        for (const InputChunk *chunk : chunks.slice(begin, i - begin))
+          chunk->writeTo(buf);
+      });
+      begin = i;
+      taskSize = 0;
+    }
+  }
+}
+
+void CodeSection::writeTo(uint8_t *buf, parallel::TaskGroup &tg) {
   log("writing " + toString(*this) + " offset=" + Twine(offset) +
       " size=" + Twine(getSize()));
   log(" headersize=" + Twine(header.size()));
@@ -80,8 +100,7 @@ void CodeSection::writeTo(uint8_t *buf) {
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
   // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  writeChunks(functions, buf, tg);
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -164,7 +183,7 @@ void DataSection::finalizeContents() {
   createHeader(bodySize);
 }
 
-void DataSection::writeTo(uint8_t *buf) {
+void DataSection::writeTo(uint8_t *buf, parallel::TaskGroup &tg) {
   log("writing " + toString(*this) + " offset=" + Twine(offset) +
       " size=" + Twine(getSize()) + " body=" + Twine(bodySize));
   buf += offset;
@@ -184,8 +203,7 @@ void DataSection::writeTo(uint8_t *buf) {
     memcpy(segStart, segment->header.data(), segment->header.size());
 
     // Write segment data payload
-    for (const InputChunk *chunk : segment->inputSegments)
-      chunk->writeTo(buf);
+    writeChunks(ArrayRef(segment->inputSegments), buf, tg);
   }
 }
 
@@ -256,7 +274,7 @@ void CustomSection::finalizeContents() {
   createHeader(payloadSize + nameData.size());
 }
 
-void CustomSection::writeTo(uint8_t *buf) {
+void CustomSection::writeTo(uint8_t *buf, parallel::TaskGroup &tg) {
   log("writing " + toString(*this) + " offset=" + Twine(offset) +
       " size=" + Twine(getSize()) + " chunks=" + Twine(inputSections.size()));
 
@@ -270,8 +288,7 @@ void CustomSection::writeTo(uint8_t *buf) {
   buf += nameData.size();
 
   // Write custom sections payload
-  for (const InputChunk *section : inputSections)
-    section->writeTo(buf);
+  writeChunks(ArrayRef(inputSections), buf, tg);
 }
 
 uint32_t CustomSection::getNumRelocations() const {
@@ -17,7 +17,6 @@
 #include "SymbolTable.h"
 #include "SyntheticSections.h"
 #include "WriterUtils.h"
-#include "lld/Common/Arrays.h"
 #include "lld/Common/CommonLinkerContext.h"
 #include "lld/Common/Strings.h"
 #include "llvm/ADT/ArrayRef.h"
@@ -35,6 +34,7 @@
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/RandomNumberGenerator.h"
 #include "llvm/Support/SHA1.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/xxhash.h"
 
 #include <cstdarg>
@@ -218,32 +218,15 @@ void Writer::writeHeader() {
 }
 
 void Writer::writeSections() {
+  llvm::TimeTraceScope timeScope("Write output sections");
   uint8_t *buf = buffer->getBufferStart();
-  parallelForEach(outputSections, [buf](OutputSection *s) {
+  // Sections hand their large chunk lists to the shared task group, so that
+  // the chunks of all sections are written in parallel.
+  parallel::TaskGroup tg;
+  for (OutputSection *s : outputSections) {
     assert(s->isNeeded());
-    s->writeTo(buf);
-  });
-}
-
-// Computes a hash value of Data using a given hash function.
-// In order to utilize multiple cores, we first split data into 1MB
-// chunks, compute a hash for each chunk, and then compute a hash value
-// of the hash values.
-
-static void
-computeHash(llvm::MutableArrayRef<uint8_t> hashBuf,
-            llvm::ArrayRef<uint8_t> data,
-            std::function<void(uint8_t *dest, ArrayRef<uint8_t> arr)> hashFn) {
-  std::vector<ArrayRef<uint8_t>> chunks = split(data, 1024 * 1024);
-  std::vector<uint8_t> hashes(chunks.size() * hashBuf.size());
-
-  // Compute hash values.
-  parallelFor(0, chunks.size(), [&](size_t i) {
-    hashFn(hashes.data() + i * hashBuf.size(), chunks[i]);
-  });
-
-  // Write to the final output buffer.
-  hashFn(hashBuf.data(), hashes);
+    s->writeTo(buf, tg);
+  }
 }
 
 static void makeUUID(unsigned version, llvm::ArrayRef<uint8_t> fileHash,
@@ -275,6 +258,7 @@ static void makeUUID(unsigned version, llvm::ArrayRef<uint8_t> fileHash,
 }
 
 void Writer::writeBuildId() {
+  llvm::TimeTraceScope timeScope("Write build ID");
   if (!out.buildIdSec->isNeeded())
     return;
   if (config->buildId == BuildIdKind::Hexstring) {
@@ -290,14 +274,14 @@ void Writer::writeBuildId() {
   switch (config->buildId) {
   case BuildIdKind::Fast: {
     std::vector<uint8_t> fileHash(8);
-    computeHash(fileHash, buf, [](uint8_t *dest, ArrayRef<uint8_t> arr) {
+    parallelTreeHash(fileHash, buf, [](uint8_t *dest, ArrayRef<uint8_t> arr) {
       support::endian::write64le(dest, xxh3_64bits(arr));
     });
     makeUUID(5, fileHash, buildId);
     break;
   }
   case BuildIdKind::Sha1:
-    computeHash(buildId, buf, [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
+    parallelTreeHash(buildId, buf, [&](uint8_t *dest, ArrayRef<uint8_t> arr) {
       memcpy(dest, SHA1::hash(arr).data(), hashSize);
     });
     break;
@@ -544,6 +528,7 @@ void Writer::addSections() {
 }
 
 void Writer::finalizeSections() {
+  llvm::TimeTraceScope timeScope("Finalize sections");
   for (OutputSection *s : outputSections) {
     s->setOffset(fileSize);
     s->finalizeContents();
@@ -929,6 +914,7 @@ static void finalizeIndirectFunctionTable() {
 }
 
 static void scanRelocations() {
+  llvm::TimeTraceScope timeScope("Scan relocations");
   for (ObjFile *file : symtab->objectFiles) {
     LLVM_DEBUG(dbgs() << "scanRelocations: " << file->getName() << "\n");
     for (InputChunk *chunk : file->functions)
@@ -941,6 +927,7 @@ static void scanRelocations() {
 }
 
 void Writer::assignIndexes() {
+  llvm::TimeTraceScope timeScope("Assign indexes");
   // Seal the import section, since other index spaces such as function and
   // global are effected by the number of imports.
   out.importSec->seal();
@@ -1675,6 +1662,7 @@ void Writer::createSyntheticSectionsPostLayout() {
 }
 
 void Writer::run() {
+  llvm::TimeTraceScope timeScope("Write output file");
   // For PIC code the table base is assigned dynamically by the loader.
   // For non-PIC, we start at 1 so that accessing table index 0 always traps.
   if (!config->isPic) {
@@ -592,6 +592,10 @@ public:
   /// Get the time it took to resolve all locations in this breakpoint.
   StatsDuration::Duration GetResolveTime() const { return m_resolve_time; }
 
+  /// Get the total time spent evaluating the conditions of this breakpoint's
+  /// locations, including parsing them.
+  StatsDuration::Duration GetConditionTime() const { return m_condition_time; }
+
 protected:
   friend class Target;
   // Protected Methods
@@ -670,6 +674,7 @@ private:
   BreakpointName::Permissions m_permissions;
 
   StatsDuration m_resolve_time;
+  StatsDuration m_condition_time;
 
   void SendBreakpointChangedEvent(lldb::BreakpointEventType eventKind);
 
@@ -10,6 +10,7 @@
 #define LLDB_BREAKPOINT_WATCHPOINT_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "lldb/Breakpoint/StoppointSite.h"
@@ -180,6 +181,33 @@ public:
   //     condition has been set.
   const char *GetConditionText() const;
 
+  /// Evaluate the condition expression in \a exe_ctx.
+  ///
+  /// The expression is parsed and JIT compiled the first time it is evaluated
+  /// and the compiled code is reused for every later hit, as long as the
+  /// execution context still matches the one it was compiled for.
+  ///
+  /// \param[in] exe_ctx
+  ///    The context to evaluate the condition in.
+  ///
+  /// \param[in] options
+  ///    The options to execute the expression with.
+  ///
+  /// \param[out] result_valobj_sp
+  ///    The value of the condition, if it was evaluated successfully.
+  ///
+  /// \param[out] error
+  ///    A description of the failure if the condition could not be parsed
+  ///    or executed.
+  ///
+  /// \return
+  ///    The result of executing the condition. Parse failures are reported
+  ///    as lldb::eExpressionParseError.
+  lldb::ExpressionResults
+  EvaluateCondition(ExecutionContext &exe_ctx,
+                    const EvaluateExpressionOptions &options,
+                    lldb::ValueObjectSP &result_valobj_sp, Status &error);
+
   void TurnOnEphemeralMode();
 
   void TurnOffEphemeralMode();
@@ -229,7 +257,9 @@ private:
                  // the callback machinery.
   bool m_being_created;
 
-  std::unique_ptr<UserExpression> m_condition_up; // The condition to test.
+  lldb::UserExpressionSP m_condition_sp; // The condition to test.
+  bool m_condition_parsed = false; // True if m_condition_sp has been parsed.
+  std::mutex m_condition_mutex; // Guards parsing and running the condition.
 
   void SetID(lldb::watch_id_t id) { m_id = id; }
 
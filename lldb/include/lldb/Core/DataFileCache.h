@@ -9,6 +9,7 @@
 #ifndef LLDB_CORE_DATAFILECACHE_H
 #define LLDB_CORE_DATAFILECACHE_H
 
+#include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/UUID.h"
@@ -216,11 +217,20 @@ public:
 
   llvm::StringRef Get(uint32_t offset) const;
 
+  /// Get the string at \a offset as a ConstString.
+  ///
+  /// The same names are referenced many times from the tables of a cache file,
+  /// so the result is remembered per offset and each string is only hashed
+  /// into the ConstString pool once. This is not thread safe.
+  ConstString GetConstString(uint32_t offset) const;
+
   bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr);
 
 protected:
   /// All of the strings in the string table are contained in m_data.
   llvm::StringRef m_data;
+  /// ConstStrings already handed out by GetConstString(), by offset.
+  mutable llvm::DenseMap<uint32_t, ConstString> m_const_strings;
 };
 
 } // namespace lldb_private
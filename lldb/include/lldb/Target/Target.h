@@ -97,6 +97,8 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  bool GetParallelModuleLoad() const;
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -236,6 +236,7 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
   Log *log = GetLog(LLDBLog::Breakpoints);
 
   std::lock_guard<std::mutex> guard(m_condition_mutex);
+  ElapsedTime elapsed(m_owner.m_condition_time);
 
   size_t condition_hash;
   const char *condition_text = GetConditionText(&condition_hash);
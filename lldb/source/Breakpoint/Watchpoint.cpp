@@ -12,6 +12,8 @@
 #include "lldb/Core/Value.h"
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Core/ValueObjectMemory.h"
+#include "lldb/Expression/DiagnosticManager.h"
+#include "lldb/Expression/ExpressionVariable.h"
 #include "lldb/Expression/UserExpression.h"
 #include "lldb/Symbol/TypeSystem.h"
 #include "lldb/Target/Process.h"
@@ -399,31 +401,85 @@ bool Watchpoint::InvokeCallback(StoppointCallbackContext *context) {
 }
 
 void Watchpoint::SetCondition(const char *condition) {
-  if (condition == nullptr || condition[0] == '\0') {
-    if (m_condition_up)
-      m_condition_up.reset();
-  } else {
-    // Pass nullptr for expr_prefix (no translation-unit level definitions).
-    Status error;
-    m_condition_up.reset(m_target.GetUserExpressionForLanguage(
-        condition, llvm::StringRef(), lldb::eLanguageTypeUnknown,
-        UserExpression::eResultTypeAny, EvaluateExpressionOptions(), nullptr,
-        error));
-    if (error.Fail()) {
-      // FIXME: Log something...
-      m_condition_up.reset();
+  {
+    std::lock_guard<std::mutex> guard(m_condition_mutex);
+    m_condition_parsed = false;
+    if (condition == nullptr || condition[0] == '\0') {
+      if (m_condition_sp)
+        m_condition_sp.reset();
+    } else {
+      // Pass nullptr for expr_prefix (no translation-unit level definitions).
+      Status error;
+      m_condition_sp.reset(m_target.GetUserExpressionForLanguage(
+          condition, llvm::StringRef(), lldb::eLanguageTypeUnknown,
+          UserExpression::eResultTypeAny, EvaluateExpressionOptions(), nullptr,
+          error));
+      if (error.Fail()) {
+        // FIXME: Log something...
+        m_condition_sp.reset();
+      }
     }
   }
   SendWatchpointChangedEvent(eWatchpointEventTypeConditionChanged);
 }
 
 const char *Watchpoint::GetConditionText() const {
-  if (m_condition_up)
-    return m_condition_up->GetUserText();
+  if (m_condition_sp)
+    return m_condition_sp->GetUserText();
   else
     return nullptr;
 }
 
+ExpressionResults
+Watchpoint::EvaluateCondition(ExecutionContext &exe_ctx,
+                              const EvaluateExpressionOptions &options,
+                              ValueObjectSP &result_valobj_sp, Status &error) {
+  std::lock_guard<std::mutex> guard(m_condition_mutex);
+  if (!m_condition_sp) {
+    error.SetErrorString("watchpoint has no condition");
+    return eExpressionSetupError;
+  }
+
+  DiagnosticManager diagnostics;
+  if (!m_condition_parsed || !m_condition_sp->MatchesContext(exe_ctx)) {
+    if (m_condition_parsed) {
+      // The condition was compiled for another context, start over from its
+      // text.
+      std::string condition_text(m_condition_sp->GetUserText());
+      m_condition_parsed = false;
+      m_condition_sp.reset(m_target.GetUserExpressionForLanguage(
+          condition_text, llvm::StringRef(), lldb::eLanguageTypeUnknown,
+          UserExpression::eResultTypeAny, EvaluateExpressionOptions(), nullptr,
+          error));
+      if (error.Fail()) {
+        m_condition_sp.reset();
+        return eExpressionSetupError;
+      }
+    }
+    if (!m_condition_sp->Parse(diagnostics, exe_ctx,
+                               eExecutionPolicyOnlyWhenNeeded, true, false)) {
+      error.SetErrorStringWithFormat(
+          "Couldn't parse conditional expression:\n%s",
+          diagnostics.GetString().c_str());
+      return eExpressionParseError;
+    }
+    m_condition_parsed = true;
+  }
+
+  diagnostics.Clear();
+  ExpressionVariableSP result_variable_sp;
+  ExpressionResults result_code = m_condition_sp->Execute(
+      diagnostics, exe_ctx, options, m_condition_sp, result_variable_sp);
+  if (result_code != eExpressionCompleted) {
+    error.SetErrorStringWithFormat("Couldn't execute expression:\n%s",
+                                   diagnostics.GetString().c_str());
+    return result_code;
+  }
+  if (result_variable_sp)
+    result_valobj_sp = result_variable_sp->GetValueObject();
+  return result_code;
+}
+
 void Watchpoint::SendWatchpointChangedEvent(
     lldb::WatchpointEventType eventKind) {
   if (!m_being_created &&
@@ -311,6 +311,7 @@ bool StringTableReader::Decode(const lldb_private::DataExtractor &data,
   if (bytes == nullptr)
     return false;
   m_data = llvm::StringRef(bytes, length);
+  m_const_strings.clear();
   return true;
 }
 
@@ -320,3 +321,10 @@ llvm::StringRef StringTableReader::Get(uint32_t offset) const {
   return llvm::StringRef(m_data.data() + offset);
 }
 
+ConstString StringTableReader::GetConstString(uint32_t offset) const {
+  auto [it, inserted] = m_const_strings.try_emplace(offset);
+  if (inserted)
+    it->second = ConstString(Get(offset));
+  return it->second;
+}
+
@@ -10,6 +10,7 @@
 #include "DynamicLoaderPOSIXDYLD.h"
 
 #include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
@@ -24,6 +25,8 @@
 #include "lldb/Utility/LLDBLog.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/ProcessInfo.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/ThreadPool.h"
 
 #include <memory>
 #include <optional>
@@ -644,6 +647,9 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
 
+  // Keeps the modules created in parallel alive until they are loaded below.
+  std::vector<ModuleSP> preloaded_modules = PreloadModules(module_names);
+
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
     ModuleSP module_sp =
         LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
@@ -664,6 +670,46 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_initial_modules_added = true;
 }
 
+std::vector<ModuleSP> DynamicLoaderPOSIXDYLD::PreloadModules(
+    const std::vector<FileSpec> &module_names) {
+  std::vector<ModuleSP> modules;
+  Target &target = m_process->GetTarget();
+  PlatformSP platform_sp = target.GetPlatform();
+  if (!target.GetParallelModuleLoad() || !platform_sp ||
+      module_names.size() < 2)
+    return modules;
+
+  // Creating a module parses its object file and, with preload-symbols, its
+  // symbol table, which is where most of the time goes when a process has many
+  // shared libraries. Do that for all of them in parallel, through the
+  // platform's shared module cache only. Adding the modules to the target's
+  // image list is left to the loading loop, which does it serially and in
+  // link-map order, so the order of the image list does not depend on which
+  // task finishes first. Duplicate names are dropped so two tasks never race
+  // to create the same module.
+  modules.resize(module_names.size());
+  const FileSpecList search_paths = target.GetExecutableSearchPaths();
+  const ArchSpec &arch = target.GetArchitecture();
+  const bool preload_symbols = target.GetPreloadSymbols();
+  llvm::DenseSet<ConstString> seen;
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (size_t i = 0; i < module_names.size(); ++i) {
+    if (!seen.insert(ConstString(module_names[i].GetPath())).second)
+      continue;
+    task_group.async([&, i] {
+      ModuleSpec module_spec(module_names[i], arch);
+      ModuleSP module_sp;
+      platform_sp->GetSharedModule(module_spec, m_process, module_sp,
+                                   &search_paths, nullptr, nullptr);
+      if (module_sp && preload_symbols)
+        module_sp->PreloadSymbols();
+      modules[i] = module_sp;
+    });
+  }
+  task_group.wait();
+  return modules;
+}
+
 addr_t DynamicLoaderPOSIXDYLD::ComputeLoadOffset() {
   addr_t virt_entry;
 
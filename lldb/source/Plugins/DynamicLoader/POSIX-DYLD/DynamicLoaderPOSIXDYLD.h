@@ -146,6 +146,13 @@ protected:
   /// of all dependent modules.
   virtual void LoadAllCurrentModules();
 
+  /// Create the modules for \a module_names in parallel ahead of loading
+  /// them, if the target's parallel-module-load setting allows it. The
+  /// modules are not added to the target; the result is indexed like
+  /// \a module_names and is empty if nothing was preloaded.
+  std::vector<lldb::ModuleSP>
+  PreloadModules(const std::vector<lldb_private::FileSpec> &module_names);
+
   void LoadVDSO();
 
   // Loading an interpreter module (if present) assuming m_interpreter_base
@@ -166,6 +166,12 @@ public:
     const uint32_t idx = ePropertyUseGPacketForReading;
     return GetPropertyAtIndexAs<bool>(idx, true);
   }
+
+  uint64_t GetStackPrefetchSize() const {
+    const uint32_t idx = ePropertyStackPrefetchSize;
+    return GetPropertyAtIndexAs<uint64_t>(
+        idx, g_processgdbremote_properties[idx].default_uint_value);
+  }
 };
 
 } // namespace
@@ -2363,6 +2369,40 @@ void ProcessGDBRemote::RefreshStateAfterStop() {
   // Let all threads recover from stopping and do any clean up based on the
   // previous thread state (if any).
   m_thread_list_real.RefreshStateAfterStop();
+
+  PrefetchStackMemory();
+}
+
+void ProcessGDBRemote::PrefetchStackMemory() {
+  const uint64_t prefetch_size =
+      GetGlobalPluginProperties().GetStackPrefetchSize();
+  if (prefetch_size == 0)
+    return;
+
+  ThreadSP thread_sp = m_thread_list.GetSelectedThread();
+  if (!thread_sp)
+    return;
+  RegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext();
+  if (!reg_ctx_sp)
+    return;
+  // The stack pointer is normally expedited in the stop reply, so this does
+  // not cost a packet.
+  const addr_t sp = reg_ctx_sp->GetSP(LLDB_INVALID_ADDRESS);
+  if (sp == LLDB_INVALID_ADDRESS)
+    return;
+
+  // Read the whole range with one packet (DoReadMemory clamps it to what the
+  // stub accepts) and hand it to the memory cache, like the expedited memory
+  // of a stop reply. A short read near the end of the stack mapping is fine,
+  // whatever was read is cached.
+  auto data_buffer_sp = std::make_shared<DataBufferHeap>(prefetch_size, 0);
+  Status error;
+  const size_t bytes_read =
+      DoReadMemory(sp, data_buffer_sp->GetBytes(), prefetch_size, error);
+  if (bytes_read == 0)
+    return;
+  data_buffer_sp->SetByteSize(bytes_read);
+  m_memory_cache.AddL1CacheData(sp, data_buffer_sp);
 }
 
 Status ProcessGDBRemote::DoHalt(bool &caused_stop) {
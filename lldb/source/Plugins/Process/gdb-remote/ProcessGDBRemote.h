@@ -376,6 +376,10 @@ protected:
 
   bool UpdateThreadIDList();
 
+  /// Read stack memory of the selected thread into the memory cache, as
+  /// configured by the stack-prefetch-size setting.
+  void PrefetchStackMemory();
+
   void DidLaunchOrAttach(ArchSpec &process_arch);
   void LoadStubBinaries();
   void MaybeLoadExecutableModule();
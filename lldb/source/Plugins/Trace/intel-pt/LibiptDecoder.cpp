@@ -8,6 +8,7 @@
 #include "LibiptDecoder.h"
 #include "TraceIntelPT.h"
 #include "lldb/Target/Process.h"
+#include <cstring>
 #include <optional>
 
 using namespace lldb;
@@ -66,6 +67,49 @@ static Expected<pt_config> CreateBasicLibiptConfig(TraceIntelPT &trace_intel_pt,
   return config;
 }
 
+namespace {
+/// Serves the memory reads of a libipt instruction decoder from the process,
+/// one page at a time. The decoder asks for the bytes of every instruction it
+/// decodes, and almost all of them fall in the same page as the previous one,
+/// so this saves a process memory read per decoded instruction.
+class ProcessMemoryReader {
+public:
+  ProcessMemoryReader(Process &process) : m_process(process) {}
+
+  int Read(uint8_t *buffer, size_t size, lldb::addr_t pc) {
+    const lldb::addr_t page = pc & ~(kPageSize - 1);
+    if (page != m_page) {
+      m_page = page;
+      Status error;
+      m_data.resize(kPageSize);
+      size_t bytes_read =
+          m_process.ReadMemory(page, m_data.data(), kPageSize, error);
+      m_data.resize(error.Fail() ? 0 : bytes_read);
+    }
+
+    if (pc + size <= m_page + m_data.size()) {
+      memcpy(buffer, m_data.data() + (pc - m_page), size);
+      return size;
+    }
+
+    // The instruction spans two pages or the page couldn't be read whole, so
+    // read exactly what was requested.
+    Status error;
+    int bytes_read = m_process.ReadMemory(pc, buffer, size, error);
+    if (error.Fail())
+      return -pte_nomap;
+    return bytes_read;
+  }
+
+private:
+  static constexpr lldb::addr_t kPageSize = 4096;
+
+  Process &m_process;
+  lldb::addr_t m_page = LLDB_INVALID_ADDRESS;
+  std::vector<uint8_t> m_data;
+};
+} // namespace
+
 /// Callback used by libipt for reading the process memory.
 ///
 /// More information can be found in
@@ -73,20 +117,15 @@ static Expected<pt_config> CreateBasicLibiptConfig(TraceIntelPT &trace_intel_pt,
 static int ReadProcessMemory(uint8_t *buffer, size_t size,
                              const pt_asid * /* unused */, uint64_t pc,
                              void *context) {
-  Process *process = static_cast<Process *>(context);
-
-  Status error;
-  int bytes_read = process->ReadMemory(pc, buffer, size, error);
-  if (error.Fail())
-    return -pte_nomap;
-  return bytes_read;
+  return static_cast<ProcessMemoryReader *>(context)->Read(buffer, size, pc);
 }
 
 /// Set up the memory image callback for the given decoder.
-static Error SetupMemoryImage(pt_insn_decoder *decoder, Process &process) {
+static Error SetupMemoryImage(pt_insn_decoder *decoder,
+                              ProcessMemoryReader &reader) {
   pt_image *image = pt_insn_get_image(decoder);
 
-  int status = pt_image_set_callback(image, ReadProcessMemory, &process);
+  int status = pt_image_set_callback(image, ReadProcessMemory, &reader);
   if (IsLibiptError(status))
     return make_error<IntelPTError>(status);
   return Error::success();
@@ -95,7 +134,7 @@ static Error SetupMemoryImage(pt_insn_decoder *decoder, Process &process) {
 /// Create an instruction decoder for the given buffer and the given process.
 static Expected<PtInsnDecoderUP>
 CreateInstructionDecoder(TraceIntelPT &trace_intel_pt, ArrayRef<uint8_t> buffer,
-                         Process &process) {
+                         ProcessMemoryReader &reader) {
   Expected<pt_config> config = CreateBasicLibiptConfig(trace_intel_pt, buffer);
   if (!config)
     return config.takeError();
@@ -106,7 +145,7 @@ CreateInstructionDecoder(TraceIntelPT &trace_intel_pt, ArrayRef<uint8_t> buffer,
 
   PtInsnDecoderUP decoder_up(decoder_ptr, InsnDecoderDeleter);
 
-  if (Error err = SetupMemoryImage(decoder_ptr, process))
+  if (Error err = SetupMemoryImage(decoder_ptr, reader))
     return std::move(err);
 
   return decoder_up;
@@ -335,11 +374,13 @@ public:
   /// \param[in] tsc_upper_bound
   ///   Maximum allowed value of TSCs decoded from this PSB block.
   ///   Any of this PSB's data occurring after this TSC will be excluded.
-  PSBBlockDecoder(PtInsnDecoderUP &&decoder_up, const PSBBlock &psb_block,
+  PSBBlockDecoder(std::unique_ptr<ProcessMemoryReader> &&reader_up,
+                  PtInsnDecoderUP &&decoder_up, const PSBBlock &psb_block,
                   std::optional<lldb::addr_t> next_block_ip,
                   DecodedThread &decoded_thread, TraceIntelPT &trace_intel_pt,
                   std::optional<DecodedThread::TSC> tsc_upper_bound)
-      : m_decoder_up(std::move(decoder_up)), m_psb_block(psb_block),
+      : m_reader_up(std::move(reader_up)),
+        m_decoder_up(std::move(decoder_up)), m_psb_block(psb_block),
         m_next_block_ip(next_block_ip), m_decoded_thread(decoded_thread),
         m_anomaly_detector(*m_decoder_up, trace_intel_pt, decoded_thread),
         m_tsc_upper_bound(tsc_upper_bound) {}
@@ -373,13 +414,15 @@ public:
          std::optional<lldb::addr_t> next_block_ip,
          DecodedThread &decoded_thread,
          std::optional<DecodedThread::TSC> tsc_upper_bound) {
+    auto reader_up = std::make_unique<ProcessMemoryReader>(process);
     Expected<PtInsnDecoderUP> decoder_up =
-        CreateInstructionDecoder(trace_intel_pt, buffer, process);
+        CreateInstructionDecoder(trace_intel_pt, buffer, *reader_up);
     if (!decoder_up)
       return decoder_up.takeError();
 
-    return PSBBlockDecoder(std::move(*decoder_up), psb_block, next_block_ip,
-                           decoded_thread, trace_intel_pt, tsc_upper_bound);
+    return PSBBlockDecoder(std::move(reader_up), std::move(*decoder_up),
+                           psb_block, next_block_ip, decoded_thread,
+                           trace_intel_pt, tsc_upper_bound);
   }
 
   void DecodePSBBlock() {
@@ -550,6 +593,8 @@ private:
   }
 
 private:
+  /// The memory reader used by \a m_decoder_up, so it must outlive it.
+  std::unique_ptr<ProcessMemoryReader> m_reader_up;
   PtInsnDecoderUP m_decoder_up;
   PSBBlock m_psb_block;
   std::optional<lldb::addr_t> m_next_block_ip;
@@ -914,9 +914,8 @@ protected:
           expr_options.SetIgnoreBreakpoints(true);
           ValueObjectSP result_value_sp;
           Status error;
-          result_code = UserExpression::Evaluate(
-              exe_ctx, expr_options, wp_sp->GetConditionText(),
-              llvm::StringRef(), result_value_sp, error);
+          result_code = wp_sp->EvaluateCondition(exe_ctx, expr_options,
+                                                 result_value_sp, error);
 
           if (result_code == eExpressionCompleted) {
             if (result_value_sp) {
@@ -4251,6 +4251,12 @@ void TargetProperties::SetPreloadSymbols(bool b) {
   SetPropertyAtIndex(idx, b);
 }
 
+bool TargetProperties::GetParallelModuleLoad() const {
+  const uint32_t idx = ePropertyParallelModuleLoad;
+  return GetPropertyAtIndexAs<bool>(
+      idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetDisableASLR() const {
   const uint32_t idx = ePropertyDisableASLR;
   return GetPropertyAtIndexAs<bool>(
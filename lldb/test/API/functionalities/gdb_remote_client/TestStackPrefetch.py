@@ -0,0 +1,85 @@
+import lldb
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+from lldbsuite.test import lldbutil
+from lldbsuite.test.gdbclientutils import *
+from lldbsuite.test.lldbgdbclient import GDBRemoteTestBase
+
+
+class TestStackPrefetch(GDBRemoteTestBase):
+    STACK_POINTER = 0x2000
+    PREFETCH_SIZE = 0x100
+
+    class MyResponder(MockGDBServerResponder):
+        def __init__(self):
+            super().__init__()
+            self.memory_byte = "aa"
+
+        def qSupported(self, client_supported):
+            return "PacketSize=3fff;QStartNoAckMode+;qXfer:features:read+"
+
+        def qXferRead(self, obj, annex, offset, length):
+            if annex == "target.xml":
+                return (
+                    """<?xml version="1.0"?>
+                    <target version="1.0">
+                      <architecture>i386:x86-64</architecture>
+                      <feature name="org.gnu.gdb.i386.core">
+                        <reg name="rip" bitsize="64" regnum="0" type="code_ptr" group="general" generic="pc"/>
+                        <reg name="rsp" bitsize="64" regnum="1" type="data_ptr" group="general" generic="sp"/>
+                        <reg name="rbp" bitsize="64" regnum="2" type="data_ptr" group="general" generic="fp"/>
+                      </feature>
+                    </target>""",
+                    False,
+                )
+            return None, False
+
+        def haltReason(self):
+            return (
+                "T05thread:1;00:0010000000000000;01:0020000000000000;"
+                "02:0020000000000000;"
+            )
+
+        def readRegister(self, regnum):
+            return "E01"
+
+        def readMemory(self, addr, length):
+            return self.memory_byte * length
+
+    def connect_with_prefetch(self, size):
+        self.runCmd(
+            "settings set plugin.process.gdb-remote.stack-prefetch-size %d" % size
+        )
+        self.addTearDownHook(
+            lambda: self.runCmd(
+                "settings clear plugin.process.gdb-remote.stack-prefetch-size"
+            )
+        )
+        self.server.responder = self.MyResponder()
+        target = self.dbg.CreateTarget("")
+        process = self.connect(target)
+        lldbutil.expect_state_changes(
+            self, self.dbg.GetListener(), process, [lldb.eStateStopped]
+        )
+        return process
+
+    def read_stack_byte(self, process, offset):
+        error = lldb.SBError()
+        data = process.ReadMemory(self.STACK_POINTER + offset, 1, error)
+        self.assertSuccess(error)
+        return data
+
+    def test_prefetch(self):
+        """Test that the stack is read with one packet and then cached."""
+        process = self.connect_with_prefetch(self.PREFETCH_SIZE)
+        self.assertPacketLogContains(
+            ["m%x,%x" % (self.STACK_POINTER, self.PREFETCH_SIZE)]
+        )
+
+        # Reads within the prefetched range are served from the cache, so they
+        # still see the memory as it was at the stop.
+        self.server.responder.memory_byte = "bb"
+        self.assertEqual(self.read_stack_byte(process, 0x10), b"\xaa")
+        self.assertEqual(
+            self.read_stack_byte(process, self.PREFETCH_SIZE - 1), b"\xaa"
+        )
@@ -0,0 +1,71 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FlatHashMap.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Pointer keys, as in ValueMap, SlotTracker and symbol table lookups. The
+// pointers are spread over a large array and visited in random order so that
+// large maps do not fit in cache.
+static std::vector<int *> getKeys(size_t N) {
+  static std::vector<int> Storage;
+  Storage.resize(N * 4);
+  std::vector<int *> Keys;
+  for (size_t I = 0; I != N; ++I)
+    Keys.push_back(&Storage[I * 4]);
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(0));
+  return Keys;
+}
+
+template <typename MapT> static void BM_Insert(benchmark::State &State) {
+  std::vector<int *> Keys = getKeys(State.range(0));
+  for (auto _ : State) {
+    MapT M;
+    for (int *K : Keys)
+      M[K] = 1;
+    benchmark::DoNotOptimize(M.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT> static void BM_LookupHit(benchmark::State &State) {
+  std::vector<int *> Keys = getKeys(State.range(0));
+  MapT M;
+  for (int *K : Keys)
+    M[K] = 1;
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(1));
+  for (auto _ : State) {
+    unsigned Sum = 0;
+    for (int *K : Keys)
+      Sum += M.lookup(K);
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT> static void BM_LookupMiss(benchmark::State &State) {
+  std::vector<int *> Keys = getKeys(State.range(0) * 2);
+  MapT M;
+  for (size_t I = 0, E = Keys.size() / 2; I != E; ++I)
+    M[Keys[I]] = 1;
+  for (auto _ : State) {
+    unsigned Sum = 0;
+    for (size_t I = Keys.size() / 2, E = Keys.size(); I != E; ++I)
+      Sum += M.count(Keys[I]);
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size() / 2);
+}
+
+using DenseMapT = llvm::DenseMap<int *, unsigned>;
+using FlatHashMapT = llvm::FlatHashMap<int *, unsigned>;
+
+BENCHMARK_TEMPLATE(BM_Insert, DenseMapT)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Insert, FlatHashMapT)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LookupHit, DenseMapT)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LookupHit, FlatHashMapT)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LookupMiss, DenseMapT)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LookupMiss, FlatHashMapT)->Range(1 << 6, 1 << 20);
+
+BENCHMARK_MAIN();
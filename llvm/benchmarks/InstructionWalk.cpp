@@ -0,0 +1,92 @@
+//===- InstructionWalk.cpp - Instruction list walk benchmarks -------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+// Builds a function with NumBlocks blocks of InstsPerBlock instructions each.
+// With Scatter set, instructions are created in random block order, so that
+// consecutive instructions of a block are far apart in memory, as they end up
+// after transformations that insert, move and delete instructions. Otherwise
+// every block's instructions are allocated back to back.
+static std::unique_ptr<Module> buildModule(LLVMContext &Ctx, bool Scatter) {
+  constexpr unsigned NumBlocks = 1024, InstsPerBlock = 256;
+  auto M = std::make_unique<Module>("bench", Ctx);
+  Type *I64 = Type::getInt64Ty(Ctx);
+  Function *F = Function::Create(FunctionType::get(I64, {I64}, false),
+                                 GlobalValue::ExternalLinkage, "f", *M);
+  std::vector<BasicBlock *> Blocks;
+  for (unsigned I = 0; I != NumBlocks; ++I)
+    Blocks.push_back(BasicBlock::Create(Ctx, "", F));
+
+  std::vector<unsigned> Order;
+  for (unsigned I = 0; I != NumBlocks * InstsPerBlock; ++I)
+    Order.push_back(I / InstsPerBlock);
+  if (Scatter)
+    std::shuffle(Order.begin(), Order.end(), std::mt19937(0));
+
+  Value *Arg = F->getArg(0);
+  for (unsigned BB : Order)
+    BinaryOperator::Create(Instruction::Add, Arg, Arg, "", Blocks[BB]);
+  return M;
+}
+
+// The inner loop of most IR passes: visit every instruction in order.
+static void BM_WalkInstructions(benchmark::State &State) {
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = buildModule(Ctx, State.range(0));
+  size_t NumInsts = 0;
+  for (auto _ : State) {
+    unsigned Sum = 0;
+    NumInsts = 0;
+    for (Function &F : *M)
+      for (BasicBlock &BB : F)
+        for (Instruction &I : BB) {
+          Sum += I.getOpcode();
+          ++NumInsts;
+        }
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * NumInsts);
+}
+BENCHMARK(BM_WalkInstructions)->ArgName("scatter")->Arg(0)->Arg(1);
+
+// Dominance-style ordering queries within a block, which renumber the block
+// lazily after it is modified.
+static void BM_ComesBefore(benchmark::State &State) {
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = buildModule(Ctx, State.range(0));
+  BasicBlock &BB = M->getFunction("f")->front();
+  std::vector<Instruction *> Insts;
+  for (Instruction &I : BB)
+    Insts.push_back(&I);
+  std::mt19937 Gen(0);
+  for (auto _ : State) {
+    // Invalidate the order, as any insertion would.
+    BinaryOperator::Create(Instruction::Add, Insts[0], Insts[0], "", &BB)
+        ->eraseFromParent();
+    unsigned Before = 0;
+    for (unsigned I = 0; I != 64; ++I)
+      Before += Insts[Gen() % Insts.size()]->comesBefore(
+          Insts[Gen() % Insts.size()]);
+    benchmark::DoNotOptimize(Before);
+  }
+}
+BENCHMARK(BM_ComesBefore)->ArgName("scatter")->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,78 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/LEB128.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// Text resembling assembly or FileCheck input: lowercase words, punctuation
+// and line breaks, with no occurrence of the needles searched for below.
+static std::string getText(size_t Size) {
+  const char Alphabet[] = "abcdefghijklmnopqrstuvwxy_%,.:\t     \n";
+  std::mt19937 Gen(0);
+  std::uniform_int_distribution<size_t> Dist(0, sizeof(Alphabet) - 2);
+  std::string Text;
+  for (size_t I = 0; I != Size; ++I)
+    Text += Alphabet[Dist(Gen)];
+  return Text;
+}
+
+static void BM_FindMiss(benchmark::State &State) {
+  std::string Text = getText(1 << 16);
+  std::string Needle(State.range(0), 'z');
+  Needle.front() = 'a';
+  for (auto _ : State)
+    benchmark::DoNotOptimize(llvm::StringRef(Text).find(Needle));
+  State.SetBytesProcessed(State.iterations() * Text.size());
+}
+BENCHMARK(BM_FindMiss)->Arg(2)->Arg(4)->Arg(8)->Arg(32);
+
+static void BM_FindFirstOfWhitespace(benchmark::State &State) {
+  std::string Text(1 << 16, 'x');
+  for (auto _ : State)
+    benchmark::DoNotOptimize(llvm::StringRef(Text).find_first_of(" \t\n"));
+  State.SetBytesProcessed(State.iterations() * Text.size());
+}
+BENCHMARK(BM_FindFirstOfWhitespace);
+
+static void BM_SplitLines(benchmark::State &State) {
+  std::string Text = getText(1 << 16);
+  for (auto _ : State) {
+    llvm::StringRef Rest = Text;
+    size_t Lines = 0;
+    while (!Rest.empty()) {
+      Rest = Rest.split("\n").second;
+      ++Lines;
+    }
+    benchmark::DoNotOptimize(Lines);
+  }
+  State.SetBytesProcessed(State.iterations() * Text.size());
+}
+BENCHMARK(BM_SplitLines);
+
+// A stream of ULEB128 values where most, but not all, fit in one byte, as in
+// DWARF abbreviations and attribute forms.
+static void BM_DecodeULEB128(benchmark::State &State) {
+  std::mt19937 Gen(0);
+  std::vector<uint8_t> Bytes;
+  for (unsigned I = 0; I != 4096; ++I) {
+    uint64_t V = Gen() % 16 ? Gen() % 128 : Gen();
+    uint8_t Buf[16];
+    unsigned Size = llvm::encodeULEB128(V, Buf);
+    Bytes.insert(Bytes.end(), Buf, Buf + Size);
+  }
+  for (auto _ : State) {
+    const uint8_t *P = Bytes.data(), *End = P + Bytes.size();
+    uint64_t Sum = 0;
+    while (P != End) {
+      unsigned N;
+      Sum += llvm::decodeULEB128(P, &N, End);
+      P += N;
+    }
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetBytesProcessed(State.iterations() * Bytes.size());
+}
+BENCHMARK(BM_DecodeULEB128);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,588 @@
+//===- llvm/ADT/FlatHashMap.h - Group-probed hash table ---------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the FlatHashMap class, an open-addressing hash table in
+/// the style of Swiss tables.
+///
+/// Next to the array of buckets, the table keeps one control byte per bucket
+/// holding either a marker for an empty or erased bucket, or 7 bits of the
+/// hash of the key it contains. A lookup loads the control bytes of a group of
+/// 16 buckets at once, compares them against the key's 7 hash bits with SIMD
+/// instructions where available (SSE2 or NEON), and compares full keys only
+/// for the few matching buckets. Unlike DenseMap, no key values are reserved
+/// as empty and tombstone markers.
+///
+/// The interface follows DenseMap closely enough that most users can switch by
+/// changing the type: buckets are DenseMapPairs, and KeyInfoT only needs
+/// getHashValue() and isEqual(). Iterators are invalidated by insertion and by
+/// rehashing; erasing does not move other elements.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_FLATHASHMAP_H
+#define LLVM_ADT_FLATHASHMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/bit.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LLVM_FLATHASHMAP_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define LLVM_FLATHASHMAP_NEON 1
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// Control byte values. Full buckets hold the 7 low bits of H2 (0..127), so
+/// the sign bit distinguishes full buckets from the markers.
+enum : int8_t { FlatHashEmpty = -128, FlatHashDeleted = -2 };
+
+/// A set of bucket indices within a group. Each index is represented by one
+/// bit at position (Index << Shift).
+template <typename MaskT, unsigned Shift> class FlatHashBitMask {
+  MaskT Mask;
+
+public:
+  explicit FlatHashBitMask(MaskT Mask) : Mask(Mask) {}
+  explicit operator bool() const { return Mask != 0; }
+  unsigned lowest() const { return llvm::countr_zero(Mask) >> Shift; }
+  void clearLowest() { Mask &= Mask - 1; }
+};
+
+/// The control bytes of a group of FlatHashGroup::Width buckets.
+struct FlatHashGroup {
+  static constexpr unsigned Width = 16;
+
+#if defined(LLVM_FLATHASHMAP_SSE2)
+  using BitMask = FlatHashBitMask<uint32_t, 0>;
+
+  __m128i Ctrl;
+  explicit FlatHashGroup(const int8_t *P)
+      : Ctrl(_mm_load_si128(reinterpret_cast<const __m128i *>(P))) {}
+
+  BitMask match(int8_t H2) const {
+    return BitMask(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Ctrl))));
+  }
+  BitMask matchEmpty() const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_set1_epi8(FlatHashEmpty), Ctrl))));
+  }
+  // Empty and deleted buckets are the ones with the sign bit set.
+  BitMask matchEmptyOrDeleted() const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(Ctrl)));
+  }
+#elif defined(LLVM_FLATHASHMAP_NEON)
+  // NEON has no movemask. Narrowing the comparison result by 4 bits turns
+  // each byte into a nibble, and keeping the top bit of each nibble gives a
+  // mask with one bit per bucket at 4 * Index + 3.
+  using BitMask = FlatHashBitMask<uint64_t, 2>;
+
+  int8x16_t Ctrl;
+  explicit FlatHashGroup(const int8_t *P) : Ctrl(vld1q_s8(P)) {}
+
+  static BitMask toMask(uint8x16_t Cmp) {
+    uint8x8_t Narrow = vshrn_n_u16(vreinterpretq_u16_u8(Cmp), 4);
+    return BitMask(vget_lane_u64(vreinterpret_u64_u8(Narrow), 0) &
+                   0x8888888888888888ULL);
+  }
+  BitMask match(int8_t H2) const {
+    return toMask(vceqq_s8(Ctrl, vdupq_n_s8(H2)));
+  }
+  BitMask matchEmpty() const {
+    return toMask(vceqq_s8(Ctrl, vdupq_n_s8(FlatHashEmpty)));
+  }
+  BitMask matchEmptyOrDeleted() const {
+    return toMask(vcltq_s8(Ctrl, vdupq_n_s8(0)));
+  }
+#else
+  using BitMask = FlatHashBitMask<uint32_t, 0>;
+
+  const int8_t *Ctrl;
+  explicit FlatHashGroup(const int8_t *P) : Ctrl(P) {}
+
+  template <typename PredT> BitMask matchIf(PredT Pred) const {
+    uint32_t Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= uint32_t(Pred(Ctrl[I])) << I;
+    return BitMask(Mask);
+  }
+  BitMask match(int8_t H2) const {
+    return matchIf([H2](int8_t C) { return C == H2; });
+  }
+  BitMask matchEmpty() const {
+    return matchIf([](int8_t C) { return C == FlatHashEmpty; });
+  }
+  BitMask matchEmptyOrDeleted() const {
+    return matchIf([](int8_t C) { return C < 0; });
+  }
+#endif
+};
+
+template <typename KeyT, typename ValueT, bool IsConst>
+class FlatHashMapIterator;
+
+} // end namespace detail
+
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class FlatHashMap {
+  using Group = detail::FlatHashGroup;
+  static constexpr unsigned GroupWidth = Group::Width;
+
+public:
+  using size_type = unsigned;
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = detail::DenseMapPair<KeyT, ValueT>;
+  using iterator = detail::FlatHashMapIterator<KeyT, ValueT, false>;
+  using const_iterator = detail::FlatHashMapIterator<KeyT, ValueT, true>;
+
+  explicit FlatHashMap(unsigned InitialReserve = 0) {
+    if (InitialReserve)
+      reserve(InitialReserve);
+  }
+
+  FlatHashMap(std::initializer_list<value_type> Vals) {
+    reserve(Vals.size());
+    insert(Vals.begin(), Vals.end());
+  }
+
+  FlatHashMap(const FlatHashMap &Other) { copyFrom(Other); }
+
+  FlatHashMap(FlatHashMap &&Other) { swap(Other); }
+
+  ~FlatHashMap() {
+    destroyAll();
+    deallocate();
+  }
+
+  FlatHashMap &operator=(const FlatHashMap &Other) {
+    if (&Other != this) {
+      destroyAll();
+      deallocate();
+      copyFrom(Other);
+    }
+    return *this;
+  }
+
+  FlatHashMap &operator=(FlatHashMap &&Other) {
+    destroyAll();
+    deallocate();
+    init();
+    swap(Other);
+    return *this;
+  }
+
+  void swap(FlatHashMap &Other) {
+    std::swap(Ctrl, Other.Ctrl);
+    std::swap(Buckets, Other.Buckets);
+    std::swap(NumBuckets, Other.NumBuckets);
+    std::swap(NumEntries, Other.NumEntries);
+    std::swap(GrowthLeft, Other.GrowthLeft);
+  }
+
+  iterator begin() { return makeIterator(0); }
+  iterator end() { return makeIterator(NumBuckets); }
+  const_iterator begin() const { return makeConstIterator(0); }
+  const_iterator end() const { return makeConstIterator(NumBuckets); }
+
+  [[nodiscard]] bool empty() const { return NumEntries == 0; }
+  unsigned size() const { return NumEntries; }
+
+  /// Grow the table so that \p NumEntries elements can be held without
+  /// rehashing.
+  void reserve(size_type NumEntries) {
+    unsigned Needed = getMinBucketsToReserve(NumEntries);
+    if (Needed > NumBuckets)
+      rehash(Needed);
+  }
+
+  void clear() {
+    if (NumEntries == 0 && GrowthLeft == getMaxLoad(NumBuckets))
+      return;
+    destroyAll();
+    if (NumBuckets)
+      std::memset(Ctrl, detail::FlatHashEmpty, NumBuckets);
+    NumEntries = 0;
+    GrowthLeft = getMaxLoad(NumBuckets);
+  }
+
+  /// Return true if the specified key is in the map, false otherwise.
+  bool contains(const KeyT &Key) const { return findIndex(Key) != NumBuckets; }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const KeyT &Key) const { return contains(Key) ? 1 : 0; }
+
+  iterator find(const KeyT &Key) { return makeIterator(findIndex(Key)); }
+  const_iterator find(const KeyT &Key) const {
+    return makeConstIterator(findIndex(Key));
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const KeyT &Key) const {
+    unsigned I = findIndex(Key);
+    if (I != NumBuckets)
+      return Buckets[I].getSecond();
+    return ValueT();
+  }
+
+  /// Return the entry for the specified key. Asserts that it exists.
+  const ValueT &at(const KeyT &Key) const {
+    unsigned I = findIndex(Key);
+    assert(I != NumBuckets && "FlatHashMap::at failed due to a missing key");
+    return Buckets[I].getSecond();
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // If the key is already in the map, it returns false and doesn't update the
+  // value.
+  std::pair<iterator, bool> insert(const std::pair<KeyT, ValueT> &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+
+  std::pair<iterator, bool> insert(std::pair<KeyT, ValueT> &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  // Inserts key,value pair into the map if the key isn't already in the map.
+  // The value is constructed in-place if the key is not in the map, otherwise
+  // it is not moved.
+  template <typename KeyArgT, typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyArgT &&Key, Ts &&...Args) {
+    auto [I, Inserted] = findOrPrepareInsert(Key);
+    if (Inserted)
+      ::new (&Buckets[I])
+          value_type(std::piecewise_construct,
+                     std::forward_as_tuple(std::forward<KeyArgT>(Key)),
+                     std::forward_as_tuple(std::forward<Ts>(Args)...));
+    return {makeIterator(I), Inserted};
+  }
+
+  template <typename V>
+  std::pair<iterator, bool> insert_or_assign(const KeyT &Key, V &&Val) {
+    auto Ret = try_emplace(Key, std::forward<V>(Val));
+    if (!Ret.second)
+      Ret.first->second = std::forward<V>(Val);
+    return Ret;
+  }
+
+  ValueT &operator[](const KeyT &Key) { return try_emplace(Key).first->second; }
+
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->second;
+  }
+
+  bool erase(const KeyT &Key) {
+    unsigned I = findIndex(Key);
+    if (I == NumBuckets)
+      return false;
+    eraseIndex(I);
+    return true;
+  }
+
+  void erase(iterator I) { eraseIndex(I.Ptr - Buckets); }
+
+  /// Return the approximate size (in bytes) of the actual map.
+  size_t getMemorySize() const {
+    return NumBuckets ? getAllocationSize(NumBuckets) : 0;
+  }
+
+private:
+  // Mix the possibly weak hash from KeyInfoT. The top 7 bits of the product
+  // become the control byte; group selection uses bits starting at 25 so that
+  // the two are independent.
+  static uint64_t hash(const KeyT &Key) {
+    return uint64_t(KeyInfoT::getHashValue(Key)) * 0x9E3779B97F4A7C15ULL;
+  }
+  static int8_t getH2(uint64_t Hash) { return int8_t(Hash >> 57); }
+  unsigned getFirstGroup(uint64_t Hash) const {
+    return unsigned(Hash >> 25) & (NumBuckets / GroupWidth - 1);
+  }
+
+  // Probe groups in triangular order, which visits every group of a table
+  // with a power-of-two number of groups.
+  unsigned getNextGroup(unsigned G, unsigned &Step) const {
+    return (G + ++Step) & (NumBuckets / GroupWidth - 1);
+  }
+
+  // Keep at least 1/8 of the buckets empty so that probing terminates and
+  // probe sequences stay short.
+  static unsigned getMaxLoad(unsigned NumBuckets) {
+    return NumBuckets - NumBuckets / 8;
+  }
+
+  static unsigned getMinBucketsToReserve(unsigned NumEntries) {
+    if (NumEntries == 0)
+      return 0;
+    uint64_t N = uint64_t(NumEntries) * 8 / 7 + 1;
+    return std::max<uint64_t>(GroupWidth, PowerOf2Ceil(N));
+  }
+
+  static size_t getCtrlOffset(unsigned NumBuckets) {
+    return alignTo(size_t(NumBuckets) * sizeof(value_type), GroupWidth);
+  }
+  static size_t getAllocationSize(unsigned NumBuckets) {
+    return getCtrlOffset(NumBuckets) + NumBuckets;
+  }
+  static constexpr size_t getAllocationAlign() {
+    return alignof(value_type) > GroupWidth ? alignof(value_type) : GroupWidth;
+  }
+
+  bool isFull(unsigned I) const { return Ctrl[I] >= 0; }
+
+  unsigned findIndex(const KeyT &Key) const {
+    if (NumBuckets == 0)
+      return NumBuckets;
+    return findIndex(Key, hash(Key));
+  }
+
+  unsigned findIndex(const KeyT &Key, uint64_t Hash) const {
+    int8_t H2 = getH2(Hash);
+    unsigned G = getFirstGroup(Hash);
+    for (unsigned Step = 0;; G = getNextGroup(G, Step)) {
+      Group Grp(Ctrl + G * GroupWidth);
+      for (auto M = Grp.match(H2); M; M.clearLowest()) {
+        unsigned I = G * GroupWidth + M.lowest();
+        if (KeyInfoT::isEqual(Buckets[I].getFirst(), Key))
+          return I;
+      }
+      if (Grp.matchEmpty())
+        return NumBuckets;
+    }
+  }
+
+  // Returns the first empty or deleted bucket in the probe sequence of Hash.
+  unsigned findFreeIndex(uint64_t Hash) const {
+    unsigned G = getFirstGroup(Hash);
+    for (unsigned Step = 0;; G = getNextGroup(G, Step))
+      if (auto M = Group(Ctrl + G * GroupWidth).matchEmptyOrDeleted())
+        return G * GroupWidth + M.lowest();
+  }
+
+  // Returns the index of Key and false if it is present. Otherwise claims a
+  // bucket for it, growing the table if needed, and returns its index and
+  // true; the caller must construct the element.
+  std::pair<unsigned, bool> findOrPrepareInsert(const KeyT &Key) {
+    uint64_t Hash = hash(Key);
+    if (NumBuckets != 0) {
+      unsigned I = findIndex(Key, Hash);
+      if (I != NumBuckets)
+        return {I, false};
+    }
+    if (NumBuckets == 0) {
+      rehash(GroupWidth);
+    } else if (GrowthLeft == 0 &&
+               Ctrl[findFreeIndex(Hash)] != detail::FlatHashDeleted) {
+      // Reuse a deleted bucket if there is one on the probe path, otherwise
+      // rehash. If erased buckets make up much of the load, rehashing at the
+      // same size is enough to reclaim them.
+      rehash(NumEntries * 2 < getMaxLoad(NumBuckets) ? NumBuckets
+                                                     : NumBuckets * 2);
+    }
+    unsigned I = findFreeIndex(Hash);
+    if (Ctrl[I] == detail::FlatHashEmpty)
+      --GrowthLeft;
+    Ctrl[I] = getH2(Hash);
+    ++NumEntries;
+    return {I, true};
+  }
+
+  void eraseIndex(unsigned I) {
+    assert(I < NumBuckets && isFull(I) && "erasing an invalid bucket");
+    Buckets[I].~value_type();
+    --NumEntries;
+    // A probe for another key only continues past this group if the group had
+    // no empty bucket when that key was inserted. If the group has an empty
+    // bucket now, no such key can depend on this bucket and it becomes empty
+    // again; otherwise it is marked deleted.
+    if (Group(Ctrl + I / GroupWidth * GroupWidth).matchEmpty()) {
+      Ctrl[I] = detail::FlatHashEmpty;
+      ++GrowthLeft;
+    } else {
+      Ctrl[I] = detail::FlatHashDeleted;
+    }
+  }
+
+  void allocate(unsigned N) {
+    assert(isPowerOf2_32(N) && N >= GroupWidth && "invalid bucket count");
+    char *Mem = static_cast<char *>(
+        allocate_buffer(getAllocationSize(N), getAllocationAlign()));
+    Buckets = reinterpret_cast<value_type *>(Mem);
+    Ctrl = reinterpret_cast<int8_t *>(Mem + getCtrlOffset(N));
+    std::memset(Ctrl, detail::FlatHashEmpty, N);
+    NumBuckets = N;
+    NumEntries = 0;
+    GrowthLeft = getMaxLoad(N);
+  }
+
+  void deallocate() {
+    if (NumBuckets)
+      deallocate_buffer(Buckets, getAllocationSize(NumBuckets),
+                        getAllocationAlign());
+  }
+
+  void init() {
+    Ctrl = nullptr;
+    Buckets = nullptr;
+    NumBuckets = NumEntries = GrowthLeft = 0;
+  }
+
+  void destroyAll() {
+    for (unsigned I = 0; I != NumBuckets; ++I)
+      if (isFull(I))
+        Buckets[I].~value_type();
+  }
+
+  void rehash(unsigned N) {
+    int8_t *OldCtrl = Ctrl;
+    value_type *OldBuckets = Buckets;
+    unsigned OldNumBuckets = NumBuckets;
+    allocate(N);
+    for (unsigned I = 0; I != OldNumBuckets; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      uint64_t Hash = hash(OldBuckets[I].getFirst());
+      unsigned J = findFreeIndex(Hash);
+      Ctrl[J] = getH2(Hash);
+      ::new (&Buckets[J]) value_type(std::move(OldBuckets[I]));
+      OldBuckets[I].~value_type();
+      ++NumEntries;
+      --GrowthLeft;
+    }
+    if (OldNumBuckets)
+      deallocate_buffer(OldBuckets, getAllocationSize(OldNumBuckets),
+                        getAllocationAlign());
+  }
+
+  void copyFrom(const FlatHashMap &Other) {
+    init();
+    if (Other.NumBuckets == 0)
+      return;
+    allocate(Other.NumBuckets);
+    std::memcpy(Ctrl, Other.Ctrl, NumBuckets);
+    for (unsigned I = 0; I != NumBuckets; ++I)
+      if (isFull(I))
+        ::new (&Buckets[I]) value_type(Other.Buckets[I]);
+    NumEntries = Other.NumEntries;
+    GrowthLeft = Other.GrowthLeft;
+  }
+
+  iterator makeIterator(unsigned I) {
+    return iterator(Buckets + I, Ctrl + I, Ctrl + NumBuckets);
+  }
+  const_iterator makeConstIterator(unsigned I) const {
+    return const_iterator(Buckets + I, Ctrl + I, Ctrl + NumBuckets);
+  }
+
+  int8_t *Ctrl = nullptr;
+  value_type *Buckets = nullptr;
+  unsigned NumBuckets = 0;
+  unsigned NumEntries = 0;
+  unsigned GrowthLeft = 0;
+};
+
+namespace detail {
+
+template <typename KeyT, typename ValueT, bool IsConst>
+class FlatHashMapIterator {
+  template <typename, typename, typename> friend class llvm::FlatHashMap;
+  friend class FlatHashMapIterator<KeyT, ValueT, true>;
+  friend class FlatHashMapIterator<KeyT, ValueT, false>;
+
+  using Bucket = DenseMapPair<KeyT, ValueT>;
+  using BucketPtr = std::conditional_t<IsConst, const Bucket *, Bucket *>;
+
+  BucketPtr Ptr = nullptr;
+  const int8_t *CtrlPtr = nullptr;
+  const int8_t *CtrlEnd = nullptr;
+
+  FlatHashMapIterator(BucketPtr Ptr, const int8_t *CtrlPtr,
+                      const int8_t *CtrlEnd)
+      : Ptr(Ptr), CtrlPtr(CtrlPtr), CtrlEnd(CtrlEnd) {
+    skipEmpty();
+  }
+
+  void skipEmpty() {
+    while (CtrlPtr != CtrlEnd && *CtrlPtr < 0) {
+      ++CtrlPtr;
+      ++Ptr;
+    }
+  }
+
+public:
+  using difference_type = ptrdiff_t;
+  using value_type = std::conditional_t<IsConst, const Bucket, Bucket>;
+  using pointer = value_type *;
+  using reference = value_type &;
+  using iterator_category = std::forward_iterator_tag;
+
+  FlatHashMapIterator() = default;
+
+  // Converting ctor from non-const iterators to const iterators. SFINAE'd out
+  // for const iterator destinations so it doesn't end up as a user defined
+  // copy constructor.
+  template <bool IsConstSrc,
+            typename = std::enable_if_t<!IsConstSrc && IsConst>>
+  FlatHashMapIterator(const FlatHashMapIterator<KeyT, ValueT, IsConstSrc> &I)
+      : Ptr(I.Ptr), CtrlPtr(I.CtrlPtr), CtrlEnd(I.CtrlEnd) {}
+
+  reference operator*() const { return *Ptr; }
+  pointer operator->() const { return Ptr; }
+
+  friend bool operator==(const FlatHashMapIterator &LHS,
+                         const FlatHashMapIterator &RHS) {
+    return LHS.Ptr == RHS.Ptr;
+  }
+  friend bool operator!=(const FlatHashMapIterator &LHS,
+                         const FlatHashMapIterator &RHS) {
+    return !(LHS == RHS);
+  }
+
+  FlatHashMapIterator &operator++() {
+    ++Ptr;
+    ++CtrlPtr;
+    skipEmpty();
+    return *this;
+  }
+  FlatHashMapIterator operator++(int) {
+    FlatHashMapIterator Tmp = *this;
+    ++*this;
+    return Tmp;
+  }
+};
+
+} // end namespace detail
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_FLATHASHMAP_H
@@ -120,7 +120,11 @@ constexpr bool isHeuristicInlineCostFeature(InlineCostFeatureIndex Feature) {
     "number of blocks reached from a conditional instruction, in the callee")  \
   M(int64_t, {1}, callee_users,                                                \
     "number of module-internal users of the callee, +1 if the callee is "      \
-    "exposed externally")
+    "exposed externally")                                                      \
+  M(int64_t, {1}, is_hot_callsite,                                             \
+    "1 if profile data shows the call site is hot, 0 otherwise")               \
+  M(int64_t, {1}, is_cold_callsite,                                            \
+    "1 if profile data shows the call site is cold, 0 otherwise")
 
 // clang-format off
 enum class FeatureIndex : size_t {
@@ -24,6 +24,7 @@ namespace llvm {
 class DiagnosticInfoOptimizationBase;
 class Module;
 class MLInlineAdvice;
+class ProfileSummaryInfo;
 
 class MLInlineAdvisor : public InlineAdvisor {
 public:
@@ -78,6 +79,7 @@ private:
   mutable std::map<const Function *, FunctionPropertiesInfo> FPICache;
 
   LazyCallGraph &CG;
+  ProfileSummaryInfo &PSI;
 
   int64_t NodeCount = 0;
   int64_t EdgeCount = 0;
@@ -1679,6 +1679,11 @@ private:
   /// expression recursively.
   const SCEV *createSCEV(Value *V);
 
+  /// Return true if this function has created as many unique SCEV expressions
+  /// as -scalar-evolution-max-nodes allows. Past that point getSCEV models new
+  /// instructions as SCEVUnknown and backedge-taken counts are not computed.
+  bool isOverNodeBudget() const;
+
   /// We know that there is no SCEV for the specified value. Create a new SCEV
   /// for \p V iteratively.
   const SCEV *createSCEVIter(Value *V);
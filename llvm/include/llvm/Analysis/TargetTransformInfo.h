@@ -21,6 +21,7 @@
 #ifndef LLVM_ANALYSIS_TARGETTRANSFORMINFO_H
 #define LLVM_ANALYSIS_TARGETTRANSFORMINFO_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallBitVector.h"
 #include "llvm/IR/FMF.h"
 #include "llvm/IR/InstrTypes.h"
@@ -31,6 +32,7 @@
 #include "llvm/Support/InstructionCost.h"
 #include <functional>
 #include <optional>
+#include <tuple>
 #include <utility>
 
 namespace llvm {
@@ -197,9 +199,13 @@ struct TailFoldingInfo {
   TargetLibraryInfo *TLI;
   LoopVectorizationLegality *LVL;
   InterleavedAccessInfo *IAI;
+  /// If not null, targets may use this to explain why they declined to
+  /// fold the tail.
+  OptimizationRemarkEmitter *ORE;
   TailFoldingInfo(TargetLibraryInfo *TLI, LoopVectorizationLegality *LVL,
-                  InterleavedAccessInfo *IAI)
-      : TLI(TLI), LVL(LVL), IAI(IAI) {}
+                  InterleavedAccessInfo *IAI,
+                  OptimizationRemarkEmitter *ORE = nullptr)
+      : TLI(TLI), LVL(LVL), IAI(IAI), ORE(ORE) {}
 };
 
 class TargetTransformInfo;
@@ -1681,6 +1687,16 @@ private:
   template <typename T> class Model;
 
   std::unique_ptr<Concept> TTIImpl;
+
+  /// Key of a memoized cost query: the query kind and opcode, up to two types
+  /// and the remaining scalar parameters packed into one integer.
+  using CostCacheKey = std::tuple<unsigned, Type *, Type *, uint64_t>;
+
+  /// Costs of queries that carry no instruction or operand context, filled in
+  /// when -tti-cache-costs is set. A TargetTransformInfo is created per
+  /// function and only used by the pipeline running on that function, so the
+  /// cache needs no locking even when functions are compiled in parallel.
+  mutable DenseMap<CostCacheKey, InstructionCost> CostCache;
 };
 
 class TargetTransformInfo::Concept {
@@ -20,6 +20,7 @@
 #define LLVM_CODEGEN_LIVEINTERVALS_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/IndexedMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/CodeGen/LiveInterval.h"
@@ -39,7 +40,6 @@ namespace llvm {
 
 extern cl::opt<bool> UseSegmentSetForPhysRegs;
 
-class BitVector;
 class LiveIntervalCalc;
 class MachineBlockFrequencyInfo;
 class MachineDominatorTree;
@@ -65,6 +65,11 @@ class VirtRegMap;
     /// Live interval pointers for all the virtual registers.
     IndexedMap<LiveInterval*, VirtReg2IndexFunctor> VirtRegIntervals;
 
+    /// Virtual registers, by index, whose intervals were deferred by
+    /// computeVirtRegs() and will be computed on first use. Only populated
+    /// with -lazy-live-intervals.
+    BitVector PendingVirtRegs;
+
     /// Sorted list of instructions with register mask operands. Always use the
     /// 'r' slot, RegMasks are normal clobbers, not early clobbers.
     SmallVector<SlotIndex, 8> RegMaskSlots;
@@ -110,9 +115,11 @@ class VirtRegMap;
                                 const MachineBasicBlock *MBB);
 
     LiveInterval &getInterval(Register Reg) {
-      if (hasInterval(Reg))
+      if (hasComputedInterval(Reg))
         return *VirtRegIntervals[Reg.id()];
 
+      if (isIntervalPending(Reg))
+        PendingVirtRegs.reset(Reg.virtRegIndex());
       return createAndComputeVirtRegInterval(Reg);
     }
 
@@ -120,9 +127,10 @@ class VirtRegMap;
       return const_cast<LiveIntervals*>(this)->getInterval(Reg);
     }
 
+    /// Return true if \p Reg has a live interval. An interval deferred by
+    /// -lazy-live-intervals counts as existing; getInterval() computes it.
     bool hasInterval(Register Reg) const {
-      return VirtRegIntervals.inBounds(Reg.id()) &&
-             VirtRegIntervals[Reg.id()];
+      return hasComputedInterval(Reg) || isIntervalPending(Reg);
     }
 
     /// Interval creation.
@@ -141,6 +149,8 @@ class VirtRegMap;
 
     /// Interval removal.
     void removeInterval(Register Reg) {
+      if (isIntervalPending(Reg))
+        PendingVirtRegs.reset(Reg.virtRegIndex());
       delete VirtRegIntervals[Reg];
       VirtRegIntervals[Reg] = nullptr;
     }
@@ -440,6 +450,16 @@ class VirtRegMap;
     void constructMainRangeFromSubranges(LiveInterval &LI);
 
   private:
+    bool hasComputedInterval(Register Reg) const {
+      return VirtRegIntervals.inBounds(Reg.id()) &&
+             VirtRegIntervals[Reg.id()];
+    }
+
+    bool isIntervalPending(Register Reg) const {
+      return Reg.virtRegIndex() < PendingVirtRegs.size() &&
+             PendingVirtRegs.test(Reg.virtRegIndex());
+    }
+
     /// Compute live intervals for all virtual registers.
     void computeVirtRegs();
 
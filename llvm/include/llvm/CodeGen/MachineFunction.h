@@ -959,6 +959,10 @@ public:
     return InstrCount;
   }
 
+  /// Return the number of bytes allocated so far from this function's
+  /// allocator, which backs its blocks, instructions and operands.
+  size_t getAllocatedBytes() const { return Allocator.getBytesAllocated(); }
+
   //===--------------------------------------------------------------------===//
   // Internal functions used to automatically number MachineBasicBlocks
 
@@ -32,6 +32,13 @@ class raw_pwrite_stream;
 ///
 /// Writes bitcode for individual partitions into output streams in BCOSs, if
 /// BCOSs is not empty.
+///
+/// Partitions are moved into their own LLVMContext through bitcode, so that
+/// each thread owns all IR and machine code state it touches. Code generation
+/// cannot be parallelized per function within one module: MachineFunctions
+/// share the module's LLVMContext (constants, types, metadata uniquing), the
+/// MachineModuleInfo and the MCContext, and the AsmPrinter emits functions
+/// into a single MCStreamer in order, none of which are thread-safe.
 void splitCodeGen(
     Module &M, ArrayRef<raw_pwrite_stream *> OSs,
     ArrayRef<llvm::raw_pwrite_stream *> BCOSs,
@@ -395,6 +395,11 @@ class RegPressureTracker {
   /// Live-through pressure.
   std::vector<unsigned> LiveThruPressure;
 
+  /// Scratch space for snapshotting CurrSetPressure and P.MaxSetPressure
+  /// around speculative bumps, kept to avoid reallocating on every query.
+  std::vector<unsigned> SavedSetPressure;
+  std::vector<unsigned> SavedMaxSetPressure;
+
 public:
   RegPressureTracker(IntervalPressure &rp) : P(rp), RequireIntervals(true) {}
   RegPressureTracker(RegionPressure &rp) : P(rp), RequireIntervals(false) {}
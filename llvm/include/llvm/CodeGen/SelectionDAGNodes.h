@@ -637,6 +637,12 @@ private:
 
   uint32_t CFIType = 0;
 
+  /// Hash of this node's CSE profile, or 0 if not known. Filled in lazily by
+  /// the CSE map and cleared when the node is removed from it, so it is only
+  /// trusted while the node's operands cannot change.
+  unsigned CSEHash = 0;
+  friend struct FoldingSetTrait<SDNode>;
+
 public:
   //===--------------------------------------------------------------------===//
   //  Accessors
@@ -1099,6 +1105,30 @@ protected:
   void DropOperands();
 };
 
+/// Specialize FoldingSetTrait for SDNode so that lookups in the CSE map can
+/// reject nodes whose cached hash differs without recomputing their profile,
+/// and so that rehashing on growth does not walk every node's operands.
+template <> struct FoldingSetTrait<SDNode> : DefaultFoldingSetTrait<SDNode> {
+  static bool Equals(SDNode &X, const FoldingSetNodeID &ID, unsigned IDHash,
+                     FoldingSetNodeID &TempID) {
+    if (X.CSEHash && X.CSEHash != IDHash)
+      return false;
+    X.Profile(TempID);
+    if (TempID != ID)
+      return false;
+    X.CSEHash = IDHash;
+    return true;
+  }
+
+  static unsigned ComputeHash(SDNode &X, FoldingSetNodeID &TempID) {
+    if (!X.CSEHash) {
+      X.Profile(TempID);
+      X.CSEHash = TempID.ComputeHash();
+    }
+    return X.CSEHash;
+  }
+};
+
 /// Wrapper class for IR location info (IR ordering and DebugLoc) to be passed
 /// into SDNode creation functions.
 /// When an SDNode is created from the DAGBuilder, the DebugLoc is extracted
@@ -4,6 +4,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/MC/MCSection.h"
 #include "llvm/MC/MCStreamer.h"
+#include "llvm/Support/Allocator.h"
 #include <cassert>
 
 namespace llvm {
@@ -33,6 +34,10 @@ class DWPStringPool {
   MCStreamer &Out;
   MCSection *Sec;
   DenseMap<const char *, uint32_t, CStrDenseMapInfo> Pool;
+  /// Storage for the keys of Pool. The pool keeps its own copy of every
+  /// distinct string so that the input it came from can be released as soon
+  /// as it has been processed.
+  BumpPtrAllocator Alloc;
   uint32_t Offset = 0;
 
 public:
@@ -41,14 +46,18 @@ public:
   uint32_t getOffset(const char *Str, unsigned Length) {
     assert(strlen(Str) + 1 == Length && "Ensure length hint is correct");
 
-    auto Pair = Pool.insert(std::make_pair(Str, Offset));
-    if (Pair.second) {
-      Out.switchSection(Sec);
-      Out.emitBytes(StringRef(Str, Length));
-      Offset += Length;
-    }
+    auto It = Pool.find(Str);
+    if (It != Pool.end())
+      return It->second;
 
-    return Pair.first->second;
+    char *Copy = Alloc.Allocate<char>(Length);
+    memcpy(Copy, Str, Length);
+    Pool.insert(std::make_pair(Copy, Offset));
+    Out.switchSection(Sec);
+    Out.emitBytes(StringRef(Copy, Length));
+    uint32_t StrOffset = Offset;
+    Offset += Length;
+    return StrOffset;
   }
 };
 } // namespace llvm
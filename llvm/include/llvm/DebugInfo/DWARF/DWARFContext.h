@@ -130,6 +130,10 @@ private:
   // Index, and TU Index for DWARF5.
   bool ParseCUTUIndexManually = false;
 
+  /// True if the context was created with a thread-safe state, so units may
+  /// be extracted from several threads at once.
+  bool ThreadSafe = false;
+
 public:
   DWARFContext(std::unique_ptr<const DWARFObject> DObj,
                std::string DWPName = "",
@@ -145,6 +149,9 @@ public:
 
   const DWARFObject &getDWARFObj() const { return *DObj; }
 
+  /// Return true if this context may be used from several threads at once.
+  bool isThreadSafe() const { return ThreadSafe; }
+
   static bool classof(const DIContext *DICtx) {
     return DICtx->getKind() == CK_DWARF;
   }
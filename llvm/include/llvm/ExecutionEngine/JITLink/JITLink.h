@@ -318,6 +318,11 @@ public:
   /// moving edges between blocks.
   void addEdge(const Edge &E) { Edges.push_back(E); }
 
+  /// Reserve space for \p N edges in addition to the existing ones. Graph
+  /// builders that know the relocation count up front use this to avoid
+  /// repeatedly growing the edge list.
+  void reserveEdges(size_t N) { Edges.reserve(Edges.size() + N); }
+
   /// Return the list of edges attached to this content.
   iterator_range<edge_iterator> edges() {
     return make_range(Edges.begin(), Edges.end());
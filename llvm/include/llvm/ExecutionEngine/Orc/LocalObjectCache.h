@@ -0,0 +1,81 @@
+//===- LocalObjectCache.h - Persistent on-disk JIT object cache -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that keeps compiled objects in a directory on disk so that
+// they can be reused across process restarts.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/Error.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+
+class MemoryBuffer;
+class MemoryBufferRef;
+class Module;
+
+namespace orc {
+
+/// An ObjectCache backed by a directory on disk.
+///
+/// Objects are keyed by a SHA1 of the module's bitcode, its target triple and
+/// data layout, and a client supplied configuration key. The configuration
+/// key must capture everything else that affects code generation, e.g. the
+/// CPU, the target features and the optimization level. Entries are written
+/// to a temporary file and renamed into place, so several threads or
+/// processes may share one cache directory.
+///
+/// Pass the cache to SimpleCompiler or ConcurrentIRCompiler (for LLJIT, via
+/// LLJITBuilder::setCompileFunctionCreator) to skip compilation of modules
+/// that were compiled before. The cache is best effort: failures to read or
+/// write an entry are treated as cache misses.
+class LocalObjectCache : public ObjectCache {
+public:
+  /// Create a cache that stores its entries in \p CacheDir. The directory is
+  /// created if it does not exist.
+  static Expected<std::unique_ptr<LocalObjectCache>>
+  Create(StringRef CacheDir, std::string ConfigKey = "");
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  /// Return the cache key for \p M as a hex string.
+  std::string getKey(const Module &M) const;
+
+  StringRef getCacheDir() const { return CacheDir; }
+
+private:
+  LocalObjectCache(StringRef CacheDir, std::string ConfigKey)
+      : CacheDir(CacheDir), ConfigKey(std::move(ConfigKey)) {}
+
+  SmallString<128> getEntryPath(StringRef Key) const;
+
+  SmallString<128> CacheDir;
+  std::string ConfigKey;
+
+  /// Keys computed by getObject for modules that missed the cache. Code
+  /// generation may modify the module before notifyObjectCompiled is called,
+  /// so the object must be stored under the key the module had on lookup.
+  std::mutex PendingKeysMutex;
+  DenseMap<const Module *, std::string> PendingKeys;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_LOCALOBJECTCACHE_H
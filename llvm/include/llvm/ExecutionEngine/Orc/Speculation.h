@@ -72,14 +72,17 @@ private:
 
   void launchCompile(ExecutorAddr FAddr) {
     SymbolNameSet CandidateSet;
-    // Copy CandidateSet is necessary, to avoid unsynchronized access to
-    // the datastructure.
+    // Speculation is launched at most once per function, so take the
+    // candidates out of the map rather than copying them. This also keeps
+    // threads that race past the same speculation guard from issuing the
+    // lookups twice.
     {
       std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
       auto It = GlobalSpecMap.find(FAddr);
       if (It == GlobalSpecMap.end())
         return;
-      CandidateSet = It->getSecond();
+      CandidateSet = std::move(It->getSecond());
+      GlobalSpecMap.erase(It);
     }
 
     SymbolDependenceMap SpeculativeLookUpImpls;
@@ -105,17 +108,28 @@ private:
 
     // for a given symbol, there may be no symbol qualified for speculatively
     // compile try to fix this before jumping to this code if possible.
-    for (auto &LookupPair : SpeculativeLookUpImpls)
-      ES.lookup(
-          LookupKind::Static,
-          makeJITDylibSearchOrder(LookupPair.first,
-                                  JITDylibLookupFlags::MatchAllSymbols),
-          SymbolLookupSet(LookupPair.second), SymbolState::Ready,
-          [this](Expected<SymbolMap> Result) {
-            if (auto Err = Result.takeError())
-              ES.reportError(std::move(Err));
-          },
-          NoDependenciesToRegister);
+    if (SpeculativeLookUpImpls.empty())
+      return;
+
+    // The caller is the JIT'd function that is about to run, so do not make
+    // it wait for the lookups: issue them from the session's task dispatcher.
+    // With a thread pool dispatcher (e.g. LLJIT with compile threads) this
+    // moves the speculative compiles off the executing thread entirely.
+    ES.dispatchTask(makeGenericNamedTask(
+        [this, LookUpImpls = std::move(SpeculativeLookUpImpls)]() {
+          for (auto &LookupPair : LookUpImpls)
+            ES.lookup(
+                LookupKind::Static,
+                makeJITDylibSearchOrder(LookupPair.first,
+                                        JITDylibLookupFlags::MatchAllSymbols),
+                SymbolLookupSet(LookupPair.second), SymbolState::Ready,
+                [this](Expected<SymbolMap> Result) {
+                  if (auto Err = Result.takeError())
+                    ES.reportError(std::move(Err));
+                },
+                NoDependenciesToRegister);
+        },
+        "Speculative compile"));
   }
 
 public:
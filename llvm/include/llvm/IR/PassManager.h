@@ -1190,6 +1190,14 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// Functions are visited one at a time. Even with the rules above honored,
+/// function pipelines could not run concurrently on one module: creating
+/// constants, types or metadata mutates the shared LLVMContext, editing a
+/// function touches the use lists of the globals and constants it references,
+/// and the FunctionAnalysisManager cache is not synchronized. To optimize a
+/// large module in parallel, split it into modules with their own contexts
+/// instead, as SplitModule and the ThinLTO backends do.
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor> {
 public:
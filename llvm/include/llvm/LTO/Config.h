@@ -22,6 +22,7 @@
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/CodeGen.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Target/TargetOptions.h"
 
 #include <functional>
@@ -180,6 +181,9 @@ struct Config {
   /// Time trace granularity.
   unsigned TimeTraceGranularity = 500;
 
+  /// Limits on what the time trace profiler of each backend thread records.
+  TimeTraceProfilerOptions TimeTraceOptions;
+
   bool ShouldDiscardValueNames = true;
   DiagnosticHandlerFunction DiagHandler;
 
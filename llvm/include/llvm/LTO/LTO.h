@@ -95,6 +95,13 @@ setupStatsFile(StringRef StatsFilename);
 /// ordered indices to elements in the input array.
 std::vector<int> generateModulesOrdering(ArrayRef<BitcodeModule *> R);
 
+/// Estimates the work of the ThinLTO backend for a module as the summed
+/// instruction count of the functions it defines (\p DefinedGVSummaries) and
+/// the functions it imports (\p ImportList), according to \p Index.
+uint64_t estimateBackendCost(const ModuleSummaryIndex &Index,
+                             const GVSummaryMapTy &DefinedGVSummaries,
+                             const FunctionImporter::ImportMapTy &ImportList);
+
 /// Updates MemProf attributes (and metadata) based on whether the index
 /// has recorded that we are linking with allocation libraries containing
 /// the necessary APIs for downstream transformations.
@@ -23,6 +23,8 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Target/TargetOptions.h"
 #include "llvm/Transforms/IPO/FunctionImport.h"
+#include <condition_variable>
+#include <mutex>
 
 namespace llvm {
 
@@ -45,18 +47,45 @@ Error backend(const Config &C, AddStreamFn AddStream,
               unsigned ParallelCodeGenParallelismLevel, Module &M,
               ModuleSummaryIndex &CombinedIndex);
 
+/// Bounds the number of ThinLTO backends of a link that are in code generation
+/// at the same time, see -thinlto-max-concurrent-codegen. Code generation has
+/// the highest memory footprint of the backend, so bounding the number of
+/// backends in it lets more threads run the cheaper optimization stage without
+/// running out of memory.
+class CodeGenAdmission {
+public:
+  CodeGenAdmission();
+
+  /// Returns the number of backends allowed in code generation at the same
+  /// time, or 0 if there is no limit.
+  unsigned getLimit() const { return Limit; }
+
+  /// Blocks until code generation has room for another backend.
+  void acquire();
+  void release();
+
+private:
+  const unsigned Limit;
+  std::mutex Mutex;
+  std::condition_variable CV;
+  unsigned Active = 0;
+};
+
 /// Runs a ThinLTO backend.
 /// If \p ModuleMap is not nullptr, all the module files to be imported have
 /// already been mapped to memory and the corresponding BitcodeModule objects
 /// are saved in the ModuleMap. If \p ModuleMap is nullptr, module files will
 /// be mapped to memory on demand and at any given time during importing, only
-/// one source module will be kept open at the most.
+/// one source module will be kept open at the most. If \p Admission is not
+/// nullptr, it is shared by all the backends of the link to bound how many of
+/// them run code generation at the same time.
 Error thinBackend(const Config &C, unsigned Task, AddStreamFn AddStream,
                   Module &M, const ModuleSummaryIndex &CombinedIndex,
                   const FunctionImporter::ImportMapTy &ImportList,
                   const GVSummaryMapTy &DefinedGlobals,
                   MapVector<StringRef, BitcodeModule> *ModuleMap,
-                  const std::vector<uint8_t> &CmdArgs = std::vector<uint8_t>());
+                  const std::vector<uint8_t> &CmdArgs = std::vector<uint8_t>(),
+                  CodeGenAdmission *Admission = nullptr);
 
 Error finalizeOptimizationRemarks(
     std::unique_ptr<ToolOutputFile> DiagOutputFile);
@@ -166,6 +166,18 @@ inline StringRef getInstrProfCounterBiasVarName() {
   return INSTR_PROF_QUOTE(INSTR_PROF_PROFILE_COUNTER_BIAS_VAR);
 }
 
+/// Return the name of the thread-local variable holding the bias from the
+/// counter section to the counter shard of the current thread.
+inline StringRef getInstrProfCounterShardBiasVarName() {
+  return INSTR_PROF_QUOTE(INSTR_PROF_PROFILE_COUNTER_SHARD_BIAS_VAR);
+}
+
+/// Return the name of the runtime function which assigns a counter shard to
+/// the current thread and returns its bias.
+inline StringRef getInstrProfGetCounterShardBiasFuncName() {
+  return INSTR_PROF_QUOTE(INSTR_PROF_PROFILE_GET_COUNTER_SHARD_BIAS_FUNC);
+}
+
 /// Return the marker used to separate PGO names during serialization.
 inline StringRef getInstrProfNameSeparator() { return "\01"; }
 
@@ -60,6 +60,12 @@ public:
   /// Returns path where file will show up if buffer is committed.
   StringRef getPath() const { return FinalPath; }
 
+  /// Hints that the bytes in [Offset, Offset + Size) are final. An on-disk
+  /// buffer uses this to start writing them back to the file asynchronously,
+  /// so that the I/O overlaps with filling the rest of the buffer and commit()
+  /// has less left to do. The range may still be modified afterwards.
+  virtual void startWriteback(size_t Offset, size_t Size) {}
+
   /// Flushes the content of the buffer to its file and deallocates the
   /// buffer.  If commit() is not called before this object's destructor
   /// is called, the file is deleted in the destructor. The optional parameter
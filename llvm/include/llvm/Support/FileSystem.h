@@ -1272,6 +1272,15 @@ public:
     priv ///< May modify via data, but changes are lost on destruction.
   };
 
+  /// Hints about how a mapping is going to be used, see advise().
+  enum class advice {
+    normal,     ///< No particular access pattern; default readahead.
+    sequential, ///< Read front to back; read ahead aggressively.
+    random,     ///< Read in no particular order; don't read ahead.
+    populate,   ///< Fault in the whole mapping now.
+    hugepage    ///< Back the mapping with transparent huge pages if possible.
+  };
+
 private:
   /// Platform-specific mapping state.
   size_t Size = 0;
@@ -1297,6 +1306,7 @@ private:
 
   void unmapImpl();
   void dontNeedImpl();
+  void adviseImpl(advice A);
 
   std::error_code init(sys::fs::file_t FD, uint64_t Offset, mapmode Mode);
 
@@ -1327,6 +1337,9 @@ public:
     copyFrom(mapped_file_region());
   }
   void dontNeed() { dontNeedImpl(); }
+  /// Pass \p A to the kernel for the whole mapping. Hints a platform does not
+  /// support are ignored.
+  void advise(advice A) { adviseImpl(A); }
 
   size_t size() const;
   char *data() const;
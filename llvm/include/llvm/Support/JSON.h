@@ -877,6 +877,26 @@ private:
 /// to the original source).
 llvm::Expected<Value> parse(llvm::StringRef JSON);
 
+/// Parses a JSON document whose top level is an array, passing each element
+/// to \p Callback as soon as it is parsed instead of building the whole array.
+/// Only one element is held in memory at a time, which bounds the memory use
+/// for large inputs such as arrays of records. Parsing stops at the first
+/// ParseError or at the first error returned by \p Callback, which is then
+/// returned.
+llvm::Error
+parseArrayElements(llvm::StringRef JSON,
+                   llvm::function_ref<llvm::Error(Value &&)> Callback);
+
+/// Like parseArrayElements(), but parses the elements in parallel. The array
+/// is first split at its top-level commas, which is much cheaper than parsing,
+/// and the elements are then parsed on the llvm::parallel thread pool.
+/// \p Callback receives the index of each element and may be called
+/// concurrently and in any order. Returns the error for the lowest-indexed
+/// element that failed, if any.
+llvm::Error parseArrayElementsInParallel(
+    llvm::StringRef JSON,
+    llvm::function_ref<llvm::Error(size_t Index, Value &&)> Callback);
+
 class ParseError : public llvm::ErrorInfo<ParseError> {
   const char *Msg;
   unsigned Line, Column, Offset;
@@ -14,6 +14,8 @@
 #ifndef LLVM_SUPPORT_LEB128_H
 #define LLVM_SUPPORT_LEB128_H
 
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
 namespace llvm {
@@ -128,11 +130,17 @@ inline unsigned encodeULEB128(uint64_t Value, uint8_t *p,
 inline uint64_t decodeULEB128(const uint8_t *p, unsigned *n = nullptr,
                               const uint8_t *end = nullptr,
                               const char **error = nullptr) {
+  if (error)
+    *error = nullptr;
+  // Most values in DWARF, bitcode and object file metadata fit in one byte.
+  if (LLVM_LIKELY(p != end && *p < 128)) {
+    if (n)
+      *n = 1;
+    return *p;
+  }
   const uint8_t *orig_p = p;
   uint64_t Value = 0;
   unsigned Shift = 0;
-  if (error)
-    *error = nullptr;
   do {
     if (p == end) {
       if (error)
@@ -161,12 +169,17 @@ inline uint64_t decodeULEB128(const uint8_t *p, unsigned *n = nullptr,
 inline int64_t decodeSLEB128(const uint8_t *p, unsigned *n = nullptr,
                              const uint8_t *end = nullptr,
                              const char **error = nullptr) {
+  if (error)
+    *error = nullptr;
+  if (LLVM_LIKELY(p != end && *p < 128)) {
+    if (n)
+      *n = 1;
+    return SignExtend64<7>(*p);
+  }
   const uint8_t *orig_p = p;
   int64_t Value = 0;
   unsigned Shift = 0;
   uint8_t Byte;
-  if (error)
-    *error = nullptr;
   do {
     if (p == end) {
       if (error)
@@ -82,6 +82,16 @@ public:
   /// function should not be called on a writable buffer.
   virtual void dontNeedIfMmap() {}
 
+  /// How a buffer is expected to be read, see adviseIfMmap().
+  enum class AccessPattern { Normal, Sequential, Random };
+
+  /// For MemoryBuffer_MMap, tell the kernel how the buffer is going to be
+  /// read. Besides setting up readahead for \p Pattern, small buffers are
+  /// faulted in eagerly since they are likely to be touched in full anyway,
+  /// and large ones ask for transparent huge pages to cut the number of page
+  /// faults. Does nothing for other kinds of buffers.
+  virtual void adviseIfMmap(AccessPattern Pattern) {}
+
   /// Open the specified file as a MemoryBuffer, returning a new MemoryBuffer
   /// if successful, otherwise returning null.
   ///
@@ -9,6 +9,7 @@
 #ifndef LLVM_SUPPORT_PARALLEL_H
 #define LLVM_SUPPORT_PARALLEL_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Error.h"
@@ -287,6 +288,16 @@ Error parallelForEachError(RangeTy &&R, FuncTy Fn) {
       [&Fn](auto &&V) { return wrap(Fn(V)); }));
 }
 
+/// Hash \p Data as a two-level tree so that all threads can take part.
+/// \p Data is cut into \p ChunkSize byte chunks, \p HashFn hashes every chunk
+/// into Out.size() bytes in parallel, and the concatenated chunk hashes are
+/// hashed again into \p Out. The result depends only on the input,
+/// \p ChunkSize and \p HashFn, not on the number of threads.
+void parallelTreeHash(
+    MutableArrayRef<uint8_t> Out, ArrayRef<uint8_t> Data,
+    function_ref<void(uint8_t *Dest, ArrayRef<uint8_t> Chunk)> HashFn,
+    size_t ChunkSize = 1024 * 1024);
+
 } // namespace llvm
 
 #endif // LLVM_SUPPORT_PARALLEL_H
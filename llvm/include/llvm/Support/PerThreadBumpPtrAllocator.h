@@ -11,6 +11,8 @@
 
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Parallel.h"
+#include "llvm/Support/SlabPool.h"
+#include <type_traits>
 
 namespace llvm {
 namespace parallel {
@@ -31,6 +33,18 @@ public:
       : NumOfAllocators(parallel::getThreadCount()),
         Allocators(std::make_unique<AllocatorTy[]>(NumOfAllocators)) {}
 
+  /// Construct every per-thread allocator from \p Args, e.g. a SlabPool that
+  /// all of them should draw their slabs from.
+  template <typename ArgTy, typename... ArgTys,
+            typename = std::enable_if_t<!std::is_same_v<
+                std::remove_cv_t<std::remove_reference_t<ArgTy>>,
+                PerThreadAllocator>>>
+  explicit PerThreadAllocator(ArgTy &&Arg, ArgTys &&...Args)
+      : PerThreadAllocator() {
+    for (size_t Idx = 0; Idx < getNumberOfAllocators(); Idx++)
+      Allocators[Idx] = AllocatorTy(Arg, Args...);
+  }
+
   /// \defgroup Methods which could be called asynchronously:
   ///
   /// @{
@@ -114,6 +128,11 @@ protected:
 
 using PerThreadBumpPtrAllocator = PerThreadAllocator<BumpPtrAllocator>;
 
+/// A thread-caching arena: per-thread bump allocators that refill from, and
+/// on Reset() or destruction return their slabs to, a shared SlabPool.
+using PerThreadPooledBumpPtrAllocator =
+    PerThreadAllocator<PooledBumpPtrAllocator<>>;
+
 } // end namespace parallel
 } // end namespace llvm
 
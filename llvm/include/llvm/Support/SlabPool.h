@@ -0,0 +1,151 @@
+//===- SlabPool.h - Lock-free cache of allocator slabs ----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines SlabPool, a thread-safe cache of equally sized memory
+/// slabs, and SlabPoolAllocator, a slab source for BumpPtrAllocatorImpl that
+/// draws from a SlabPool. Combined with PerThreadAllocator this gives a
+/// thread-caching arena: every thread bumps through its own slabs without
+/// synchronization, and only the (rare) slab refills touch the shared pool.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_SLABPOOL_H
+#define LLVM_SUPPORT_SLABPOOL_H
+
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/AllocatorBase.h"
+#include <atomic>
+#include <climits>
+#include <memory>
+
+namespace llvm {
+
+/// A lock-free pool of fixed-size slabs.
+///
+/// Slabs of exactly getSlabSize() bytes that are returned to the pool are kept
+/// in a fixed array of atomic slots and handed out again to the next request,
+/// from any thread. At most getMaxCachedSlabs() slabs are cached; anything
+/// beyond that (and any request of a different size or stricter alignment) is
+/// forwarded to the system allocator, so the memory held by an idle pool is
+/// bounded. releaseCachedSlabs() returns all cached slabs to the system.
+///
+/// The total memory reserved by the pool, in use or cached, can be capped.
+/// When a request would go over the cap, the cached slabs are released to make
+/// room first; if that is not enough the request fails as if the system were
+/// out of memory.
+///
+/// The pool must outlive every allocator that draws from it.
+class SlabPool {
+public:
+  static constexpr size_t DefaultSlabSize = 1024 * 1024;
+  static constexpr size_t DefaultMaxCachedSlabs = 64;
+
+  explicit SlabPool(size_t SlabSize = DefaultSlabSize,
+                    size_t MaxCachedSlabs = DefaultMaxCachedSlabs,
+                    size_t MaxReservedBytes = SIZE_MAX);
+  SlabPool(const SlabPool &) = delete;
+  SlabPool &operator=(const SlabPool &) = delete;
+  ~SlabPool();
+
+  /// \defgroup Methods which could be called asynchronously:
+  ///
+  /// @{
+
+  /// Allocate \p Size bytes aligned to \p Alignment, reusing a cached slab
+  /// when the request matches the pool's slab size.
+  void *allocate(size_t Size, size_t Alignment);
+
+  /// Return memory obtained from allocate(). Slabs of the pool's slab size
+  /// are cached for reuse while there is room; everything else is freed.
+  void deallocate(void *Ptr, size_t Size, size_t Alignment);
+
+  /// Return total bytes currently obtained from the system by this pool,
+  /// including slabs in use by allocators and slabs sitting in the cache.
+  size_t getReservedBytes() const {
+    return ReservedBytes.load(std::memory_order_relaxed);
+  }
+
+  /// Return the number of slabs currently cached by the pool.
+  size_t getNumCachedSlabs() const {
+    return NumCached.load(std::memory_order_relaxed);
+  }
+  /// @}
+
+  /// Free every cached slab. Slabs still owned by allocators are unaffected
+  /// and will be cached again (or freed) when they are returned.
+  void releaseCachedSlabs();
+
+  size_t getSlabSize() const { return SlabSize; }
+  size_t getMaxCachedSlabs() const { return MaxCachedSlabs; }
+  size_t getMaxReservedBytes() const { return MaxReservedBytes; }
+
+private:
+  bool isPoolable(size_t Size, size_t Alignment) const {
+    return Size == SlabSize && Alignment <= alignof(std::max_align_t);
+  }
+
+  /// Account for \p Size more bytes obtained from the system, releasing the
+  /// cached slabs if that would exceed MaxReservedBytes.
+  bool tryReserve(size_t Size);
+
+  const size_t SlabSize;
+  const size_t MaxCachedSlabs;
+  const size_t MaxReservedBytes;
+  /// Cached slabs. A null entry is an empty slot. Slots are claimed with
+  /// single-word exchanges, so unlike a linked free list there is no ABA
+  /// hazard.
+  std::unique_ptr<std::atomic<void *>[]> Slots;
+  /// Never less than the number of non-null slots: a push counts its slab
+  /// before storing it, and a pop uncounts its slab after taking it.
+  std::atomic<size_t> NumCached{0};
+  std::atomic<size_t> ReservedBytes{0};
+};
+
+/// An allocator usable as the slab source of BumpPtrAllocatorImpl which draws
+/// slabs from a shared SlabPool. A default-constructed SlabPoolAllocator has
+/// no pool and behaves like MallocAllocator.
+class SlabPoolAllocator : public AllocatorBase<SlabPoolAllocator> {
+public:
+  SlabPoolAllocator() = default;
+  SlabPoolAllocator(SlabPool &Pool) : Pool(&Pool) {}
+
+  void *Allocate(size_t Size, size_t Alignment) {
+    if (Pool)
+      return Pool->allocate(Size, Alignment);
+    return allocate_buffer(Size, Alignment);
+  }
+
+  void Deallocate(const void *Ptr, size_t Size, size_t Alignment) {
+    if (Pool)
+      return Pool->deallocate(const_cast<void *>(Ptr), Size, Alignment);
+    deallocate_buffer(const_cast<void *>(Ptr), Size, Alignment);
+  }
+
+  // Pull in base class overloads.
+  using AllocatorBase<SlabPoolAllocator>::Allocate;
+  using AllocatorBase<SlabPoolAllocator>::Deallocate;
+
+  void PrintStats() const {}
+
+  SlabPool *getPool() const { return Pool; }
+
+private:
+  SlabPool *Pool = nullptr;
+};
+
+/// A BumpPtrAllocator whose slabs come from a SlabPool. Slabs never grow, so
+/// every regular slab has the pool's default slab size and can be recycled.
+/// The slab size must match the size the pool was created with.
+template <size_t SlabSize = SlabPool::DefaultSlabSize>
+using PooledBumpPtrAllocator =
+    BumpPtrAllocatorImpl<SlabPoolAllocator, SlabSize, SlabSize, SIZE_MAX>;
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_SLABPOOL_H
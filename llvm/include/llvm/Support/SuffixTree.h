@@ -47,7 +47,7 @@ public:
     /// The length of the string.
     unsigned Length;
 
-    /// The start indices of each occurrence.
+    /// The start indices of each occurrence, in increasing order.
     SmallVector<unsigned> StartIndices;
   };
 
@@ -124,7 +124,11 @@ public:
   /// A child existing on an unsigned integer implies that from the mapping
   /// represented by the current node, there is a way to reach another
   /// mapping by tacking that character on the end of the current string.
-  DenseMap<unsigned, SuffixTreeNode *> Children;
+  ///
+  /// A DenseMap allocates at least 64 buckets once it holds anything, while
+  /// most internal nodes only have a handful of children, so keep those
+  /// inline.
+  SmallDenseMap<unsigned, SuffixTreeNode *, 8> Children;
 
   SuffixTreeInternalNode(unsigned StartIdx, unsigned EndIdx,
                          SuffixTreeInternalNode *Link)
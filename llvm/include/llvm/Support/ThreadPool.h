@@ -21,6 +21,7 @@
 
 #include <future>
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <functional>
@@ -49,6 +50,10 @@ class ThreadPoolTaskGroup;
 /// available threads are used up by tasks waiting for a task that has no thread
 /// left to run on (this includes waiting on the returned future). It should be
 /// generally safe to wait() for a group as long as groups do not form a cycle.
+///
+/// Queued tasks are started in FIFO order, except that tasks of a group with a
+/// higher priority are started first, and a group may limit how many of its
+/// tasks run at the same time. See ThreadPoolTaskGroup.
 class ThreadPool {
 public:
   /// Construct a pool using the hardware strategy \p S for mapping hardware
@@ -160,7 +165,7 @@ private:
 
       // Don't allow enqueueing after disabling the pool
       assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
-      Tasks.emplace_back(std::make_pair(std::move(R.first), Group));
+      enqueueUnlocked(std::move(R.first), Group);
       requestedThreads = ActiveThreads + Tasks.size();
     }
     QueueCondition.notify_one();
@@ -184,6 +189,14 @@ private:
   void grow(int requested);
 
   void processTasks(ThreadPoolTaskGroup *WaitingForGroup);
+
+  /// Appends a task to the queue. QueueLock must be locked.
+  void enqueueUnlocked(std::function<void()> Task, ThreadPoolTaskGroup *Group);
+
+  /// Returns the queued task that should be started next, or Tasks.end() if
+  /// there is none that may start now. QueueLock must be locked.
+  std::deque<std::pair<std::function<void()>, ThreadPoolTaskGroup *>>::iterator
+  findRunnableTaskUnlocked();
 #endif
 
   /// Threads in flight
@@ -201,6 +214,10 @@ private:
   /// Signaling for job completion (all tasks or all tasks in a group).
   std::condition_variable CompletionCondition;
 
+  /// Number of queued tasks in a group with a non-default priority or a
+  /// concurrency limit. While zero, the front of the queue is always next.
+  unsigned NumConstrainedTasks = 0;
+
   /// Keep track of the number of thread actually busy
   unsigned ActiveThreads = 0;
   /// Number of threads active for tasks in the given group (only non-zero).
@@ -221,10 +238,18 @@ private:
 /// groups can run on the same threadpool but can be waited for separately.
 /// It is even possible for tasks of one group to submit and wait for tasks
 /// of another group, as long as this does not form a loop.
+///
+/// Queued tasks of a group with a higher \p Priority are started before those
+/// of groups with a lower one; tasks outside any group have priority 0. If
+/// \p MaxConcurrency is non-zero, at most that many tasks of the group run at
+/// the same time, which is useful to bound the memory used by one kind of job
+/// on a shared pool.
 class ThreadPoolTaskGroup {
 public:
   /// The ThreadPool argument is the thread pool to forward calls to.
-  ThreadPoolTaskGroup(ThreadPool &Pool) : Pool(Pool) {}
+  ThreadPoolTaskGroup(ThreadPool &Pool, int Priority = 0,
+                      unsigned MaxConcurrency = 0)
+      : Pool(Pool), Priority(Priority), MaxConcurrency(MaxConcurrency) {}
 
   /// Blocking destructor: will wait for all the tasks in the group to complete
   /// by calling ThreadPool::wait().
@@ -240,8 +265,23 @@ public:
   /// Calls ThreadPool::wait() for this group.
   void wait() { Pool.wait(*this); }
 
+  /// Requests cancellation of the group's work. Cancellation is cooperative:
+  /// tasks that are queued still run, and are expected to poll isCancelled()
+  /// and return early, so that futures are always satisfied.
+  void cancel() { Cancelled.store(true, std::memory_order_relaxed); }
+  bool isCancelled() const { return Cancelled.load(std::memory_order_relaxed); }
+
+  int getPriority() const { return Priority; }
+  unsigned getMaxConcurrency() const { return MaxConcurrency; }
+
+  /// Returns true if tasks of this group are not scheduled in plain FIFO order.
+  bool isConstrained() const { return Priority != 0 || MaxConcurrency != 0; }
+
 private:
   ThreadPool &Pool;
+  const int Priority;
+  const unsigned MaxConcurrency;
+  std::atomic<bool> Cancelled{false};
 };
 
 } // namespace llvm
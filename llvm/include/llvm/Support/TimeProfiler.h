@@ -55,6 +55,11 @@
 // Each new thread should begin with a timeTraceProfilerInitialize, and
 // finish with a timeTraceProfilerFinishThread call.
 //
+// To keep the profiler cheap enough to leave on, e.g. in CI, the amount of
+// data it keeps can be bounded with TimeTraceProfilerOptions: a per-thread cap
+// on recorded events (the oldest ones are dropped), a summary-only mode that
+// keeps just the per-name totals, and a limit on how many totals are written.
+//
 // Timestamps come from std::chrono::stable_clock. Note that threads need
 // not see the same time from that clock, and the resolution may not be
 // the best available.
@@ -86,11 +91,24 @@ class raw_pwrite_stream;
 struct TimeTraceProfiler;
 TimeTraceProfiler *getTimeTraceProfilerInstance();
 
+/// Limits on what the time trace profiler records and writes.
+struct TimeTraceProfilerOptions {
+  /// If non-zero, keep at most this many events per thread, dropping the
+  /// oldest ones. Totals still account for every section.
+  size_t MaxEventsPerThread = 0;
+  /// Record only the per-name totals, not individual events. Detail strings
+  /// are not computed.
+  bool SummaryOnly = false;
+  /// If non-zero, only write this many of the longest totals.
+  size_t MaxTotals = 0;
+};
+
 /// Initialize the time trace profiler.
 /// This sets up the global \p TimeTraceProfilerInstance
 /// variable to be the profiler instance.
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
-                                 StringRef ProcName);
+                                 StringRef ProcName,
+                                 const TimeTraceProfilerOptions &Options = {});
 
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
@@ -2532,6 +2532,10 @@ private:
   using DependenceVector = SmallVector<DepInfo, 8>;
   SmallVector<DependenceVector *, 16> DependenceStack;
 
+  /// Number of abstract attribute updates performed so far, checked against
+  /// -attributor-max-updates between fixpoint iterations.
+  unsigned NumUpdates = 0;
+
   /// A set to remember the functions we already assume to be live and visited.
   DenseSet<const Function *> VisitedFunctions;
 
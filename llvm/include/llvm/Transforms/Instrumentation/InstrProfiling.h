@@ -56,8 +56,9 @@ private:
     }
   };
   DenseMap<GlobalVariable *, PerFunctionProfileData> ProfileDataMap;
-  /// If runtime relocation is enabled, this maps functions to the load
-  /// instruction that produces the profile relocation bias.
+  /// If runtime relocation or counter sharding is enabled, this maps functions
+  /// to the load instruction that produces the profile relocation bias, or the
+  /// bias to the counter shard of the current thread respectively.
   DenseMap<const Function *, LoadInst *> FunctionToProfileBiasMap;
   std::vector<GlobalValue *> CompilerUsedVars;
   std::vector<GlobalValue *> UsedVars;
@@ -83,6 +84,9 @@ private:
   /// Returns true if relocating counters at runtime is enabled.
   bool isRuntimeCounterRelocationEnabled() const;
 
+  /// Returns true if counters are incremented in per-thread shards.
+  bool isCounterShardingEnabled() const;
+
   /// Returns true if profile counter update register promotion is enabled.
   bool isCounterPromotionEnabled() const;
 
@@ -105,6 +109,10 @@ private:
   /// Force emitting of name vars for unused functions.
   void lowerCoverageData(GlobalVariable *CoverageNamesVar);
 
+  /// Branch to the runtime to assign a counter shard to the thread if the
+  /// shard bias loaded by \p ShardBias is still zero.
+  void emitCounterShardAssignment(LoadInst *ShardBias);
+
   /// Compute the address of the counter value that this profiling instruction
   /// acts on.
   Value *getCounterAddress(InstrProfInstBase *I);
@@ -322,6 +322,11 @@ private:
   std::optional<gvn::AvailableValue>
   AnalyzeLoadAvailability(LoadInst *Load, MemDepResult DepInfo, Value *Address);
 
+  /// Determine if a value is available for the load from its MemorySSA
+  /// clobbering access. Used instead of MemDep when that is disabled.
+  std::optional<gvn::AvailableValue>
+  AnalyzeLoadAvailabilityFromMemorySSA(LoadInst *Load);
+
   /// Given a list of non-local dependencies, determine if a value is
   /// available for the load in each specified block.  If it is, add it to
   /// ValuesPerBlock.  If not, add it to UnavailableBlocks.
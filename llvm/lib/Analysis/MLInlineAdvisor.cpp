@@ -14,6 +14,7 @@
 #include "llvm/Analysis/MLInlineAdvisor.h"
 #include "llvm/ADT/SCCIterator.h"
 #include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/CallGraph.h"
 #include "llvm/Analysis/FunctionPropertiesAnalysis.h"
 #include "llvm/Analysis/InlineCost.h"
@@ -23,6 +24,7 @@
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/Analysis/MLModelRunner.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/Analysis/ReleaseModeModelRunner.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/IR/Dominators.h"
@@ -129,6 +131,7 @@ MLInlineAdvisor::MLInlineAdvisor(
           M, MAM.getResult<FunctionAnalysisManagerModuleProxy>(M).getManager()),
       ModelRunner(std::move(Runner)), GetDefaultAdvice(GetDefaultAdvice),
       CG(MAM.getResult<LazyCallGraphAnalysis>(M)),
+      PSI(MAM.getResult<ProfileSummaryAnalysis>(M)),
       InitialIRSize(getModuleIRSize()), CurrentIRSize(InitialIRSize) {
   assert(ModelRunner);
   ModelRunner->switchContext("");
@@ -403,6 +406,17 @@ std::unique_ptr<InlineAdvice> MLInlineAdvisor::getAdviceImpl(CallBase &CB) {
       CalleeBefore.Uses;
   *ModelRunner->getTensor<int64_t>(FeatureIndex::cost_estimate) = CostEstimate;
 
+  // Call site hotness lets a model trained on profiled builds favor speed in
+  // hot code. Without a profile summary both features stay 0.
+  bool IsHot = false, IsCold = false;
+  if (PSI.hasProfileSummary()) {
+    auto &CallerBFI = FAM.getResult<BlockFrequencyAnalysis>(Caller);
+    IsHot = PSI.isHotCallSite(CB, &CallerBFI);
+    IsCold = PSI.isColdCallSite(CB, &CallerBFI);
+  }
+  *ModelRunner->getTensor<int64_t>(FeatureIndex::is_hot_callsite) = IsHot;
+  *ModelRunner->getTensor<int64_t>(FeatureIndex::is_cold_callsite) = IsCold;
+
   // Add the cost features
   for (size_t I = 0;
        I < static_cast<size_t>(InlineCostFeatureIndex::NumberOfFeatures); ++I) {
@@ -19,6 +19,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/iterator.h"
 #include "llvm/ADT/iterator_range.h"
@@ -59,6 +60,14 @@ using namespace llvm;
 
 #define DEBUG_TYPE "memoryssa"
 
+STATISTIC(NumClobberQueries, "Number of clobber queries on memory accesses");
+STATISTIC(NumCachedClobbers,
+          "Number of clobber queries answered by a cached optimization");
+STATISTIC(NumClobberWalks,
+          "Number of clobber queries that walked the def chain");
+STATISTIC(NumEagerUseOptimizations,
+          "Number of functions whose uses were all optimized up front");
+
 static cl::opt<std::string>
     DotCFGMSSA("dot-cfg-mssa",
                cl::value_desc("file name for generated dot file"),
@@ -2143,6 +2152,7 @@ void MemorySSA::ensureOptimizedUses() {
   CachingWalker WalkerLocal(this, &WalkerBase);
   OptimizeUses(this, &WalkerLocal, &BatchAA, DT).optimizeUses();
   IsOptimized = true;
+  ++NumEagerUseOptimizations;
 }
 
 void MemoryAccess::print(raw_ostream &OS) const {
@@ -2494,6 +2504,7 @@ MemoryAccess *MemorySSA::ClobberWalkerBase::getClobberingMemoryAccessBase(
   if (!StartingAccess)
     return MA;
 
+  ++NumClobberQueries;
   if (UseInvariantGroup) {
     if (auto *I = getInvariantGroupClobberingInstruction(
             *StartingAccess->getMemoryInst(), MSSA->getDomTree())) {
@@ -2513,6 +2524,7 @@ MemoryAccess *MemorySSA::ClobberWalkerBase::getClobberingMemoryAccessBase(
   // Note: Currently, we store the optimized def result in a separate field,
   // since we can't use the defining access.
   if (StartingAccess->isOptimized()) {
+    ++NumCachedClobbers;
     if (!SkipSelf || !isa<MemoryDef>(StartingAccess))
       return StartingAccess->getOptimized();
     IsOptimized = true;
@@ -2545,6 +2557,7 @@ MemoryAccess *MemorySSA::ClobberWalkerBase::getClobberingMemoryAccessBase(
       return DefiningAccess;
     }
 
+    ++NumClobberWalks;
     OptimizedAccess =
         Walker.findClobber(BAA, DefiningAccess, Q, UpwardWalkLimit);
     StartingAccess->setOptimized(OptimizedAccess);
@@ -249,6 +249,13 @@ static cl::opt<bool> UseContextForNoWrapFlagInference(
     cl::desc("Infer nuw/nsw flags using context where suitable"),
     cl::init(true));
 
+static cl::opt<unsigned> MaxSCEVNodes(
+    "scalar-evolution-max-nodes", cl::Hidden,
+    cl::desc("Maximum number of unique SCEV expressions per function. Once "
+             "reached, new instructions are modeled as SCEVUnknown and trip "
+             "counts are not computed (0 = unlimited)"),
+    cl::init(0));
+
 //===----------------------------------------------------------------------===//
 //                           SCEV class definitions
 //===----------------------------------------------------------------------===//
@@ -4515,6 +4522,13 @@ const SCEV *ScalarEvolution::getSCEV(Value *V) {
 
   if (const SCEV *S = getExistingSCEV(V))
     return S;
+  if (isa<Instruction>(V) && isOverNodeBudget()) {
+    // Stop analyzing new instructions once the function has used up its
+    // budget; an opaque SCEVUnknown is always a conservative answer.
+    const SCEV *S = getUnknown(V);
+    insertValueToMap(V, S);
+    return S;
+  }
   const SCEV *S = createSCEVIter(V);
   assert((!isa<Instruction>(V) || !isAlwaysUnknown(cast<Instruction>(V)) ||
           isa<SCEVUnknown>(S)) &&
@@ -4522,6 +4536,10 @@ const SCEV *ScalarEvolution::getSCEV(Value *V) {
   return S;
 }
 
+bool ScalarEvolution::isOverNodeBudget() const {
+  return MaxSCEVNodes && UniqueSCEVs.size() >= MaxSCEVNodes;
+}
+
 const SCEV *ScalarEvolution::getExistingSCEV(Value *V) {
   assert(isSCEVable(V->getType()) && "Value is not SCEVable!");
 
@@ -8644,6 +8662,10 @@ ScalarEvolution::BackedgeTakenInfo::BackedgeTakenInfo(
 ScalarEvolution::BackedgeTakenInfo
 ScalarEvolution::computeBackedgeTakenCount(const Loop *L,
                                            bool AllowPredicates) {
+  if (isOverNodeBudget())
+    return BackedgeTakenInfo({}, /*IsComplete=*/false, getCouldNotCompute(),
+                             /*MaxOrZero=*/false);
+
   SmallVector<BasicBlock *, 8> ExitingBlocks;
   L->getExitingBlocks(ExitingBlocks);
 
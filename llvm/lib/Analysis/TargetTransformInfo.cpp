@@ -42,6 +42,35 @@ static cl::opt<unsigned> PredictableBranchThreshold(
     cl::desc(
         "Use this to override the target's predictable branch threshold (%)."));
 
+static cl::opt<bool> CacheCosts(
+    "tti-cache-costs", cl::init(false), cl::Hidden,
+    cl::desc("Memoize context-free arithmetic, cast and memory op costs"));
+
+namespace {
+/// Kinds of memoized cost queries, stored in the low bits of the cache key.
+enum CostQueryKind { CQ_Arithmetic, CQ_Cast, CQ_Memory };
+} // end anonymous namespace
+
+/// Return the cost for \p Key from \p Cache, computing it with \p Compute on
+/// a miss. The cost is computed before inserting, so a target implementation
+/// that queries TTI recursively cannot invalidate an iterator held here.
+template <typename CacheT, typename KeyT, typename ComputeT>
+static InstructionCost getCachedCost(CacheT &Cache, const KeyT &Key,
+                                     ComputeT Compute) {
+  if (!CacheCosts)
+    return Compute();
+  auto It = Cache.find(Key);
+  if (It != Cache.end())
+    return It->second;
+  InstructionCost Cost = Compute();
+  Cache.try_emplace(Key, Cost);
+  return Cost;
+}
+
+static uint64_t packOperandInfo(TargetTransformInfo::OperandValueInfo Info) {
+  return Info.Kind | (Info.Properties << 4);
+}
+
 namespace {
 /// No-op implementation of the TTI interface using the utility base
 /// classes.
@@ -201,10 +230,11 @@ TargetTransformInfo::TargetTransformInfo(const DataLayout &DL)
 TargetTransformInfo::~TargetTransformInfo() = default;
 
 TargetTransformInfo::TargetTransformInfo(TargetTransformInfo &&Arg)
-    : TTIImpl(std::move(Arg.TTIImpl)) {}
+    : TTIImpl(std::move(Arg.TTIImpl)), CostCache(std::move(Arg.CostCache)) {}
 
 TargetTransformInfo &TargetTransformInfo::operator=(TargetTransformInfo &&RHS) {
   TTIImpl = std::move(RHS.TTIImpl);
+  CostCache = std::move(RHS.CostCache);
   return *this;
 }
 
@@ -834,10 +864,19 @@ InstructionCost TargetTransformInfo::getArithmeticInstrCost(
     unsigned Opcode, Type *Ty, TTI::TargetCostKind CostKind,
     OperandValueInfo Op1Info, OperandValueInfo Op2Info,
     ArrayRef<const Value *> Args, const Instruction *CxtI) const {
-  InstructionCost Cost =
-      TTIImpl->getArithmeticInstrCost(Opcode, Ty, CostKind,
-                                      Op1Info, Op2Info,
-                                      Args, CxtI);
+  auto Compute = [&] {
+    return TTIImpl->getArithmeticInstrCost(Opcode, Ty, CostKind, Op1Info,
+                                           Op2Info, Args, CxtI);
+  };
+  InstructionCost Cost;
+  if (Args.empty() && !CxtI)
+    Cost = getCachedCost(CostCache,
+                         CostCacheKey(Opcode << 2 | CQ_Arithmetic, Ty, nullptr,
+                                      CostKind | packOperandInfo(Op1Info) << 8 |
+                                          packOperandInfo(Op2Info) << 16),
+                         Compute);
+  else
+    Cost = Compute();
   assert(Cost >= 0 && "TTI should not produce negative costs!");
   return Cost;
 }
@@ -901,8 +940,15 @@ InstructionCost TargetTransformInfo::getCastInstrCost(
     TTI::TargetCostKind CostKind, const Instruction *I) const {
   assert((I == nullptr || I->getOpcode() == Opcode) &&
          "Opcode should reflect passed instruction.");
+  auto Compute = [&] {
+    return TTIImpl->getCastInstrCost(Opcode, Dst, Src, CCH, CostKind, I);
+  };
   InstructionCost Cost =
-      TTIImpl->getCastInstrCost(Opcode, Dst, Src, CCH, CostKind, I);
+      I ? Compute()
+        : getCachedCost(CostCache,
+                        CostCacheKey(Opcode << 2 | CQ_Cast, Dst, Src,
+                                     CostKind | uint64_t(CCH) << 8),
+                        Compute);
   assert(Cost >= 0 && "TTI should not produce negative costs!");
   return Cost;
 }
@@ -974,8 +1020,18 @@ InstructionCost TargetTransformInfo::getMemoryOpCost(
     const Instruction *I) const {
   assert((I == nullptr || I->getOpcode() == Opcode) &&
          "Opcode should reflect passed instruction.");
-  InstructionCost Cost = TTIImpl->getMemoryOpCost(
-      Opcode, Src, Alignment, AddressSpace, CostKind, OpInfo, I);
+  auto Compute = [&] {
+    return TTIImpl->getMemoryOpCost(Opcode, Src, Alignment, AddressSpace,
+                                    CostKind, OpInfo, I);
+  };
+  InstructionCost Cost =
+      I ? Compute()
+        : getCachedCost(CostCache,
+                        CostCacheKey(Opcode << 2 | CQ_Memory, Src, nullptr,
+                                     CostKind | packOperandInfo(OpInfo) << 8 |
+                                         uint64_t(Log2(Alignment)) << 16 |
+                                         uint64_t(AddressSpace) << 32),
+                        Compute);
   assert(Cost >= 0 && "TTI should not produce negative costs!");
   return Cost;
 }
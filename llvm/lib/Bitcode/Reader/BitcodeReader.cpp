@@ -6991,7 +6991,14 @@ ModuleSummaryIndexBitcodeReader::makeCallList(ArrayRef<uint64_t> Record,
                                               bool IsOldProfileFormat,
                                               bool HasProfile, bool HasRelBF) {
   std::vector<FunctionSummary::EdgeTy> Ret;
-  Ret.reserve(Record.size());
+  // Each edge is the callee followed by its profile information, if any.
+  // Don't overallocate: the thin link keeps every call list alive at once.
+  unsigned RecordsPerEdge = 1;
+  if (IsOldProfileFormat)
+    RecordsPerEdge += HasProfile ? 2 : 1;
+  else if (HasProfile || HasRelBF)
+    RecordsPerEdge += 1;
+  Ret.reserve(Record.size() / RecordsPerEdge);
   for (unsigned I = 0, E = Record.size(); I != E; ++I) {
     CalleeInfo::HotnessType Hotness = CalleeInfo::HotnessType::Unknown;
     uint64_t RelBF = 0;
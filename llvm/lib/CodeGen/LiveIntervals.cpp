@@ -17,6 +17,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DepthFirstIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/CodeGen/LiveInterval.h"
@@ -74,6 +75,11 @@ static cl::opt<bool> EnablePrecomputePhysRegs(
 static bool EnablePrecomputePhysRegs = false;
 #endif // NDEBUG
 
+static cl::opt<bool> LazyLiveIntervals(
+    "lazy-live-intervals", cl::Hidden, cl::init(false),
+    cl::desc("Defer computing live intervals of single-def virtual registers "
+             "until they are first queried"));
+
 namespace llvm {
 
 cl::opt<bool> UseSegmentSetForPhysRegs(
@@ -105,6 +111,7 @@ void LiveIntervals::releaseMemory() {
   for (unsigned i = 0, e = VirtRegIntervals.size(); i != e; ++i)
     delete VirtRegIntervals[Register::index2VirtReg(i)];
   VirtRegIntervals.clear();
+  PendingVirtRegs.clear();
   RegMaskSlots.clear();
   RegMaskBits.clear();
   RegMaskBlocks.clear();
@@ -194,10 +201,19 @@ bool LiveIntervals::computeVirtRegInterval(LiveInterval &LI) {
 }
 
 void LiveIntervals::computeVirtRegs() {
+  if (LazyLiveIntervals)
+    PendingVirtRegs.resize(MRI->getNumVirtRegs());
   for (unsigned i = 0, e = MRI->getNumVirtRegs(); i != e; ++i) {
     Register Reg = Register::index2VirtReg(i);
     if (MRI->reg_nodbg_empty(Reg))
       continue;
+    // A register with a single def has a single value number, so its interval
+    // can never need splitting into connected components and is safe to
+    // compute whenever it is first asked for.
+    if (LazyLiveIntervals && MRI->hasOneDef(Reg)) {
+      PendingVirtRegs.set(i);
+      continue;
+    }
     LiveInterval &LI = createEmptyInterval(Reg);
     bool NeedSplit = computeVirtRegInterval(LI);
     if (NeedSplit) {
@@ -973,13 +989,16 @@ private:
   SlotIndex NewIdx;
   SmallPtrSet<LiveRange*, 8> Updated;
   bool UpdateFlags;
+  // Virtual registers whose intervals already describe the new position.
+  const SmallSet<Register, 8> *UpToDate;
 
 public:
   HMEditor(LiveIntervals& LIS, const MachineRegisterInfo& MRI,
            const TargetRegisterInfo& TRI,
-           SlotIndex OldIdx, SlotIndex NewIdx, bool UpdateFlags)
+           SlotIndex OldIdx, SlotIndex NewIdx, bool UpdateFlags,
+           const SmallSet<Register, 8> *UpToDate = nullptr)
     : LIS(LIS), MRI(MRI), TRI(TRI), OldIdx(OldIdx), NewIdx(NewIdx),
-      UpdateFlags(UpdateFlags) {}
+      UpdateFlags(UpdateFlags), UpToDate(UpToDate) {}
 
   // FIXME: UpdateFlags is a workaround that creates live intervals for all
   // physregs, even those that aren't needed for regalloc, in order to update
@@ -1014,6 +1033,8 @@ public:
       if (!Reg)
         continue;
       if (Reg.isVirtual()) {
+        if (UpToDate && UpToDate->count(Reg))
+          continue;
         LiveInterval &LI = LIS.getInterval(Reg);
         if (LI.hasSubRanges()) {
           unsigned SubReg = MO.getSubReg();
@@ -1500,6 +1521,14 @@ void LiveIntervals::handleMove(MachineInstr &MI, bool UpdateFlags) {
   // inside it.
   assert((!MI.isBundled() || MI.getOpcode() == TargetOpcode::BUNDLE) &&
          "Cannot move instruction in bundle");
+  // HMEditor patches the intervals of MI's operands from the old position to
+  // the new one, so any deferred interval must be computed while the slot
+  // indexes still describe the old position.
+  if (!PendingVirtRegs.empty())
+    for (const MachineOperand &MO : MI.operands())
+      if (MO.isReg() && MO.getReg().isVirtual())
+        getInterval(MO.getReg());
+
   SlotIndex OldIndex = Indexes->getInstructionIndex(MI);
   Indexes->removeMachineInstrFromMaps(MI);
   SlotIndex NewIndex = Indexes->insertMachineInstrInMaps(MI);
@@ -1519,6 +1548,18 @@ void LiveIntervals::handleMoveIntoNewBundle(MachineInstr &BundleStart,
   const SlotIndex NewIndex = Indexes->insertMachineInstrInMaps(BundleStart);
   auto BundleEnd = getBundleEnd(BundleStart.getIterator());
 
+  // Compute deferred intervals of the bundle's operands while the bundled
+  // instructions are still in the maps. With the bundle header in place they
+  // already see the bundled layout, so HMEditor must leave them alone.
+  SmallSet<Register, 8> Computed;
+  if (!PendingVirtRegs.empty())
+    for (const MachineOperand &MO : BundleStart.operands())
+      if (MO.isReg() && MO.getReg().isVirtual() &&
+          isIntervalPending(MO.getReg())) {
+        getInterval(MO.getReg());
+        Computed.insert(MO.getReg());
+      }
+
   auto I = BundleStart.getIterator();
   I++;
   while (I != BundleEnd) {
@@ -1530,7 +1571,8 @@ void LiveIntervals::handleMoveIntoNewBundle(MachineInstr &BundleStart,
     I++;
   }
   for (SlotIndex OldIndex : ToProcess) {
-    HMEditor HME(*this, *MRI, *TRI, OldIndex, NewIndex, UpdateFlags);
+    HMEditor HME(*this, *MRI, *TRI, OldIndex, NewIndex, UpdateFlags,
+                 &Computed);
     HME.updateAllRanges(&BundleStart);
   }
 
@@ -27,10 +27,68 @@
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/PrintPasses.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+#include <mutex>
 
 using namespace llvm;
 using namespace ore;
 
+static cl::opt<std::string> MachinePassStatsFile(
+    "machine-pass-stats", cl::Hidden, cl::value_desc("filename"),
+    cl::desc("Write one JSON object per machine function pass run, with its "
+             "wall time, machine function allocator growth and instruction "
+             "counts, to the given file"));
+
+namespace {
+/// The destination of -machine-pass-stats records. Codegen may run on several
+/// threads, so each record is written as a whole line under a lock.
+class MachinePassStatsStream {
+  std::mutex Lock;
+  std::unique_ptr<raw_fd_ostream> OS;
+  bool Failed = false;
+
+public:
+  void write(const json::Value &Record) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    if (Failed)
+      return;
+    if (!OS) {
+      std::error_code EC;
+      OS = std::make_unique<raw_fd_ostream>(MachinePassStatsFile, EC,
+                                            sys::fs::OF_Text);
+      if (EC) {
+        WithColor::warning() << "could not open '" << MachinePassStatsFile
+                             << "': " << EC.message() << '\n';
+        OS.reset();
+        Failed = true;
+        return;
+      }
+    }
+    *OS << Record << '\n';
+  }
+};
+} // end anonymous namespace
+
+static void recordMachinePassStats(const MachineFunction &MF,
+                                   StringRef PassName, int64_t WallMicros,
+                                   size_t BytesBefore, unsigned CountBefore) {
+  static MachinePassStatsStream Stream;
+  Stream.write(json::Object{
+      {"function", MF.getName()},
+      {"pass", PassName},
+      {"wall_us", WallMicros},
+      {"bytes_allocated",
+       int64_t(MF.getAllocatedBytes()) - int64_t(BytesBefore)},
+      {"instrs_before", CountBefore},
+      {"instrs_after", MF.getInstructionCount()},
+  });
+}
+
 Pass *MachineFunctionPass::createPrinterPass(raw_ostream &O,
                                              const std::string &Banner) const {
   return createMachineFunctionPrinterPass(O, Banner);
@@ -65,12 +123,20 @@ bool MachineFunctionPass::runOnFunction(Function &F) {
   // Check if the user asked for size remarks.
   bool ShouldEmitSizeRemarks =
       F.getParent()->shouldEmitInstrCountChangedRemark();
+  bool ShouldRecordStats = !MachinePassStatsFile.empty();
 
-  // If we want size remarks, collect the number of MachineInstrs in our
-  // MachineFunction before the pass runs.
-  if (ShouldEmitSizeRemarks)
+  // If we want size remarks or pass stats, collect the number of
+  // MachineInstrs in our MachineFunction before the pass runs.
+  if (ShouldEmitSizeRemarks || ShouldRecordStats)
     CountBefore = MF.getInstructionCount();
 
+  size_t BytesBefore = 0;
+  std::chrono::steady_clock::time_point StartTime;
+  if (ShouldRecordStats) {
+    BytesBefore = MF.getAllocatedBytes();
+    StartTime = std::chrono::steady_clock::now();
+  }
+
   // For --print-changed, if the function name is a candidate, save the
   // serialized MF to be compared later.
   SmallString<0> BeforeStr, AfterStr;
@@ -90,6 +156,13 @@ bool MachineFunctionPass::runOnFunction(Function &F) {
 
   bool RV = runOnMachineFunction(MF);
 
+  if (ShouldRecordStats) {
+    auto Wall = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - StartTime);
+    recordMachinePassStats(MF, getPassName(), Wall.count(), BytesBefore,
+                           CountBefore);
+  }
+
   if (ShouldEmitSizeRemarks) {
     // We wanted size remarks. Check if there was a change to the number of
     // MachineInstrs in the module. Emit a remark if there was a change.
@@ -587,6 +587,10 @@ void MachineOutliner::findCandidates(
   for (const SuffixTree::RepeatedSubstring &RS : ST) {
     CandidatesForRepeatedSeq.clear();
     unsigned StringLen = RS.Length;
+    // The occurrences come in increasing order. Every candidate of this
+    // sequence has the same length, so a new one can only overlap the last one
+    // kept, and keeping the earliest non-overlapping occurrences keeps as many
+    // as possible.
     LLVM_DEBUG(dbgs() << "  Sequence length: " << StringLen << "\n");
     // Debug code to keep track of how many candidates we removed.
 #ifndef NDEBUG
@@ -612,21 +616,18 @@ void MachineOutliner::findCandidates(
       //
       // Note that two things DON'T overlap when they look like this:
       // start1...end1 .... start2...end2
-      // That is, one must either
-      // * End before the other starts
-      // * Start after the other ends
+      // Since the start indices are sorted, that means this candidate must
+      // start after the last kept one ends.
       unsigned EndIdx = StartIdx + StringLen - 1;
-      auto FirstOverlap = find_if(
-          CandidatesForRepeatedSeq, [StartIdx, EndIdx](const Candidate &C) {
-            return EndIdx >= C.getStartIdx() && StartIdx <= C.getEndIdx();
-          });
-      if (FirstOverlap != CandidatesForRepeatedSeq.end()) {
+      if (!CandidatesForRepeatedSeq.empty() &&
+          StartIdx <= CandidatesForRepeatedSeq.back().getEndIdx()) {
 #ifndef NDEBUG
         ++NumDiscarded;
         LLVM_DEBUG(dbgs() << "    .. DISCARD candidate @ [" << StartIdx
                           << ", " << EndIdx << "]; overlaps with candidate @ ["
-                          << FirstOverlap->getStartIdx() << ", "
-                          << FirstOverlap->getEndIdx() << "]\n");
+                          << CandidatesForRepeatedSeq.back().getStartIdx()
+                          << ", " << CandidatesForRepeatedSeq.back().getEndIdx()
+                          << "]\n");
 #endif
         continue;
       }
@@ -82,6 +82,8 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumSplitBudgetExceeded,
+          "Number of functions that exhausted the live range split budget");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -147,6 +149,14 @@ static cl::opt<unsigned> SplitThresholdForRegWithHint(
              "percentate"),
     cl::init(75), cl::Hidden);
 
+static cl::opt<unsigned> SplitBudgetPerVirtReg(
+    "regalloc-split-budget",
+    cl::desc("Limit the number of live range split attempts in a function to "
+             "this many per virtual register. Once the budget is exhausted, "
+             "the remaining live ranges are evicted or spilled without trying "
+             "to split them (0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
 static RegisterRegAlloc greedyRegAlloc("greedy", "greedy register allocator",
                                        createGreedyRegisterAllocator);
 
@@ -2437,7 +2447,7 @@ MCRegister RAGreedy::selectOrSplitImpl(const LiveInterval &VirtReg,
     return 0;
   }
 
-  if (Stage < RS_Spill) {
+  if (Stage < RS_Spill && consumeSplitBudget()) {
     // Try splitting VirtReg or interferences.
     unsigned NewVRegSizeBefore = NewVRegs.size();
     Register PhysReg = trySplit(VirtReg, Order, NewVRegs, FixedRegisters);
@@ -2484,6 +2494,34 @@ MCRegister RAGreedy::selectOrSplitImpl(const LiveInterval &VirtReg,
   return 0;
 }
 
+bool RAGreedy::consumeSplitBudget() {
+  if (!SplitBudget)
+    return true;
+  if (SplitAttempts < SplitBudget) {
+    ++SplitAttempts;
+    return true;
+  }
+  if (SplitAttempts++ != SplitBudget)
+    return false;
+
+  // First time over budget: report it once for the function.
+  ++NumSplitBudgetExceeded;
+  LLVM_DEBUG(dbgs() << "Split budget of " << SplitBudget
+                    << " attempts exceeded, spilling remaining ranges\n");
+  ORE->emit([&]() {
+    using namespace ore;
+    DebugLoc Loc;
+    if (auto *SP = MF->getFunction().getSubprogram())
+      Loc = DILocation::get(SP->getContext(), SP->getLine(), 1, SP);
+    return MachineOptimizationRemarkMissed(DEBUG_TYPE, "SplitBudgetExceeded",
+                                           Loc, &MF->front())
+           << "live range split budget of " << NV("SplitBudget", SplitBudget)
+           << " attempts exceeded; remaining live ranges are spilled "
+              "without splitting";
+  });
+  return false;
+}
+
 void RAGreedy::RAGreedyStats::report(MachineOptimizationRemarkMissed &R) {
   using namespace ore;
   if (Spills) {
@@ -2734,6 +2772,8 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   IntfCache.init(MF, Matrix->getLiveUnions(), Indexes, LIS, TRI);
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
+  SplitBudget = uint64_t(SplitBudgetPerVirtReg) * MRI->getNumVirtRegs();
+  SplitAttempts = 0;
 
   allocatePhysRegs();
   tryHintsRecoloring();
@@ -282,6 +282,11 @@ private:
 
   bool ReverseLocalAssignment = false;
 
+  /// Maximum number of trySplit() attempts for the current function, or 0 if
+  /// unlimited, and the number of attempts made so far.
+  uint64_t SplitBudget = 0;
+  uint64_t SplitAttempts = 0;
+
 public:
   RAGreedy(const RegClassFilterFunc F = allocateAllRegClasses);
 
@@ -381,6 +386,9 @@ private:
                          SmallVectorImpl<Register> &);
   unsigned trySplit(const LiveInterval &, AllocationOrder &,
                     SmallVectorImpl<Register> &, const SmallVirtRegSet &);
+  /// Account for one trySplit() attempt. Returns false once the function's
+  /// split budget is exhausted, emitting a remark the first time.
+  bool consumeSplitBudget();
   unsigned tryLastChanceRecoloring(const LiveInterval &, AllocationOrder &,
                                    SmallVectorImpl<Register> &,
                                    SmallVirtRegSet &, RecoloringStack &,
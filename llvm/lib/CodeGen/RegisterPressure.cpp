@@ -1094,23 +1094,23 @@ getMaxUpwardPressureDelta(const MachineInstr *MI, PressureDiff *PDiff,
                           ArrayRef<PressureChange> CriticalPSets,
                           ArrayRef<unsigned> MaxPressureLimit) {
   // Snapshot Pressure.
-  // FIXME: The snapshot heap space should persist. But I'm planning to
-  // summarize the pressure effect so we don't need to snapshot at all.
-  std::vector<unsigned> SavedPressure = CurrSetPressure;
-  std::vector<unsigned> SavedMaxPressure = P.MaxSetPressure;
+  // FIXME: I'm planning to summarize the pressure effect so we don't need to
+  // snapshot at all.
+  SavedSetPressure = CurrSetPressure;
+  SavedMaxSetPressure = P.MaxSetPressure;
 
   bumpUpwardPressure(MI);
 
-  computeExcessPressureDelta(SavedPressure, CurrSetPressure, Delta, RCI,
+  computeExcessPressureDelta(SavedSetPressure, CurrSetPressure, Delta, RCI,
                              LiveThruPressure);
-  computeMaxPressureDelta(SavedMaxPressure, P.MaxSetPressure, CriticalPSets,
+  computeMaxPressureDelta(SavedMaxSetPressure, P.MaxSetPressure, CriticalPSets,
                           MaxPressureLimit, Delta);
   assert(Delta.CriticalMax.getUnitInc() >= 0 &&
          Delta.CurrentMax.getUnitInc() >= 0 && "cannot decrease max pressure");
 
   // Restore the tracker's state.
-  P.MaxSetPressure.swap(SavedMaxPressure);
-  CurrSetPressure.swap(SavedPressure);
+  P.MaxSetPressure.swap(SavedMaxSetPressure);
+  CurrSetPressure.swap(SavedSetPressure);
 
 #ifndef NDEBUG
   if (!PDiff)
@@ -1342,21 +1342,21 @@ getMaxDownwardPressureDelta(const MachineInstr *MI, RegPressureDelta &Delta,
                             ArrayRef<PressureChange> CriticalPSets,
                             ArrayRef<unsigned> MaxPressureLimit) {
   // Snapshot Pressure.
-  std::vector<unsigned> SavedPressure = CurrSetPressure;
-  std::vector<unsigned> SavedMaxPressure = P.MaxSetPressure;
+  SavedSetPressure = CurrSetPressure;
+  SavedMaxSetPressure = P.MaxSetPressure;
 
   bumpDownwardPressure(MI);
 
-  computeExcessPressureDelta(SavedPressure, CurrSetPressure, Delta, RCI,
+  computeExcessPressureDelta(SavedSetPressure, CurrSetPressure, Delta, RCI,
                              LiveThruPressure);
-  computeMaxPressureDelta(SavedMaxPressure, P.MaxSetPressure, CriticalPSets,
+  computeMaxPressureDelta(SavedMaxSetPressure, P.MaxSetPressure, CriticalPSets,
                           MaxPressureLimit, Delta);
   assert(Delta.CriticalMax.getUnitInc() >= 0 &&
          Delta.CurrentMax.getUnitInc() >= 0 && "cannot decrease max pressure");
 
   // Restore the tracker's state.
-  P.MaxSetPressure.swap(SavedMaxPressure);
-  CurrSetPressure.swap(SavedPressure);
+  P.MaxSetPressure.swap(SavedMaxSetPressure);
+  CurrSetPressure.swap(SavedSetPressure);
 }
 
 /// Get the pressure of each PSet after traversing this instruction bottom-up.
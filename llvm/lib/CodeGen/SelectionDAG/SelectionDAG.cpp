@@ -1199,6 +1199,8 @@ bool SelectionDAG::RemoveNodeFromCSEMaps(SDNode *N) {
     assert(N->getOpcode() != ISD::DELETED_NODE && "DELETED_NODE in CSEMap!");
     assert(N->getOpcode() != ISD::EntryToken && "EntryToken in CSEMap!");
     Erased = CSEMap.RemoveNode(N);
+    // The caller is about to modify N; forget its cached profile hash.
+    N->CSEHash = 0;
     break;
   }
 #ifndef NDEBUG
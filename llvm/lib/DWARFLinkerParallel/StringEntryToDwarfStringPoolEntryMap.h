@@ -26,9 +26,11 @@ public:
   /// Create DwarfStringPoolEntry for specified StringEntry if necessary.
   /// Initialize DwarfStringPoolEntry with initial values.
   DwarfStringPoolEntryWithExtString *add(const StringEntry *String) {
-    DwarfStringPoolEntriesTy::iterator it = DwarfStringPoolEntries.find(String);
+    // This is called for every string patch of the whole link from a single
+    // thread, so look the string up only once.
+    auto [it, Inserted] = DwarfStringPoolEntries.try_emplace(String, nullptr);
 
-    if (it == DwarfStringPoolEntries.end()) {
+    if (Inserted) {
       DwarfStringPoolEntryWithExtString *DataPtr =
           GlobalData.getAllocator()
               .Allocate<DwarfStringPoolEntryWithExtString>();
@@ -36,7 +38,7 @@ public:
       DataPtr->Index = DwarfStringPoolEntry::NotIndexed;
       DataPtr->Offset = 0;
       DataPtr->Symbol = nullptr;
-      it = DwarfStringPoolEntries.insert(std::make_pair(String, DataPtr)).first;
+      it->second = DataPtr;
     }
 
     assert(it->second != nullptr);
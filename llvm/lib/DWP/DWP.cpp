@@ -616,12 +616,15 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
+  // Everything that outlives an input is copied out of it: section contents
+  // are copied into the streamer, strings into the string pool and unit names
+  // into the index entries. Each input, and its decompressed sections, is
+  // therefore released as soon as it has been processed instead of being kept
+  // alive until the whole package is written.
   std::deque<SmallString<32>> UncompressedSections;
 
   for (const auto &Input : Inputs) {
+    UncompressedSections.clear();
     auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
     if (!ErrOrObj) {
       return handleErrors(ErrOrObj.takeError(),
@@ -631,7 +634,6 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
     }
 
     auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
 
     UnitIndexEntry CurEntry = {};
 
@@ -733,7 +733,8 @@ DWARFContext::DWARFContext(std::unique_ptr<const DWARFObject> DObj,
                            bool ThreadSafe)
     : DIContext(CK_DWARF),
       RecoverableErrorHandler(RecoverableErrorHandler),
-      WarningHandler(WarningHandler), DObj(std::move(DObj)) {
+      WarningHandler(WarningHandler), DObj(std::move(DObj)),
+      ThreadSafe(ThreadSafe) {
         if (ThreadSafe)
           State.reset(new ThreadSafeState(*this, DWPName));
         else
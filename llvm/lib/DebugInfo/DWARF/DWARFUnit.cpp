@@ -649,6 +649,11 @@ void DWARFUnit::clearDIEs(bool KeepCUDie) {
   DieArray = (KeepCUDie && !DieArray.empty())
                  ? std::vector<DWARFDebugInfoEntry>({DieArray[0]})
                  : std::vector<DWARFDebugInfoEntry>();
+  // The address and variable maps point into the DIE array; forget which
+  // roots were scanned so the variable map is rebuilt on demand.
+  AddrDieMap.clear();
+  VariableDieMap.clear();
+  RootsParsedForVariables.clear();
 }
 
 Expected<DWARFAddressRangesVector>
@@ -29,9 +29,11 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Support/raw_ostream.h"
 #include <map>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -350,6 +352,27 @@ unsigned DWARFVerifier::verifyUnits(const DWARFUnitVector &Units) {
   unsigned NumDebugInfoErrors = 0;
   ReferenceMap CrossUnitReferences;
 
+  // Extracting the DIEs dominates the cost of verifying large units. When the
+  // context allows it, extract all units up front in a thread pool. The
+  // extraction errors are kept and reported in unit order below, together
+  // with the rest of the output for the unit.
+  std::vector<std::optional<Error>> ExtractionErrors;
+  if (DCtx.isThreadSafe() && Units.getNumUnits() > 1) {
+    // Parse the abbreviations serially first: the abbreviation cache is shared
+    // between the units and is not thread-safe.
+    for (const auto &Unit : Units)
+      Unit->getAbbreviations();
+
+    ExtractionErrors.resize(Units.getNumUnits());
+    ThreadPool Pool(hardware_concurrency());
+    for (size_t I = 0, E = Units.getNumUnits(); I != E; ++I)
+      Pool.async([&, I]() {
+        ExtractionErrors[I] =
+            Units[I]->tryExtractDIEsIfNeeded(false /*CUDieOnly*/);
+      });
+    Pool.wait();
+  }
+
   unsigned Index = 1;
   for (const auto &Unit : Units) {
     OS << "Verifying unit: " << Index << " / " << Units.getNumUnits();
@@ -357,6 +380,9 @@ unsigned DWARFVerifier::verifyUnits(const DWARFUnitVector &Units) {
       OS << ", \"" << Name << '\"';
     OS << '\n';
     OS.flush();
+    if (!ExtractionErrors.empty())
+      if (Error Err = std::move(*ExtractionErrors[Index - 1]))
+        DCtx.getRecoverableErrorHandler()(std::move(Err));
     ReferenceMap UnitLocalReferences;
     NumDebugInfoErrors +=
         verifyUnitContents(*Unit, UnitLocalReferences, CrossUnitReferences);
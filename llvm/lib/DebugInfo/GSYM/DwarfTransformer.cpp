@@ -519,6 +519,17 @@ Error DwarfTransformer::convert(uint32_t NumThreads, raw_ostream *OS) {
     }
     return ReturnDie;
   };
+  auto releaseUnit = [](DWARFUnit &DwarfUnit) {
+    if (DwarfUnit.getDWOId()) {
+      DWARFUnit *DWOCU = DwarfUnit.getNonSkeletonUnitDIE().getDwarfUnit();
+      if (DWOCU && DWOCU != &DwarfUnit) {
+        DWOCU->getContext().clearLineTableForUnit(DWOCU);
+        DWOCU->clearDIEs(/*KeepCUDie=*/true);
+      }
+    }
+    DwarfUnit.getContext().clearLineTableForUnit(&DwarfUnit);
+    DwarfUnit.clearDIEs(/*KeepCUDie=*/true);
+  };
   if (NumThreads == 1) {
     // Parse all DWARF data from this thread, use the same string/file table
     // for everything
@@ -526,6 +537,11 @@ Error DwarfTransformer::convert(uint32_t NumThreads, raw_ostream *OS) {
       DWARFDie Die = getDie(*CU);
       CUInfo CUI(DICtx, dyn_cast<DWARFCompileUnit>(CU.get()));
       handleDie(OS, CUI, Die);
+      // Everything needed from this unit now lives in the GsymCreator, so drop
+      // its DIEs and line table to keep the peak memory proportional to the
+      // largest unit rather than to the whole binary. Cross unit references
+      // from later units simply extract the DIEs again.
+      releaseUnit(*CU);
     }
   } else {
     // LLVM Dwarf parser is not thread-safe and we need to parse all DWARF up
@@ -565,6 +581,11 @@ Error DwarfTransformer::convert(uint32_t NumThreads, raw_ostream *OS) {
       }
     }
     pool.wait();
+
+    // All conversion is done, release the parsed DWARF before the creator
+    // sorts and encodes the function infos.
+    for (const auto &CU : DICtx.compile_units())
+      releaseUnit(*CU);
   }
   size_t FunctionsAddedCount = Gsym.getNumFunctionInfos() - NumBefore;
   if (OS)
@@ -625,6 +625,9 @@ Error ELFLinkGraphBuilder<ELFT>::forEachRelaRelocation(
   if (!RelEntries)
     return RelEntries.takeError();
 
+  // Most relocations become one edge on BlockToFix.
+  BlockToFix->reserveEdges(RelEntries->size());
+
   // Let the callee process relocation entries one by one.
   for (const typename ELFT::Rela &R : *RelEntries)
     if (Error Err = Func(R, **FixupSection, *BlockToFix))
@@ -675,6 +678,9 @@ Error ELFLinkGraphBuilder<ELFT>::forEachRelRelocation(
   if (!RelEntries)
     return RelEntries.takeError();
 
+  // Most relocations become one edge on BlockToFix.
+  BlockToFix->reserveEdges(RelEntries->size());
+
   // Let the callee process relocation entries one by one.
   for (const typename ELFT::Rel &R : *RelEntries)
     if (Error Err = Func(R, **FixupSection, *BlockToFix))
@@ -309,10 +309,10 @@ private:
       uint64_t SegSize =
           alignTo(Seg.ContentSize + Seg.ZeroFillSize, MemMgr.PageSize);
       sys::MemoryBlock MB(Seg.WorkingMem, SegSize);
+      // protectMappedMemory invalidates the instruction cache itself when
+      // MF_EXEC is requested.
       if (auto EC = sys::Memory::protectMappedMemory(MB, Prot))
         return errorCodeToError(EC);
-      if (Prot & sys::Memory::MF_EXEC)
-        sys::Memory::InvalidateInstructionCache(MB.base(), MB.allocatedSize());
     }
     return Error::success();
   }
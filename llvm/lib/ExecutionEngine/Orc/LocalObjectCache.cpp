@@ -0,0 +1,125 @@
+//===--------- LocalObjectCache.cpp - Persistent on-disk JIT object cache -===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/LocalObjectCache.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+#define DEBUG_TYPE "orc"
+
+namespace llvm {
+namespace orc {
+
+Expected<std::unique_ptr<LocalObjectCache>>
+LocalObjectCache::Create(StringRef CacheDir, std::string ConfigKey) {
+  if (std::error_code EC =
+          sys::fs::create_directories(CacheDir, /*IgnoreExisting=*/true))
+    return createFileError(CacheDir, EC);
+  return std::unique_ptr<LocalObjectCache>(
+      new LocalObjectCache(CacheDir, std::move(ConfigKey)));
+}
+
+std::string LocalObjectCache::getKey(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+  }
+
+  // Length-prefix every component so that distinct inputs can not produce the
+  // same byte stream.
+  SHA1 Hasher;
+  auto AddString = [&](StringRef Str) {
+    uint64_t Size = Str.size();
+    Hasher.update(ArrayRef(reinterpret_cast<const uint8_t *>(&Size),
+                           sizeof(Size)));
+    Hasher.update(Str);
+  };
+  AddString(ConfigKey);
+  AddString(M.getTargetTriple());
+  AddString(M.getDataLayoutStr());
+  AddString(StringRef(Bitcode.data(), Bitcode.size()));
+  return toHex(Hasher.final());
+}
+
+SmallString<128> LocalObjectCache::getEntryPath(StringRef Key) const {
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, "llvmjitcache-" + Key + ".o");
+  return Path;
+}
+
+std::unique_ptr<MemoryBuffer> LocalObjectCache::getObject(const Module *M) {
+  std::string Key = getKey(*M);
+  auto BufferOrErr = MemoryBuffer::getFile(getEntryPath(Key), /*IsText=*/false,
+                                           /*RequiresNullTerminator=*/false);
+  if (BufferOrErr) {
+    LLVM_DEBUG(dbgs() << "LocalObjectCache: hit for " << M->getModuleIdentifier()
+                      << " (" << Key << ")\n");
+    return std::move(*BufferOrErr);
+  }
+
+  LLVM_DEBUG(dbgs() << "LocalObjectCache: miss for "
+                    << M->getModuleIdentifier() << " (" << Key << ")\n");
+  std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+  PendingKeys[M] = std::move(Key);
+  return nullptr;
+}
+
+void LocalObjectCache::notifyObjectCompiled(const Module *M,
+                                            MemoryBufferRef Obj) {
+  std::string Key;
+  {
+    std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+    auto I = PendingKeys.find(M);
+    if (I != PendingKeys.end()) {
+      Key = std::move(I->second);
+      PendingKeys.erase(I);
+    }
+  }
+  // The object was compiled without a prior lookup through this cache.
+  if (Key.empty())
+    Key = getKey(*M);
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // readers never observe a partially written entry.
+  SmallString<128> TempModel(CacheDir);
+  sys::path::append(TempModel, "llvmjitcache-%%%%%%.tmp.o");
+  Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+      TempModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << Obj.getBuffer();
+    OS.flush();
+    if (OS.has_error()) {
+      OS.clear_error();
+      consumeError(Temp->discard());
+      return;
+    }
+  }
+
+  // If another thread or process stored the same entry first, keep fails on
+  // some platforms; the existing entry is equivalent, so just drop ours.
+  if (Error Err = Temp->keep(getEntryPath(Key))) {
+    consumeError(std::move(Err));
+    consumeError(Temp->discard());
+  }
+}
+
+} // end namespace orc
+} // end namespace llvm
@@ -78,13 +78,12 @@ void InProcessMemoryMapper::initialize(MemoryMapper::AllocInfo &AI,
     std::memset((Base + Segment.ContentSize).toPtr<void *>(), 0,
                 Segment.ZeroFillSize);
 
+    // This also invalidates the instruction cache for executable segments.
     if (auto EC = sys::Memory::protectMappedMemory(
             {Base.toPtr<void *>(), Size},
             toSysMemoryProtectionFlags(Segment.AG.getMemProt()))) {
       return OnInitialized(errorCodeToError(EC));
     }
-    if ((Segment.AG.getMemProt() & MemProt::Exec) == MemProt::Exec)
-      sys::Memory::InvalidateInstructionCache(Base.toPtr<void *>(), Size);
   }
 
   auto DeinitializeActions = shared::runFinalizeActions(AI.Actions);
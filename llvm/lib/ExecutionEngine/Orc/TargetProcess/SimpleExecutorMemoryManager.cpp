@@ -130,12 +130,11 @@ Error SimpleExecutorMemoryManager::finalize(tpctypes::FinalizeRequest &FR) {
       memcpy(Mem, Seg.Content.data(), Seg.Content.size());
     memset(Mem + Seg.Content.size(), 0, Seg.Size - Seg.Content.size());
     assert(Seg.Size <= std::numeric_limits<size_t>::max());
+    // This also invalidates the instruction cache for executable segments.
     if (auto EC = sys::Memory::protectMappedMemory(
             {Mem, static_cast<size_t>(Seg.Size)},
             toSysMemoryProtectionFlags(Seg.RAG.Prot)))
       return BailOut(errorCodeToError(EC));
-    if ((Seg.RAG.Prot & MemProt::Exec) == MemProt::Exec)
-      sys::Memory::InvalidateInstructionCache(Mem, Seg.Size);
   }
 
   // Run finalization actions.
@@ -11,6 +11,10 @@
 
 namespace llvm {
 
+// Uses dominate IR memory in large modules; catch accidental growth.
+static_assert(sizeof(Use) == 4 * sizeof(void *),
+              "Use should be exactly four pointers");
+
 void Use::swap(Use &RHS) {
   if (Val == RHS.Val)
     return;
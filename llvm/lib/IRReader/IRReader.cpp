@@ -102,6 +102,8 @@ std::unique_ptr<Module> llvm::parseIRFile(StringRef Filename, SMDiagnostic &Err,
     return nullptr;
   }
 
+  // The whole file is parsed front to back.
+  FileOrErr.get()->adviseIfMmap(MemoryBuffer::AccessPattern::Sequential);
   return parseIR(FileOrErr.get()->getMemBufferRef(), Err, Context, Callbacks);
 }
 
@@ -65,10 +65,22 @@ using namespace object;
 
 #define DEBUG_TYPE "lto"
 
+STATISTIC(NumCacheHits, "Number of ThinLTO backends served from the cache");
+STATISTIC(NumCacheMisses, "Number of ThinLTO backends missing in the cache");
+STATISTIC(NumCacheMissInsts,
+          "Estimated instructions compiled by ThinLTO backends missing in the "
+          "cache");
+
 static cl::opt<bool>
     DumpThinCGSCCs("dump-thin-cg-sccs", cl::init(false), cl::Hidden,
                    cl::desc("Dump the SCCs in the ThinLTO index's callgraph"));
 
+static cl::opt<bool> ThinLTOScheduleByInstCount(
+    "thinlto-schedule-by-inst-count", cl::init(false), cl::Hidden,
+    cl::desc("Start parallel ThinLTO backends in decreasing order of the "
+             "instruction count of their defined and imported functions, "
+             "rather than of their bitcode size"));
+
 namespace llvm {
 /// Enable global value internalization in LTO.
 cl::opt<bool> EnableLTOInternalization(
@@ -1414,6 +1426,8 @@ class InProcessThinBackend : public ThinBackendProc {
   ThreadPool BackendThreadPool;
   AddStreamFn AddStream;
   FileCache Cache;
+  // Shared by the backends of this link, see -thinlto-max-concurrent-codegen.
+  CodeGenAdmission Admission;
   std::set<GlobalValue::GUID> CfiFunctionDefs;
   std::set<GlobalValue::GUID> CfiFunctionDecls;
 
@@ -1456,7 +1470,8 @@ public:
         return MOrErr.takeError();
 
       return thinBackend(Conf, Task, AddStream, **MOrErr, CombinedIndex,
-                         ImportList, DefinedGlobals, &ModuleMap);
+                         ImportList, DefinedGlobals, &ModuleMap,
+                         std::vector<uint8_t>(), &Admission);
     };
 
     auto ModuleID = BM.getModuleIdentifier();
@@ -1482,9 +1497,15 @@ public:
     if (Error Err = CacheAddStreamOrErr.takeError())
       return Err;
     AddStreamFn &CacheAddStream = *CacheAddStreamOrErr;
-    if (CacheAddStream)
+    if (CacheAddStream) {
+      ++NumCacheMisses;
+      if (AreStatisticsEnabled())
+        NumCacheMissInsts +=
+            estimateBackendCost(CombinedIndex, DefinedGlobals, ImportList);
       return RunThinBackend(CacheAddStream);
+    }
 
+    ++NumCacheHits;
     return Error::success();
   }
 
@@ -1508,7 +1529,7 @@ public:
             MapVector<StringRef, BitcodeModule> &ModuleMap) {
           if (LLVM_ENABLE_THREADS && Conf.TimeTraceEnabled)
             timeTraceProfilerInitialize(Conf.TimeTraceGranularity,
-                                        "thin backend");
+                                        "thin backend", Conf.TimeTraceOptions);
           Error E = runThinLTOBackendThread(
               AddStream, Cache, Task, BM, CombinedIndex, ImportList, ExportList,
               ResolvedODR, DefinedGlobals, ModuleMap);
@@ -1684,7 +1705,10 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
       ModuleToDefinedGVSummaries.try_emplace(Mod.first);
 
   // Synthesize entry counts for functions in the CombinedIndex.
-  computeSyntheticCounts(ThinLTO.CombinedIndex);
+  {
+    TimeTraceScope TimeScope("Synthesize entry counts");
+    computeSyntheticCounts(ThinLTO.CombinedIndex);
+  }
 
   DenseMap<StringRef, FunctionImporter::ImportMapTy> ImportLists(
       ThinLTO.ModuleMap.size());
@@ -1734,20 +1758,26 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
   // no index entries in the typeIdMetadata map (e.g. if we are instead
   // performing IR-based WPD in hybrid regular/thin LTO mode).
   std::map<ValueInfo, std::vector<VTableSlotSummary>> LocalWPDTargetsMap;
-  runWholeProgramDevirtOnIndex(ThinLTO.CombinedIndex, ExportedGUIDs,
-                               LocalWPDTargetsMap);
+  {
+    TimeTraceScope TimeScope("Whole program devirtualization");
+    runWholeProgramDevirtOnIndex(ThinLTO.CombinedIndex, ExportedGUIDs,
+                                 LocalWPDTargetsMap);
+  }
 
   auto isPrevailing = [&](GlobalValue::GUID GUID, const GlobalValueSummary *S) {
     return ThinLTO.PrevailingModuleForGUID[GUID] == S->modulePath();
   };
   if (EnableMemProfContextDisambiguation) {
+    TimeTraceScope TimeScope("MemProf context disambiguation");
     MemProfContextDisambiguation ContextDisambiguation;
     ContextDisambiguation.run(ThinLTO.CombinedIndex, isPrevailing);
   }
 
-  if (Conf.OptLevel > 0)
+  if (Conf.OptLevel > 0) {
+    TimeTraceScope TimeScope("Compute cross-module import");
     ComputeCrossModuleImport(ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries,
                              isPrevailing, ImportLists, ExportLists);
+  }
 
   // Figure out which symbols need to be internalized. This also needs to happen
   // at -O0 because summary-based DCE is implemented using internalization, and
@@ -1786,18 +1816,27 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
   updateIndexWPDForExports(ThinLTO.CombinedIndex, isExported,
                            LocalWPDTargetsMap);
 
-  thinLTOInternalizeAndPromoteInIndex(ThinLTO.CombinedIndex, isExported,
-                                      isPrevailing);
+  {
+    TimeTraceScope TimeScope("Internalize and promote");
+    thinLTOInternalizeAndPromoteInIndex(ThinLTO.CombinedIndex, isExported,
+                                        isPrevailing);
+  }
 
   auto recordNewLinkage = [&](StringRef ModuleIdentifier,
                               GlobalValue::GUID GUID,
                               GlobalValue::LinkageTypes NewLinkage) {
     ResolvedODR[ModuleIdentifier][GUID] = NewLinkage;
   };
-  thinLTOResolvePrevailingInIndex(Conf, ThinLTO.CombinedIndex, isPrevailing,
-                                  recordNewLinkage, GUIDPreservedSymbols);
+  {
+    TimeTraceScope TimeScope("Resolve prevailing");
+    thinLTOResolvePrevailingInIndex(Conf, ThinLTO.CombinedIndex, isPrevailing,
+                                    recordNewLinkage, GUIDPreservedSymbols);
+  }
 
-  thinLTOPropagateFunctionAttrs(ThinLTO.CombinedIndex, isPrevailing);
+  {
+    TimeTraceScope TimeScope("Propagate function attributes");
+    thinLTOPropagateFunctionAttrs(ThinLTO.CombinedIndex, isPrevailing);
+  }
 
   generateParamAccessSummary(ThinLTO.CombinedIndex);
 
@@ -1836,11 +1875,29 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
     // improve parallelism, and avoid starving the thread pool near the end.
     // This saves about 15 sec on a 36-core machine while link `clang.exe` (out
     // of 100 sec).
-    std::vector<BitcodeModule *> ModulesVec;
-    ModulesVec.reserve(ModuleMap.size());
-    for (auto &Mod : ModuleMap)
-      ModulesVec.push_back(&Mod.second);
-    for (int I : generateModulesOrdering(ModulesVec))
+    std::vector<int> ModulesOrdering;
+    if (ThinLTOScheduleByInstCount) {
+      // Bitcode size ignores the imported functions, which the backend has to
+      // optimize as well. Estimate the work from the summary instead.
+      std::vector<uint64_t> Costs;
+      Costs.reserve(ModuleMap.size());
+      for (auto &Mod : ModuleMap)
+        Costs.push_back(estimateBackendCost(
+            ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries[Mod.first],
+            ImportLists[Mod.first]));
+      auto Seq = llvm::seq<int>(0, ModuleMap.size());
+      ModulesOrdering.assign(Seq.begin(), Seq.end());
+      llvm::stable_sort(ModulesOrdering, [&](int LeftIndex, int RightIndex) {
+        return Costs[LeftIndex] > Costs[RightIndex];
+      });
+    } else {
+      std::vector<BitcodeModule *> ModulesVec;
+      ModulesVec.reserve(ModuleMap.size());
+      for (auto &Mod : ModuleMap)
+        ModulesVec.push_back(&Mod.second);
+      ModulesOrdering = generateModulesOrdering(ModulesVec);
+    }
+    for (int I : ModulesOrdering)
       if (Error E = ProcessOneModule(I))
         return E;
   }
@@ -1888,6 +1945,26 @@ lto::setupStatsFile(StringRef StatsFilename) {
   return std::move(StatsFile);
 }
 
+uint64_t
+lto::estimateBackendCost(const ModuleSummaryIndex &Index,
+                         const GVSummaryMapTy &DefinedGVSummaries,
+                         const FunctionImporter::ImportMapTy &ImportList) {
+  uint64_t Cost = 0;
+  // Aliases are not counted, their aliasee is summarized on its own.
+  auto AddCost = [&](const GlobalValueSummary *S) {
+    if (const auto *FS = dyn_cast<FunctionSummary>(S))
+      Cost += FS->instCount();
+  };
+  for (const auto &[GUID, Summary] : DefinedGVSummaries)
+    AddCost(Summary);
+  for (const auto &[FromModule, GUIDs] : ImportList)
+    for (GlobalValue::GUID GUID : GUIDs)
+      if (const GlobalValueSummary *S =
+              Index.findSummaryInModule(GUID, FromModule))
+        AddCost(S);
+  return Cost;
+}
+
 // Compute the ordering we will process the inputs: the rough heuristic here
 // is to sort them per size so that the largest module get schedule as soon as
 // possible. This is purely a compile-time optimization.
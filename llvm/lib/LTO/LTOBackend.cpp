@@ -74,6 +74,12 @@ static cl::opt<bool> ThinLTOAssumeMerged(
     cl::desc("Assume the input has already undergone ThinLTO function "
              "importing and the other pre-optimization pipeline changes."));
 
+static cl::opt<unsigned> ThinLTOMaxConcurrentCodeGen(
+    "thinlto-max-concurrent-codegen", cl::init(0), cl::Hidden,
+    cl::desc("Maximum number of ThinLTO backends that may run code generation "
+             "at the same time; the others keep optimizing or wait (0 = no "
+             "limit)"));
+
 namespace llvm {
 extern cl::opt<bool> NoPGOWarnMismatch;
 }
@@ -425,6 +431,62 @@ static void codegen(const Config &Conf, TargetMachine *TM,
     DwoOut->keep();
 }
 
+CodeGenAdmission::CodeGenAdmission() : Limit(ThinLTOMaxConcurrentCodeGen) {}
+
+void CodeGenAdmission::acquire() {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  CV.wait(Lock, [&] { return Active < Limit; });
+  ++Active;
+}
+
+void CodeGenAdmission::release() {
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    --Active;
+  }
+  CV.notify_one();
+}
+
+/// Run codegen() for a ThinLTO backend, waiting for \p Admission first if it
+/// sets a limit. The backend parks its optimized module as bitcode and deletes
+/// the function bodies of \p Mod before it waits, so that waiting backends
+/// don't hold on to the memory the limit is meant to bound. Code is then
+/// generated for the module read back from the bitcode, and \p Mod must not be
+/// used afterwards. Every backend takes this path, whether it has to wait or
+/// not, and use-list order is preserved, so that the output doesn't depend on
+/// timing.
+static Error thinCodegen(const Config &Conf, TargetMachine *TM,
+                         AddStreamFn AddStream, unsigned Task, Module &Mod,
+                         const ModuleSummaryIndex &CombinedIndex,
+                         CodeGenAdmission *Admission) {
+  if (!Admission || !Admission->getLimit()) {
+    codegen(Conf, TM, AddStream, Task, Mod, CombinedIndex);
+    return Error::success();
+  }
+
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(Mod, OS, /*ShouldPreserveUseListOrder=*/true);
+  }
+  for (Function &F : Mod)
+    F.deleteBody();
+
+  Admission->acquire();
+  Expected<std::unique_ptr<Module>> ParkedMod = parseBitcodeFile(
+      MemoryBufferRef(StringRef(Bitcode.data(), Bitcode.size()),
+                      Mod.getModuleIdentifier()),
+      Mod.getContext());
+  if (!ParkedMod) {
+    Admission->release();
+    return ParkedMod.takeError();
+  }
+  Bitcode = {};
+  codegen(Conf, TM, AddStream, Task, **ParkedMod, CombinedIndex);
+  Admission->release();
+  return Error::success();
+}
+
 static void splitCodeGen(const Config &C, TargetMachine *TM,
                          AddStreamFn AddStream,
                          unsigned ParallelCodeGenParallelismLevel, Module &Mod,
@@ -553,7 +615,8 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
                        const FunctionImporter::ImportMapTy &ImportList,
                        const GVSummaryMapTy &DefinedGlobals,
                        MapVector<StringRef, BitcodeModule> *ModuleMap,
-                       const std::vector<uint8_t> &CmdArgs) {
+                       const std::vector<uint8_t> &CmdArgs,
+                       CodeGenAdmission *Admission) {
   Expected<const Target *> TOrErr = initAndLookupTarget(Conf, Mod);
   if (!TOrErr)
     return TOrErr.takeError();
@@ -575,7 +638,10 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
 
   LLVM_DEBUG(dbgs() << "Running ThinLTO\n");
   if (Conf.CodeGenOnly) {
-    codegen(Conf, TM.get(), AddStream, Task, Mod, CombinedIndex);
+    if (Error Err =
+            thinCodegen(Conf, TM.get(), AddStream, Task, Mod, CombinedIndex,
+                        Admission))
+      return Err;
     return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
   }
 
@@ -590,7 +656,10 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
                  CmdArgs))
           return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
 
-        codegen(Conf, TM, AddStream, Task, Mod, CombinedIndex);
+        if (Error Err =
+                thinCodegen(Conf, TM, AddStream, Task, Mod, CombinedIndex,
+                            Admission))
+          return Err;
         return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
       };
 
@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -241,6 +242,31 @@ static Error replaceDebugSections(
   return Obj.replaceSections(FromTo);
 }
 
+static Error compressDebugSections(Object &Obj,
+                                   DebugCompressionType CompressionType) {
+  SmallVector<SectionBase *, 13> ToCompress;
+  for (auto &Sec : Obj.sections())
+    if (isCompressable(Sec))
+      ToCompress.push_back(&Sec);
+
+  // Compression dominates the run time for inputs with large debug info, and
+  // the sections are independent of each other, so compress them in parallel
+  // before adding the results to the object in the original order.
+  SmallVector<std::unique_ptr<CompressedSection>, 0> Compressed(
+      ToCompress.size());
+  parallelFor(0, ToCompress.size(), [&](size_t I) {
+    Compressed[I] = std::make_unique<CompressedSection>(
+        *ToCompress[I], CompressionType, Obj.Is64Bits);
+  });
+
+  DenseMap<SectionBase *, SectionBase *> FromTo;
+  for (size_t I = 0, E = ToCompress.size(); I != E; ++I)
+    FromTo[ToCompress[I]] =
+        &Obj.addSection<CompressedSection>(std::move(*Compressed[I]));
+
+  return Obj.replaceSections(FromTo);
+}
+
 static bool isAArch64MappingSymbol(const Symbol &Sym) {
   if (Sym.Binding != STB_LOCAL || Sym.Type != STT_NOTYPE ||
       Sym.getShndx() == SHN_UNDEF)
@@ -522,12 +548,7 @@ static Error replaceAndRemoveSections(const CommonConfig &Config,
     return E;
 
   if (Config.CompressionType != DebugCompressionType::None) {
-    if (Error Err = replaceDebugSections(
-            Obj, isCompressable,
-            [&Config, &Obj](const SectionBase *S) -> Expected<SectionBase *> {
-              return &Obj.addSection<CompressedSection>(
-                  CompressedSection(*S, Config.CompressionType, Obj.Is64Bits));
-            }))
+    if (Error Err = compressDebugSections(Obj, Config.CompressionType))
       return Err;
   } else if (Config.DecompressDebugSections) {
     if (Error Err = replaceDebugSections(
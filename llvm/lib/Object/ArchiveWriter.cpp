@@ -30,6 +30,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -777,12 +778,39 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
       Entry.second = Entry.second > 1 ? 1 : 0;
   }
 
+  // Object files are read independently of each other and are parsed up front
+  // in parallel. Bitcode files are read into the shared LLVMContext and each
+  // holds a whole module, so they are parsed serially, at most one member
+  // ahead of the one being written.
+  bool NeedSymFiles =
+      NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind);
+  std::vector<std::unique_ptr<SymbolicFile>> SymFiles(NewMembers.size());
+  auto IsBitcode = [&](size_t I) {
+    return identify_magic(NewMembers[I].Buf->getBuffer()) ==
+           file_magic::bitcode;
+  };
+  auto ParseMember = [&](size_t I) -> Error {
+    const NewArchiveMember &M = NewMembers[I];
+    Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr =
+        getSymbolicFile(M.Buf->getMemBufferRef(), Context);
+    if (!SymFileOrErr)
+      return createFileError(M.MemberName, SymFileOrErr.takeError());
+    SymFiles[I] = std::move(*SymFileOrErr);
+    return Error::success();
+  };
+  if (NeedSymFiles) {
+    SmallVector<size_t, 0> ObjectMembers;
+    for (size_t I = 0, E = NewMembers.size(); I != E; ++I)
+      if (!IsBitcode(I))
+        ObjectMembers.push_back(I);
+    if (Error Err = parallelForEachError(ObjectMembers, ParseMember))
+      return std::move(Err);
+  }
+
   // The big archive format needs to know the offset of the previous member
   // header.
   uint64_t PrevOffset = 0;
   uint64_t NextMemHeadPadSize = 0;
-  std::unique_ptr<SymbolicFile> CurSymFile;
-  std::unique_ptr<SymbolicFile> NextSymFile;
   uint16_t Index = 0;
 
   for (auto M = NewMembers.begin(); M < NewMembers.end(); ++M) {
@@ -819,29 +847,16 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
           std::move(StringMsg), object::object_error::parse_failed);
     }
 
-    if (NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind)) {
-      auto SetNextSymFile = [&NextSymFile,
-                             &Context](MemoryBufferRef Buf,
-                                       StringRef MemberName) -> Error {
-        Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr =
-            getSymbolicFile(Buf, Context);
-        if (!SymFileOrErr)
-          return createFileError(MemberName, SymFileOrErr.takeError());
-        NextSymFile = std::move(*SymFileOrErr);
-        return Error::success();
-      };
-
-      if (M == NewMembers.begin())
-        if (Error Err = SetNextSymFile(Buf, M->MemberName))
+    size_t I = M - NewMembers.begin();
+    if (NeedSymFiles) {
+      if (M == NewMembers.begin() && IsBitcode(I))
+        if (Error Err = ParseMember(I))
           return std::move(Err);
-
-      CurSymFile = std::move(NextSymFile);
-
-      if ((M + 1) != NewMembers.end())
-        if (Error Err = SetNextSymFile((M + 1)->Buf->getMemBufferRef(),
-                                       (M + 1)->MemberName))
+      if ((M + 1) != NewMembers.end() && IsBitcode(I + 1))
+        if (Error Err = ParseMember(I + 1))
           return std::move(Err);
     }
+    std::unique_ptr<SymbolicFile> CurSymFile = std::move(SymFiles[I]);
 
     // In the big archive file format, we need to calculate and include the next
     // member offset and previous member offset in the file member header.
@@ -868,7 +883,7 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
                                        alignTo((M + 1)->MemberName.size(), 2);
         NextMemHeadPadSize =
             alignToPowerOf2(OffsetToNextMemData,
-                            getMemberAlignment(NextSymFile.get())) -
+                            getMemberAlignment(SymFiles[I + 1].get())) -
             OffsetToNextMemData;
         NextOffset += NextMemHeadPadSize;
       }
@@ -892,6 +907,11 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
         HasObject = true;
     }
 
+    // Only the big archive symbol tables need the parsed file later on; drop it
+    // otherwise so that at most one bitcode module is alive at a time.
+    if (!isAIXBigArchive(Kind))
+      CurSymFile.reset();
+
     Pos += Header.size() + Data.size() + Padding.size();
     Ret.push_back({std::move(Symbols), std::move(Header), Data, Padding,
                    MemHeadPadSize, std::move(CurSymFile)});
@@ -272,6 +272,16 @@ Error CoverageMapping::loadFunctionRecord(
       Record.MappingRegions[0].Count.isZero() && Counts[0] > 0)
     return Error::success();
 
+  // Don't create records for (filenames, function) pairs we've already seen.
+  // Functions defined in headers have one record per TU that uses them, so
+  // check this before evaluating the regions of what would be a duplicate.
+  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
+                                          Record.Filenames.end());
+  auto ProvenanceIt = RecordProvenance.find(FilenamesHash);
+  if (ProvenanceIt != RecordProvenance.end() &&
+      ProvenanceIt->second.contains(hash_value(OrigFuncName)))
+    return Error::success();
+
   FunctionRecord Function(OrigFuncName, Record.Filenames);
   for (const auto &Region : Record.MappingRegions) {
     Expected<int64_t> ExecutionCount = Ctx.evaluate(Region.Count);
@@ -287,11 +297,9 @@ Error CoverageMapping::loadFunctionRecord(
     Function.pushRegion(Region, *ExecutionCount, *AltExecutionCount);
   }
 
-  // Don't create records for (filenames, function) pairs we've already seen.
-  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
-                                          Record.Filenames.end());
-  if (!RecordProvenance[FilenamesHash].insert(hash_value(OrigFuncName)).second)
-    return Error::success();
+  // Only remember the pair once the record is known to be valid, so that an
+  // unevaluable record does not hide a later good one.
+  RecordProvenance[FilenamesHash].insert(hash_value(OrigFuncName));
 
   Functions.push_back(std::move(Function));
 
@@ -348,9 +348,23 @@ void InstrProfWriter::addTemporalProfileTraces(
 
 void InstrProfWriter::mergeRecordsFromWriter(InstrProfWriter &&IPW,
                                              function_ref<void(Error)> Warn) {
-  for (auto &I : IPW.FunctionData)
+  for (auto &I : IPW.FunctionData) {
+    if (I.getValue().empty())
+      continue;
+    // Functions that this writer has not seen yet are taken over wholesale.
+    // Their records were already scaled and sorted when they were added to
+    // IPW, so there is nothing to merge.
+    auto [Where, Inserted] = FunctionData.try_emplace(I.getKey());
+    if (Inserted) {
+      Where->second = std::move(I.getValue());
+      continue;
+    }
     for (auto &Func : I.getValue())
       addRecord(I.getKey(), Func.first, std::move(Func.second), 1, Warn);
+  }
+  // Release the merged-in records now rather than when IPW is destroyed, so
+  // that a tree of merges does not keep every intermediate copy alive.
+  IPW.FunctionData.clear();
 
   BinaryIds.reserve(BinaryIds.size() + IPW.BinaryIds.size());
   for (auto &I : IPW.BinaryIds)
@@ -905,7 +905,11 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
         // For function in the current module, keep its farthest ancestor
         // context. This can be used to load itself and its child and
         // sibling contexts.
-        if ((useMD5() && FuncGuidsToUse.count(std::stoull(FName.data()))) ||
+        // With MD5 names the name is the decimal GUID. Parse it in place;
+        // this loop runs once per context, and there can be millions.
+        uint64_t FGUID;
+        if ((useMD5() && !FName.getAsInteger(10, FGUID) &&
+             FuncGuidsToUse.count(FGUID)) ||
             (!useMD5() && (FuncsToUse.count(FName) ||
                            (Remapper && Remapper->exist(FName))))) {
           if (!CommonContext || !CommonContext->IsPrefixOf(FContext))
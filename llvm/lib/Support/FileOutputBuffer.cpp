@@ -22,6 +22,10 @@
 #include <io.h>
 #endif
 
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
 using namespace llvm;
 using namespace llvm::sys;
 
@@ -42,6 +46,17 @@ public:
 
   size_t getBufferSize() const override { return Buffer.size(); }
 
+  void startWriteback(size_t Offset, size_t Size) override {
+#if defined(__linux__)
+    // Initiate writeback of the dirty pages in the range without waiting for
+    // it. Errors are not fatal; the pages are written on commit() anyway.
+    if (Offset < Buffer.size())
+      (void)::sync_file_range(Temp.FD, Offset,
+                              std::min(Size, Buffer.size() - Offset),
+                              SYNC_FILE_RANGE_WRITE);
+#endif
+  }
+
   Error commit() override {
     // Unmap buffer, letting OS flush dirty pages to file on disk.
     Buffer.unmap();
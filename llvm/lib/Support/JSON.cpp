@@ -13,9 +13,11 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/NativeFormatting.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cctype>
 #include <cerrno>
+#include <mutex>
 #include <optional>
 
 namespace llvm {
@@ -368,6 +370,9 @@ class Parser {
 public:
   Parser(StringRef JSON)
       : Start(JSON.begin()), P(JSON.begin()), End(JSON.end()) {}
+  // Parse only Fragment, but report error positions relative to Document.
+  Parser(StringRef Document, StringRef Fragment)
+      : Start(Document.begin()), P(Fragment.begin()), End(Fragment.end()) {}
 
   bool checkUTF8() {
     size_t ErrOffset;
@@ -378,6 +383,8 @@ public:
   }
 
   bool parseValue(Value &Out);
+  bool parseArrayElements(function_ref<Error(Value &&)> Callback);
+  bool splitArray(std::vector<StringRef> &Elements);
 
   bool assertEnd() {
     eatWhitespace();
@@ -402,6 +409,7 @@ private:
   bool parseString(std::string &Out);
   bool parseUnicode(std::string &Out);
   bool parseError(const char *Msg); // always returns false
+  bool skipValue();
 
   char next() { return P == End ? 0 : *P++; }
   char peek() { return P == End ? 0 : *P; }
@@ -504,6 +512,95 @@ bool Parser::parseValue(Value &Out) {
   }
 }
 
+bool Parser::parseArrayElements(function_ref<Error(Value &&)> Callback) {
+  eatWhitespace();
+  if (next() != '[')
+    return parseError("Expected [ at start of array");
+  eatWhitespace();
+  if (peek() == ']') {
+    ++P;
+    return true;
+  }
+  for (;;) {
+    Value V = nullptr;
+    if (!parseValue(V))
+      return false;
+    if (Error E = Callback(std::move(V))) {
+      Err.emplace(std::move(E));
+      return false;
+    }
+    eatWhitespace();
+    switch (next()) {
+    case ',':
+      eatWhitespace();
+      continue;
+    case ']':
+      return true;
+    default:
+      return parseError("Expected , or ] after array element");
+    }
+  }
+}
+
+// Advance past one value without interpreting it. Only strings are checked
+// for termination; everything else is validated when the value is parsed.
+bool Parser::skipValue() {
+  unsigned Depth = 0;
+  while (P != End) {
+    switch (*P) {
+    case '"':
+      for (++P; P != End && *P != '"'; ++P)
+        if (*P == '\\' && P + 1 != End)
+          ++P;
+      if (P == End)
+        return parseError("Unterminated string");
+      break;
+    case '[':
+    case '{':
+      ++Depth;
+      break;
+    case ']':
+    case '}':
+      if (Depth == 0)
+        return true;
+      --Depth;
+      break;
+    case ',':
+      if (Depth == 0)
+        return true;
+      break;
+    }
+    ++P;
+  }
+  return true;
+}
+
+bool Parser::splitArray(std::vector<StringRef> &Elements) {
+  eatWhitespace();
+  if (next() != '[')
+    return parseError("Expected [ at start of array");
+  eatWhitespace();
+  if (peek() == ']') {
+    ++P;
+    return true;
+  }
+  for (;;) {
+    const char *Begin = P;
+    if (!skipValue())
+      return false;
+    Elements.push_back(StringRef(Begin, P - Begin).rtrim(" \r\n\t"));
+    switch (next()) {
+    case ',':
+      eatWhitespace();
+      continue;
+    case ']':
+      return true;
+    default:
+      return parseError("Expected , or ] after array element");
+    }
+  }
+}
+
 bool Parser::parseNumber(char First, Value &Out) {
   // Read the number into a string. (Must be null-terminated for strto*).
   SmallString<24> S;
@@ -692,6 +789,56 @@ Expected<Value> parse(StringRef JSON) {
         return std::move(E);
   return P.takeError();
 }
+
+Error parseArrayElements(StringRef JSON,
+                         function_ref<Error(Value &&)> Callback) {
+  Parser P(JSON);
+  if (P.checkUTF8())
+    if (P.parseArrayElements(Callback))
+      if (P.assertEnd())
+        return Error::success();
+  return P.takeError();
+}
+
+Error parseArrayElementsInParallel(
+    StringRef JSON, function_ref<Error(size_t Index, Value &&)> Callback) {
+  std::vector<StringRef> Elements;
+  {
+    Parser P(JSON);
+    if (!P.checkUTF8() || !P.splitArray(Elements) || !P.assertEnd())
+      return P.takeError();
+  }
+
+  std::mutex Mu;
+  size_t FirstFailure = Elements.size();
+  Error FirstError = Error::success();
+  parallelFor(0, Elements.size(), [&](size_t I) {
+    Error E = [&]() -> Error {
+      {
+        std::lock_guard<std::mutex> Lock(Mu);
+        if (FirstFailure < I)
+          return Error::success();
+      }
+      Parser P(JSON, Elements[I]);
+      Value V = nullptr;
+      if (!P.parseValue(V) || !P.assertEnd())
+        return P.takeError();
+      return Callback(I, std::move(V));
+    }();
+    if (!E)
+      return;
+    std::lock_guard<std::mutex> Lock(Mu);
+    if (I < FirstFailure) {
+      consumeError(std::move(FirstError));
+      FirstError = std::move(E);
+      FirstFailure = I;
+    } else {
+      consumeError(std::move(E));
+    }
+  });
+  return FirstError;
+}
+
 char ParseError::ID = 0;
 
 bool isUTF8(llvm::StringRef S, size_t *ErrOffset) {
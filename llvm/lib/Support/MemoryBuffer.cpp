@@ -238,6 +238,29 @@ public:
   }
 
   void dontNeedIfMmap() override { MFR.dontNeed(); }
+
+  void adviseIfMmap(MemoryBuffer::AccessPattern Pattern) override {
+    using advice = sys::fs::mapped_file_region::advice;
+    switch (Pattern) {
+    case MemoryBuffer::AccessPattern::Normal:
+      MFR.advise(advice::normal);
+      break;
+    case MemoryBuffer::AccessPattern::Sequential:
+      MFR.advise(advice::sequential);
+      break;
+    case MemoryBuffer::AccessPattern::Random:
+      MFR.advise(advice::random);
+      break;
+    }
+
+    // Fault small files in with a single call instead of one page fault per
+    // page. Files spanning many huge pages are better off with fewer, larger
+    // TLB entries.
+    if (MFR.size() <= 4 * 1024 * 1024)
+      MFR.advise(advice::populate);
+    else if (MFR.size() >= 32 * 1024 * 1024)
+      MFR.advise(advice::hugepage);
+  }
 };
 } // namespace
 
@@ -229,23 +229,29 @@ void llvm::parallelFor(size_t Begin, size_t End,
 #if LLVM_ENABLE_THREADS
   if (parallel::strategy.ThreadsRequested != 1) {
     auto NumItems = End - Begin;
-    // Limit the number of tasks to MaxTasksPerGroup to limit job scheduling
+    // Limit the number of chunks to MaxTasksPerGroup to limit job scheduling
     // overhead on large inputs.
     auto TaskSize = NumItems / parallel::detail::MaxTasksPerGroup;
     if (TaskSize == 0)
       TaskSize = 1;
 
+    // Rather than pushing every chunk through the executor's queue, which
+    // serializes all workers on its lock, spawn one task per thread and let
+    // the tasks claim chunks from a shared counter. Threads that finish early
+    // keep claiming chunks, so uneven chunks still balance.
+    size_t NumChunks = (NumItems + TaskSize - 1) / TaskSize;
+    size_t NumTasks = std::min(parallel::getThreadCount(), NumChunks);
+    std::atomic<size_t> Next{Begin};
     parallel::TaskGroup TG;
-    for (; Begin + TaskSize < End; Begin += TaskSize) {
-      TG.spawn([=, &Fn] {
-        for (size_t I = Begin, E = Begin + TaskSize; I != E; ++I)
-          Fn(I);
-      });
-    }
-    if (Begin != End) {
-      TG.spawn([=, &Fn] {
-        for (size_t I = Begin; I != End; ++I)
-          Fn(I);
+    for (size_t T = 0; T != NumTasks; ++T) {
+      TG.spawn([=, &Next, &Fn] {
+        for (;;) {
+          size_t I = Next.fetch_add(TaskSize, std::memory_order_relaxed);
+          if (I >= End)
+            return;
+          for (size_t E = std::min(I + TaskSize, End); I != E; ++I)
+            Fn(I);
+        }
       });
     }
     return;
@@ -255,3 +261,18 @@ void llvm::parallelFor(size_t Begin, size_t End,
   for (; Begin != End; ++Begin)
     Fn(Begin);
 }
+
+void llvm::parallelTreeHash(
+    MutableArrayRef<uint8_t> Out, ArrayRef<uint8_t> Data,
+    function_ref<void(uint8_t *Dest, ArrayRef<uint8_t> Chunk)> HashFn,
+    size_t ChunkSize) {
+  assert(ChunkSize > 0 && "chunk size must be positive");
+  size_t HashSize = Out.size();
+  size_t NumChunks = divideCeil(Data.size(), ChunkSize);
+  std::vector<uint8_t> Hashes(NumChunks * HashSize);
+  parallelFor(0, NumChunks, [&](size_t I) {
+    ArrayRef<uint8_t> Chunk = Data.slice(I * ChunkSize).take_front(ChunkSize);
+    HashFn(Hashes.data() + I * HashSize, Chunk);
+  });
+  HashFn(Out.data(), Hashes);
+}
@@ -0,0 +1,90 @@
+//===- SlabPool.cpp - Lock-free cache of allocator slabs ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/SlabPool.h"
+#include "llvm/Support/ErrorHandling.h"
+
+using namespace llvm;
+
+SlabPool::SlabPool(size_t SlabSize, size_t MaxCachedSlabs,
+                   size_t MaxReservedBytes)
+    : SlabSize(SlabSize), MaxCachedSlabs(MaxCachedSlabs),
+      MaxReservedBytes(MaxReservedBytes),
+      Slots(std::make_unique<std::atomic<void *>[]>(MaxCachedSlabs)) {
+  assert(SlabSize > 0 && "slab size must be positive");
+  for (size_t I = 0; I != MaxCachedSlabs; ++I)
+    Slots[I].store(nullptr, std::memory_order_relaxed);
+}
+
+SlabPool::~SlabPool() { releaseCachedSlabs(); }
+
+void *SlabPool::allocate(size_t Size, size_t Alignment) {
+  if (isPoolable(Size, Alignment) &&
+      NumCached.load(std::memory_order_relaxed) != 0) {
+    for (size_t I = 0; I != MaxCachedSlabs; ++I) {
+      if (!Slots[I].load(std::memory_order_relaxed))
+        continue;
+      if (void *Slab = Slots[I].exchange(nullptr, std::memory_order_acquire)) {
+        NumCached.fetch_sub(1, std::memory_order_relaxed);
+        return Slab;
+      }
+    }
+  }
+
+  if (!tryReserve(Size))
+    report_bad_alloc_error("SlabPool reserved memory limit exceeded");
+  return allocate_buffer(Size, Alignment);
+}
+
+bool SlabPool::tryReserve(size_t Size) {
+  auto FitsAfterAdding = [&] {
+    size_t Old = ReservedBytes.fetch_add(Size, std::memory_order_relaxed);
+    if (Old <= MaxReservedBytes && Size <= MaxReservedBytes - Old)
+      return true;
+    ReservedBytes.fetch_sub(Size, std::memory_order_relaxed);
+    return false;
+  };
+  if (FitsAfterAdding())
+    return true;
+  // Cached slabs are the only memory the pool can give back by itself.
+  releaseCachedSlabs();
+  return FitsAfterAdding();
+}
+
+void SlabPool::deallocate(void *Ptr, size_t Size, size_t Alignment) {
+  if (isPoolable(Size, Alignment)) {
+    // Count the slab before publishing it, so that a concurrent allocate()
+    // that takes it cannot uncount it first and wrap NumCached around.
+    if (NumCached.fetch_add(1, std::memory_order_relaxed) < MaxCachedSlabs) {
+      for (size_t I = 0; I != MaxCachedSlabs; ++I) {
+        if (Slots[I].load(std::memory_order_relaxed))
+          continue;
+        void *Expected = nullptr;
+        if (Slots[I].compare_exchange_strong(Expected, Ptr,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed))
+          return;
+      }
+    }
+    // The cache is full, or every free slot was taken while we scanned.
+    NumCached.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  ReservedBytes.fetch_sub(Size, std::memory_order_relaxed);
+  deallocate_buffer(Ptr, Size, Alignment);
+}
+
+void SlabPool::releaseCachedSlabs() {
+  for (size_t I = 0; I != MaxCachedSlabs; ++I) {
+    if (void *Slab = Slots[I].exchange(nullptr, std::memory_order_acquire)) {
+      NumCached.fetch_sub(1, std::memory_order_relaxed);
+      ReservedBytes.fetch_sub(SlabSize, std::memory_order_relaxed);
+      deallocate_buffer(Slab, SlabSize, alignof(std::max_align_t));
+    }
+  }
+}
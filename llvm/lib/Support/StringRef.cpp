@@ -12,9 +12,19 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/edit_distance.h"
+#include "llvm/ADT/bit.h"
 #include "llvm/Support/Error.h"
 #include <bitset>
 
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LLVM_STRINGREF_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define LLVM_STRINGREF_NEON 1
+#endif
+
 using namespace llvm;
 
 // MSVC emits references to this into the translation units which reference it.
@@ -127,6 +137,80 @@ std::string StringRef::upper() const {
 ///
 /// \return - The index of the first occurrence of \arg Str, or npos if not
 /// found.
+#if defined(LLVM_STRINGREF_SSE2) || defined(LLVM_STRINGREF_NEON)
+namespace {
+/// 16 bytes of a string, compared against characters all at once.
+struct CharBlock {
+  static constexpr size_t Width = 16;
+
+#if defined(LLVM_STRINGREF_SSE2)
+  // One bit per byte.
+  static constexpr unsigned MaskShift = 0;
+  __m128i V;
+  explicit CharBlock(__m128i V) : V(V) {}
+  static CharBlock load(const char *P) {
+    return CharBlock(_mm_loadu_si128(reinterpret_cast<const __m128i *>(P)));
+  }
+  CharBlock eq(char C) const {
+    return CharBlock(_mm_cmpeq_epi8(V, _mm_set1_epi8(C)));
+  }
+  CharBlock operator&(CharBlock RHS) const {
+    return CharBlock(_mm_and_si128(V, RHS.V));
+  }
+  CharBlock operator|(CharBlock RHS) const {
+    return CharBlock(_mm_or_si128(V, RHS.V));
+  }
+  uint64_t mask() const { return uint32_t(_mm_movemask_epi8(V)); }
+#else
+  // NEON has no movemask. Narrowing each byte to a nibble gives one bit per
+  // byte at 4 * Index + 3.
+  static constexpr unsigned MaskShift = 2;
+  uint8x16_t V;
+  explicit CharBlock(uint8x16_t V) : V(V) {}
+  static CharBlock load(const char *P) {
+    return CharBlock(vld1q_u8(reinterpret_cast<const uint8_t *>(P)));
+  }
+  CharBlock eq(char C) const {
+    return CharBlock(vceqq_u8(V, vdupq_n_u8(uint8_t(C))));
+  }
+  CharBlock operator&(CharBlock RHS) const {
+    return CharBlock(vandq_u8(V, RHS.V));
+  }
+  CharBlock operator|(CharBlock RHS) const {
+    return CharBlock(vorrq_u8(V, RHS.V));
+  }
+  uint64_t mask() const {
+    uint8x8_t Narrow = vshrn_n_u16(vreinterpretq_u16_u8(V), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(Narrow), 0) &
+           0x8888888888888888ULL;
+  }
+#endif
+};
+} // end anonymous namespace
+
+/// Find the first position in [Start, Stop) at which the \p N >= 2 byte
+/// \p Needle begins, or return null. Candidates are filtered 16 at a time by
+/// comparing both the first and the last byte of the needle, so the full
+/// comparison only runs on likely matches.
+static const char *findBlocks(const char *Start, const char *Stop,
+                              const char *Needle, size_t N) {
+  for (; Start + CharBlock::Width <= Stop; Start += CharBlock::Width) {
+    uint64_t Mask = (CharBlock::load(Start).eq(Needle[0]) &
+                     CharBlock::load(Start + N - 1).eq(Needle[N - 1]))
+                        .mask();
+    for (; Mask; Mask &= Mask - 1) {
+      const char *P = Start + (llvm::countr_zero(Mask) >> CharBlock::MaskShift);
+      if (std::memcmp(P + 1, Needle + 1, N - 2) == 0)
+        return P;
+    }
+  }
+  for (; Start < Stop; ++Start)
+    if (Start[0] == Needle[0] && std::memcmp(Start + 1, Needle + 1, N - 1) == 0)
+      return Start;
+  return nullptr;
+}
+#endif
+
 size_t StringRef::find(StringRef Str, size_t From) const {
   if (From > Length)
     return npos;
@@ -147,6 +231,13 @@ size_t StringRef::find(StringRef Str, size_t From) const {
 
   const char *Stop = Start + (Size - N + 1);
 
+#if defined(LLVM_STRINGREF_SSE2) || defined(LLVM_STRINGREF_NEON)
+  if (Size - N + 1 >= CharBlock::Width) {
+    const char *Ptr = findBlocks(Start, Stop, Needle, N);
+    return Ptr == nullptr ? npos : Ptr - Data;
+  }
+#endif
+
   if (N == 2) {
     // Provide a fast path for newline finding (CRLF case) in InclusionRewriter.
     // Not the most optimized strategy, but getting memcmp inlined should be
@@ -236,6 +327,26 @@ size_t StringRef::rfind_insensitive(StringRef Str) const {
 /// Note: O(size() + Chars.size())
 StringRef::size_type StringRef::find_first_of(StringRef Chars,
                                               size_t From) const {
+#if defined(LLVM_STRINGREF_SSE2) || defined(LLVM_STRINGREF_NEON)
+  // Small sets, such as whitespace or separators, are matched one block at a
+  // time with a comparison per character.
+  if (!Chars.empty() && Chars.size() <= 8) {
+    size_type I = std::min(From, Length);
+    for (; I + CharBlock::Width <= Length; I += CharBlock::Width) {
+      CharBlock Block = CharBlock::load(Data + I);
+      CharBlock Match = Block.eq(Chars[0]);
+      for (char C : Chars.drop_front())
+        Match = Match | Block.eq(C);
+      if (uint64_t Mask = Match.mask())
+        return I + (llvm::countr_zero(Mask) >> CharBlock::MaskShift);
+    }
+    for (; I != Length; ++I)
+      if (Chars.contains(Data[I]))
+        return I;
+    return npos;
+  }
+#endif
+
   std::bitset<1 << CHAR_BIT> CharBits;
   for (char C : Chars)
     CharBits.set((unsigned char)C);
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/SuffixTree.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/SuffixTreeNode.h"
@@ -241,10 +242,19 @@ void SuffixTree::RepeatedSubstringIterator::advance() {
     // it's too short, we'll quit.
     unsigned Length = Curr->getConcatLen();
 
+    // Visit the children in the order of their keys rather than the order of
+    // the map, so that the order of the repeated substrings does not depend
+    // on how Children is hashed. Clients such as the MachineOutliner break
+    // ties between candidates using this order.
+    SmallVector<std::pair<unsigned, SuffixTreeNode *>> SortedChildren(
+        Curr->Children.begin(), Curr->Children.end());
+    llvm::sort(SortedChildren, llvm::less_first());
+
     // Iterate over each child, saving internal nodes for visiting, and
     // leaf nodes in LeafChildren. Internal nodes represent individual
-    // strings, which may repeat.
-    for (auto &ChildPair : Curr->Children) {
+    // strings, which may repeat. The worklist is a stack, so push the
+    // internal children backwards to visit the smallest key first.
+    for (auto &ChildPair : reverse(SortedChildren)) {
       // Save all of this node's children for processing.
       if (auto *InternalChild =
               dyn_cast<SuffixTreeInternalNode>(ChildPair.second)) {
@@ -274,6 +284,7 @@ void SuffixTree::RepeatedSubstringIterator::advance() {
     RS.Length = Length;
     for (unsigned StartIdx : RepeatedSubstringStarts)
       RS.StartIndices.push_back(StartIdx);
+    llvm::sort(RS.StartIndices);
     break;
   }
   // At this point, either NewRS is an empty RepeatedSubstring, or it was
@@ -51,6 +51,38 @@ void ThreadPool::grow(int requested) {
   }
 }
 
+void ThreadPool::enqueueUnlocked(std::function<void()> Task,
+                                 ThreadPoolTaskGroup *Group) {
+  if (Group != nullptr && Group->isConstrained())
+    ++NumConstrainedTasks;
+  Tasks.emplace_back(std::make_pair(std::move(Task), Group));
+}
+
+std::deque<std::pair<std::function<void()>, ThreadPoolTaskGroup *>>::iterator
+ThreadPool::findRunnableTaskUnlocked() {
+  if (NumConstrainedTasks == 0)
+    return Tasks.begin();
+  // Pick the oldest task of the highest priority among the groups that are
+  // below their concurrency limit.
+  auto Best = Tasks.end();
+  int BestPriority = 0;
+  for (auto I = Tasks.begin(), E = Tasks.end(); I != E; ++I) {
+    ThreadPoolTaskGroup *Group = I->second;
+    int Priority = 0;
+    if (Group != nullptr) {
+      unsigned Limit = Group->getMaxConcurrency();
+      if (Limit != 0 && ActiveGroups.lookup(Group) >= Limit)
+        continue;
+      Priority = Group->getPriority();
+    }
+    if (Best == E || Priority > BestPriority) {
+      Best = I;
+      BestPriority = Priority;
+    }
+  }
+  return Best;
+}
+
 #ifndef NDEBUG
 // The group of the tasks run by the current thread.
 static LLVM_THREAD_LOCAL std::vector<ThreadPoolTaskGroup *>
@@ -62,12 +94,19 @@ void ThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
   while (true) {
     std::function<void()> Task;
     ThreadPoolTaskGroup *GroupOfTask;
+    // Whether the task's group caps its concurrency. Read before running the
+    // task since the group may be destroyed as soon as the task completes.
+    bool GroupIsLimited;
     {
       std::unique_lock<std::mutex> LockGuard(QueueLock);
       bool workCompletedForGroup = false; // Result of workCompletedUnlocked()
-      // Wait for tasks to be pushed in the queue
+      auto Next = Tasks.end();
+      // Wait for a task that may start now to be pushed in the queue. Tasks of
+      // a group at its concurrency limit stay queued until one of the group's
+      // running tasks finishes.
       QueueCondition.wait(LockGuard, [&] {
-        return !EnableFlag || !Tasks.empty() ||
+        return (!EnableFlag && Tasks.empty()) ||
+               (Next = findRunnableTaskUnlocked()) != Tasks.end() ||
                (WaitingForGroup != nullptr &&
                 (workCompletedForGroup =
                      workCompletedUnlocked(WaitingForGroup)));
@@ -83,13 +122,17 @@ void ThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
       // in order for wait() to properly detect that even if the queue is
       // empty, there is still a task in flight.
       ++ActiveThreads;
-      Task = std::move(Tasks.front().first);
-      GroupOfTask = Tasks.front().second;
+      Task = std::move(Next->first);
+      GroupOfTask = Next->second;
+      GroupIsLimited =
+          GroupOfTask != nullptr && GroupOfTask->getMaxConcurrency() != 0;
+      if (GroupOfTask != nullptr && GroupOfTask->isConstrained())
+        --NumConstrainedTasks;
       // Need to count active threads in each group separately, ActiveThreads
       // would never be 0 if waiting for another group inside a wait.
       if (GroupOfTask != nullptr)
         ++ActiveGroups[GroupOfTask]; // Increment or set to 1 if new item
-      Tasks.pop_front();
+      Tasks.erase(Next);
     }
 #ifndef NDEBUG
     if (CurrentThreadTaskGroups == nullptr)
@@ -128,8 +171,9 @@ void ThreadPool::processTasks(ThreadPoolTaskGroup *WaitingForGroup) {
       CompletionCondition.notify_all();
     // If this was a task in a group, notify also threads waiting for tasks
     // in this function on QueueCondition, to make a recursive wait() return
-    // after the group it's been waiting for has finished.
-    if (NotifyGroup)
+    // after the group it's been waiting for has finished. Likewise wake idle
+    // threads if the group has queued tasks held back by its limit.
+    if (NotifyGroup || GroupIsLimited)
       QueueCondition.notify_all();
   }
 }
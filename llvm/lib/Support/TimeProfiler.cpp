@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <deque>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -95,16 +96,18 @@ struct TimeTraceProfilerEntry {
 } // anonymous namespace
 
 struct llvm::TimeTraceProfiler {
-  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "")
+  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "",
+                    const TimeTraceProfilerOptions &Options = {})
       : BeginningOfTime(system_clock::now()), StartTime(ClockType::now()),
         ProcName(ProcName), Pid(sys::Process::getProcessId()),
-        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity) {
+        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity),
+        Options(Options) {
     llvm::get_thread_name(ThreadName);
   }
 
   void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
     Stack.emplace_back(ClockType::now(), TimePointType(), std::move(Name),
-                       Detail());
+                       Options.SummaryOnly ? std::string() : Detail());
   }
 
   void end() {
@@ -113,7 +116,7 @@ struct llvm::TimeTraceProfiler {
     E.End = ClockType::now();
 
     // Check that end times monotonically increase.
-    assert((Entries.empty() ||
+    assert((Options.SummaryOnly || Entries.empty() ||
             (E.getFlameGraphStartUs(StartTime) + E.getFlameGraphDurUs() >=
              Entries.back().getFlameGraphStartUs(StartTime) +
                  Entries.back().getFlameGraphDurUs())) &&
@@ -123,8 +126,15 @@ struct llvm::TimeTraceProfiler {
     DurationType Duration = E.End - E.Start;
 
     // Only include sections longer or equal to TimeTraceGranularity msec.
-    if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity)
+    if (!Options.SummaryOnly &&
+        duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity) {
+      if (Options.MaxEventsPerThread &&
+          Entries.size() == Options.MaxEventsPerThread) {
+        Entries.pop_front();
+        ++NumDroppedEntries;
+      }
       Entries.emplace_back(E);
+    }
 
     // Track total time taken by each "name", but only the topmost levels of
     // them; e.g. if there's a template instantiation that instantiates other
@@ -214,6 +224,8 @@ struct llvm::TimeTraceProfiler {
                                 const NameAndCountAndDurationType &B) {
       return A.second.second > B.second.second;
     });
+    if (Options.MaxTotals && SortedTotals.size() > Options.MaxTotals)
+      SortedTotals.resize(Options.MaxTotals);
 
     // Report totals on separate threads of tracing file.
     uint64_t TotalTid = MaxTid + 1;
@@ -258,6 +270,13 @@ struct llvm::TimeTraceProfiler {
     J.arrayEnd();
     J.attributeEnd();
 
+    // Tell the reader the trace is incomplete if events were dropped.
+    size_t NumDropped = NumDroppedEntries;
+    for (const TimeTraceProfiler *TTP : Instances.List)
+      NumDropped += TTP->NumDroppedEntries;
+    if (NumDropped)
+      J.attribute("droppedEvents", int64_t(NumDropped));
+
     // Emit the absolute time when this TimeProfiler started.
     // This can be used to combine the profiling data from
     // multiple processes and preserve actual time intervals.
@@ -270,7 +289,8 @@ struct llvm::TimeTraceProfiler {
   }
 
   SmallVector<TimeTraceProfilerEntry, 16> Stack;
-  SmallVector<TimeTraceProfilerEntry, 128> Entries;
+  std::deque<TimeTraceProfilerEntry> Entries;
+  size_t NumDroppedEntries = 0;
   StringMap<CountAndDurationType> CountAndTotalPerName;
   // System clock time when the session was begun.
   const time_point<system_clock> BeginningOfTime;
@@ -283,14 +303,17 @@ struct llvm::TimeTraceProfiler {
 
   // Minimum time granularity (in microseconds)
   const unsigned TimeTraceGranularity;
+
+  const TimeTraceProfilerOptions Options;
 };
 
-void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
-                                       StringRef ProcName) {
+void llvm::timeTraceProfilerInitialize(
+    unsigned TimeTraceGranularity, StringRef ProcName,
+    const TimeTraceProfilerOptions &Options) {
   assert(TimeTraceProfilerInstance == nullptr &&
          "Profiler should not be initialized");
   TimeTraceProfilerInstance = new TimeTraceProfiler(
-      TimeTraceGranularity, llvm::sys::path::filename(ProcName));
+      TimeTraceGranularity, llvm::sys::path::filename(ProcName), Options);
 }
 
 // Removes all TimeTraceProfilerInstances.
@@ -12,6 +12,7 @@
 #include "MCTargetDesc/AArch64AddressingModes.h"
 #include "llvm/Analysis/IVDescriptors.h"
 #include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/CodeGen/BasicTTIImpl.h"
 #include "llvm/CodeGen/CostTable.h"
@@ -3810,11 +3811,27 @@ bool AArch64TTIImpl::preferPredicateOverEpilogue(TailFoldingInfo *TFI) {
   if (!ST->hasSVE())
     return false;
 
+  Loop *L = TFI->LVL->getLoop();
+  // Explain why the tail is not folded, as the alternative is a scalar
+  // epilogue that is otherwise easy to miss.
+  auto Decline = [&](StringRef RemarkName, const Twine &Reason) {
+    LLVM_DEBUG(dbgs() << "Not tail-folding: " << Reason << "\n");
+    if (TFI->ORE)
+      TFI->ORE->emit([&]() {
+        return OptimizationRemarkAnalysis("loop-vectorize", RemarkName,
+                                          L->getStartLoc(), L->getHeader())
+               << "not folding the tail into a predicated loop: "
+               << Reason.str();
+      });
+    return false;
+  };
+
   // We don't currently support vectorisation with interleaving for SVE - with
   // such loops we're better off not using tail-folding. This gives us a chance
   // to fall back on fixed-width vectorisation using NEON's ld2/st2/etc.
   if (TFI->IAI->hasGroups())
-    return false;
+    return Decline("TailFoldingInterleaved",
+                   "the loop has interleaved memory accesses");
 
   TailFoldingOpts Required = TailFoldingOpts::Disabled;
   if (TFI->LVL->getReductionVars().size())
@@ -3825,25 +3842,44 @@ bool AArch64TTIImpl::preferPredicateOverEpilogue(TailFoldingInfo *TFI) {
   // We call this to discover whether any load/store pointers in the loop have
   // negative strides. This will require extra work to reverse the loop
   // predicate, which may be expensive.
-  if (containsDecreasingPointers(TFI->LVL->getLoop(),
-                                 TFI->LVL->getPredicatedScalarEvolution()))
+  if (containsDecreasingPointers(L, TFI->LVL->getPredicatedScalarEvolution()))
     Required |= TailFoldingOpts::Reverse;
   if (Required == TailFoldingOpts::Disabled)
     Required |= TailFoldingOpts::Simple;
 
   if (!TailFoldingOptionLoc.satisfies(ST->getSVETailFoldingDefaultOpts(),
-                                      Required))
-    return false;
+                                      Required)) {
+    SmallVector<StringRef, 3> Kinds;
+    if ((Required & TailFoldingOpts::Reductions) != TailFoldingOpts::Disabled)
+      Kinds.push_back("reductions");
+    if ((Required & TailFoldingOpts::Recurrences) != TailFoldingOpts::Disabled)
+      Kinds.push_back("recurrences");
+    if ((Required & TailFoldingOpts::Reverse) != TailFoldingOpts::Disabled)
+      Kinds.push_back("reversed accesses");
+    if (Kinds.empty())
+      return Decline("TailFoldingNotEnabled",
+                     "tail folding is not enabled for this target (see "
+                     "-sve-tail-folding)");
+    return Decline("TailFoldingNotEnabled",
+                   "tail folding of loops with " + join(Kinds, ", ") +
+                       " is not enabled for this target (see "
+                       "-sve-tail-folding)");
+  }
 
   // Don't tail-fold for tight loops where we would be better off interleaving
   // with an unpredicated loop.
   unsigned NumInsns = 0;
-  for (BasicBlock *BB : TFI->LVL->getLoop()->blocks()) {
+  for (BasicBlock *BB : L->blocks()) {
     NumInsns += BB->sizeWithoutDebug();
   }
 
   // We expect 4 of these to be a IV PHI, IV add, IV compare and branch.
-  return NumInsns >= SVETailFoldInsnThreshold;
+  if (NumInsns < SVETailFoldInsnThreshold)
+    return Decline("TailFoldingTightLoop",
+                   "the loop has only " + Twine(NumInsns) +
+                       " instructions, fewer than the threshold of " +
+                       Twine(SVETailFoldInsnThreshold));
+  return true;
 }
 
 InstructionCost
@@ -27,6 +27,7 @@
 #include "AMDGPUIGroupLP.h"
 #include "SIMachineFunctionInfo.h"
 #include "llvm/CodeGen/RegisterClassInfo.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #define DEBUG_TYPE "machine-scheduler"
 
@@ -630,6 +631,28 @@ void GCNScheduleDAGMILive::finalizeSchedule() {
   runSchedStages();
 }
 
+static StringRef getStageName(GCNSchedStageID StageID) {
+  switch (StageID) {
+  case GCNSchedStageID::OccInitialSchedule:
+    return "Max Occupancy Initial Schedule";
+  case GCNSchedStageID::UnclusteredHighRPReschedule:
+    return "Unclustered High Register Pressure Reschedule";
+  case GCNSchedStageID::ClusteredLowOccupancyReschedule:
+    return "Clustered Low Occupancy Reschedule";
+  case GCNSchedStageID::PreRARematerialize:
+    return "Pre-RA Rematerialize";
+  case GCNSchedStageID::ILPInitialSchedule:
+    return "Max ILP Initial Schedule";
+  }
+  llvm_unreachable("unknown scheduling stage");
+}
+
+#ifndef NDEBUG
+raw_ostream &llvm::operator<<(raw_ostream &OS, const GCNSchedStageID &StageID) {
+  return OS << getStageName(StageID);
+}
+#endif
+
 void GCNScheduleDAGMILive::runSchedStages() {
   LLVM_DEBUG(dbgs() << "All regions recorded, starting actual scheduling.\n");
 
@@ -638,6 +661,8 @@ void GCNScheduleDAGMILive::runSchedStages() {
 
   GCNSchedStrategy &S = static_cast<GCNSchedStrategy &>(*SchedImpl);
   while (S.advanceStage()) {
+    TimeTraceScope TimeScope("GCNSchedStage",
+                             getStageName(S.getCurrentStage()));
     auto Stage = createSchedStage(S.getCurrentStage());
     if (!Stage->initGCNSchedStage())
       continue;
@@ -660,30 +685,6 @@ void GCNScheduleDAGMILive::runSchedStages() {
   }
 }
 
-#ifndef NDEBUG
-raw_ostream &llvm::operator<<(raw_ostream &OS, const GCNSchedStageID &StageID) {
-  switch (StageID) {
-  case GCNSchedStageID::OccInitialSchedule:
-    OS << "Max Occupancy Initial Schedule";
-    break;
-  case GCNSchedStageID::UnclusteredHighRPReschedule:
-    OS << "Unclustered High Register Pressure Reschedule";
-    break;
-  case GCNSchedStageID::ClusteredLowOccupancyReschedule:
-    OS << "Clustered Low Occupancy Reschedule";
-    break;
-  case GCNSchedStageID::PreRARematerialize:
-    OS << "Pre-RA Rematerialize";
-    break;
-  case GCNSchedStageID::ILPInitialSchedule:
-    OS << "Max ILP Initial Schedule";
-    break;
-  }
-
-  return OS;
-}
-#endif
-
 GCNSchedStage::GCNSchedStage(GCNSchedStageID StageID, GCNScheduleDAGMILive &DAG)
     : DAG(DAG), S(static_cast<GCNSchedStrategy &>(*DAG.SchedImpl)), MF(DAG.MF),
       MFI(DAG.MFI), ST(DAG.ST), StageID(StageID) {}
@@ -80,7 +80,13 @@ SDValue X86SelectionDAGInfo::EmitTargetCodeForMemset(
     uint64_t Val = ValC->getZExtValue() & 255;
 
     // If the value is a constant, then we can potentially use larger sets.
-    if (Alignment > Align(2)) {
+    // With ERMSB a byte-wise rep stos is as fast as the wider forms, as for
+    // memcpy, and it needs no separate tail.
+    if (Subtarget.hasERMSB()) {
+      AVT = MVT::i8;
+      ValReg = X86::AL;
+      Count = DAG.getIntPtrConstant(SizeVal, dl);
+    } else if (Alignment > Align(2)) {
       // DWORD aligned
       AVT = MVT::i32;
       ValReg = X86::EAX;
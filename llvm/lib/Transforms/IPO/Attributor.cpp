@@ -77,6 +77,7 @@ STATISTIC(NumFnWithoutExactDefinition,
 STATISTIC(NumFnShallowWrappersCreated, "Number of shallow wrappers created");
 STATISTIC(NumAttributesTimedOut,
           "Number of abstract attributes timed out before fixpoint");
+STATISTIC(NumAttributeUpdates, "Number of abstract attribute updates");
 STATISTIC(NumAttributesValidFixpoint,
           "Number of abstract attributes in a valid fixpoint state");
 STATISTIC(NumAttributesManifested,
@@ -95,6 +96,12 @@ static cl::opt<unsigned>
                           cl::desc("Maximal number of fixpoint iterations."),
                           cl::init(32));
 
+static cl::opt<unsigned> MaxUpdates(
+    "attributor-max-updates", cl::Hidden,
+    cl::desc("Maximal number of abstract attribute updates per Attributor run "
+             "(0 = unlimited); checked between fixpoint iterations"),
+    cl::init(0));
+
 static cl::opt<unsigned>
     MaxSpecializationPerCB("attributor-max-specializations-per-call-base",
                            cl::Hidden,
@@ -2212,10 +2219,20 @@ void Attributor::runTillFixpoint() {
                     QueryAAsAwaitingUpdate.end());
     QueryAAsAwaitingUpdate.clear();
 
+    // Stopping here is as sound as hitting the iteration limit: everything
+    // that changed in the last iteration is reverted below.
+    if (MaxUpdates && NumUpdates >= MaxUpdates)
+      break;
   } while (!Worklist.empty() && (IterationCounter++ < MaxIterations));
 
-  if (IterationCounter > MaxIterations && !Functions.empty()) {
+  bool OutOfUpdates = MaxUpdates && NumUpdates >= MaxUpdates &&
+                      !Worklist.empty();
+  if ((IterationCounter > MaxIterations || OutOfUpdates) &&
+      !Functions.empty()) {
     auto Remark = [&](OptimizationRemarkMissed ORM) {
+      if (OutOfUpdates)
+        return ORM << "Attributor did not reach a fixpoint after "
+                   << ore::NV("Updates", NumUpdates) << " updates.";
       return ORM << "Attributor did not reach a fixpoint after "
                  << ore::NV("Iterations", MaxIterations) << " iterations.";
     };
@@ -2686,6 +2703,8 @@ ChangeStatus Attributor::updateAA(AbstractAttribute &AA) {
   });
   assert(Phase == AttributorPhase::UPDATE &&
          "We can update AA only in the update stage!");
+  ++NumUpdates;
+  ++NumAttributeUpdates;
 
   // Use a new dependence vector for this update.
   DependenceVector DV;
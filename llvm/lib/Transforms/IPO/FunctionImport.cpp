@@ -39,6 +39,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
 #include "llvm/Transforms/Utils/Cloning.h"
@@ -1355,6 +1356,7 @@ Expected<bool> FunctionImporter::importFunctions(
     ModuleNameOrderedList.insert(FunctionsToImportPerModule.first);
   }
   for (const auto &Name : ModuleNameOrderedList) {
+    TimeTraceScope TimeScope("Import module", Name);
     // Get the module for the import
     const auto &FunctionsToImportPerModule = ImportList.find(Name);
     assert(FunctionsToImportPerModule != ImportList.end());
@@ -1371,9 +1373,15 @@ Expected<bool> FunctionImporter::importFunctions(
       return std::move(Err);
 
     auto &ImportGUIDs = FunctionsToImportPerModule->second;
+    // Source modules are often much larger than what is imported from them
+    // (e.g. the inline functions of a common header), so stop hashing names
+    // once every requested global has been found.
+    size_t NumNotFound = ImportGUIDs.size();
     // Find the globals to import
     SetVector<GlobalValue *> GlobalsToImport;
     for (Function &F : *SrcModule) {
+      if (!NumNotFound)
+        break;
       if (!F.hasName())
         continue;
       auto GUID = F.getGUID();
@@ -1382,6 +1390,7 @@ Expected<bool> FunctionImporter::importFunctions(
                         << GUID << " " << F.getName() << " from "
                         << SrcModule->getSourceFileName() << "\n");
       if (Import) {
+        --NumNotFound;
         if (Error Err = F.materialize())
           return std::move(Err);
         if (EnableImportMetadata) {
@@ -1396,6 +1405,8 @@ Expected<bool> FunctionImporter::importFunctions(
       }
     }
     for (GlobalVariable &GV : SrcModule->globals()) {
+      if (!NumNotFound)
+        break;
       if (!GV.hasName())
         continue;
       auto GUID = GV.getGUID();
@@ -1404,12 +1415,15 @@ Expected<bool> FunctionImporter::importFunctions(
                         << GUID << " " << GV.getName() << " from "
                         << SrcModule->getSourceFileName() << "\n");
       if (Import) {
+        --NumNotFound;
         if (Error Err = GV.materialize())
           return std::move(Err);
         ImportedGVCount += GlobalsToImport.insert(&GV);
       }
     }
     for (GlobalAlias &GA : SrcModule->aliases()) {
+      if (!NumNotFound)
+        break;
       if (!GA.hasName() || isa<GlobalIFunc>(GA.getAliaseeObject()))
         continue;
       auto GUID = GA.getGUID();
@@ -1418,6 +1432,7 @@ Expected<bool> FunctionImporter::importFunctions(
                         << GUID << " " << GA.getName() << " from "
                         << SrcModule->getSourceFileName() << "\n");
       if (Import) {
+        --NumNotFound;
         if (Error Err = GA.materialize())
           return std::move(Err);
         // Import alias as a copy of its aliasee.
@@ -92,13 +92,18 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/DebugCounter.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/KnownBits.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/InstCombine/InstCombine.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/Local.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cinttypes>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -152,6 +157,72 @@ MaxArraySize("instcombine-maxarray-size", cl::init(1024),
 static cl::opt<unsigned> ShouldLowerDbgDeclare("instcombine-lower-dbg-declare",
                                                cl::Hidden, cl::init(true));
 
+static cl::opt<bool> EnableVisitStats(
+    "instcombine-visit-stats", cl::Hidden, cl::init(false),
+    cl::desc("Print per-opcode visit counts, successful combines and time "
+             "spent visiting instructions when the process exits"));
+
+namespace {
+
+/// Per-opcode telemetry collected under -instcombine-visit-stats. Each
+/// worklist run gathers its counts locally and merges them in once, so the
+/// lock is not taken per instruction.
+class InstCombineVisitStats {
+public:
+  struct Entry {
+    uint64_t Visits = 0;
+    uint64_t Combines = 0;
+    std::chrono::nanoseconds Time{0};
+  };
+  using Table = SmallVector<Entry, 0>;
+
+  static Table makeTable() { return Table(Instruction::OtherOpsEnd); }
+
+  void merge(const Table &Local) {
+    sys::ScopedLock Guard(Lock);
+    for (unsigned Opc = 0, E = Local.size(); Opc != E; ++Opc) {
+      Totals[Opc].Visits += Local[Opc].Visits;
+      Totals[Opc].Combines += Local[Opc].Combines;
+      Totals[Opc].Time += Local[Opc].Time;
+    }
+  }
+
+  ~InstCombineVisitStats() {
+    if (EnableVisitStats)
+      print(*CreateInfoOutputFile());
+  }
+
+private:
+  void print(raw_ostream &OS) {
+    SmallVector<unsigned, 64> Opcodes;
+    for (unsigned Opc = 0, E = Totals.size(); Opc != E; ++Opc)
+      if (Totals[Opc].Visits)
+        Opcodes.push_back(Opc);
+    llvm::stable_sort(Opcodes, [&](unsigned A, unsigned B) {
+      return Totals[A].Time > Totals[B].Time;
+    });
+
+    OS << "===" << std::string(73, '-') << "===\n"
+       << "                     InstCombine visit statistics\n"
+       << "===" << std::string(73, '-') << "===\n\n"
+       << "    Time (s)       Visits     Combines  Opcode\n";
+    for (unsigned Opc : Opcodes) {
+      const Entry &En = Totals[Opc];
+      OS << format("%12.6f %12" PRIu64 " %12" PRIu64 "  %s\n",
+                   std::chrono::duration<double>(En.Time).count(), En.Visits,
+                   En.Combines, Instruction::getOpcodeName(Opc));
+    }
+    OS.flush();
+  }
+
+  sys::Mutex Lock;
+  Table Totals = makeTable();
+};
+
+} // end anonymous namespace
+
+static ManagedStatic<InstCombineVisitStats> VisitStats;
+
 std::optional<Instruction *>
 InstCombiner::targetInstCombineIntrinsic(IntrinsicInst &II) {
   // Handle target specific intrinsics
@@ -3938,6 +4009,10 @@ bool InstCombinerImpl::tryToSinkInstruction(Instruction *I,
 }
 
 bool InstCombinerImpl::run() {
+  InstCombineVisitStats::Table LocalVisitStats;
+  if (EnableVisitStats)
+    LocalVisitStats = InstCombineVisitStats::makeTable();
+
   while (!Worklist.isEmpty()) {
     // Walk deferred instructions in reverse order, and push them to the
     // worklist, which means they'll end up popped from the worklist in-order.
@@ -4066,7 +4141,21 @@ bool InstCombinerImpl::run() {
     LLVM_DEBUG(raw_string_ostream SS(OrigI); I->print(SS); OrigI = SS.str(););
     LLVM_DEBUG(dbgs() << "IC: Visiting: " << OrigI << '\n');
 
-    if (Instruction *Result = visit(*I)) {
+    unsigned Opcode = I->getOpcode();
+    std::chrono::steady_clock::time_point VisitStart;
+    if (EnableVisitStats)
+      VisitStart = std::chrono::steady_clock::now();
+
+    Instruction *Result = visit(*I);
+
+    if (EnableVisitStats) {
+      InstCombineVisitStats::Entry &En = LocalVisitStats[Opcode];
+      ++En.Visits;
+      En.Combines += Result != nullptr;
+      En.Time += std::chrono::steady_clock::now() - VisitStart;
+    }
+
+    if (Result) {
       ++NumCombined;
       // Should we replace the old instruction with a new one?
       if (Result != I) {
@@ -4118,6 +4207,9 @@ bool InstCombinerImpl::run() {
     }
   }
 
+  if (EnableVisitStats)
+    VisitStats->merge(LocalVisitStats);
+
   Worklist.zap();
   return MadeIRChange;
 }
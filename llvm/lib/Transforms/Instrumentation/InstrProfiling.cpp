@@ -36,6 +36,7 @@
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Instructions.h"
 #include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/InitializePasses.h"
@@ -47,6 +48,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/TargetParser/Triple.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
 #include "llvm/Transforms/Utils/SSAUpdater.h"
 #include <algorithm>
@@ -77,6 +79,13 @@ cl::opt<bool>
                              cl::desc("Enable relocating counters at runtime."),
                              cl::init(false));
 
+cl::opt<bool> CounterSharding(
+    "instrprof-counter-sharding",
+    cl::desc("Increment counters in per-thread shards of the counter section, "
+             "which the runtime sums when the profile is written. Avoids "
+             "false sharing between threads running the same code."),
+    cl::init(false));
+
 cl::opt<bool> ValueProfileStaticAlloc(
     "vp-static-alloc",
     cl::desc("Do static counter allocation for value profiler"),
@@ -181,10 +190,10 @@ public:
       Type *Ty = LiveInValue->getType();
       IRBuilder<> Builder(InsertPos);
       if (auto *AddrInst = dyn_cast_or_null<IntToPtrInst>(Addr)) {
-        // If isRuntimeCounterRelocationEnabled() is true then the address of
-        // the store instruction is computed with two instructions in
-        // InstrProfiling::getCounterAddress(). We need to copy those
-        // instructions to this block to compute Addr correctly.
+        // If isRuntimeCounterRelocationEnabled() or isCounterShardingEnabled()
+        // is true then the address of the store instruction is computed with
+        // two instructions in InstrProfiling::getCounterAddress(). We need to
+        // copy those instructions to this block to compute Addr correctly.
         // %BiasAdd = add i64 ptrtoint <__profc_>, <__llvm_profile_counter_bias>
         // %Addr = inttoptr i64 %BiasAdd to i64*
         auto *OrigBiasInst = dyn_cast<BinaryOperator>(AddrInst->getOperand(0));
@@ -437,6 +446,10 @@ bool InstrProfiling::lowerIntrinsics(Function *F) {
   if (!MadeChange)
     return false;
 
+  if (isCounterShardingEnabled())
+    if (LoadInst *ShardBias = FunctionToProfileBiasMap.lookup(F))
+      emitCounterShardAssignment(ShardBias);
+
   promoteCounterLoadStores(F);
   return true;
 }
@@ -453,6 +466,16 @@ bool InstrProfiling::isRuntimeCounterRelocationEnabled() const {
   return TT.isOSFuchsia();
 }
 
+bool InstrProfiling::isCounterShardingEnabled() const {
+  // Both modes are implemented by biasing the counter addresses.
+  if (!CounterSharding || isRuntimeCounterRelocationEnabled())
+    return false;
+  // On Darwin, continuous mode can be turned on when the program starts. It
+  // maps the counter section onto the profile file, so increments must go to
+  // the section itself rather than to shards summed at exit.
+  return !TT.isOSBinFormatMachO();
+}
+
 bool InstrProfiling::isCounterPromotionEnabled() const {
   if (DoCounterPromotion.getNumOccurrences() > 0)
     return DoCounterPromotion;
@@ -680,11 +703,38 @@ Value *InstrProfiling::getCounterAddress(InstrProfInstBase *I) {
   auto *Addr = Builder.CreateConstInBoundsGEP2_32(
       Counters->getValueType(), Counters, 0, I->getIndex()->getZExtValue());
 
+  Type *Int64Ty = Type::getInt64Ty(M->getContext());
+  Function *Fn = I->getParent()->getParent();
+  if (isCounterShardingEnabled()) {
+    // Only counts can be summed; coverage bytes and timestamps stay in the
+    // counter section.
+    if (!isa<InstrProfIncrementInst>(I))
+      return Addr;
+    LoadInst *&ShardBiasLI = FunctionToProfileBiasMap[Fn];
+    if (!ShardBiasLI) {
+      IRBuilder<> EntryBuilder(&Fn->getEntryBlock().front());
+      auto *ShardBias =
+          M->getGlobalVariable(getInstrProfCounterShardBiasVarName());
+      if (!ShardBias) {
+        // The thread-local bias is defined by the runtime, which also
+        // implements the shard assignment.
+        ShardBias = new GlobalVariable(
+            *M, Int64Ty, false, GlobalValue::ExternalLinkage, nullptr,
+            getInstrProfCounterShardBiasVarName(), nullptr,
+            GlobalValue::GeneralDynamicTLSModel);
+        ShardBias->setVisibility(GlobalVariable::HiddenVisibility);
+      }
+      ShardBiasLI = EntryBuilder.CreateLoad(
+          Int64Ty, EntryBuilder.CreateThreadLocalAddress(ShardBias));
+    }
+    auto *Add =
+        Builder.CreateAdd(Builder.CreatePtrToInt(Addr, Int64Ty), ShardBiasLI);
+    return Builder.CreateIntToPtr(Add, Addr->getType());
+  }
+
   if (!isRuntimeCounterRelocationEnabled())
     return Addr;
 
-  Type *Int64Ty = Type::getInt64Ty(M->getContext());
-  Function *Fn = I->getParent()->getParent();
   LoadInst *&BiasLI = FunctionToProfileBiasMap[Fn];
   if (!BiasLI) {
     IRBuilder<> EntryBuilder(&Fn->getEntryBlock().front());
@@ -710,6 +760,48 @@ Value *InstrProfiling::getCounterAddress(InstrProfInstBase *I) {
   return Builder.CreateIntToPtr(Add, Addr->getType());
 }
 
+void InstrProfiling::emitCounterShardAssignment(LoadInst *ShardBias) {
+  // The bias of a thread is zero until the thread first runs instrumented
+  // code. Ask the runtime to assign a shard then:
+  //
+  //   %bias = load i64, ptr @__llvm_profile_counter_shard_bias
+  //   %unassigned = icmp eq i64 %bias, 0
+  //   br i1 %unassigned, label %assign, label %tail
+  // assign:
+  //   %assigned = call i64 @__llvm_profile_get_counter_shard_bias()
+  // tail:
+  //   phi i64 [ %bias, %entry ], [ %assigned, %assign ]
+  LLVMContext &Ctx = M->getContext();
+  Type *Int64Ty = Type::getInt64Ty(Ctx);
+  BasicBlock *Entry = ShardBias->getParent();
+  // Keep the static allocas in the entry block.
+  for (Instruction &I : llvm::make_early_inc_range(
+           make_range(std::next(ShardBias->getIterator()), Entry->end())))
+    if (auto *AI = dyn_cast<AllocaInst>(&I); AI && AI->isStaticAlloca())
+      AI->moveBefore(ShardBias);
+
+  IRBuilder<> Builder(ShardBias->getNextNode());
+  auto *IsUnassigned =
+      cast<Instruction>(Builder.CreateICmpEQ(ShardBias, Builder.getInt64(0)));
+  Instruction *AssignTerm = SplitBlockAndInsertIfThen(
+      IsUnassigned, IsUnassigned->getNextNode(), /*Unreachable=*/false,
+      MDBuilder(Ctx).createBranchWeights(1, (1U << 20) - 1));
+  Builder.SetInsertPoint(AssignTerm);
+  FunctionCallee GetShardBias =
+      M->getOrInsertFunction(getInstrProfGetCounterShardBiasFuncName(), Int64Ty);
+  CallInst *Assigned = Builder.CreateCall(GetShardBias);
+  Assigned->setDoesNotThrow();
+
+  BasicBlock *Tail = AssignTerm->getSuccessor(0);
+  Builder.SetInsertPoint(Tail, Tail->begin());
+  PHINode *Bias = Builder.CreatePHI(Int64Ty, 2);
+  Bias->addIncoming(ShardBias, Entry);
+  Bias->addIncoming(Assigned, AssignTerm->getParent());
+  ShardBias->replaceUsesWithIf(Bias, [&](Use &U) {
+    return U.getUser() != IsUnassigned && U.getUser() != Bias;
+  });
+}
+
 void InstrProfiling::lowerCover(InstrProfCoverInst *CoverInstruction) {
   auto *Addr = getCounterAddress(CoverInstruction);
   IRBuilder<> Builder(CoverInstruction);
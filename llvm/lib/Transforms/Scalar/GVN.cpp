@@ -112,6 +112,10 @@ static cl::opt<bool>
 GVNEnableSplitBackedgeInLoadPRE("enable-split-backedge-in-load-pre",
                                 cl::init(false));
 static cl::opt<bool> GVNEnableMemDep("enable-gvn-memdep", cl::init(true));
+static cl::opt<bool> GVNMemorySSALoads(
+    "enable-gvn-memoryssa-loads", cl::init(false), cl::Hidden,
+    cl::desc("When MemoryDependenceAnalysis is disabled, eliminate loads that "
+             "are fully available from their MemorySSA clobber"));
 
 static cl::opt<uint32_t> MaxNumDeps(
     "gvn-max-num-deps", cl::Hidden, cl::init(100),
@@ -761,7 +765,9 @@ PreservedAnalyses GVNPass::run(Function &F, FunctionAnalysisManager &AM) {
   auto *MemDep =
       isMemDepEnabled() ? &AM.getResult<MemoryDependenceAnalysis>(F) : nullptr;
   auto *LI = AM.getCachedResult<LoopAnalysis>(F);
-  auto *MSSA = AM.getCachedResult<MemorySSAAnalysis>(F);
+  auto *MSSA = !MemDep && GVNMemorySSALoads
+                   ? &AM.getResult<MemorySSAAnalysis>(F)
+                   : AM.getCachedResult<MemorySSAAnalysis>(F);
   auto &ORE = AM.getResult<OptimizationRemarkEmitterAnalysis>(F);
   bool Changed = runImpl(F, AC, DT, TLI, AA, MemDep, LI, &ORE,
                          MSSA ? &MSSA->getMSSA() : nullptr);
@@ -2126,10 +2132,48 @@ static void patchAndReplaceAllUsesWith(Instruction *I, Value *Repl) {
   I->replaceAllUsesWith(Repl);
 }
 
+std::optional<AvailableValue>
+GVNPass::AnalyzeLoadAvailabilityFromMemorySSA(LoadInst *Load) {
+  assert(Load->isUnordered() && "rules below are incorrect for ordered access");
+  MemorySSA &MSSA = *MSSAU->getMemorySSA();
+  auto *Def =
+      dyn_cast<MemoryDef>(MSSA.getWalker()->getClobberingMemoryAccess(Load));
+  if (!Def || MSSA.isLiveOnEntryDef(Def))
+    return std::nullopt;
+
+  // Unlike a MemDep dependence, the MemorySSA clobber is only known to may
+  // alias the load, so treat it like a MemDep clobber and only forward from
+  // writes that provably cover the loaded bits.
+  Instruction *DepInst = Def->getMemoryInst();
+  Value *Address = Load->getPointerOperand();
+  const DataLayout &DL = Load->getModule()->getDataLayout();
+  if (auto *DepSI = dyn_cast<StoreInst>(DepInst)) {
+    // Can't forward from non-atomic to atomic without violating memory model.
+    if (Load->isAtomic() > DepSI->isAtomic())
+      return std::nullopt;
+    int Offset =
+        analyzeLoadFromClobberingStore(Load->getType(), Address, DepSI, DL);
+    if (Offset != -1)
+      return AvailableValue::get(DepSI->getValueOperand(), Offset);
+    return std::nullopt;
+  }
+
+  if (auto *DepMI = dyn_cast<MemIntrinsic>(DepInst)) {
+    if (Load->isAtomic())
+      return std::nullopt;
+    int Offset =
+        analyzeLoadFromClobberingMemInst(Load->getType(), Address, DepMI, DL);
+    if (Offset != -1)
+      return AvailableValue::getMI(DepMI, Offset);
+  }
+  return std::nullopt;
+}
+
 /// Attempt to eliminate a load, first by eliminating it
 /// locally, and then attempting non-local elimination if that fails.
 bool GVNPass::processLoad(LoadInst *L) {
-  if (!MD)
+  bool UseMemorySSA = !MD && MSSAU && GVNMemorySSALoads;
+  if (!MD && !UseMemorySSA)
     return false;
 
   // This code hasn't been audited for ordered or volatile memory access
@@ -2141,6 +2185,19 @@ bool GVNPass::processLoad(LoadInst *L) {
     return true;
   }
 
+  if (UseMemorySSA) {
+    auto AV = AnalyzeLoadAvailabilityFromMemorySSA(L);
+    if (!AV)
+      return false;
+    Value *AvailableValue = AV->MaterializeAdjustedValue(L, L, *this);
+    patchAndReplaceAllUsesWith(L, AvailableValue);
+    markInstructionForDeletion(L);
+    MSSAU->removeMemoryAccess(L);
+    ++NumGVNLoad;
+    reportLoadElim(L, AvailableValue, ORE);
+    return true;
+  }
+
   // ... to a pointer that has been loaded from before...
   MemDepResult Dep = MD->getDependency(L);
 
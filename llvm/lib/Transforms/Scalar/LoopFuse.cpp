@@ -124,6 +124,11 @@ static cl::opt<unsigned> FusionPeelMaxCount(
     cl::desc("Max number of iterations to be peeled from a loop, such that "
              "fusion can take place"));
 
+static cl::opt<bool> FusionRequireDataReuse(
+    "loop-fusion-require-data-reuse", cl::init(false), cl::Hidden,
+    cl::desc("Only fuse loops that access a common array, so that fusion "
+             "improves cache locality"));
+
 #ifndef NDEBUG
 static cl::opt<bool>
     VerboseFusionDebugging("loop-fusion-verbose-debug",
@@ -708,12 +713,36 @@ private:
 
   /// Determine if it is beneficial to fuse two loops.
   ///
-  /// For now, this method simply returns true because we want to fuse as much
-  /// as possible (primarily to test the pass). This method will evolve, over
-  /// time, to add heuristics for profitability of fusion.
+  /// By default this returns true because we want to fuse as much as possible
+  /// (primarily to test the pass). With -loop-fusion-require-data-reuse, two
+  /// loops are only fused if they access memory through a common base
+  /// pointer: the second loop then reuses data the first one just brought
+  /// into the cache, whereas fusing loops over unrelated arrays only adds
+  /// register and cache pressure to the combined body.
   bool isBeneficialFusion(const FusionCandidate &FC0,
                           const FusionCandidate &FC1) {
-    return true;
+    if (!FusionRequireDataReuse)
+      return true;
+
+    auto GetBase = [&](Instruction *I) -> const SCEV * {
+      Value *Ptr = getLoadStorePointerOperand(I);
+      return Ptr ? SE.getPointerBase(SE.getSCEV(Ptr)) : nullptr;
+    };
+    SmallPtrSet<const SCEV *, 16> Bases0;
+    for (const auto *Insts : {&FC0.MemReads, &FC0.MemWrites})
+      for (Instruction *I : *Insts)
+        if (const SCEV *Base = GetBase(I))
+          Bases0.insert(Base);
+
+    bool SharesData = false;
+    for (const auto *Insts : {&FC1.MemReads, &FC1.MemWrites})
+      SharesData |= any_of(*Insts, [&](Instruction *I) {
+        const SCEV *Base = GetBase(I);
+        return Base && Bases0.contains(Base);
+      });
+    LLVM_DEBUG(if (!SharesData) dbgs()
+               << "Fusion candidates do not access a common array.\n");
+    return SharesData;
   }
 
   /// Determine if two fusion candidates have the same trip count (i.e., they
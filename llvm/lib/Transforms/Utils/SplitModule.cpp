@@ -30,10 +30,13 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/User.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Support/BalancedPartitioning.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/ValueMapper.h"
@@ -49,6 +52,12 @@ using namespace llvm;
 
 #define DEBUG_TYPE "split-module"
 
+static cl::opt<bool> SplitByCallGraph(
+    "split-module-by-call-graph", cl::init(false), cl::Hidden,
+    cl::desc("Keep globals that reference each other in the same partition "
+             "and balance partitions by instruction count, instead of "
+             "assigning globals by the hash of their name"));
+
 namespace {
 
 using ClusterMapType = EquivalenceClasses<const GlobalValue *>;
@@ -96,6 +105,130 @@ static const GlobalObject *getGVPartitioningRoot(const GlobalValue *GV) {
   return GO;
 }
 
+// Returns the clusters of the globals that \p GV references directly or
+// through constants: from the instructions of a function, or from the
+// initializer of a variable, e.g. a vtable referencing its virtual functions.
+static void collectReferencedClusters(
+    const GlobalValue &GV, const ClusterMapType &GVtoClusterMap,
+    const DenseMap<const GlobalValue *, unsigned> &LeaderToCluster,
+    SmallVectorImpl<BPFunctionNode::UtilityNodeT> &Clusters) {
+  SmallVector<const Constant *, 8> Worklist;
+  SmallPtrSet<const Constant *, 8> Visited;
+  if (const auto *F = dyn_cast<Function>(&GV)) {
+    for (const BasicBlock &BB : *F)
+      for (const Instruction &I : BB)
+        for (const Value *Op : I.operands())
+          if (const auto *C = dyn_cast<Constant>(Op))
+            Worklist.push_back(C);
+  } else if (const auto *GVar = dyn_cast<GlobalVariable>(&GV)) {
+    if (GVar->hasInitializer())
+      Worklist.push_back(GVar->getInitializer());
+  }
+  while (!Worklist.empty()) {
+    const Constant *C = Worklist.pop_back_val();
+    if (!Visited.insert(C).second)
+      continue;
+    if (const auto *Ref = dyn_cast<GlobalValue>(C)) {
+      auto Leader = GVtoClusterMap.findLeader(Ref);
+      if (Leader != GVtoClusterMap.member_end())
+        Clusters.push_back(LeaderToCluster.lookup(*Leader));
+      continue;
+    }
+    // Look through constant expressions and aggregates. Operands that are not
+    // constants, such as the basic block of a blockaddress, are skipped.
+    for (const Value *Op : C->operands())
+      if (const auto *OpC = dyn_cast<Constant>(Op))
+        Worklist.push_back(OpC);
+  }
+}
+
+// Assign the clusters of \p GVtoClusterMap, which must contain every
+// definition of the module, to \p N partitions. Clusters are ordered with
+// BalancedPartitioning so that clusters referencing the same globals end up
+// close to each other, and the order is then cut into N ranges of about the
+// same number of instructions.
+static void findCallGraphPartitions(const Module &M,
+                                    const ClusterMapType &GVtoClusterMap,
+                                    ClusterIDMapType &ClusterIDMap,
+                                    unsigned N) {
+  // Number the clusters deterministically, by the name of their leader. Names
+  // are not unique for unnamed and local globals, so ties are broken by the
+  // position of the leader in the module.
+  DenseMap<const GlobalValue *, unsigned> ModuleOrder;
+  unsigned Position = 0;
+  for (const GlobalValue &GV : M.global_values())
+    ModuleOrder[&GV] = Position++;
+  SmallVector<ClusterMapType::iterator, 64> Leaders;
+  for (ClusterMapType::iterator I = GVtoClusterMap.begin(),
+                                E = GVtoClusterMap.end();
+       I != E; ++I)
+    if (I->isLeader())
+      Leaders.push_back(I);
+  llvm::sort(Leaders, [&](ClusterMapType::iterator A,
+                          ClusterMapType::iterator B) {
+    const GlobalValue *GA = A->getData(), *GB = B->getData();
+    if (GA->getName() != GB->getName())
+      return GA->getName() < GB->getName();
+    return ModuleOrder.lookup(GA) < ModuleOrder.lookup(GB);
+  });
+  DenseMap<const GlobalValue *, unsigned> LeaderToCluster;
+  for (unsigned I = 0, E = Leaders.size(); I != E; ++I)
+    LeaderToCluster[Leaders[I]->getData()] = I;
+
+  // Each cluster is a utility of itself and of every cluster referencing it,
+  // so that BalancedPartitioning keeps callers next to their callees.
+  std::vector<uint64_t> Costs(Leaders.size());
+  std::vector<SmallVector<BPFunctionNode::UtilityNodeT, 4>> Utilities(
+      Leaders.size());
+  for (unsigned I = 0, E = Leaders.size(); I != E; ++I) {
+    Utilities[I].push_back(I);
+    for (ClusterMapType::member_iterator MI =
+             GVtoClusterMap.member_begin(Leaders[I]);
+         MI != GVtoClusterMap.member_end(); ++MI) {
+      const auto *F = dyn_cast<Function>(*MI);
+      Costs[I] += F ? std::max(1u, F->getInstructionCount()) : 1;
+      collectReferencedClusters(**MI, GVtoClusterMap, LeaderToCluster,
+                                Utilities[I]);
+    }
+    llvm::sort(Utilities[I]);
+    Utilities[I].erase(std::unique(Utilities[I].begin(), Utilities[I].end()),
+                       Utilities[I].end());
+  }
+
+  std::vector<BPFunctionNode> Nodes;
+  Nodes.reserve(Leaders.size());
+  for (unsigned I = 0, E = Leaders.size(); I != E; ++I)
+    Nodes.emplace_back(I, Utilities[I]);
+  // Only the coarse levels of the bisection matter for the partitions; a few
+  // more levels let the cut below balance the cost more evenly.
+  BalancedPartitioningConfig Config;
+  Config.SplitDepth = Log2_32_Ceil(N) + 4;
+  BalancedPartitioning(Config).run(Nodes);
+
+  uint64_t TotalCost = 0;
+  for (uint64_t Cost : Costs)
+    TotalCost += Cost;
+  unsigned Partition = 0;
+  uint64_t CostSoFar = 0;
+  SmallVector<uint64_t, 16> PartitionCosts(N);
+  for (const BPFunctionNode &Node : Nodes) {
+    // Move on once this partition has its share of the total cost.
+    while (Partition + 1 < N &&
+           CostSoFar >= TotalCost * (Partition + 1) / N)
+      ++Partition;
+    CostSoFar += Costs[Node.Id];
+    PartitionCosts[Partition] += Costs[Node.Id];
+    for (ClusterMapType::member_iterator MI =
+             GVtoClusterMap.member_begin(Leaders[Node.Id]);
+         MI != GVtoClusterMap.member_end(); ++MI)
+      ClusterIDMap[*MI] = Partition;
+  }
+  LLVM_DEBUG({
+    for (unsigned I = 0; I != N; ++I)
+      dbgs() << "Partition[" << I << "] cost " << PartitionCosts[I] << "\n";
+  });
+}
+
 // Find partitions for module in the way that no locals need to be
 // globalized.
 // Try to balance pack those partitions into N files since this roughly equals
@@ -151,6 +284,21 @@ static void findPartitions(Module &M, ClusterIDMapType &ClusterIDMap,
   llvm::for_each(M.globals(), recordGVSet);
   llvm::for_each(M.aliases(), recordGVSet);
 
+  if (SplitByCallGraph) {
+    // Every definition needs a cluster, even one of its own, as none is left
+    // to the name hash.
+    for (const GlobalValue &GV : M.global_values()) {
+      if (GV.isDeclaration())
+        continue;
+      GVtoClusterMap.insert(&GV);
+      if (const GlobalObject *Root = getGVPartitioningRoot(&GV))
+        if (&GV != Root)
+          GVtoClusterMap.unionSets(&GV, Root);
+    }
+    findCallGraphPartitions(M, GVtoClusterMap, ClusterIDMap, N);
+    return;
+  }
+
   // Assigned all GVs to merged clusters while balancing number of objects in
   // each.
   auto CompareClusters = [](const std::pair<unsigned, unsigned> &a,
@@ -2227,6 +2227,16 @@ static void collectSupportedLoops(Loop &L, LoopInfo *LI,
       return;
     }
   }
+  // An outer loop the user asked to vectorize is silently skipped without the
+  // VPlan-native path; say so, as only its inner loops will be considered.
+  if (!L.isInnermost() && !EnableVPlanNativePath &&
+      LoopVectorizeHints(&L, true /*DisableInterleaving*/, *ORE).getForce() ==
+          LoopVectorizeHints::FK_Enabled)
+    reportVectorizationInfo(
+        "Outer loop vectorization requires -enable-vplan-native-path; only "
+        "inner loops will be considered",
+        "OuterLoopVectorizationNotEnabled", ORE, &L);
+
   for (Loop *InnerL : L)
     collectSupportedLoops(*InnerL, LI, ORE, V);
 }
@@ -9579,7 +9589,8 @@ void VPWidenMemoryInstructionRecipe::execute(VPTransformState &State) {
 static ScalarEpilogueLowering getScalarEpilogueLowering(
     Function *F, Loop *L, LoopVectorizeHints &Hints, ProfileSummaryInfo *PSI,
     BlockFrequencyInfo *BFI, TargetTransformInfo *TTI, TargetLibraryInfo *TLI,
-    LoopVectorizationLegality &LVL, InterleavedAccessInfo *IAI) {
+    LoopVectorizationLegality &LVL, InterleavedAccessInfo *IAI,
+    OptimizationRemarkEmitter *ORE) {
   // 1) OptSize takes precedence over all other options, i.e. if this is set,
   // don't look at hints or options, and don't request a scalar epilogue.
   // (For PGSO, as shouldOptimizeForSize isn't currently accessible from
@@ -9614,7 +9625,7 @@ static ScalarEpilogueLowering getScalarEpilogueLowering(
   };
 
   // 4) if the TTI hook indicates this is profitable, request predication.
-  TailFoldingInfo TFI(TLI, &LVL, IAI);
+  TailFoldingInfo TFI(TLI, &LVL, IAI, ORE);
   if (TTI->preferPredicateOverEpilogue(&TFI))
     return CM_ScalarEpilogueNotNeededUsePredicate;
 
@@ -9634,7 +9645,10 @@ static bool processLoopInVPlanNativePath(
     LoopVectorizationRequirements &Requirements) {
 
   if (isa<SCEVCouldNotCompute>(PSE.getBackedgeTakenCount())) {
-    LLVM_DEBUG(dbgs() << "LV: cannot compute the outer-loop trip count\n");
+    reportVectorizationFailure(
+        "cannot compute the outer-loop trip count",
+        "Cannot vectorize outer loop: its trip count could not be computed",
+        "CantComputeOuterLoopTripCount", ORE, L);
     return false;
   }
   assert(EnableVPlanNativePath && "VPlan-native path is disabled.");
@@ -9642,7 +9656,8 @@ static bool processLoopInVPlanNativePath(
   InterleavedAccessInfo IAI(PSE, L, DT, LI, LVL->getLAI());
 
   ScalarEpilogueLowering SEL =
-      getScalarEpilogueLowering(F, L, Hints, PSI, BFI, TTI, TLI, *LVL, &IAI);
+      getScalarEpilogueLowering(F, L, Hints, PSI, BFI, TTI, TLI, *LVL, &IAI,
+                                ORE);
 
   LoopVectorizationCostModel CM(SEL, L, PSE, LI, LVL, *TTI, TLI, DB, AC, ORE, F,
                                 &Hints, IAI);
@@ -9912,8 +9927,9 @@ bool LoopVectorizePass::processLoop(Loop *L) {
 
   // Check the function attributes and profiles to find out if this function
   // should be optimized for size.
-  ScalarEpilogueLowering SEL =
-      getScalarEpilogueLowering(F, L, Hints, PSI, BFI, TTI, TLI, LVL, &IAI);
+  ScalarEpilogueLowering SEL = getScalarEpilogueLowering(F, L, Hints, PSI, BFI,
+                                                         TTI, TLI, LVL, &IAI,
+                                                         ORE);
 
   // Check the loop for a trip count threshold: vectorize loops with a tiny trip
   // count by optimizing for size, to minimize overheads.
@@ -107,6 +107,10 @@ using namespace slpvectorizer;
 #define DEBUG_TYPE "SLP"
 
 STATISTIC(NumVectorInstructions, "Number of vector instructions generated");
+STATISTIC(NumTreesBuilt, "Number of SLP trees built");
+STATISTIC(NumTreesVectorized, "Number of SLP trees vectorized");
+STATISTIC(NumTreesOverBudget,
+          "Number of SLP trees not built because the function was over budget");
 
 cl::opt<bool> RunSLPVectorization("vectorize-slp", cl::init(true), cl::Hidden,
                                   cl::desc("Run the SLP vectorization passes"));
@@ -156,6 +160,10 @@ static cl::opt<unsigned> RecursionMaxDepth(
     "slp-recursion-max-depth", cl::init(12), cl::Hidden,
     cl::desc("Limit the recursion depth when building a vectorizable tree"));
 
+static cl::opt<unsigned> MaxTreesPerFunction(
+    "slp-max-trees-per-function", cl::init(0), cl::Hidden,
+    cl::desc("Limit the number of SLP trees built per function (0=unlimited)"));
+
 static cl::opt<unsigned> MinTreeSize(
     "slp-min-tree-size", cl::init(3), cl::Hidden,
     cl::desc("Only vectorize small trees if they are fully vectorizable"));
@@ -2390,6 +2398,10 @@ public:
   ~BoUpSLP();
 
 private:
+  /// Count a tree about to be built against -slp-max-trees-per-function.
+  /// \returns false once the function has used up its budget.
+  bool consumeTreeBudget();
+
   /// Check if the operands on the edges \p Edges of the \p UserTE allows
   /// reordering (i.e. the operands can be reordered because they have only one
   /// user and reordarable).
@@ -3632,6 +3644,9 @@ private:
   unsigned MaxVecRegSize; // This is set by TTI or overridden by cl::opt.
   unsigned MinVecRegSize; // Set by cl::opt (default: 128).
 
+  /// Number of trees built so far for this function.
+  unsigned NumTreesInFunction = 0;
+
   /// Instruction builder to construct the vectorized tree.
   IRBuilder<> Builder;
 
@@ -5161,18 +5176,30 @@ BoUpSLP::findExternalStoreUsersReorderIndices(TreeEntry *TE) const {
   return ExternalReorderIndices;
 }
 
+bool BoUpSLP::consumeTreeBudget() {
+  if (MaxTreesPerFunction && NumTreesInFunction >= MaxTreesPerFunction) {
+    LLVM_DEBUG(dbgs() << "SLP: Tree budget of " << MaxTreesPerFunction
+                      << " exhausted for " << F->getName() << ".\n");
+    ++NumTreesOverBudget;
+    return false;
+  }
+  ++NumTreesInFunction;
+  ++NumTreesBuilt;
+  return true;
+}
+
 void BoUpSLP::buildTree(ArrayRef<Value *> Roots,
                         const SmallDenseSet<Value *> &UserIgnoreLst) {
   deleteTree();
   UserIgnoreList = &UserIgnoreLst;
-  if (!allSameType(Roots))
+  if (!allSameType(Roots) || !consumeTreeBudget())
     return;
   buildTree_rec(Roots, 0, EdgeInfo());
 }
 
 void BoUpSLP::buildTree(ArrayRef<Value *> Roots) {
   deleteTree();
-  if (!allSameType(Roots))
+  if (!allSameType(Roots) || !consumeTreeBudget())
     return;
   buildTree_rec(Roots, 0, EdgeInfo());
 }
@@ -11036,6 +11063,7 @@ Value *BoUpSLP::vectorizeTree(
     const ExtraValueToDebugLocsMap &ExternallyUsedValues,
     SmallVectorImpl<std::pair<Value *, Value *>> &ReplacedExternals,
     Instruction *ReductionRoot) {
+  ++NumTreesVectorized;
   // All blocks must be scheduled before any instructions are inserted.
   for (auto &BSIter : BlocksSchedules) {
     scheduleBlock(BSIter.second.get());
@@ -0,0 +1,39 @@
+; RUN: llc < %s -mtriple=i686-- -mattr=-sse,-ermsb | FileCheck %s --check-prefix=NOERMSB
+; RUN: llc < %s -mtriple=i686-- -mattr=-sse,+ermsb | FileCheck %s --check-prefix=ERMSB
+
+; Without vector stores these memsets are too large to expand into a store
+; sequence, so they are lowered to rep stos. With ERMSB a single byte-wise rep
+; stos covers the whole size; otherwise the widest aligned form is used and the
+; remaining bytes are stored separately.
+
+define void @set_const(ptr align 4 %p) nounwind {
+; NOERMSB-LABEL: set_const:
+; NOERMSB:         movl $25, %ecx
+; NOERMSB:         rep;stosl %eax, %es:(%edi)
+; NOERMSB:         movw $10794, 100(
+;
+; ERMSB-LABEL: set_const:
+; ERMSB:         movb $42, %al
+; ERMSB:         movl $102, %ecx
+; ERMSB-NOT:     stosl
+; ERMSB:         rep;stosb %al, %es:(%edi)
+; ERMSB-NOT:     movw
+; ERMSB:         retl
+  call void @llvm.memset.p0.i32(ptr align 4 %p, i8 42, i32 102, i1 false)
+  ret void
+}
+
+; A variable value is always stored byte by byte.
+define void @set_var(ptr align 4 %p, i8 %v) nounwind {
+; NOERMSB-LABEL: set_var:
+; NOERMSB:         movl $102, %ecx
+; NOERMSB:         rep;stosb %al, %es:(%edi)
+;
+; ERMSB-LABEL: set_var:
+; ERMSB:         movl $102, %ecx
+; ERMSB:         rep;stosb %al, %es:(%edi)
+  call void @llvm.memset.p0.i32(ptr align 4 %p, i8 %v, i32 102, i1 false)
+  ret void
+}
+
+declare void @llvm.memset.p0.i32(ptr nocapture writeonly, i8, i32, i1)
@@ -0,0 +1,54 @@
+; RUN: opt < %s -S -passes=instrprof -instrprof-counter-sharding | FileCheck %s
+; RUN: opt < %s -S -passes=instrprof -instrprof-counter-sharding -runtime-counter-relocation | FileCheck %s --check-prefixes=NOSHARD,RELOC
+; RUN: opt < %s -S -passes=instrprof -instrprof-counter-sharding -mtriple=x86_64-apple-macosx10.15 | FileCheck %s --check-prefix=NOSHARD
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+@__profn_foo = private constant [3 x i8] c"foo"
+
+; CHECK: @__llvm_profile_counter_shard_bias = external hidden thread_local global i64
+; RELOC: @__llvm_profile_counter_bias
+; NOSHARD-NOT: __llvm_profile_counter_shard_bias
+
+; The shard bias is loaded once on entry, and the runtime assigns a shard when
+; it is still zero. Every increment is then biased into the thread's shard.
+
+; CHECK-LABEL: define void @foo(
+; CHECK-NEXT:  entry:
+; CHECK-NEXT:    [[TLS:%.*]] = call ptr @llvm.threadlocal.address.p0(ptr @__llvm_profile_counter_shard_bias)
+; CHECK-NEXT:    [[BIAS:%.*]] = load i64, ptr [[TLS]], align 8
+; CHECK-NEXT:    [[UNASSIGNED:%.*]] = icmp eq i64 [[BIAS]], 0
+; CHECK-NEXT:    br i1 [[UNASSIGNED]], label %[[ASSIGN:.*]], label %[[TAIL:.*]], !prof
+; CHECK:       [[ASSIGN]]:
+; CHECK-NEXT:    [[ASSIGNED:%.*]] = call i64 @__llvm_profile_get_counter_shard_bias()
+; CHECK-NEXT:    br label %[[TAIL]]
+; CHECK:       [[TAIL]]:
+; CHECK-NEXT:    [[SHARD:%.*]] = phi i64 [ [[BIAS]], %entry ], [ [[ASSIGNED]], %[[ASSIGN]] ]
+; CHECK-NEXT:    [[ADDR0:%.*]] = add i64 ptrtoint (ptr @__profc_foo to i64), [[SHARD]]
+; CHECK-NEXT:    [[PTR0:%.*]] = inttoptr i64 [[ADDR0]] to ptr
+; CHECK-NEXT:    [[PGOCOUNT0:%.*]] = load i64, ptr [[PTR0]], align 8
+; CHECK-NEXT:    [[INC0:%.*]] = add i64 [[PGOCOUNT0]], 1
+; CHECK-NEXT:    store i64 [[INC0]], ptr [[PTR0]], align 8
+; CHECK:       then:
+; CHECK-NEXT:    [[ADDR1:%.*]] = add i64 ptrtoint (ptr getelementptr inbounds ([2 x i64], ptr @__profc_foo, i32 0, i32 1) to i64), [[SHARD]]
+; CHECK-NEXT:    [[PTR1:%.*]] = inttoptr i64 [[ADDR1]] to ptr
+; CHECK-NEXT:    [[PGOCOUNT1:%.*]] = load i64, ptr [[PTR1]], align 8
+; CHECK-NEXT:    [[INC1:%.*]] = add i64 [[PGOCOUNT1]], 1
+; CHECK-NEXT:    store i64 [[INC1]], ptr [[PTR1]], align 8
+define void @foo(i1 %c) {
+entry:
+  call void @llvm.instrprof.increment(ptr @__profn_foo, i64 0, i32 2, i32 0)
+  br i1 %c, label %then, label %exit
+
+then:
+  call void @llvm.instrprof.increment(ptr @__profn_foo, i64 0, i32 2, i32 1)
+  br label %exit
+
+exit:
+  ret void
+}
+
+; CHECK: declare i64 @__llvm_profile_get_counter_shard_bias()
+
+declare void @llvm.instrprof.increment(ptr, i64, i32, i32)
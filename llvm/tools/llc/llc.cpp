@@ -92,6 +92,22 @@ static cl::opt<unsigned> TimeTraceGranularity(
         "Minimum time granularity (in microseconds) traced by time profiler"),
     cl::init(500), cl::Hidden);
 
+static cl::opt<unsigned> TimeTraceMaxEvents(
+    "time-trace-max-events",
+    cl::desc("Keep at most this many time trace events per thread, dropping "
+             "the oldest ones (0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
+static cl::opt<bool> TimeTraceSummary(
+    "time-trace-summary",
+    cl::desc("Only record per-name totals in the time trace"), cl::Hidden);
+
+static cl::opt<unsigned> TimeTraceMaxTotals(
+    "time-trace-max-totals",
+    cl::desc("Only write this many of the longest time trace totals "
+             "(0 = all)"),
+    cl::init(0), cl::Hidden);
+
 static cl::opt<std::string>
     TimeTraceFile("time-trace-file",
                   cl::desc("Specify time trace file destination"),
@@ -334,6 +350,14 @@ struct LLCDiagnosticHandler : public DiagnosticHandler {
   }
 };
 
+static TimeTraceProfilerOptions getTimeTraceOptions() {
+  TimeTraceProfilerOptions Options;
+  Options.MaxEventsPerThread = TimeTraceMaxEvents;
+  Options.SummaryOnly = TimeTraceSummary;
+  Options.MaxTotals = TimeTraceMaxTotals;
+  return Options;
+}
+
 // main - Entry point for the llc compiler.
 //
 int main(int argc, char **argv) {
@@ -378,7 +402,8 @@ int main(int argc, char **argv) {
   cl::ParseCommandLineOptions(argc, argv, "llvm system compiler\n");
 
   if (TimeTrace)
-    timeTraceProfilerInitialize(TimeTraceGranularity, argv[0]);
+    timeTraceProfilerInitialize(TimeTraceGranularity, argv[0],
+                                getTimeTraceOptions());
   auto TimeTraceScopeExit = make_scope_exit([]() {
     if (TimeTrace) {
       if (auto E = timeTraceProfilerWrite(TimeTraceFile, OutputFilename)) {
@@ -38,6 +38,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Triple.h"
 #include <cstdlib>
+#include <mutex>
 
 using namespace llvm;
 using namespace llvm::dwarfdump;
@@ -717,15 +718,24 @@ static bool handleBuffer(StringRef Filename, MemoryBufferRef Buffer,
   error(Filename, BinOrErr.takeError());
 
   bool Result = true;
+  // With -verify, units are extracted concurrently and errors and warnings may
+  // be reported from several threads.
+  std::mutex HandlerMutex;
   auto RecoverableErrorHandler = [&](Error E) {
+    std::lock_guard<std::mutex> Lock(HandlerMutex);
     Result = false;
     WithColor::defaultErrorHandler(std::move(E));
   };
+  auto WarningHandler = [&](Error E) {
+    std::lock_guard<std::mutex> Lock(HandlerMutex);
+    WithColor::defaultWarningHandler(std::move(E));
+  };
   if (auto *Obj = dyn_cast<ObjectFile>(BinOrErr->get())) {
     if (filterArch(*Obj)) {
       std::unique_ptr<DWARFContext> DICtx = DWARFContext::create(
           *Obj, DWARFContext::ProcessDebugRelocations::Process, nullptr, "",
-          RecoverableErrorHandler);
+          RecoverableErrorHandler, WarningHandler,
+          /*ThreadSafe=*/Verify);
       DICtx->setParseCUTUIndexManually(ManuallyGenerateUnitIndex);
       if (!HandleObj(*Obj, *DICtx, Filename, OS))
         Result = false;
@@ -739,7 +749,8 @@ static bool handleBuffer(StringRef Filename, MemoryBufferRef Buffer,
         if (filterArch(Obj)) {
           std::unique_ptr<DWARFContext> DICtx = DWARFContext::create(
               Obj, DWARFContext::ProcessDebugRelocations::Process, nullptr, "",
-              RecoverableErrorHandler);
+              RecoverableErrorHandler, WarningHandler,
+              /*ThreadSafe=*/Verify);
           if (!HandleObj(Obj, *DICtx, ObjName, OS))
             Result = false;
         }
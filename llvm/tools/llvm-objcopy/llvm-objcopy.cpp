@@ -156,6 +156,7 @@ static Error executeObjcopy(ConfigManager &ConfigMgr) {
     if (!BufOrErr)
       return createFileError(Config.InputFilename, BufOrErr.getError());
     MemoryBufferHolder = std::move(*BufOrErr);
+    MemoryBufferHolder->adviseIfMmap(MemoryBuffer::AccessPattern::Sequential);
 
     if (Config.InputFormat == FileFormat::Binary)
       ObjcopyFunc = [&](raw_ostream &OutFile) -> Error {
@@ -169,11 +170,20 @@ static Error executeObjcopy(ConfigManager &ConfigMgr) {
         return executeObjcopyOnIHex(ConfigMgr, *MemoryBufferHolder, OutFile);
       };
   } else {
-    Expected<OwningBinary<llvm::object::Binary>> BinaryOrErr =
-        createBinary(Config.InputFilename);
+    ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+        MemoryBuffer::getFileOrSTDIN(Config.InputFilename, /*IsText=*/false,
+                                     /*RequiresNullTerminator=*/false);
+    if (!BufOrErr)
+      return createFileError(Config.InputFilename, BufOrErr.getError());
+    // Every section is read once while building the output, mostly in file
+    // order.
+    (*BufOrErr)->adviseIfMmap(MemoryBuffer::AccessPattern::Sequential);
+    Expected<std::unique_ptr<llvm::object::Binary>> BinaryOrErr =
+        createBinary((*BufOrErr)->getMemBufferRef());
     if (!BinaryOrErr)
       return createFileError(Config.InputFilename, BinaryOrErr.takeError());
-    BinaryHolder = std::move(*BinaryOrErr);
+    BinaryHolder = OwningBinary<llvm::object::Binary>(std::move(*BinaryOrErr),
+                                                      std::move(*BufOrErr));
 
     if (Archive *Ar = dyn_cast<Archive>(BinaryHolder.getBinary())) {
       // Handle Archive.
@@ -12,9 +12,10 @@
 #include "ProfiledBinary.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/LineIterator.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Regex.h"
 #include <cstdint>
-#include <fstream>
 #include <list>
 #include <map>
 #include <vector>
@@ -27,15 +28,21 @@ namespace sampleprof {
 
 // Stream based trace line iterator
 class TraceStream {
-  std::string CurrentLine;
-  std::ifstream Fin;
+  std::unique_ptr<MemoryBuffer> Buffer;
+  line_iterator LineIt;
+  StringRef CurrentLine;
   bool IsAtEoF = false;
   uint64_t LineNumber = 0;
 
 public:
-  TraceStream(StringRef Filename) : Fin(Filename.str()) {
-    if (!Fin.good())
+  // The trace is memory mapped and lines are handed out as references into
+  // it, so reading a multi-gigabyte perf script does not copy every line.
+  TraceStream(StringRef Filename) {
+    auto BufferOrErr = MemoryBuffer::getFile(Filename);
+    if (!BufferOrErr)
       exitWithError("Error read input perf script file", Filename);
+    Buffer = std::move(*BufferOrErr);
+    LineIt = line_iterator(*Buffer, /*SkipBlanks=*/false);
     advance();
   }
 
@@ -50,10 +57,12 @@ public:
 
   // Read the next line
   void advance() {
-    if (!std::getline(Fin, CurrentLine)) {
+    if (LineIt.is_at_eof()) {
       IsAtEoF = true;
       return;
     }
+    CurrentLine = *LineIt;
+    ++LineIt;
     LineNumber++;
   }
 };
@@ -0,0 +1,194 @@
+//===- llvm-time-trace-summary.cpp ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// llvm-time-trace-summary merges the -ftime-trace JSON files of a whole build
+// and ranks the headers and templates that cost the most time in total.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+static cl::OptionCategory
+    TimeTraceSummaryCategory("Time Trace Summary Options");
+
+static cl::list<std::string> InputFiles(cl::Positional, cl::OneOrMore,
+                                        cl::desc("<time-trace json files>"),
+                                        cl::cat(TimeTraceSummaryCategory));
+static cl::opt<unsigned>
+    TopN("top", cl::init(20),
+         cl::desc("Number of entries to print per category"),
+         cl::cat(TimeTraceSummaryCategory));
+static cl::opt<bool> StripTemplateArgs(
+    "strip-template-args",
+    cl::desc("Group template instantiations by template rather than by "
+             "specialization"),
+    cl::cat(TimeTraceSummaryCategory));
+static cl::opt<std::string>
+    OutputFilename("output", cl::value_desc("output"), cl::init("-"),
+                   cl::desc("Output file"), cl::cat(TimeTraceSummaryCategory));
+static cl::alias OutputFilenameA("o", cl::aliasopt(OutputFilename),
+                                 cl::cat(TimeTraceSummaryCategory));
+
+namespace {
+/// Accumulated cost of one header or template over all input traces.
+struct Cost {
+  /// Sum of the inclusive durations of all events, in microseconds.
+  uint64_t TotalUs = 0;
+  /// Number of events, i.e. how often the header was parsed or the template
+  /// was instantiated.
+  unsigned Count = 0;
+};
+
+struct Summary {
+  StringMap<Cost> Headers;
+  StringMap<Cost> Templates;
+  unsigned NumFiles = 0;
+};
+} // namespace
+
+static void warn(Twine Message, StringRef Whence) {
+  WithColor::warning() << Whence << ": " << Message << "\n";
+}
+
+/// Drop the template argument list from an instantiation name such as
+/// "std::vector<int>::push_back", leaving "std::vector". The names of the
+/// operators "<", "<<", "<=" and "<<=" are not mistaken for an argument list.
+static StringRef stripTemplateArgs(StringRef Name) {
+  size_t Pos = 0;
+  while ((Pos = Name.find('<', Pos)) != StringRef::npos) {
+    if (!Name.take_front(Pos).endswith("operator"))
+      return Name.take_front(Pos);
+    // Skip the operator name. "operator<<<T>" is read as operator<< with
+    // arguments <T>.
+    ++Pos;
+    if (Name.substr(Pos).startswith("<<") || Name.substr(Pos) == "<" ||
+        Name.substr(Pos).startswith("<="))
+      ++Pos;
+    if (Name.substr(Pos).startswith("="))
+      ++Pos;
+  }
+  return Name;
+}
+
+static bool addTrace(MemoryBuffer &Buffer, Summary &S) {
+  StringRef Whence = Buffer.getBufferIdentifier();
+  Expected<json::Value> Root = json::parse(Buffer.getBuffer());
+  if (!Root) {
+    warn(toString(Root.takeError()), Whence);
+    return false;
+  }
+  const json::Object *RootObj = Root->getAsObject();
+  const json::Array *Events =
+      RootObj ? RootObj->getArray("traceEvents") : nullptr;
+  if (!Events) {
+    warn("not a time trace file: no 'traceEvents' array", Whence);
+    return false;
+  }
+
+  for (const json::Value &Event : *Events) {
+    const json::Object *E = Event.getAsObject();
+    if (!E || E->getString("ph") != "X")
+      continue;
+    std::optional<StringRef> Name = E->getString("name");
+    std::optional<int64_t> Dur = E->getInteger("dur");
+    const json::Object *Args = E->getObject("args");
+    if (!Name || !Dur || *Dur < 0 || !Args)
+      continue;
+    std::optional<StringRef> Detail = Args->getString("detail");
+    if (!Detail)
+      continue;
+
+    Cost *C = nullptr;
+    if (*Name == "Source")
+      C = &S.Headers[*Detail];
+    else if (*Name == "InstantiateClass" || *Name == "InstantiateFunction")
+      C = &S.Templates[StripTemplateArgs ? stripTemplateArgs(*Detail)
+                                         : *Detail];
+    if (!C)
+      continue;
+    C->TotalUs += *Dur;
+    ++C->Count;
+  }
+  ++S.NumFiles;
+  return true;
+}
+
+static void printRanking(raw_ostream &OS, StringRef Title,
+                         const StringMap<Cost> &Costs) {
+  std::vector<const StringMapEntry<Cost> *> Sorted;
+  Sorted.reserve(Costs.size());
+  for (const StringMapEntry<Cost> &Entry : Costs)
+    Sorted.push_back(&Entry);
+  llvm::sort(Sorted, [](const StringMapEntry<Cost> *LHS,
+                        const StringMapEntry<Cost> *RHS) {
+    if (LHS->getValue().TotalUs != RHS->getValue().TotalUs)
+      return LHS->getValue().TotalUs > RHS->getValue().TotalUs;
+    return LHS->getKey() < RHS->getKey();
+  });
+  if (Sorted.size() > TopN)
+    Sorted.resize(TopN);
+
+  OS << "*** " << Title << " (" << Costs.size() << " total):\n";
+  OS << "  total ms    count   avg ms  name\n";
+  for (const StringMapEntry<Cost> *Entry : Sorted) {
+    const Cost &C = Entry->getValue();
+    OS << format("%10.1f %8u %8.1f  ", C.TotalUs / 1000.0, C.Count,
+                 C.TotalUs / 1000.0 / C.Count)
+       << Entry->getKey() << "\n";
+  }
+  OS << "\n";
+}
+
+int main(int argc, const char *argv[]) {
+  InitLLVM X(argc, argv);
+
+  cl::HideUnrelatedOptions({&TimeTraceSummaryCategory, &getColorCategory()});
+  cl::ParseCommandLineOptions(
+      argc, argv,
+      "LLVM -ftime-trace summarizer\n\n"
+      "  Merges the time traces of many compilations and ranks headers and\n"
+      "  template instantiations by their total (inclusive) time.\n");
+
+  Summary S;
+  bool HadErrors = false;
+  for (const std::string &File : InputFiles) {
+    auto BufOrError = MemoryBuffer::getFileOrSTDIN(File);
+    if (!BufOrError) {
+      warn(BufOrError.getError().message(), File);
+      HadErrors = true;
+      continue;
+    }
+    if (!addTrace(**BufOrError, S))
+      HadErrors = true;
+  }
+
+  std::error_code EC;
+  raw_fd_ostream OS(OutputFilename, EC, sys::fs::OF_TextWithCRLF);
+  if (EC) {
+    WithColor::error() << OutputFilename << ": " << EC.message() << "\n";
+    return 1;
+  }
+
+  OS << "Summarized " << S.NumFiles << " of " << InputFiles.size()
+     << " time trace files.\n\n";
+  printRanking(OS, "Headers by total parse time", S.Headers);
+  printRanking(OS, "Templates by total instantiation time", S.Templates);
+  return HadErrors ? 1 : 0;
+}
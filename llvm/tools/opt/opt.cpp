@@ -240,6 +240,22 @@ static cl::opt<unsigned> TimeTraceGranularity(
     cl::desc("Minimum time granularity (in microseconds) traced by time profiler"),
     cl::init(500), cl::Hidden);
 
+static cl::opt<unsigned> TimeTraceMaxEvents(
+    "time-trace-max-events",
+    cl::desc("Keep at most this many time trace events per thread, dropping "
+             "the oldest ones (0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
+static cl::opt<bool> TimeTraceSummary(
+    "time-trace-summary",
+    cl::desc("Only record per-name totals in the time trace"), cl::Hidden);
+
+static cl::opt<unsigned> TimeTraceMaxTotals(
+    "time-trace-max-totals",
+    cl::desc("Only write this many of the longest time trace totals "
+             "(0 = all)"),
+    cl::init(0), cl::Hidden);
+
 static cl::opt<std::string>
     TimeTraceFile("time-trace-file",
                     cl::desc("Specify time trace file destination"),
@@ -304,10 +320,19 @@ static TargetMachine* GetTargetMachine(Triple TheTriple, StringRef CPUStr,
       codegen::getExplicitCodeModel(), GetCodeGenOptLevel());
 }
 
+static TimeTraceProfilerOptions getTimeTraceOptions() {
+  TimeTraceProfilerOptions Options;
+  Options.MaxEventsPerThread = TimeTraceMaxEvents;
+  Options.SummaryOnly = TimeTraceSummary;
+  Options.MaxTotals = TimeTraceMaxTotals;
+  return Options;
+}
+
 struct TimeTracerRAII {
   TimeTracerRAII(StringRef ProgramName) {
     if (TimeTrace)
-      timeTraceProfilerInitialize(TimeTraceGranularity, ProgramName);
+      timeTraceProfilerInitialize(TimeTraceGranularity, ProgramName,
+                                  getTimeTraceOptions());
   }
   ~TimeTracerRAII() {
     if (TimeTrace) {
@@ -0,0 +1,167 @@
+//===- llvm/unittest/ADT/FlatHashMapTest.cpp - FlatHashMap unit tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/StringRef.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+// Unlike DenseMapInfo, no empty or tombstone keys are needed.
+struct StringInfo {
+  static unsigned getHashValue(const std::string &S) {
+    return hash_value(StringRef(S));
+  }
+  static bool isEqual(const std::string &L, const std::string &R) {
+    return L == R;
+  }
+};
+
+TEST(FlatHashMapTest, EmptyMap) {
+  FlatHashMap<int, int> M;
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(0u, M.size());
+  EXPECT_TRUE(M.begin() == M.end());
+  EXPECT_FALSE(M.contains(0));
+  EXPECT_TRUE(M.find(0) == M.end());
+  EXPECT_EQ(0, M.lookup(0));
+  EXPECT_FALSE(M.erase(0));
+  EXPECT_EQ(0u, M.getMemorySize());
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  FlatHashMap<int, int> M;
+  // Keys that are DenseMapInfo<int>'s empty and tombstone keys are ordinary
+  // keys here.
+  for (int K : {0, 1, -1, 0x7fffffff, -0x7fffffff - 1})
+    EXPECT_TRUE(M.insert({K, K * 2}).second);
+  EXPECT_EQ(5u, M.size());
+  EXPECT_FALSE(M.insert({1, 100}).second);
+  EXPECT_EQ(2, M.lookup(1));
+  EXPECT_EQ(-2, M.at(-1));
+  EXPECT_EQ(1u, M.count(0x7fffffff));
+
+  auto It = M.find(-1);
+  ASSERT_TRUE(It != M.end());
+  EXPECT_EQ(-1, It->getFirst());
+  EXPECT_EQ(-2, It->getSecond());
+  M.erase(It);
+  EXPECT_FALSE(M.contains(-1));
+  EXPECT_TRUE(M.erase(0));
+  EXPECT_FALSE(M.erase(0));
+  EXPECT_EQ(3u, M.size());
+
+  M[7] = 3;
+  EXPECT_EQ(3, M[7]);
+  M.insert_or_assign(7, 4);
+  EXPECT_EQ(4, M.lookup(7));
+}
+
+TEST(FlatHashMapTest, NonTrivialValues) {
+  FlatHashMap<std::string, std::string, StringInfo> M;
+  for (int I = 0; I < 1000; ++I)
+    M.try_emplace(std::to_string(I), I, 'x');
+  EXPECT_EQ(1000u, M.size());
+  EXPECT_EQ(std::string(123, 'x'), M.lookup("123"));
+
+  FlatHashMap<std::string, std::string, StringInfo> Copy(M);
+  M.clear();
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(1000u, Copy.size());
+  EXPECT_EQ(std::string(999, 'x'), Copy.lookup("999"));
+
+  FlatHashMap<std::string, std::string, StringInfo> Moved(std::move(Copy));
+  EXPECT_EQ(1000u, Moved.size());
+  M = std::move(Moved);
+  EXPECT_EQ(1000u, M.size());
+  EXPECT_TRUE(M.contains("0"));
+}
+
+TEST(FlatHashMapTest, Iteration) {
+  FlatHashMap<unsigned, unsigned> M;
+  for (unsigned I = 0; I < 100; ++I)
+    M[I] = I + 1;
+  unsigned Sum = 0, Count = 0;
+  for (const auto &[K, V] : M) {
+    EXPECT_EQ(K + 1, V);
+    Sum += K;
+    ++Count;
+  }
+  EXPECT_EQ(100u, Count);
+  EXPECT_EQ(4950u, Sum);
+
+  const FlatHashMap<unsigned, unsigned> &CM = M;
+  FlatHashMap<unsigned, unsigned>::const_iterator CI = M.begin();
+  EXPECT_TRUE(CI == CM.begin());
+}
+
+TEST(FlatHashMapTest, Reserve) {
+  FlatHashMap<int, int> M;
+  M.reserve(1000);
+  size_t Size = M.getMemorySize();
+  for (int I = 0; I < 1000; ++I)
+    M[I] = I;
+  EXPECT_EQ(Size, M.getMemorySize());
+}
+
+// Repeated insertion and erasure must reuse or reclaim deleted buckets
+// rather than grow without bound.
+TEST(FlatHashMapTest, Churn) {
+  FlatHashMap<int, int> M;
+  for (int I = 0; I < 100000; ++I) {
+    M[I] = I;
+    if (I >= 10)
+      EXPECT_TRUE(M.erase(I - 10));
+  }
+  EXPECT_EQ(10u, M.size());
+  FlatHashMap<int, int> Small(64);
+  EXPECT_LE(M.getMemorySize(), Small.getMemorySize());
+}
+
+TEST(FlatHashMapTest, RandomAgainstStdMap) {
+  std::mt19937 Rng(42);
+  std::uniform_int_distribution<int> Key(0, 5000);
+  FlatHashMap<int, int> M;
+  std::map<int, int> Ref;
+  for (int I = 0; I < 200000; ++I) {
+    int K = Key(Rng);
+    if (Rng() % 3 == 0) {
+      EXPECT_EQ(Ref.erase(K) != 0, M.erase(K));
+    } else {
+      bool Inserted = Ref.insert({K, I}).second;
+      EXPECT_EQ(Inserted, M.insert({K, I}).second);
+    }
+  }
+  EXPECT_EQ(Ref.size(), M.size());
+  for (auto [K, V] : Ref)
+    EXPECT_EQ(V, M.at(K));
+  size_t Count = 0;
+  for (auto &KV : M) {
+    EXPECT_EQ(Ref.at(KV.first), KV.second);
+    ++Count;
+  }
+  EXPECT_EQ(Ref.size(), Count);
+}
+
+// Pointer keys whose DenseMapInfo hashes differ only in a few bits.
+TEST(FlatHashMapTest, PointerKeys) {
+  static int Storage[4096];
+  FlatHashMap<int *, unsigned> M;
+  for (unsigned I = 0; I < 4096; ++I)
+    M[&Storage[I]] = I;
+  for (unsigned I = 0; I < 4096; ++I)
+    EXPECT_EQ(I, M.lookup(&Storage[I]));
+}
+
+} // namespace
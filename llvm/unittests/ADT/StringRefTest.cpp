@@ -1039,6 +1039,39 @@ TEST(StringRefTest, Take) {
   EXPECT_TRUE(Taken.empty());
 }
 
+TEST(StringRefTest, FindMatchesStringView) {
+  // Exercise the block-at-a-time search at every alignment and needle length,
+  // with matches straddling block boundaries and near-misses that share the
+  // needle's first and last characters.
+  std::string Hay;
+  for (unsigned I = 0; I < 200; ++I)
+    Hay += "abcab"[(I * 7 + I / 3) % 5];
+  for (size_t Len = 1; Len <= 20; ++Len) {
+    for (size_t Pos = 0; Pos + Len <= Hay.size(); Pos += 13) {
+      std::string Needle = Hay.substr(Pos, Len);
+      std::string NearMiss = Needle;
+      if (Len > 2)
+        NearMiss[Len / 2] = 'z';
+      for (size_t From : {size_t(0), size_t(1), Pos, Pos + 1}) {
+        EXPECT_EQ(std::string_view(Hay).find(Needle, From),
+                  StringRef(Hay).find(Needle, From));
+        EXPECT_EQ(std::string_view(Hay).find(NearMiss, From),
+                  StringRef(Hay).find(NearMiss, From));
+      }
+    }
+  }
+
+  for (StringRef Chars : {"z", "c", "zc", "\t\n\v\f\r ", "zyxwvuts", "abcdefghi"})
+    for (size_t From = 0; From <= Hay.size(); ++From) {
+      EXPECT_EQ(std::string_view(Hay).find_first_of(Chars, From),
+                StringRef(Hay).find_first_of(Chars, From));
+      std::string Spaced = Hay;
+      Spaced[Hay.size() - 1 - From / 2] = '\n';
+      EXPECT_EQ(std::string_view(Spaced).find_first_of(Chars, From),
+                StringRef(Spaced).find_first_of(Chars, From));
+    }
+}
+
 TEST(StringRefTest, FindIf) {
   StringRef Punct("Test.String");
   StringRef NoPunct("ABCDEFG");
@@ -0,0 +1,84 @@
+//===- LocalObjectCacheTest.cpp - Unit tests for the on-disk object cache -===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/LocalObjectCache.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+using llvm::unittest::TempDir;
+
+namespace {
+
+std::unique_ptr<Module> makeModule(LLVMContext &Ctx, int RetVal) {
+  auto M = std::make_unique<Module>("M", Ctx);
+  M->setTargetTriple("x86_64-unknown-linux-gnu");
+  auto *F = Function::Create(
+      FunctionType::get(Type::getInt32Ty(Ctx), /*isVarArg=*/false),
+      GlobalValue::ExternalLinkage, "f", *M);
+  IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+  B.CreateRet(B.getInt32(RetVal));
+  return M;
+}
+
+TEST(LocalObjectCacheTest, MissThenHitAcrossInstances) {
+  TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto M = makeModule(Ctx, 42);
+
+  auto Cache = LocalObjectCache::Create(Dir.path(), "O2");
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+  EXPECT_EQ((*Cache)->getObject(M.get()), nullptr);
+
+  // Modify the module the way code generation might; the object must still
+  // be stored under the key the module had at lookup time.
+  std::string KeyBefore = (*Cache)->getKey(*M);
+  M->getFunction("f")->addFnAttr(Attribute::NoUnwind);
+  (*Cache)->notifyObjectCompiled(
+      M.get(), MemoryBufferRef("fake-object", "fake-object"));
+
+  // A fresh cache, e.g. in a new process, finds the entry.
+  auto Cache2 = LocalObjectCache::Create(Dir.path(), "O2");
+  ASSERT_THAT_EXPECTED(Cache2, Succeeded());
+  auto M2 = makeModule(Ctx, 42);
+  EXPECT_EQ((*Cache2)->getKey(*M2), KeyBefore);
+  std::unique_ptr<MemoryBuffer> Obj = (*Cache2)->getObject(M2.get());
+  ASSERT_NE(Obj, nullptr);
+  EXPECT_EQ(Obj->getBuffer(), "fake-object");
+}
+
+TEST(LocalObjectCacheTest, KeyDependsOnContentAndConfig) {
+  TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto M = makeModule(Ctx, 1);
+  auto Other = makeModule(Ctx, 2);
+
+  auto O2 = LocalObjectCache::Create(Dir.path(), "O2");
+  auto O0 = LocalObjectCache::Create(Dir.path(), "O0");
+  ASSERT_THAT_EXPECTED(O2, Succeeded());
+  ASSERT_THAT_EXPECTED(O0, Succeeded());
+
+  EXPECT_NE((*O2)->getKey(*M), (*O2)->getKey(*Other));
+  EXPECT_NE((*O2)->getKey(*M), (*O0)->getKey(*M));
+
+  EXPECT_EQ((*O2)->getObject(M.get()), nullptr);
+  (*O2)->notifyObjectCompiled(M.get(), MemoryBufferRef("obj", "obj"));
+  EXPECT_NE((*O2)->getObject(M.get()), nullptr);
+  EXPECT_EQ((*O0)->getObject(M.get()), nullptr);
+  EXPECT_EQ((*O2)->getObject(Other.get()), nullptr);
+}
+
+} // namespace
@@ -9,6 +9,7 @@
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
@@ -692,6 +693,52 @@ TEST(LiveIntervalTest, BundleSubRegDef) {
   });
 }
 
+/**
+ * Run \p T with -lazy-live-intervals, so that the intervals of single-def
+ * virtual registers are only computed once they are queried.
+ */
+static void lazyLiveIntervalTest(StringRef MIRFunc,
+                                 TestPassT<LiveIntervals>::TestFx T) {
+  auto *Lazy = static_cast<cl::opt<bool> *>(
+      cl::getRegisteredOptions()["lazy-live-intervals"]);
+  ASSERT_TRUE(Lazy);
+  Lazy->setValue(true);
+  liveIntervalTest(MIRFunc, T);
+  Lazy->setValue(false);
+}
+
+TEST(LiveIntervalTest, BundleLazyDef) {
+  lazyLiveIntervalTest(R"MIR(
+    %0 = IMPLICIT_DEF
+    S_NOP 0
+    S_NOP 0, implicit %0
+    S_NOP 0
+)MIR", [](MachineFunction &MF, LiveIntervals &LIS) {
+    testHandleMoveIntoNewBundle(MF, LIS, 0, 1);
+    const LiveInterval &LI = LIS.getInterval(Register::index2VirtReg(0));
+    EXPECT_EQ(LI.beginIndex(),
+              LIS.getInstructionIndex(getMI(MF, 0, 0)).getRegSlot());
+    EXPECT_EQ(LI.endIndex(),
+              LIS.getInstructionIndex(getMI(MF, 1, 0)).getRegSlot());
+  });
+}
+
+TEST(LiveIntervalTest, BundleLazyUse) {
+  lazyLiveIntervalTest(R"MIR(
+    %0 = IMPLICIT_DEF
+    S_NOP 0
+    S_NOP 0, implicit %0
+    S_NOP 0
+)MIR", [](MachineFunction &MF, LiveIntervals &LIS) {
+    testHandleMoveIntoNewBundle(MF, LIS, 1, 2);
+    const LiveInterval &LI = LIS.getInterval(Register::index2VirtReg(0));
+    EXPECT_EQ(LI.beginIndex(),
+              LIS.getInstructionIndex(getMI(MF, 0, 0)).getRegSlot());
+    EXPECT_EQ(LI.endIndex(),
+              LIS.getInstructionIndex(getMI(MF, 1, 0)).getRegSlot());
+  });
+}
+
 TEST(LiveIntervalTest, SplitAtOneInstruction) {
   liveIntervalTest(R"MIR(
     successors: %bb.1
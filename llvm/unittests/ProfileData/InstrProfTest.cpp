@@ -235,6 +235,36 @@ TEST_F(InstrProfTest, test_writer_merge) {
   ASSERT_EQ(0U, R->Counts[1]);
 }
 
+TEST_F(InstrProfTest, test_writer_merge_shared_and_new_functions) {
+  Writer.addRecord({"func1", 0x1234, {1, 2}}, Err);
+
+  InstrProfWriter Writer2;
+  Writer2.addRecord({"func1", 0x1234, {10, 20}}, Err);
+  Writer2.addRecord({"func1", 0x5678, {3}}, Err);
+  Writer2.addRecord({"func2", 0x1234, {7}}, 3, Err);
+
+  Writer.mergeRecordsFromWriter(std::move(Writer2), Err);
+
+  auto Profile = Writer.writeBuffer();
+  readProfile(std::move(Profile));
+
+  Expected<InstrProfRecord> R = Reader->getInstrProfRecord("func1", 0x1234);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(2U, R->Counts.size());
+  ASSERT_EQ(11U, R->Counts[0]);
+  ASSERT_EQ(22U, R->Counts[1]);
+
+  R = Reader->getInstrProfRecord("func1", 0x5678);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(1U, R->Counts.size());
+  ASSERT_EQ(3U, R->Counts[0]);
+
+  R = Reader->getInstrProfRecord("func2", 0x1234);
+  EXPECT_THAT_ERROR(R.takeError(), Succeeded());
+  ASSERT_EQ(1U, R->Counts.size());
+  ASSERT_EQ(21U, R->Counts[0]);
+}
+
 TEST_F(InstrProfTest, test_merge_temporal_prof_traces_truncated) {
   uint64_t ReservoirSize = 10;
   uint64_t MaxTraceLength = 2;
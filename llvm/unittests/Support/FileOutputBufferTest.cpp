@@ -155,6 +155,33 @@ TEST(FileOutputBuffer, Test) {
   ASSERT_EQ(File6Size, 0ULL);
   ASSERT_NO_ERROR(fs::remove(File6.str()));
 
+  // TEST 7: Starting writeback early does not change the committed content.
+  SmallString<128> File7(TestDirectory);
+  File7.append("/file7");
+  {
+    Expected<std::unique_ptr<FileOutputBuffer>> BufferOrErr =
+        FileOutputBuffer::create(File7, 8192);
+    ASSERT_NO_ERROR(errorToErrorCode(BufferOrErr.takeError()));
+    std::unique_ptr<FileOutputBuffer> &Buffer = *BufferOrErr;
+    memcpy(Buffer->getBufferStart(), "AABBCCDDEEFFGGHHIIJJ", 20);
+    Buffer->startWriteback(0, 4096);
+    // Modify a range after its writeback was started.
+    memcpy(Buffer->getBufferStart(), "KKLL", 4);
+    memcpy(Buffer->getBufferEnd() - 20, "AABBCCDDEEFFGGHHIIJJ", 20);
+    Buffer->startWriteback(4096, 1 << 20);
+    ASSERT_NO_ERROR(errorToErrorCode(Buffer->commit()));
+  }
+  {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+        MemoryBuffer::getFile(File7);
+    ASSERT_NO_ERROR(MBOrErr.getError());
+    StringRef Contents = (*MBOrErr)->getBuffer();
+    ASSERT_EQ(Contents.size(), 8192U);
+    EXPECT_EQ(Contents.take_front(20), "KKLLCCDDEEFFGGHHIIJJ");
+    EXPECT_EQ(Contents.take_back(20), "AABBCCDDEEFFGGHHIIJJ");
+  }
+  ASSERT_NO_ERROR(fs::remove(File7.str()));
+
   // Clean up.
   ASSERT_NO_ERROR(fs::remove(TestDirectory.str()));
 }
@@ -226,6 +226,75 @@ TEST(JSONTest, ParseErrors) {
   ExpectErr("Invalid UTF-8 sequence", "\"\xC0\x80\""); // WTF-8 null
 }
 
+TEST(JSONTest, ParseArrayElements) {
+  const char *Doc =
+      R"([{"file": "a.c", "args": ["-c", "x,]y"]}, 2, "s]","x", [3]])";
+  std::vector<std::string> Seen;
+  ASSERT_THAT_ERROR(parseArrayElements(Doc,
+                                       [&](Value &&V) {
+                                         Seen.push_back(s(V));
+                                         return Error::success();
+                                       }),
+                    Succeeded());
+  std::vector<std::string> Expected = {R"({"args":["-c","x,]y"],"file":"a.c"})",
+                                       "2", R"("s]")", R"("x")", "[3]"};
+  EXPECT_EQ(Expected, Seen);
+
+  std::vector<std::string> SeenParallel(Expected.size());
+  ASSERT_THAT_ERROR(parseArrayElementsInParallel(Doc,
+                                                 [&](size_t I, Value &&V) {
+                                                   SeenParallel[I] = s(V);
+                                                   return Error::success();
+                                                 }),
+                    Succeeded());
+  EXPECT_EQ(Expected, SeenParallel);
+
+  auto Ignore = [](Value &&) { return Error::success(); };
+  auto IgnoreIndexed = [](size_t, Value &&) { return Error::success(); };
+  EXPECT_THAT_ERROR(parseArrayElements(" [ ] ", Ignore), Succeeded());
+  EXPECT_THAT_ERROR(parseArrayElementsInParallel(" [ ] ", IgnoreIndexed),
+                    Succeeded());
+
+  for (const char *Bad :
+       {"{}", "[1,]", "[1 2]", "[1,\"abc]", "[1]x", "[1,\n [}]", "[1"}) {
+    std::string Serial = toString(parseArrayElements(Bad, Ignore));
+    std::string Parallel =
+        toString(parseArrayElementsInParallel(Bad, IgnoreIndexed));
+    EXPECT_FALSE(Serial.empty()) << Bad;
+    EXPECT_FALSE(Parallel.empty()) << Bad;
+    if (Bad[0] == '[')
+      EXPECT_EQ(toString(parse(Bad).takeError()), Serial) << Bad;
+  }
+  // Error positions are relative to the whole document.
+  EXPECT_THAT(
+      toString(parseArrayElementsInParallel("[1,\n [}]", IgnoreIndexed)),
+      testing::HasSubstr("[2:3, byte=7]"));
+
+  // Callback errors stop parsing and are propagated; the parallel variant
+  // reports the lowest-indexed failure.
+  unsigned Calls = 0;
+  EXPECT_THAT_ERROR(parseArrayElements("[1, 2, 3]",
+                                       [&](Value &&V) -> Error {
+                                         ++Calls;
+                                         if (*V.getAsInteger() == 2)
+                                           return createStringError(
+                                               inconvertibleErrorCode(), "two");
+                                         return Error::success();
+                                       }),
+                    FailedWithMessage("two"));
+  EXPECT_EQ(2u, Calls);
+  EXPECT_THAT_ERROR(parseArrayElementsInParallel(
+                        "[1, 2, 3]",
+                        [&](size_t I, Value &&V) -> Error {
+                          if (I > 0)
+                            return createStringError(
+                                inconvertibleErrorCode(),
+                                "elt " + std::to_string(I));
+                          return Error::success();
+                        }),
+                    FailedWithMessage("elt 1"));
+}
+
 // Direct tests of isUTF8 and fixUTF8. Internal uses are also tested elsewhere.
 TEST(JSONTest, UTF8) {
   for (const char *Valid : {
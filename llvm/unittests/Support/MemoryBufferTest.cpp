@@ -435,6 +435,39 @@ TEST_F(MemoryBufferTest, mmapVolatileNoNull) {
   EXPECT_TRUE(MB->getBuffer().startswith("01234567"));
 }
 
+TEST_F(MemoryBufferTest, adviseIfMmap) {
+  int FD;
+  SmallString<64> TestPath;
+  ASSERT_NO_ERROR(sys::fs::createTemporaryFile("MemoryBufferTest_adviseIfMmap",
+                                               "temp", FD, TestPath));
+  FileRemover Cleanup(TestPath);
+  raw_fd_ostream OF(FD, true);
+  unsigned PageSize = sys::Process::getPageSizeEstimate();
+  unsigned FileWrites = (PageSize * 4) / 8;
+  for (unsigned i = 0; i < FileWrites; ++i)
+    OF << "01234567";
+  OF.close();
+
+  for (auto Pattern : {MemoryBuffer::AccessPattern::Normal,
+                       MemoryBuffer::AccessPattern::Sequential,
+                       MemoryBuffer::AccessPattern::Random}) {
+    auto MBOrError = MemoryBuffer::getFile(TestPath, /*IsText=*/false,
+                                           /*RequiresNullTerminator=*/false);
+    ASSERT_NO_ERROR(MBOrError.getError());
+    OwningBuffer MB = std::move(*MBOrError);
+    EXPECT_EQ(MB->getBufferKind(), MemoryBuffer::MemoryBuffer_MMap);
+    MB->adviseIfMmap(Pattern);
+    EXPECT_EQ(MB->getBufferSize(), std::size_t(FileWrites * 8));
+    EXPECT_TRUE(MB->getBuffer().startswith("01234567"));
+    EXPECT_TRUE(MB->getBuffer().endswith("01234567"));
+  }
+
+  // Buffers that are not mapped ignore the hint.
+  OwningBuffer Copy(MemoryBuffer::getMemBufferCopy("data"));
+  Copy->adviseIfMmap(MemoryBuffer::AccessPattern::Sequential);
+  EXPECT_EQ("data", Copy->getBuffer());
+}
+
 // Test that SmallVector without a null terminator gets one.
 TEST(SmallVectorMemoryBufferTest, WithoutNullTerminatorRequiresNullTerminator) {
   SmallString<0> Data("some data");
@@ -12,7 +12,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Parallel.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/xxhash.h"
 #include "gtest/gtest.h"
 #include <array>
 #include <random>
@@ -50,6 +52,15 @@ TEST(Parallel, parallel_for) {
   ASSERT_EQ(range[2049], 1u);
 }
 
+TEST(Parallel, parallel_for_offset) {
+  // Each index in [Begin, End) must be visited exactly once when the range does
+  // not start at zero and is not a multiple of the chunk size.
+  std::vector<std::atomic<uint32_t>> range(10000);
+  parallelFor(7, 9001, [&range](size_t I) { ++range[I]; });
+  for (size_t I = 0; I != range.size(); ++I)
+    ASSERT_EQ(range[I], (I >= 7 && I < 9001) ? 1u : 0u);
+}
+
 TEST(Parallel, TransformReduce) {
   // Sum an empty list, check that it works.
   auto identity = [](uint32_t v) { return v; };
@@ -93,6 +104,30 @@ TEST(Parallel, ForEachError) {
   EXPECT_EQ(errText, std::string("asdf\nasdf\nasdf"));
 }
 
+TEST(Parallel, TreeHash) {
+  auto HashFn = [](uint8_t *Dest, ArrayRef<uint8_t> Arr) {
+    support::endian::write64le(Dest, xxh3_64bits(Arr));
+  };
+  std::vector<uint8_t> Data(10000);
+  for (size_t I = 0; I != Data.size(); ++I)
+    Data[I] = I * 31;
+
+  for (size_t Size : {0, 1, 999, 1000, 1001, 10000}) {
+    ArrayRef<uint8_t> Input = ArrayRef(Data).take_front(Size);
+    // Compute the expected value serially.
+    std::vector<uint8_t> Hashes;
+    for (size_t Off = 0; Off < Size; Off += 1000) {
+      uint8_t Buf[8];
+      HashFn(Buf, Input.slice(Off).take_front(1000));
+      Hashes.insert(Hashes.end(), Buf, Buf + 8);
+    }
+    uint8_t Expected[8], Actual[8];
+    HashFn(Expected, Hashes);
+    parallelTreeHash(Actual, Input, HashFn, /*ChunkSize=*/1000);
+    EXPECT_EQ(ArrayRef(Expected), ArrayRef(Actual)) << Size;
+  }
+}
+
 TEST(Parallel, TaskGroupSequentialFor) {
   size_t Count = 0;
   {
@@ -53,4 +53,29 @@ TEST(PerThreadBumpPtrAllocatorTest, ParallelAllocation) {
   EXPECT_EQ(Allocator.getNumberOfAllocators(), parallel::getThreadCount());
 }
 
+TEST(PerThreadBumpPtrAllocatorTest, PooledSlabsAreRecycled) {
+  SlabPool Pool;
+  PerThreadPooledBumpPtrAllocator Allocator(Pool);
+
+  static size_t constexpr NumAllocations = 4000;
+
+  parallel::TaskGroup tg;
+  tg.spawn([&]() {
+    for (size_t Idx = 0; Idx < NumAllocations; Idx++)
+      *(uint64_t *)Allocator.Allocate(4096, alignof(uint64_t)) = Idx;
+    EXPECT_EQ(4096 * NumAllocations, Allocator.getBytesAllocated());
+    size_t Reserved = Pool.getReservedBytes();
+    EXPECT_EQ(Reserved, Allocator.getTotalMemory());
+
+    // Reset returns all but the first slab to the pool, and the next round of
+    // allocations is served from the cache instead of the system.
+    Allocator.Reset();
+    EXPECT_EQ(Reserved / Pool.getSlabSize() - 1, Pool.getNumCachedSlabs());
+    for (size_t Idx = 0; Idx < NumAllocations; Idx++)
+      *(uint64_t *)Allocator.Allocate(4096, alignof(uint64_t)) = Idx;
+    EXPECT_EQ(Reserved, Pool.getReservedBytes());
+    EXPECT_EQ(0u, Pool.getNumCachedSlabs());
+  });
+}
+
 } // anonymous namespace
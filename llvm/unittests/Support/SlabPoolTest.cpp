@@ -0,0 +1,111 @@
+//===- SlabPoolTest.cpp ---------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/SlabPool.h"
+#include "llvm/Support/Parallel.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(SlabPoolTest, ReuseCachedSlab) {
+  SlabPool Pool(4096, 2);
+  void *A = Pool.allocate(4096, alignof(std::max_align_t));
+  EXPECT_EQ(4096u, Pool.getReservedBytes());
+  Pool.deallocate(A, 4096, alignof(std::max_align_t));
+  EXPECT_EQ(1u, Pool.getNumCachedSlabs());
+  EXPECT_EQ(4096u, Pool.getReservedBytes());
+
+  void *B = Pool.allocate(4096, alignof(std::max_align_t));
+  EXPECT_EQ(A, B);
+  EXPECT_EQ(0u, Pool.getNumCachedSlabs());
+  Pool.deallocate(B, 4096, alignof(std::max_align_t));
+}
+
+TEST(SlabPoolTest, OtherSizesBypassCache) {
+  SlabPool Pool(4096, 2);
+  void *A = Pool.allocate(8192, alignof(std::max_align_t));
+  EXPECT_EQ(8192u, Pool.getReservedBytes());
+  Pool.deallocate(A, 8192, alignof(std::max_align_t));
+  EXPECT_EQ(0u, Pool.getNumCachedSlabs());
+  EXPECT_EQ(0u, Pool.getReservedBytes());
+}
+
+TEST(SlabPoolTest, CacheIsBounded) {
+  SlabPool Pool(4096, 2);
+  void *Slabs[4];
+  for (void *&S : Slabs)
+    S = Pool.allocate(4096, alignof(std::max_align_t));
+  EXPECT_EQ(4 * 4096u, Pool.getReservedBytes());
+  for (void *S : Slabs)
+    Pool.deallocate(S, 4096, alignof(std::max_align_t));
+  EXPECT_EQ(2u, Pool.getNumCachedSlabs());
+  EXPECT_EQ(2 * 4096u, Pool.getReservedBytes());
+
+  Pool.releaseCachedSlabs();
+  EXPECT_EQ(0u, Pool.getNumCachedSlabs());
+  EXPECT_EQ(0u, Pool.getReservedBytes());
+}
+
+TEST(SlabPoolTest, ReservedBytesAreCapped) {
+  SlabPool Pool(4096, 2, 3 * 4096);
+  void *A = Pool.allocate(4096, alignof(std::max_align_t));
+  void *B = Pool.allocate(4096, alignof(std::max_align_t));
+  Pool.deallocate(B, 4096, alignof(std::max_align_t));
+  EXPECT_EQ(1u, Pool.getNumCachedSlabs());
+  EXPECT_EQ(2 * 4096u, Pool.getReservedBytes());
+
+  // Going over the cap releases the cached slab to make room.
+  void *C = Pool.allocate(8192, alignof(std::max_align_t));
+  EXPECT_EQ(0u, Pool.getNumCachedSlabs());
+  EXPECT_EQ(3 * 4096u, Pool.getReservedBytes());
+
+  Pool.deallocate(C, 8192, alignof(std::max_align_t));
+  Pool.deallocate(A, 4096, alignof(std::max_align_t));
+  EXPECT_EQ(1u, Pool.getNumCachedSlabs());
+  EXPECT_EQ(4096u, Pool.getReservedBytes());
+}
+
+#if GTEST_HAS_DEATH_TEST
+TEST(SlabPoolTest, ReservedBytesLimitExceeded) {
+  SlabPool Pool(4096, 2, 4096);
+  void *A = Pool.allocate(4096, alignof(std::max_align_t));
+  EXPECT_DEATH(Pool.allocate(4096, alignof(std::max_align_t)),
+               "SlabPool reserved memory limit exceeded");
+  Pool.deallocate(A, 4096, alignof(std::max_align_t));
+}
+#endif
+
+TEST(SlabPoolTest, PooledBumpPtrAllocator) {
+  SlabPool Pool(4096, 8);
+  {
+    PooledBumpPtrAllocator<4096> Alloc(Pool);
+    for (int I = 0; I < 100; ++I)
+      Alloc.Allocate(100, 8);
+    EXPECT_EQ(Alloc.getTotalMemory(), Pool.getReservedBytes());
+    Alloc.Reset();
+    // All but the first slab went back to the pool.
+    EXPECT_EQ(Pool.getReservedBytes() / 4096 - 1, Pool.getNumCachedSlabs());
+  }
+  EXPECT_EQ(Pool.getReservedBytes() / 4096, Pool.getNumCachedSlabs());
+}
+
+TEST(SlabPoolTest, ConcurrentAllocation) {
+  SlabPool Pool(4096, 16);
+  parallelFor(0, 10000, [&](size_t Idx) {
+    void *P = Pool.allocate(4096, alignof(std::max_align_t));
+    *static_cast<size_t *>(P) = Idx;
+    EXPECT_EQ(Idx, *static_cast<size_t *>(P));
+    Pool.deallocate(P, 4096, alignof(std::max_align_t));
+  });
+  EXPECT_LE(Pool.getNumCachedSlabs(), 16u);
+  EXPECT_EQ(Pool.getNumCachedSlabs() * 4096, Pool.getReservedBytes());
+}
+
+} // anonymous namespace
@@ -140,4 +140,23 @@ TEST(SuffixTreeTest, TestExclusion) {
   }
 }
 
+// Tests that the repeated substrings come out in a fixed order, independent of
+// how each node stores its children: children are visited by increasing key,
+// and the start indices of each substring are sorted. The MachineOutliner
+// relies on this order to break ties between equally beneficial candidates.
+TEST(SuffixTreeTest, TestDeterministicOrder) {
+  std::vector<unsigned> Data = {5, 6, 100, 5, 6, 101, 3, 4, 102,
+                                3, 4, 103, 3, 4, 104};
+  SuffixTree ST(Data);
+  std::vector<SuffixTree::RepeatedSubstring> SubStrings;
+  for (auto It = ST.begin(); It != ST.end(); It++)
+    SubStrings.push_back(*It);
+  ASSERT_EQ(SubStrings.size(), 2u);
+  EXPECT_EQ(SubStrings[0].Length, 2u);
+  EXPECT_EQ(SubStrings[0].StartIndices,
+            (SmallVector<unsigned>{6u, 9u, 12u}));
+  EXPECT_EQ(SubStrings[1].Length, 2u);
+  EXPECT_EQ(SubStrings[1].StartIndices, (SmallVector<unsigned>{0u, 3u}));
+}
+
 } // namespace
@@ -263,6 +263,81 @@ TEST_F(ThreadPoolTest, Groups) {
   ASSERT_EQ(1, checked_in2);
 }
 
+TEST_F(ThreadPoolTest, GroupPriority) {
+  CHECK_UNSUPPORTED();
+  ThreadPool Pool(hardware_concurrency(1));
+  PhaseResetHelper Helper(this);
+  ThreadPoolTaskGroup Low(Pool);
+  ThreadPoolTaskGroup High(Pool, /*Priority=*/1);
+
+  std::mutex OrderMutex;
+  std::vector<int> Order;
+  // Keep the only worker busy so that the tasks below are queued together.
+  Pool.async([this] { waitForMainThread(); });
+  for (int I = 0; I < 3; ++I)
+    Low.async([&, I] {
+      std::lock_guard<std::mutex> Lock(OrderMutex);
+      Order.push_back(I);
+    });
+  for (int I = 3; I < 6; ++I)
+    High.async([&, I] {
+      std::lock_guard<std::mutex> Lock(OrderMutex);
+      Order.push_back(I);
+    });
+  setMainThreadReady();
+  Pool.wait();
+  ASSERT_EQ(std::vector<int>({3, 4, 5, 0, 1, 2}), Order);
+}
+
+TEST_F(ThreadPoolTest, GroupConcurrencyLimit) {
+  CHECK_UNSUPPORTED();
+  ThreadPoolStrategy S = hardware_concurrency(4);
+  if (S.compute_thread_count() < 2)
+    GTEST_SKIP();
+  ThreadPool Pool(S);
+  ThreadPoolTaskGroup Limited(Pool, /*Priority=*/0, /*MaxConcurrency=*/1);
+  ThreadPoolTaskGroup Other(Pool);
+
+  std::atomic_int Running{0};
+  std::atomic_int MaxRunning{0};
+  std::atomic_int OtherDone{0};
+  for (size_t I = 0; I < 8; ++I) {
+    Limited.async([&] {
+      int Now = ++Running;
+      int Max = MaxRunning;
+      while (Now > Max && !MaxRunning.compare_exchange_weak(Max, Now))
+        ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      --Running;
+    });
+    Other.async([&] { ++OtherDone; });
+  }
+  Limited.wait();
+  Other.wait();
+  ASSERT_EQ(1, MaxRunning);
+  ASSERT_EQ(8, OtherDone);
+}
+
+TEST_F(ThreadPoolTest, GroupCancel) {
+  CHECK_UNSUPPORTED();
+  ThreadPool Pool(hardware_concurrency(1));
+  PhaseResetHelper Helper(this);
+  ThreadPoolTaskGroup Group(Pool);
+
+  std::atomic_int Skipped{0};
+  Pool.async([this] { waitForMainThread(); });
+  for (size_t I = 0; I < 5; ++I)
+    Group.async([&] {
+      if (Group.isCancelled())
+        ++Skipped;
+    });
+  ASSERT_FALSE(Group.isCancelled());
+  Group.cancel();
+  setMainThreadReady();
+  Group.wait();
+  ASSERT_EQ(5, Skipped);
+}
+
 // Check recursive tasks.
 TEST_F(ThreadPoolTest, RecursiveGroups) {
   CHECK_UNSUPPORTED();
@@ -54,6 +54,45 @@ TEST(TimeProfiler, Begin_End_Smoke) {
   ASSERT_TRUE(json.find(R"("detail":"detail")") != std::string::npos);
 }
 
+TEST(TimeProfiler, MaxEventsPerThread) {
+  TimeTraceProfilerOptions Options;
+  Options.MaxEventsPerThread = 2;
+  timeTraceProfilerInitialize(/*TimeTraceGranularity=*/0, "test", Options);
+
+  { TimeTraceScope scope("first", "detail"); }
+  { TimeTraceScope scope("second", "detail"); }
+  { TimeTraceScope scope("third", "detail"); }
+
+  std::string json = teardownProfiler();
+  ASSERT_TRUE(json.find(R"("name":"first")") == std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"second")") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"third")") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"Total first")") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("droppedEvents":1)") != std::string::npos);
+}
+
+TEST(TimeProfiler, SummaryOnly) {
+  TimeTraceProfilerOptions Options;
+  Options.SummaryOnly = true;
+  Options.MaxTotals = 1;
+  timeTraceProfilerInitialize(/*TimeTraceGranularity=*/0, "test", Options);
+
+  bool DetailCalled = false;
+  {
+    TimeTraceScope scope("event", [&] {
+      DetailCalled = true;
+      return std::string("detail");
+    });
+    TimeTraceScope nested("nested");
+  }
+
+  std::string json = teardownProfiler();
+  EXPECT_FALSE(DetailCalled);
+  ASSERT_TRUE(json.find(R"("name":"event")") == std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"Total event")") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("name":"Total nested")") == std::string::npos);
+}
+
 TEST(TimeProfiler, Begin_End_Disabled) {
   // Nothing should be observable here. The test is really just making sure
   // we've not got a stray nullptr deref.
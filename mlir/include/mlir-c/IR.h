@@ -305,6 +305,13 @@ MLIR_CAPI_EXPORTED MlirModule mlirModuleCreateEmpty(MlirLocation location);
 MLIR_CAPI_EXPORTED MlirModule mlirModuleCreateParse(MlirContext context,
                                                     MlirStringRef module);
 
+/// Parses a module from the file at the given path and transfers ownership to
+/// the caller. Both textual and bytecode files are accepted. The file is
+/// memory-mapped when possible, and the blobs of bytecode dense resources refer
+/// to the mapped file directly rather than being copied into the context.
+MLIR_CAPI_EXPORTED MlirModule mlirModuleCreateParseFromFile(
+    MlirContext context, MlirStringRef fileName);
+
 /// Gets the context that a module was created with.
 MLIR_CAPI_EXPORTED MlirContext mlirModuleGetContext(MlirModule module);
 
@@ -17,6 +17,7 @@
 #include <cassert>
 #include <cinttypes>
 #include <functional>
+#include <thread>
 #include <vector>
 
 namespace mlir {
@@ -64,6 +65,50 @@ struct ElementLT final {
   const uint64_t rank;
 };
 
+/// Sorts `[begin, end)` a la `std::sort`, using all hardware threads for
+/// large ranges.  The range is split into one chunk per thread, the chunks
+/// are sorted concurrently, and then merged pairwise (each round of merges
+/// also running concurrently).
+template <typename RandomIt, typename Compare>
+void parallelSort(RandomIt begin, RandomIt end, Compare comp) {
+  // Below this many elements per thread, spawning threads does not pay off.
+  constexpr uint64_t kMinChunkSize = 1 << 15;
+  const uint64_t n = end - begin;
+  const uint64_t numChunks =
+      std::min<uint64_t>(std::thread::hardware_concurrency(), n / kMinChunkSize);
+  if (numChunks < 2) {
+    std::sort(begin, end, comp);
+    return;
+  }
+
+  std::vector<uint64_t> bounds(numChunks + 1);
+  for (uint64_t i = 0; i <= numChunks; ++i)
+    bounds[i] = n * i / numChunks;
+
+  std::vector<std::thread> threads;
+  threads.reserve(numChunks);
+  for (uint64_t i = 1; i < numChunks; ++i)
+    threads.emplace_back([&, i] {
+      std::sort(begin + bounds[i], begin + bounds[i + 1], comp);
+    });
+  std::sort(begin + bounds[0], begin + bounds[1], comp);
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (uint64_t width = 1; width < numChunks; width *= 2) {
+    threads.clear();
+    for (uint64_t i = 0; i + width < numChunks; i += 2 * width) {
+      const uint64_t lo = bounds[i], mid = bounds[i + width],
+                     hi = bounds[std::min(i + 2 * width, numChunks)];
+      threads.emplace_back([&, lo, mid, hi] {
+        std::inplace_merge(begin + lo, begin + mid, begin + hi, comp);
+      });
+    }
+    for (std::thread &thread : threads)
+      thread.join();
+  }
+}
+
 /// The type of callback functions which receive an element.  We avoid
 /// packaging the coordinates and value together as an `Element` object
 /// because this helps keep code somewhat cleaner.
@@ -183,7 +228,7 @@ public:
   void sort() {
     if (isSorted)
       return;
-    std::sort(elements.begin(), elements.end(), getElementLT());
+    parallelSort(elements.begin(), elements.end(), getElementLT());
     isSorted = true;
   }
 
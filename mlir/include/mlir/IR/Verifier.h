@@ -21,6 +21,14 @@ class Operation;
 /// on nested operations.
 LogicalResult verify(Operation *op, bool verifyRecursively = true);
 
+/// Perform a shallow verification of this operation: the operation and the
+/// operations nested in its regions are checked, but the bodies of nested
+/// operations that are IsolatedFromAbove are not; only the invariants of those
+/// operations themselves are. This bounds the cost of verifying a large module
+/// after a transformation limited to its top-level structure. On error, this
+/// reports the error through the MLIRContext and returns failure.
+LogicalResult verifyLocally(Operation *op);
+
 } // namespace mlir
 
 #endif
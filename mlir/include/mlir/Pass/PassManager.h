@@ -269,6 +269,13 @@ public:
   /// Runs the verifier after each individual pass.
   void enableVerifier(bool enabled = true);
 
+  /// When the verifier is enabled, only verify the operation a pass ran on and
+  /// the operations in its regions after each pass, without descending into
+  /// nested IsolatedFromAbove operations (see `verifyLocally`). Those are left
+  /// to the passes scheduled on them, and the whole IR is verified once after
+  /// the pipeline finished instead.
+  void enableLocalVerifier(bool enabled = true);
+
   //===--------------------------------------------------------------------===//
   // Instrumentations
   //===--------------------------------------------------------------------===//
@@ -420,6 +427,14 @@ public:
   void
   enableStatistics(PassDisplayMode displayMode = PassDisplayMode::Pipeline);
 
+  //===--------------------------------------------------------------------===//
+  // Pass IR Size
+
+  /// Add an instrumentation that counts the operations before and after each
+  /// pass, and prints the totals per pass to `out` when the pass manager is
+  /// destroyed. This helps finding passes that unexpectedly grow the IR.
+  void enableIRSizeTracking(raw_ostream &out = llvm::errs());
+
 private:
   /// Dump the statistics of the passes within this pass manager.
   void dumpStatistics();
@@ -454,6 +469,10 @@ private:
 
   /// A flag that indicates if the IR should be verified in between passes.
   bool verifyPasses : 1;
+
+  /// A flag that indicates if the verification in between passes should stop
+  /// at nested IsolatedFromAbove operations.
+  bool verifyLocally : 1;
 };
 
 /// Register a set of useful command-line options that can be used to configure
@@ -88,6 +88,8 @@ private:
   /// The list that owns the patterns used within this applicator.
   const FrozenRewritePatternSet &frozenPatternList;
   /// The set of patterns to match for each operation, stable sorted by benefit.
+  /// Each list already has `anyOpPatterns` merged in, so that matching an
+  /// operation only walks a single list of native patterns.
   DenseMap<OperationName, SmallVector<const RewritePattern *, 2>> patterns;
   /// The set of patterns that may match against any operation type, stable
   /// sorted by benefit.
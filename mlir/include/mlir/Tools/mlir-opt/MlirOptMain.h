@@ -163,6 +163,14 @@ public:
   }
   bool shouldVerifyPasses() const { return verifyPassesFlag; }
 
+  /// Set whether the verifier run after each pass should skip the bodies of
+  /// nested isolated operations, with a full verification at the end.
+  MlirOptMainConfig &verifyPassesLocally(bool verify) {
+    verifyPassesLocallyFlag = verify;
+    return *this;
+  }
+  bool shouldVerifyPassesLocally() const { return verifyPassesLocallyFlag; }
+
   /// Set whether to run the verifier after each transformation pass.
   MlirOptMainConfig &verifyRoundtrip(bool verify) {
     verifyRoundtripFlag = verify;
@@ -220,6 +228,9 @@ protected:
   /// Run the verifier after each transformation pass.
   bool verifyPassesFlag = true;
 
+  /// Only verify the operation each pass ran on, not nested isolated ops.
+  bool verifyPassesLocallyFlag = false;
+
   /// Verify that the input IR round-trips perfectly.
   bool verifyRoundtripFlag = false;
 };
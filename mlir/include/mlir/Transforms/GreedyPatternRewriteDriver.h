@@ -79,6 +79,16 @@ public:
 
   /// An optional listener that should be notified about IR modifications.
   RewriterBase::Listener *listener = nullptr;
+
+  /// When simplifying a region, first simplify the IsolatedFromAbove ops
+  /// directly nested in it (e.g. the functions of a module) concurrently on
+  /// the context's thread pool, then simplify the region itself without
+  /// revisiting their bodies. This is ignored when multi-threading is disabled
+  /// on the context, when a listener is set, in strict mode, or when the
+  /// number of rewrites is limited.
+  ///
+  /// Note: Only applicable when simplifying entire regions.
+  bool parallelizeIsolatedRegions = false;
 };
 
 //===----------------------------------------------------------------------===//
@@ -65,6 +65,15 @@ Returns a new MlirModule or raises an MLIRError if the parsing fails.
 See also: https://mlir.llvm.org/docs/LangRef/
 )";
 
+static const char kModuleParseFileDocstring[] =
+    R"(Parses a module from a file, in either assembly or bytecode format.
+
+The file is memory-mapped when possible, and bytecode resource blobs reference
+the mapped file instead of being copied.
+
+Returns a new MlirModule or raises an MLIRError if the parsing fails.
+)";
+
 static const char kOperationCreateDocstring[] =
     R"(Creates a new operation.
 
@@ -2701,6 +2710,18 @@ void mlir::python::populateIRCore(py::module &m) {
           },
           py::arg("asm"), py::arg("context") = py::none(),
           kModuleParseDocstring)
+      .def_static(
+          "parseFile",
+          [](const std::string &path, DefaultingPyMlirContext context) {
+            PyMlirContext::ErrorCapture errors(context->getRef());
+            MlirModule module = mlirModuleCreateParseFromFile(
+                context->get(), toMlirStringRef(path));
+            if (mlirModuleIsNull(module))
+              throw MLIRError("Unable to parse module file", errors.take());
+            return PyModule::forModule(module).releaseObject();
+          },
+          py::arg("path"), py::arg("context") = py::none(),
+          kModuleParseFileDocstring)
       .def_static(
           "create",
           [](DefaultingPyLocation loc) {
@@ -27,6 +27,7 @@
 #include "mlir/IR/Verifier.h"
 #include "mlir/Interfaces/InferTypeOpInterface.h"
 #include "mlir/Parser/Parser.h"
+#include "llvm/Support/SourceMgr.h"
 
 #include <cstddef>
 #include <memory>
@@ -308,6 +309,18 @@ MlirModule mlirModuleCreateParse(MlirContext context, MlirStringRef module) {
   return MlirModule{owning.release().getOperation()};
 }
 
+MlirModule mlirModuleCreateParseFromFile(MlirContext context,
+                                         MlirStringRef fileName) {
+  // The source manager is kept alive by any resource blob that references its
+  // buffer, which avoids copying large resources.
+  auto sourceMgr = std::make_shared<llvm::SourceMgr>();
+  OwningOpRef<ModuleOp> owning = parseSourceFile<ModuleOp>(
+      unwrap(fileName), sourceMgr, ParserConfig(unwrap(context)));
+  if (!owning)
+    return MlirModule{nullptr};
+  return MlirModule{owning.release().getOperation()};
+}
+
 MlirContext mlirModuleGetContext(MlirModule module) {
   return wrap(unwrap(module).getContext());
 }
@@ -16,14 +16,16 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
 #include "llvm/ADT/StringMap.h"
-#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 
 using namespace mlir::runtime;
 
@@ -38,6 +40,156 @@ namespace {
 // Forward declare class defined below.
 class RefCounted;
 
+// -------------------------------------------------------------------------- //
+// A work stealing scheduler for async tasks. Every worker thread has its own
+// task queue: tasks scheduled from a worker go to the back of its queue and
+// are picked up LIFO by that worker, which keeps a task and its continuations
+// on the same core. Idle workers steal the oldest tasks of other workers.
+// Tasks scheduled from outside of the scheduler go to a shared queue.
+// -------------------------------------------------------------------------- //
+
+class WorkStealingScheduler;
+
+// The scheduler and worker index of the current thread, if it is a worker.
+static thread_local WorkStealingScheduler *currentScheduler = nullptr;
+static thread_local unsigned currentWorker = 0;
+
+class WorkStealingScheduler {
+public:
+  using Task = std::function<void()>;
+
+  explicit WorkStealingScheduler(unsigned numThreads) {
+    for (unsigned i = 0; i < numThreads; ++i)
+      workers.push_back(std::make_unique<Worker>());
+    for (unsigned i = 0; i < numThreads; ++i)
+      threads.emplace_back([this, i] { workerLoop(i); });
+  }
+
+  ~WorkStealingScheduler() {
+    wait();
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      stop = true;
+    }
+    wakeup.notify_all();
+    for (std::thread &thread : threads)
+      thread.join();
+  }
+
+  unsigned getThreadCount() const { return threads.size(); }
+
+  bool isWorkerThread() const { return currentScheduler == this; }
+
+  void schedule(Task task) {
+    numPending.fetch_add(1);
+    if (isWorkerThread()) {
+      Worker &worker = *workers[currentWorker];
+      std::lock_guard<std::mutex> lock(worker.mu);
+      worker.tasks.push_back(std::move(task));
+    } else {
+      std::lock_guard<std::mutex> lock(mu);
+      injected.push_back(std::move(task));
+    }
+    numQueued.fetch_add(1);
+
+    // Only take the lock if there is a worker to wake up.
+    if (numSleeping.load() > 0) {
+      std::lock_guard<std::mutex> lock(mu);
+      wakeup.notify_one();
+    }
+  }
+
+  // Waits for the completion of all scheduled tasks.
+  void wait() {
+    std::unique_lock<std::mutex> lock(mu);
+    done.wait(lock, [this] { return numPending.load() == 0; });
+  }
+
+private:
+  struct Worker {
+    std::mutex mu;
+    std::deque<Task> tasks;
+  };
+
+  bool findTask(unsigned self, Task &task) {
+    if (numQueued.load() == 0)
+      return false;
+
+    auto take = [&](std::deque<Task> &tasks, bool back) {
+      if (tasks.empty())
+        return false;
+      task = std::move(back ? tasks.back() : tasks.front());
+      back ? tasks.pop_back() : tasks.pop_front();
+      numQueued.fetch_sub(1);
+      return true;
+    };
+
+    {
+      Worker &worker = *workers[self];
+      std::lock_guard<std::mutex> lock(worker.mu);
+      if (take(worker.tasks, /*back=*/true))
+        return true;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      if (take(injected, /*back=*/false))
+        return true;
+    }
+    for (unsigned i = 1, e = workers.size(); i < e; ++i) {
+      Worker &victim = *workers[(self + i) % e];
+      std::lock_guard<std::mutex> lock(victim.mu);
+      if (take(victim.tasks, /*back=*/false))
+        return true;
+    }
+    return false;
+  }
+
+  void run(Task &task) {
+    task();
+    task = nullptr;
+    if (numPending.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(mu);
+      done.notify_all();
+    }
+  }
+
+  void workerLoop(unsigned self) {
+    currentScheduler = this;
+    currentWorker = self;
+    while (true) {
+      Task task;
+      if (findTask(self, task)) {
+        run(task);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(mu);
+      numSleeping.fetch_add(1);
+      wakeup.wait(lock, [this] { return stop || numQueued.load() > 0; });
+      numSleeping.fetch_sub(1);
+      if (stop && numQueued.load() == 0)
+        return;
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::vector<std::thread> threads;
+
+  // Protects `injected` and `stop`, and is used for sleeping and waiting.
+  std::mutex mu;
+  std::condition_variable wakeup;
+  std::condition_variable done;
+  std::deque<Task> injected;
+  bool stop = false;
+
+  // Tasks that were scheduled but did not complete yet.
+  std::atomic<int64_t> numPending{0};
+  // Tasks sitting in one of the queues.
+  std::atomic<int64_t> numQueued{0};
+  // Workers waiting for new tasks.
+  std::atomic<int64_t> numSleeping{0};
+};
+
 // -------------------------------------------------------------------------- //
 // AsyncRuntime orchestrates all async operations and Async runtime API is built
 // on top of the default runtime instance.
@@ -45,10 +197,12 @@ class RefCounted;
 
 class AsyncRuntime {
 public:
-  AsyncRuntime() : numRefCountedObjects(0) {}
+  AsyncRuntime()
+      : numRefCountedObjects(0),
+        scheduler(llvm::hardware_concurrency().compute_thread_count()) {}
 
   ~AsyncRuntime() {
-    threadPool.wait(); // wait for the completion of all async tasks
+    scheduler.wait(); // wait for the completion of all async tasks
     assert(getNumRefCountedObjects() == 0 &&
            "all ref counted objects must be destroyed");
   }
@@ -57,7 +211,7 @@ public:
     return numRefCountedObjects.load(std::memory_order_relaxed);
   }
 
-  llvm::ThreadPool &getThreadPool() { return threadPool; }
+  WorkStealingScheduler &getScheduler() { return scheduler; }
 
 private:
   friend class RefCounted;
@@ -72,7 +226,7 @@ private:
   }
 
   std::atomic<int64_t> numRefCountedObjects;
-  llvm::ThreadPool threadPool;
+  WorkStealingScheduler scheduler;
 };
 
 // -------------------------------------------------------------------------- //
@@ -394,7 +548,7 @@ extern "C" ValueStorage mlirAsyncRuntimeGetValueStorage(AsyncValue *value) {
 
 extern "C" void mlirAsyncRuntimeExecute(CoroHandle handle, CoroResume resume) {
   auto *runtime = getDefaultAsyncRuntime();
-  runtime->getThreadPool().async([handle, resume]() { (*resume)(handle); });
+  runtime->getScheduler().schedule([handle, resume]() { (*resume)(handle); });
 }
 
 extern "C" void mlirAsyncRuntimeAwaitTokenAndExecute(AsyncToken *token,
@@ -437,7 +591,7 @@ extern "C" void mlirAsyncRuntimeAwaitAllInGroupAndExecute(AsyncGroup *group,
 }
 
 extern "C" int64_t mlirAsyncRuntimGetNumWorkerThreads() {
-  return getDefaultAsyncRuntime()->getThreadPool().getThreadCount();
+  return getDefaultAsyncRuntime()->getScheduler().getThreadCount();
 }
 
 //===----------------------------------------------------------------------===//
@@ -46,9 +46,12 @@ namespace {
 class OperationVerifier {
 public:
   /// If `verifyRecursively` is true, then this will also recursively verify
-  /// nested operations.
-  explicit OperationVerifier(bool verifyRecursively)
-      : verifyRecursively(verifyRecursively) {}
+  /// nested operations. If `verifyIsolatedRegions` is false, the regions of
+  /// nested IsolatedFromAbove operations are not descended into.
+  explicit OperationVerifier(bool verifyRecursively,
+                             bool verifyIsolatedRegions = true)
+      : verifyRecursively(verifyRecursively),
+        verifyIsolatedRegions(verifyIsolatedRegions) {}
 
   /// Verify the given operation.
   LogicalResult verifyOpAndDominance(Operation &op);
@@ -77,6 +80,10 @@ private:
   /// A flag indicating if this verifier should recursively verify nested
   /// operations.
   bool verifyRecursively;
+
+  /// A flag indicating if this verifier should verify the regions of nested
+  /// IsolatedFromAbove operations.
+  bool verifyIsolatedRegions;
 };
 } // namespace
 
@@ -225,8 +232,12 @@ LogicalResult OperationVerifier::verifyOnExit(Operation &op) {
             opsWithIsolatedRegions.push_back(&o);
   }
   if (failed(failableParallelForEach(
-          op.getContext(), opsWithIsolatedRegions,
-          [&](Operation *o) { return verifyOpAndDominance(*o); })))
+          op.getContext(), opsWithIsolatedRegions, [&](Operation *o) {
+            if (!verifyIsolatedRegions)
+              return OperationVerifier(/*verifyRecursively=*/false)
+                  .verifyOpAndDominance(*o);
+            return verifyOpAndDominance(*o);
+          })))
     return failure();
   OperationName opName = op.getName();
   std::optional<RegisteredOperationName> registeredInfo =
@@ -422,3 +433,9 @@ LogicalResult mlir::verify(Operation *op, bool verifyRecursively) {
   OperationVerifier verifier(verifyRecursively);
   return verifier.verifyOpAndDominance(*op);
 }
+
+LogicalResult mlir::verifyLocally(Operation *op) {
+  OperationVerifier verifier(/*verifyRecursively=*/true,
+                             /*verifyIsolatedRegions=*/false);
+  return verifier.verifyOpAndDominance(*op);
+}
@@ -447,7 +447,8 @@ llvm::hash_code OpPassManager::hash() {
 //===----------------------------------------------------------------------===//
 
 LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
-                                     AnalysisManager am, bool verifyPasses,
+                                     AnalysisManager am,
+                                     PassVerification verifyPasses,
                                      unsigned parentInitGeneration) {
   std::optional<RegisteredOperationName> opInfo = op->getRegisteredInfo();
   if (!opInfo)
@@ -510,7 +511,7 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
 
   // When verifyPasses is specified, we run the verifier (unless the pass
   // failed).
-  if (!passFailed && verifyPasses) {
+  if (!passFailed && verifyPasses != PassVerification::None) {
     bool runVerifierNow = true;
 
     // If the pass is an adaptor pass, we don't run the verifier recursively
@@ -528,8 +529,15 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
 #ifndef EXPENSIVE_CHECKS
     runVerifierNow = !pass->passState->preservedAnalyses.isAll();
 #endif
-    if (runVerifierNow)
-      passFailed = failed(verify(op, runVerifierRecursively));
+    if (runVerifierNow) {
+      // In local mode, nested isolated operations are only verified by the
+      // passes scheduled on them and by the final verification of the pass
+      // manager.
+      if (runVerifierRecursively && verifyPasses == PassVerification::Local)
+        passFailed = failed(verifyLocally(op));
+      else
+        passFailed = failed(verify(op, runVerifierRecursively));
+    }
   }
 
   // Instrument after the pass has run.
@@ -546,8 +554,9 @@ LogicalResult OpToOpPassAdaptor::run(Pass *pass, Operation *op,
 
 /// Run the given operation and analysis manager on a provided op pass manager.
 LogicalResult OpToOpPassAdaptor::runPipeline(
-    OpPassManager &pm, Operation *op, AnalysisManager am, bool verifyPasses,
-    unsigned parentInitGeneration, PassInstrumentor *instrumentor,
+    OpPassManager &pm, Operation *op, AnalysisManager am,
+    PassVerification verifyPasses, unsigned parentInitGeneration,
+    PassInstrumentor *instrumentor,
     const PassInstrumentation::PipelineParentInfo *parentInfo) {
   assert((!instrumentor || parentInfo) &&
          "expected parent info if instrumentor is provided");
@@ -685,7 +694,7 @@ void OpToOpPassAdaptor::runOnOperation() {
 }
 
 /// Run the held pipeline over all nested operations.
-void OpToOpPassAdaptor::runOnOperation(bool verifyPasses) {
+void OpToOpPassAdaptor::runOnOperation(PassVerification verifyPasses) {
   if (getContext().isMultithreadingEnabled())
     runOnOperationAsyncImpl(verifyPasses);
   else
@@ -693,7 +702,7 @@ void OpToOpPassAdaptor::runOnOperation(bool verifyPasses) {
 }
 
 /// Run this pass adaptor synchronously.
-void OpToOpPassAdaptor::runOnOperationImpl(bool verifyPasses) {
+void OpToOpPassAdaptor::runOnOperationImpl(PassVerification verifyPasses) {
   auto am = getAnalysisManager();
   PassInstrumentation::PipelineParentInfo parentInfo = {llvm::get_threadid(),
                                                         this};
@@ -725,7 +734,8 @@ static bool hasSizeMismatch(ArrayRef<OpPassManager> lhs,
 }
 
 /// Run this pass adaptor synchronously.
-void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
+void OpToOpPassAdaptor::runOnOperationAsyncImpl(
+    PassVerification verifyPasses) {
   AnalysisManager am = getAnalysisManager();
   MLIRContext *context = &getContext();
 
@@ -807,17 +817,19 @@ void OpToOpPassAdaptor::runOnOperationAsyncImpl(bool verifyPasses) {
 PassManager::PassManager(MLIRContext *ctx, StringRef operationName,
                          Nesting nesting)
     : OpPassManager(operationName, nesting), context(ctx), passTiming(false),
-      verifyPasses(true) {}
+      verifyPasses(true), verifyLocally(false) {}
 
 PassManager::PassManager(OperationName operationName, Nesting nesting)
     : OpPassManager(operationName, nesting),
       context(operationName.getContext()), passTiming(false),
-      verifyPasses(true) {}
+      verifyPasses(true), verifyLocally(false) {}
 
 PassManager::~PassManager() = default;
 
 void PassManager::enableVerifier(bool enabled) { verifyPasses = enabled; }
 
+void PassManager::enableLocalVerifier(bool enabled) { verifyLocally = enabled; }
+
 /// Run the passes within this manager on the provided operation.
 LogicalResult PassManager::run(Operation *op) {
   MLIRContext *context = getContext();
@@ -877,8 +889,19 @@ void PassManager::addInstrumentation(std::unique_ptr<PassInstrumentation> pi) {
 }
 
 LogicalResult PassManager::runPasses(Operation *op, AnalysisManager am) {
-  return OpToOpPassAdaptor::runPipeline(*this, op, am, verifyPasses,
-                                        impl->initializationGeneration);
+  PassVerification verification = PassVerification::None;
+  if (verifyPasses)
+    verification =
+        verifyLocally ? PassVerification::Local : PassVerification::Full;
+  if (failed(OpToOpPassAdaptor::runPipeline(*this, op, am, verification,
+                                            impl->initializationGeneration)))
+    return failure();
+
+  // The local verification skipped the bodies of nested isolated operations
+  // that were not processed by a nested pipeline. Verify the whole IR once now.
+  if (verification == PassVerification::Local && size() != 0)
+    return verify(op);
+  return success();
 }
 
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,109 @@
+//===- PassIRSize.cpp - IR size tracking for passes -----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "PassDetail.h"
+#include "mlir/Pass/PassManager.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Support/Format.h"
+#include <mutex>
+
+using namespace mlir;
+using namespace mlir::detail;
+
+constexpr StringLiteral kPassIRSizeDescription =
+    "... Pass IR size report ...";
+
+namespace {
+/// The accumulated effect of every run of one pass on the IR size.
+struct PassIRSize {
+  uint64_t numRuns = 0;
+  uint64_t opsBefore = 0;
+  uint64_t opsAfter = 0;
+};
+
+/// An instrumentation that counts the operations nested under the operation a
+/// pass runs on, before and after the pass, and reports the totals per pass
+/// when the pass manager is destroyed.
+struct PassIRSizeInstrumentation : public PassInstrumentation {
+  PassIRSizeInstrumentation(raw_ostream &out) : out(out) {}
+  ~PassIRSizeInstrumentation() override { print(); }
+
+  void runBeforePass(Pass *pass, Operation *op) override {
+    if (isa<OpToOpPassAdaptor>(pass))
+      return;
+    uint64_t numOps = countOps(op);
+    std::lock_guard<std::mutex> lock(mutex);
+    pending[{pass, op}] = numOps;
+  }
+
+  void runAfterPass(Pass *pass, Operation *op) override {
+    if (isa<OpToOpPassAdaptor>(pass))
+      return;
+    uint64_t numOps = countOps(op);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = pending.find({pass, op});
+    if (it == pending.end())
+      return;
+    PassIRSize &size = sizes[pass->getName()];
+    ++size.numRuns;
+    size.opsBefore += it->second;
+    size.opsAfter += numOps;
+    pending.erase(it);
+  }
+
+  void runAfterPassFailed(Pass *pass, Operation *op) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.erase({pass, op});
+  }
+
+private:
+  /// Return the number of operations nested under `op`, including `op`.
+  static uint64_t countOps(Operation *op) {
+    uint64_t numOps = 0;
+    op->walk([&](Operation *) { ++numOps; });
+    return numOps;
+  }
+
+  void print() {
+    if (sizes.empty())
+      return;
+
+    out << "===" << std::string(73, '-') << "===\n";
+    unsigned padding = (80 - kPassIRSizeDescription.size()) / 2;
+    out.indent(padding) << kPassIRSizeDescription << '\n';
+    out << "===" << std::string(73, '-') << "===\n";
+    out << llvm::format("%8s %12s %12s %12s  %s\n", "Runs", "Ops Before",
+                        "Ops After", "Delta", "Name");
+    for (auto &it : sizes) {
+      const PassIRSize &size = it.second;
+      int64_t delta = int64_t(size.opsAfter) - int64_t(size.opsBefore);
+      out << llvm::format("%8llu %12llu %12llu %+12lld  ",
+                          (unsigned long long)size.numRuns,
+                          (unsigned long long)size.opsBefore,
+                          (unsigned long long)size.opsAfter, (long long)delta)
+          << it.first << "\n";
+    }
+    out.flush();
+  }
+
+  /// The operation counts of pass runs that are in flight.
+  DenseMap<std::pair<Pass *, Operation *>, uint64_t> pending;
+
+  /// The accumulated sizes, in the order the passes first completed.
+  llvm::MapVector<StringRef, PassIRSize> sizes;
+
+  /// Guards `pending` and `sizes` against passes running on multiple threads.
+  std::mutex mutex;
+
+  raw_ostream &out;
+};
+} // namespace
+
+void PassManager::enableIRSizeTracking(raw_ostream &out) {
+  addInstrumentation(std::make_unique<PassIRSizeInstrumentation>(out));
+}
@@ -78,6 +78,14 @@ struct PassManagerOptions {
               "display the results in a merged list sorted by pass name"),
           clEnumValN(PassDisplayMode::Pipeline, "pipeline",
                      "display the results with a nested pipeline view"))};
+
+  //===--------------------------------------------------------------------===//
+  // Pass IR Size
+  //===--------------------------------------------------------------------===//
+  llvm::cl::opt<bool> passIRSize{
+      "mlir-pass-ir-size",
+      llvm::cl::desc("Display the number of operations before and after each "
+                     "pass")};
 };
 } // namespace
 
@@ -143,6 +151,10 @@ LogicalResult mlir::applyPassManagerCLOptions(PassManager &pm) {
   if (options->passStatistics)
     pm.enableStatistics(options->passStatisticsDisplayMode);
 
+  // Enable IR size tracking.
+  if (options->passIRSize)
+    pm.enableIRSizeTracking();
+
   if (options->printModuleScope && pm.getContext()->isMultithreadingEnabled()) {
     emitError(UnknownLoc::get(pm.getContext()))
         << "IR print for module scope can't be setup on a pass-manager "
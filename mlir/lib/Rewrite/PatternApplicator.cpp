@@ -108,6 +108,27 @@ void PatternApplicator::applyCostModel(CostModel model) {
   for (auto &it : patterns)
     processPatternList(it.second);
   processPatternList(anyOpPatterns);
+
+  // Merge the op agnostic patterns into each op specific list, preferring the
+  // op specific pattern when the benefits are equal.
+  if (anyOpPatterns.empty())
+    return;
+  SmallVector<const RewritePattern *> merged;
+  for (auto &it : patterns) {
+    SmallVectorImpl<const RewritePattern *> &list = it.second;
+    merged.clear();
+    merged.reserve(list.size() + anyOpPatterns.size());
+    auto opIt = list.begin(), opE = list.end();
+    auto anyIt = anyOpPatterns.begin(), anyE = anyOpPatterns.end();
+    while (opIt != opE || anyIt != anyE) {
+      if (anyIt != anyE &&
+          (opIt == opE || (*opIt)->getBenefit() < (*anyIt)->getBenefit()))
+        merged.push_back(*anyIt++);
+      else
+        merged.push_back(*opIt++);
+    }
+    list.assign(merged.begin(), merged.end());
+  }
 }
 
 void PatternApplicator::walkAllPatterns(
@@ -137,15 +158,14 @@ LogicalResult PatternApplicator::matchAndRewrite(
     bytecode->match(op, rewriter, pdlMatches, *mutableByteCodeState);
 
   // Check to see if there are patterns matching this specific operation type.
-  MutableArrayRef<const RewritePattern *> opPatterns;
+  // These lists already include the patterns matching any operation type.
+  MutableArrayRef<const RewritePattern *> opPatterns = anyOpPatterns;
   auto patternIt = patterns.find(op->getName());
   if (patternIt != patterns.end())
     opPatterns = patternIt->second;
 
-  // Process the patterns for that match the specific operation type, and any
-  // operation type in an interleaved fashion.
+  // Process the native patterns and the PDL matches in an interleaved fashion.
   unsigned opIt = 0, opE = opPatterns.size();
-  unsigned anyIt = 0, anyE = anyOpPatterns.size();
   unsigned pdlIt = 0, pdlE = pdlMatches.size();
   LogicalResult result = failure();
   do {
@@ -154,16 +174,9 @@ LogicalResult PatternApplicator::matchAndRewrite(
     unsigned *bestPatternIt = &opIt;
     const PDLByteCode::MatchResult *pdlMatch = nullptr;
 
-    /// Operation specific patterns.
+    /// Native patterns.
     if (opIt < opE)
       bestPattern = opPatterns[opIt];
-    /// Operation agnostic patterns.
-    if (anyIt < anyE &&
-        (!bestPattern ||
-         bestPattern->getBenefit() < anyOpPatterns[anyIt]->getBenefit())) {
-      bestPatternIt = &anyIt;
-      bestPattern = anyOpPatterns[anyIt];
-    }
     /// PDL patterns.
     if (pdlIt < pdlE && (!bestPattern || bestPattern->getBenefit() <
                                              pdlMatches[pdlIt].benefit)) {
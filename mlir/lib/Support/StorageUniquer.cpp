@@ -12,6 +12,7 @@
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -109,13 +110,26 @@ private:
 
 public:
 #if LLVM_ENABLE_THREADS != 0
+  /// Return the default number of shards: enough that threads creating
+  /// instances of the same storage type rarely contend on a shard lock. Shards
+  /// are allocated lazily, so unused ones only cost a pointer.
+  static size_t getDefaultNumShards() {
+    static const size_t numShards = [] {
+      unsigned numThreads =
+          llvm::hardware_concurrency().compute_thread_count();
+      return std::min<size_t>(llvm::PowerOf2Ceil(std::max(8u, 2 * numThreads)),
+                              128);
+    }();
+    return numShards;
+  }
+
   /// Initialize the storage uniquer with a given number of storage shards to
   /// use. The provided shard number is required to be a valid power of 2. The
   /// destructor function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards = getDefaultNumShards())
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
-        destructorFn(destructorFn) {
+        shardShift(32 - llvm::Log2_64(numShards)), destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
            "the number of shards is required to be a power of 2");
     for (size_t i = 0; i < numShards; i++)
@@ -177,8 +191,13 @@ public:
 private:
   /// Return the shard used for the given hash value.
   Shard &getShard(unsigned hashValue) {
-    // Get a shard number from the provided hashvalue.
-    unsigned shardNum = hashValue & (numShards - 1);
+    // Get a shard number from the high bits of the (remixed) hash value. The
+    // low bits select the bucket within the shard's set, and using them here
+    // would leave most of the buckets of every shard unused.
+    unsigned shardNum =
+        numShards == 1 ? 0
+                       : static_cast<uint32_t>(hashValue * 0x9E3779B9u) >>
+                             shardShift;
 
     // Try to acquire an already initialized shard.
     Shard *shard = shards[shardNum].load(std::memory_order_acquire);
@@ -207,6 +226,9 @@ private:
   /// The number of available shards.
   size_t numShards;
 
+  /// The shift that maps a 32-bit hash to a shard number.
+  unsigned shardShift;
+
   /// Function to used to destruct any allocated storage instances.
   function_ref<void(BaseStorage *)> destructorFn;
 
@@ -35,6 +35,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     this->enableRegionSimplification = config.enableRegionSimplification;
     this->maxIterations = config.maxIterations;
     this->maxNumRewrites = config.maxNumRewrites;
+    this->parallelizeIsolatedRegions = config.parallelizeIsolatedRegions;
     this->disabledPatterns = disabledPatterns;
     this->enabledPatterns = enabledPatterns;
   }
@@ -47,6 +48,7 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     config.enableRegionSimplification = enableRegionSimplification;
     config.maxIterations = maxIterations;
     config.maxNumRewrites = maxNumRewrites;
+    config.parallelizeIsolatedRegions = parallelizeIsolatedRegions;
 
     RewritePatternSet owningPatterns(context);
     for (auto *dialect : context->getLoadedDialects())
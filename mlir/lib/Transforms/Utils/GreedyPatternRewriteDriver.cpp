@@ -15,6 +15,7 @@
 #include "mlir/Config/mlir-config.h"
 #include "mlir/IR/Action.h"
 #include "mlir/IR/Matchers.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Rewrite/PatternApplicator.h"
 #include "mlir/Transforms/FoldUtils.h"
@@ -615,9 +616,16 @@ public:
   /// success if the transformation converged.
   LogicalResult simplify(bool *changed) &&;
 
+  /// Mark `op`, an op nested in `region`, as already simplified. Its body is
+  /// not added to the initial worklist; only the op itself is.
+  void markSimplified(Operation *op) { simplifiedOps.insert(op); }
+
 private:
   /// The region that is simplified.
   Region &region;
+
+  /// Ops whose bodies reached a fixpoint before this driver started.
+  DenseSet<Operation *> simplifiedOps;
 };
 } // namespace
 
@@ -671,18 +679,33 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
 
     worklist.clear();
 
+    // Bodies of already simplified ops only need to be revisited once the
+    // first iteration changed something.
+    auto isSimplified = [&](Operation *op) {
+      return iteration == 1 && simplifiedOps.contains(op);
+    };
+
     if (!config.useTopDownTraversal) {
       // Add operations to the worklist in postorder.
-      region.walk([&](Operation *op) {
-        if (!insertKnownConstant(op))
-          addToWorklist(op);
-      });
+      for (Block &block : region) {
+        for (Operation &nestedOp : block) {
+          if (isSimplified(&nestedOp)) {
+            addToWorklist(&nestedOp);
+            continue;
+          }
+          nestedOp.walk([&](Operation *op) {
+            if (!insertKnownConstant(op))
+              addToWorklist(op);
+          });
+        }
+      }
     } else {
       // Add all nested operations to the worklist in preorder.
       region.walk<WalkOrder::PreOrder>([&](Operation *op) {
         if (!insertKnownConstant(op)) {
           addToWorklist(op);
-          return WalkResult::advance();
+          return isSimplified(op) ? WalkResult::skip()
+                                  : WalkResult::advance();
         }
         return WalkResult::skip();
       });
@@ -724,10 +747,42 @@ mlir::applyPatternsAndFoldGreedily(Region &region,
   if (!config.scope)
     config.scope = &region;
 
+  // Simplify the nested isolated ops first, concurrently. They cannot refer
+  // to each other's values, so each one gets its own driver.
+  MLIRContext *ctx = region.getContext();
+  SmallVector<Operation *> isolatedOps;
+  if (config.parallelizeIsolatedRegions && ctx->isMultithreadingEnabled() &&
+      !config.listener && config.strictMode == GreedyRewriteStrictness::AnyOp &&
+      config.maxNumRewrites == GreedyRewriteConfig::kNoLimit) {
+    for (Block &block : region)
+      for (Operation &op : block)
+        if (op.getNumRegions() != 0 &&
+            op.hasTrait<OpTrait::IsIsolatedFromAbove>())
+          isolatedOps.push_back(&op);
+  }
+  SmallVector<char> isolatedConverged(isolatedOps.size(), false);
+  std::atomic<bool> isolatedChanged(false);
+  if (isolatedOps.size() > 1) {
+    GreedyRewriteConfig nestedConfig = config;
+    nestedConfig.scope = nullptr;
+    nestedConfig.parallelizeIsolatedRegions = false;
+    parallelFor(ctx, 0, isolatedOps.size(), [&](size_t i) {
+      bool opChanged = false;
+      isolatedConverged[i] = succeeded(applyPatternsAndFoldGreedily(
+          isolatedOps[i], patterns, nestedConfig, &opChanged));
+      if (opChanged)
+        isolatedChanged = true;
+    });
+  }
+
   // Start the pattern driver.
-  RegionPatternRewriteDriver driver(region.getContext(), patterns, config,
-                                    region);
+  RegionPatternRewriteDriver driver(ctx, patterns, config, region);
+  for (auto [op, opConverged] : llvm::zip(isolatedOps, isolatedConverged))
+    if (opConverged)
+      driver.markSimplified(op);
   LogicalResult converged = std::move(driver).simplify(changed);
+  if (changed)
+    *changed |= isolatedChanged;
   LLVM_DEBUG(if (failed(converged)) {
     llvm::dbgs() << "The pattern rewrite did not converge after scanning "
                  << config.maxIterations << " times\n";
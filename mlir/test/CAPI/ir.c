@@ -2241,6 +2241,35 @@ int testDialectRegistry(void) {
   return 0;
 }
 
+int testModuleParseFromFile(MlirContext ctx) {
+  fprintf(stderr, "@testModuleParseFromFile\n");
+
+  const char *fileName = "capi-ir-parse-from-file.mlir";
+  FILE *file = fopen(fileName, "w");
+  if (!file)
+    return 1;
+  fputs("func.func private @fromFile()\n", file);
+  fclose(file);
+
+  MlirModule module = mlirModuleCreateParseFromFile(
+      ctx, mlirStringRefCreateFromCString(fileName));
+  remove(fileName);
+  if (mlirModuleIsNull(module))
+    return 2;
+  mlirOperationDump(mlirModuleGetOperation(module));
+  // CHECK-LABEL: @testModuleParseFromFile
+  // CHECK: func.func private @fromFile()
+  mlirModuleDestroy(module);
+
+  // A file that cannot be opened yields a null module.
+  MlirModule missing = mlirModuleCreateParseFromFile(
+      ctx, mlirStringRefCreateFromCString(fileName));
+  if (!mlirModuleIsNull(missing))
+    return 3;
+
+  return 0;
+}
+
 void testExplicitThreadPools(void) {
   MlirLlvmThreadPool threadPool = mlirLlvmThreadPoolCreate();
   MlirDialectRegistry registry = mlirDialectRegistryCreate();
@@ -2350,6 +2379,8 @@ int main(void) {
     return 14;
   if (testDialectRegistry())
     return 15;
+  if (testModuleParseFromFile(ctx))
+    return 16;
 
   testExplicitThreadPools();
   testDiagnostics();
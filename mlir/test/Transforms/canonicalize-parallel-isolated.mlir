@@ -0,0 +1,46 @@
+// RUN: mlir-opt %s -pass-pipeline='builtin.module(canonicalize{parallelize-isolated-regions})' | FileCheck %s
+// RUN: mlir-opt %s -mlir-disable-threading -pass-pipeline='builtin.module(canonicalize{parallelize-isolated-regions})' | FileCheck %s
+// RUN: mlir-opt %s -pass-pipeline='builtin.module(canonicalize{parallelize-isolated-regions top-down=false})' | FileCheck %s
+
+// The functions are canonicalized by their own drivers, and must end up the
+// same as with the sequential driver.
+
+// CHECK-LABEL: func @add_zero
+//  CHECK-SAME:   (%[[ARG:.*]]: i32)
+//  CHECK-NEXT:   return %[[ARG]] : i32
+func.func @add_zero(%arg0: i32) -> i32 {
+  %c0 = arith.constant 0 : i32
+  %0 = arith.addi %arg0, %c0 : i32
+  return %0 : i32
+}
+
+// CHECK-LABEL: func @fold_constants
+//  CHECK-NEXT:   %[[C:.*]] = arith.constant 3 : i32
+//  CHECK-NEXT:   return %[[C]] : i32
+func.func @fold_constants() -> i32 {
+  %c1 = arith.constant 1 : i32
+  %c2 = arith.constant 2 : i32
+  %0 = arith.addi %c1, %c2 : i32
+  return %0 : i32
+}
+
+// CHECK-LABEL: func @nested_if
+//  CHECK-SAME:   (%[[ARG:.*]]: i32)
+//   CHECK-NOT:   scf.if
+//       CHECK:   return %[[ARG]] : i32
+func.func @nested_if(%arg0: i32) -> i32 {
+  %true = arith.constant true
+  %0 = scf.if %true -> i32 {
+    scf.yield %arg0 : i32
+  } else {
+    %c0 = arith.constant 0 : i32
+    scf.yield %c0 : i32
+  }
+  return %0 : i32
+}
+
+// CHECK-LABEL: func @unchanged
+//  CHECK-NEXT:   return
+func.func @unchanged() {
+  return
+}
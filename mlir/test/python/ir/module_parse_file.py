@@ -0,0 +1,45 @@
+# RUN: %PYTHON %s | FileCheck %s
+
+import os
+import tempfile
+
+from mlir.ir import *
+
+
+def run(f):
+    print("\nTEST:", f.__name__)
+    f()
+    return f
+
+
+# Verify successful parse from a file.
+# CHECK-LABEL: TEST: testParseFileSuccess
+# CHECK: module @successfulParse
+@run
+def testParseFileSuccess():
+    ctx = Context()
+    with tempfile.NamedTemporaryFile(mode="w", suffix=".mlir", delete=False) as f:
+        f.write("module @successfulParse {}\n")
+        path = f.name
+    try:
+        module = Module.parseFile(path, ctx)
+    finally:
+        os.remove(path)
+    assert module.context is ctx
+    module.operation.verify()
+    print(str(module))
+
+
+# Verify that a file that cannot be opened raises an error.
+# CHECK-LABEL: TEST: testParseFileMissing
+# CHECK: Unable to parse module file
+@run
+def testParseFileMissing():
+    ctx = Context()
+    path = os.path.join(tempfile.mkdtemp(), "missing.mlir")
+    try:
+        Module.parseFile(path, ctx)
+    except MLIRError as e:
+        print(e)
+    else:
+        print("Exception not produced")
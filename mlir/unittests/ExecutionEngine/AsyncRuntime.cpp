@@ -0,0 +1,55 @@
+//===- AsyncRuntime.cpp -----------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/AsyncRuntime.h"
+
+#include "gmock/gmock.h"
+
+#include <vector>
+
+using namespace ::mlir::runtime;
+
+namespace {
+// A task of the dependency chain: waits for its input token with a blocking
+// await, then emplaces its output token.
+struct ChainTask {
+  AsyncToken *in;
+  AsyncToken *out;
+};
+} // namespace
+
+static void runChainTask(void *handle) {
+  auto *task = static_cast<ChainTask *>(handle);
+  mlirAsyncRuntimeAwaitToken(task->in);
+  mlirAsyncRuntimeEmplaceToken(task->out);
+}
+
+// Every task of the chain blocks on a token that is only produced by the task
+// scheduled before it. The chain must complete no matter which worker picks
+// up which task, and with more tasks than there are workers.
+TEST(AsyncRuntime, blockingAwaitDependencyChain) {
+  int64_t numTasks = 2 * mlirAsyncRuntimGetNumWorkerThreads() + 1;
+
+  std::vector<AsyncToken *> tokens;
+  for (int64_t i = 0; i <= numTasks; ++i)
+    tokens.push_back(mlirAsyncRuntimeCreateToken());
+
+  std::vector<ChainTask> tasks;
+  for (int64_t i = 0; i < numTasks; ++i)
+    tasks.push_back({tokens[i], tokens[i + 1]});
+  for (ChainTask &task : tasks)
+    mlirAsyncRuntimeExecute(&task, runChainTask);
+
+  mlirAsyncRuntimeEmplaceToken(tokens.front());
+  mlirAsyncRuntimeAwaitToken(tokens.back());
+  EXPECT_FALSE(mlirAsyncRuntimeIsTokenError(tokens.back()));
+
+  // Tokens are created with two references; emplacing drops one of them.
+  for (AsyncToken *token : tokens)
+    mlirAsyncRuntimeDropRef(token, 1);
+}
@@ -0,0 +1,55 @@
+//===- SparseTensorCOO.cpp --------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/SparseTensor/COO.h"
+
+#include "gmock/gmock.h"
+
+#include <random>
+
+using namespace ::mlir::sparse_tensor;
+using namespace ::testing;
+
+TEST(SparseTensorCOO, parallelSortSmall) {
+  std::vector<int> data = {5, 3, 9, 1, 7, 3};
+  parallelSort(data.begin(), data.end(), std::less<int>());
+  EXPECT_THAT(data, ElementsAre(1, 3, 3, 5, 7, 9));
+}
+
+TEST(SparseTensorCOO, parallelSortLarge) {
+  // Large enough to be split into chunks on any machine with more than one
+  // hardware thread, and not a multiple of the chunk count.
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> data(1000003);
+  for (uint64_t &x : data)
+    x = rng() % 1000;
+  std::vector<uint64_t> expected = data;
+  std::sort(expected.begin(), expected.end());
+  parallelSort(data.begin(), data.end(), std::less<uint64_t>());
+  EXPECT_EQ(data, expected);
+}
+
+TEST(SparseTensorCOO, sortLarge) {
+  const uint64_t rows = 1000, cols = 1000, numElements = 300000;
+  SparseTensorCOO<double> coo({rows, cols}, numElements);
+  std::mt19937_64 rng(7);
+  for (uint64_t i = 0; i < numElements; ++i)
+    coo.add({rng() % rows, rng() % cols}, static_cast<double>(i));
+  coo.sort();
+
+  const std::vector<Element<double>> &elements = coo.getElements();
+  ASSERT_EQ(elements.size(), numElements);
+  ElementLT<double> lt = coo.getElementLT();
+  for (uint64_t i = 1; i < numElements; ++i)
+    ASSERT_FALSE(lt(elements[i], elements[i - 1])) << "at element " << i;
+  // Sorting permutes the elements, so every value is still there once.
+  std::vector<bool> seen(numElements, false);
+  for (const Element<double> &e : elements)
+    seen[static_cast<uint64_t>(e.value)] = true;
+  EXPECT_THAT(seen, Each(true));
+}
@@ -91,27 +91,40 @@ struct SharedMemorySmartStackTy {
   void pop(void *Ptr, uint32_t Bytes);
 
 private:
-  /// Compute the size of the storage space reserved for a thread.
-  uint32_t computeThreadStorageTotal() {
+  /// Compute the offset into the storage, \p Begin, and the size, \p Total,
+  /// of the space reserved for thread \p TId.
+  void computeThreadStorage(uint32_t TId, uint32_t &Begin, uint32_t &Total) {
     uint32_t NumLanesInBlock = mapping::getNumberOfThreadsInBlock();
-    return utils::align_down((state::SharedScratchpadSize / NumLanesInBlock),
-                             Alignment);
-  }
-
-  /// Return the top address of the warp data stack, that is the first address
-  /// this warp will allocate memory at next.
-  void *getThreadDataTop(uint32_t TId) {
-    return &Data[computeThreadStorageTotal() * TId + Usage[TId]];
+    Total = utils::align_down((state::SharedScratchpadSize / NumLanesInBlock),
+                              Alignment);
+    Begin = Total * TId;
+
+    // The main thread in generic mode gets the space of its entire warp as the
+    // other threads do not participate in any computation at all. Its warp is
+    // the last one, so that is everything from its proportional share onwards.
+    // This must not be derived from the rounded down per-thread share, which
+    // is zero for all but the smallest blocks. The start of the space does not
+    // depend on the parallel level so that allocations made before and inside
+    // a parallel region stack up properly.
+    if (mapping::isSPMDMode() ||
+        TId != ((NumLanesInBlock - 1) & ~(mapping::getWarpSize() - 1)))
+      return;
+    Begin = utils::align_up(state::SharedScratchpadSize * TId / NumLanesInBlock,
+                            Alignment);
+    uint32_t Remaining = state::SharedScratchpadSize - Begin;
+    if (mapping::isMainThreadInGenericMode() || Total > Remaining)
+      Total = Remaining;
   }
 
   /// The actual storage, shared among all warps.
   unsigned char Data[state::SharedScratchpadSize]
       __attribute__((aligned(Alignment)));
+  /// The space used by each thread, in units of \p Alignment bytes.
   unsigned char Usage[mapping::MaxThreadsPerTeam]
       __attribute__((aligned(Alignment)));
 };
 
-static_assert(state::SharedScratchpadSize / mapping::MaxThreadsPerTeam <= 256,
+static_assert(state::SharedScratchpadSize / Alignment < 256,
               "Shared scratchpad of this size not supported yet.");
 
 /// The allocation of a single shared memory scratchpad.
@@ -125,17 +138,14 @@ void *SharedMemorySmartStackTy::push(uint64_t Bytes) {
   // First align the number of requested bytes.
   uint64_t AlignedBytes = utils::align_up(Bytes, Alignment);
 
-  uint32_t StorageTotal = computeThreadStorageTotal();
-
-  // The main thread in generic mode gets the space of its entire warp as the
-  // other threads do not participate in any computation at all.
-  if (mapping::isMainThreadInGenericMode())
-    StorageTotal *= mapping::getWarpSize();
-
   int TId = mapping::getThreadIdInBlock();
-  if (Usage[TId] + AlignedBytes <= StorageTotal) {
-    void *Ptr = getThreadDataTop(TId);
-    Usage[TId] += AlignedBytes;
+  uint32_t StorageBegin, StorageTotal;
+  computeThreadStorage(TId, StorageBegin, StorageTotal);
+
+  uint32_t Used = Usage[TId] * Alignment;
+  if (Used + AlignedBytes <= StorageTotal) {
+    void *Ptr = &Data[StorageBegin + Used];
+    Usage[TId] += AlignedBytes / Alignment;
     return Ptr;
   }
 
@@ -154,7 +164,7 @@ void SharedMemorySmartStackTy::pop(void *Ptr, uint32_t Bytes) {
   uint64_t AlignedBytes = utils::align_up(Bytes, Alignment);
   if (utils::isSharedMemPtr(Ptr)) {
     int TId = mapping::getThreadIdInBlock();
-    Usage[TId] -= AlignedBytes;
+    Usage[TId] -= AlignedBytes / Alignment;
     return;
   }
   memory::freeGlobal(Ptr, "Slow path shared memory deallocation");
@@ -91,16 +91,7 @@ class MemoryManagerTy {
     return L;
   }
 
-  /// A structure stores the meta data of a target pointer
-  struct NodeTy {
-    /// Memory size
-    const size_t Size;
-    /// Target pointer
-    void *Ptr;
-
-    /// Constructor
-    NodeTy(size_t Size, void *Ptr) : Size(Size), Ptr(Ptr) {}
-  };
+  struct NodeTy;
 
   /// To make \p NodePtrTy ordered when they're put into \p std::multiset.
   struct NodeCmpTy {
@@ -113,6 +104,22 @@ class MemoryManagerTy {
   /// the look up procedure more efficient.
   using FreeListTy = std::multiset<std::reference_wrapper<NodeTy>, NodeCmpTy>;
 
+  /// A structure stores the meta data of a target pointer
+  struct NodeTy {
+    /// Memory size
+    const size_t Size;
+    /// Target pointer
+    void *Ptr;
+    /// The free list node of this entry while the memory is handed out. A
+    /// buffer that is reused over and over (e.g. kernel arguments) then moves
+    /// between the free list and its user without allocating a new set node
+    /// on every free.
+    FreeListTy::node_type FreeListNode;
+
+    /// Constructor
+    NodeTy(size_t Size, void *Ptr) : Size(Size), Ptr(Ptr) {}
+  };
+
   /// A list of \p FreeListTy entries, each of which is a \p std::multiset of
   /// Nodes whose size is less or equal to a specific bucket size.
   std::vector<FreeListTy> FreeLists;
@@ -246,7 +253,7 @@ public:
 
       if (Itr != List.end()) {
         NodePtr = &Itr->get();
-        List.erase(Itr);
+        NodePtr->FreeListNode = List.extract(Itr);
       }
     }
 
@@ -309,7 +316,10 @@ public:
 
     {
       std::lock_guard<std::mutex> G(FreeListLocks[B]);
-      FreeLists[B].insert(*P);
+      if (P->FreeListNode)
+        FreeLists[B].insert(std::move(P->FreeListNode));
+      else
+        FreeLists[B].insert(*P);
     }
 
     return OFFLOAD_SUCCESS;
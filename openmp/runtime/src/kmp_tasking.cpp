@@ -3242,7 +3242,16 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
     return NULL;
   }
 
-  __kmp_acquire_bootstrap_lock(&victim_td->td.td_deque_lock);
+  // Do not queue up behind the owner or other thieves: the deque lock is a
+  // ticket lock, so every waiting thief would also delay the owner's next
+  // push or pop. A busy deque is treated like an empty one and the caller
+  // moves on to another victim.
+  if (!__kmp_test_bootstrap_lock(&victim_td->td.td_deque_lock)) {
+    KA_TRACE(10, ("__kmp_steal_task(exit #1b): T#%d could not steal from "
+                  "T#%d: task_team=%p deque is locked\n",
+                  gtid, __kmp_gtid_from_thread(victim_thr), task_team));
+    return NULL;
+  }
 
   int ntasks = TCR_4(victim_td->td.td_deque_ntasks);
   // Check again after we acquire the lock
@@ -3335,6 +3344,49 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
   return task;
 }
 
+// Number of random candidates __kmp_pick_victim_tid draws while looking for a
+// victim in the thief's own locality domain before settling for a remote one.
+#define KMP_TASK_STEAL_LOCAL_TRIES 4
+
+// __kmp_pick_victim_tid: pick a random thread other than tid to steal from.
+// When the threads are bound, candidates on the thief's own NUMA node (or
+// socket, if the topology has no NUMA level) are preferred so that stolen
+// tasks and the data they touch stay on the local memory controller. A few
+// random draws are made; if none of them is local, the last one is used, so
+// remote threads are still stolen from when the local ones run dry.
+static inline kmp_int32
+__kmp_pick_victim_tid(kmp_info_t *thread, kmp_int32 tid, kmp_int32 nthreads,
+                      kmp_thread_data_t *threads_data) {
+  kmp_int32 victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+  if (victim_tid >= tid) {
+    ++victim_tid; // Adjusts random distribution to exclude self
+  }
+#if KMP_AFFINITY_SUPPORTED
+  if (nthreads > 2 && KMP_AFFINITY_CAPABLE()) {
+    // Negative ids mean the domain is unknown or the thread's mask spans
+    // several of them; there is no locality to preserve in either case.
+    kmp_hw_t domain = KMP_HW_NUMA;
+    int my_id = thread->th.th_topology_ids[domain];
+    if (my_id < 0) {
+      domain = KMP_HW_SOCKET;
+      my_id = thread->th.th_topology_ids[domain];
+    }
+    if (my_id >= 0) {
+      for (int tries = 1; tries < KMP_TASK_STEAL_LOCAL_TRIES; ++tries) {
+        kmp_info_t *other_thread = threads_data[victim_tid].td.td_thr;
+        if (other_thread->th.th_topology_ids[domain] == my_id)
+          break;
+        victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+        if (victim_tid >= tid) {
+          ++victim_tid;
+        }
+      }
+    }
+  }
+#endif
+  return victim_tid;
+}
+
 // __kmp_execute_tasks_template: Choose and execute tasks until either the
 // condition is statisfied (return true) or there are none left (return false).
 //
@@ -3407,10 +3459,8 @@ static inline int __kmp_execute_tasks_template(
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
             // and failed.  Arch says that's not such a great idea.
-            victim_tid = __kmp_get_random(thread) % (nthreads - 1);
-            if (victim_tid >= tid) {
-              ++victim_tid; // Adjusts random distribution to exclude self
-            }
+            victim_tid =
+                __kmp_pick_victim_tid(thread, tid, nthreads, threads_data);
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
             // There is a slight chance that __kmp_enable_tasking() did not wake
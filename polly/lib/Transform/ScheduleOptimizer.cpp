@@ -52,6 +52,7 @@
 #include "polly/MatmulOptimizer.h"
 #include "polly/Options.h"
 #include "polly/ScheduleTreeTransform.h"
+#include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLOStream.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
@@ -172,6 +173,12 @@ static cl::opt<bool> EnableReschedule("polly-reschedule",
                                       cl::desc("Optimize SCoPs using ISL"),
                                       cl::init(true), cl::cat(PollyCategory));
 
+static cl::opt<int> ScheduleComputeOut(
+    "polly-schedule-computeout",
+    cl::desc("Bound the scheduler by a maximal amount of computational steps "
+             "(0 means no bound)"),
+    cl::Hidden, cl::init(300000), cl::cat(PollyCategory));
+
 static cl::opt<bool>
     PMBasedOpts("polly-pattern-matching-based-opts",
                 cl::desc("Perform optimizations based on pattern matching"),
@@ -192,6 +199,8 @@ static cl::opt<bool> OptimizedScops(
 
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
+STATISTIC(ScopsScheduleComputeOut,
+          "Number of scops whose rescheduling ran out of isl operations");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
@@ -860,7 +869,18 @@ static void runIslScheduleOptimizer(
     SC = SC.set_proximity(Proximity);
     SC = SC.set_validity(Validity);
     SC = SC.set_coincidence(Validity);
-    Schedule = SC.compute_schedule();
+
+    {
+      IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
+      Schedule = SC.compute_schedule();
+
+      if (MaxOpGuard.hasQuotaExceeded()) {
+        LLVM_DEBUG(dbgs() << "Schedule optimizer calculation exceeds ISL "
+                             "quota; keeping the original schedule\n");
+        ScopsScheduleComputeOut++;
+      }
+    }
+
     isl_options_set_on_error(Ctx, OnErrorStatus);
 
     ScopsRescheduled++;